@@ -274,7 +274,9 @@ if isDA:
                                                                                                    d0CutOff = cms.double(3.),        # downweight high IP tracks
                                                                                                    dzCutOff = cms.double(3.),        # outlier rejection after freeze-out (T<Tmin)   
                                                                                                    zmerge = cms.double(1e-2),        # merge intermediat clusters separated by less than zmerge
-                                                                                                   uniquetrkweight = cms.double(0.8) # require at least two tracks with this weight at T=Tpurge
+                                                                                                   uniquetrkweight = cms.double(0.8), # require at least two tracks with this weight at T=Tpurge
+                                                                                                   zgap = cms.double(0.),            # anneal regions separated by larger gaps in z concurrently (off if 0)
+                                                                                                   zrange = cms.double(0.)           # tracks only see vertices within zrange sigmas (off if 0)
                                                                                                    )
                                                                      )
                                            )
@@ -0,0 +1,79 @@
+#ifndef EGAMMAOBJECTS_GBRForestFlat
+#define EGAMMAOBJECTS_GBRForestFlat
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// GBRForestFlat                                                        //
+//                                                                      //
+// Evaluation-only copy of a GBRForest: the intermediate nodes of all   //
+// the trees are stored in one contiguous array, each tree breadth      //
+// first, and the terminal responses in another one.                    //
+//                                                                      //
+// The batch interface scores many input vectors per call, walking the  //
+// trees for a block of inputs at once. The responses are summed in     //
+// the same order as GBRForest::GetResponse, so results are identical.  //
+//                                                                      //
+// Not persistent: build it from the GBRForest read from the database.  //
+//////////////////////////////////////////////////////////////////////////
+
+#include "CondFormats/EgammaObjects/interface/GBRForest.h"
+
+#include <vector>
+#include <cmath>
+
+class GBRForestFlat {
+
+  public:
+
+    explicit GBRForestFlat(const GBRForest &forest);
+
+    double GetResponse(const float* vector) const;
+    double GetGradBoostClassifier(const float* vector) const;
+    double GetClassifier(const float* vector) const { return GetGradBoostClassifier(vector); }
+
+    // nVectors input vectors, the first variable of vector i at vectors[i*stride]
+    void GetResponses(const float* vectors, unsigned int nVectors, unsigned int stride, double* responses) const;
+    void GetGradBoostClassifiers(const float* vectors, unsigned int nVectors, unsigned int stride, double* responses) const;
+
+    unsigned int NTrees() const { return fRoots.size(); }
+
+  private:
+
+    // a daughter (or root) >= 0 is the index of an intermediate node in
+    // fNodes, one < 0 is ~index of a terminal response in fResponses
+    struct Node {
+      float cut;
+      unsigned int index;
+      int left;
+      int right;
+    };
+
+    int Daughter(const Node &node, const float* vector) const {
+      return vector[node.index] > node.cut ? node.right : node.left;
+    }
+
+    double fInitialResponse;
+    std::vector<Node> fNodes;
+    std::vector<float> fResponses;
+    std::vector<int> fRoots;
+
+};
+
+//_______________________________________________________________________
+inline double GBRForestFlat::GetResponse(const float* vector) const {
+  double response = fInitialResponse;
+  for (int root : fRoots) {
+    int index = root;
+    while (index>=0) index = Daughter(fNodes[index], vector);
+    response += fResponses[~index];
+  }
+  return response;
+}
+
+//_______________________________________________________________________
+inline double GBRForestFlat::GetGradBoostClassifier(const float* vector) const {
+  double response = GetResponse(vector);
+  return 2.0/(1.0+exp(-2.0*response))-1; //MVA output between -1 and 1
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef EGAMMAOBJECTS_GBRForestFlatCache
+#define EGAMMAOBJECTS_GBRForestFlatCache
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// GBRForestFlatCache                                                   //
+//                                                                      //
+// The GBRForestFlat copies of the forests used by a module, shared by  //
+// all its streams (e.g. in its GlobalCache): each forest is flattened  //
+// once per IOV, by the first stream asking for it.                     //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "CondFormats/EgammaObjects/interface/GBRForestFlat.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+class GBRForestFlatCache {
+
+  public:
+
+    // the flat copy of the forest labelled label for the IOV cacheId (0 if
+    // not from the database); *getForest() is the forest, only asked for
+    // when the copy has to be built
+    template<typename F>
+    std::shared_ptr<const GBRForestFlat> Get(const std::string &label, unsigned long long cacheId, F getForest) const {
+      std::lock_guard<std::mutex> guard(fMutex);
+      auto &entry = fForests[label];
+      if (!entry.second || entry.first!=cacheId) {
+        entry.second = std::make_shared<const GBRForestFlat>(*getForest());
+        entry.first = cacheId;
+      }
+      return entry.second;
+    }
+
+  private:
+
+    mutable std::mutex fMutex;
+    mutable std::map<std::string, std::pair<unsigned long long, std::shared_ptr<const GBRForestFlat> > > fForests;
+
+};
+
+#endif
@@ -0,0 +1,83 @@
+#include "CondFormats/EgammaObjects/interface/GBRForestFlat.h"
+
+#include <algorithm>
+
+//_______________________________________________________________________
+GBRForestFlat::GBRForestFlat(const GBRForest &forest) :
+fInitialResponse(forest.InitialResponse())
+{
+  fRoots.reserve(forest.Trees().size());
+
+  std::vector<int> queue;
+  for (const GBRTree &tree : forest.Trees()) {
+    const int responseOffset = fResponses.size();
+    fResponses.insert(fResponses.end(), tree.Responses().begin(), tree.Responses().end());
+
+    // a tree without intermediate nodes has a single response
+    if (tree.CutIndices().empty()) {
+      fRoots.push_back(~responseOffset);
+      continue;
+    }
+
+    // breadth first: queue holds the tree indices of the nodes in the order
+    // they are stored, so the daughters of queue[i] are stored after it
+    const int nodeOffset = fNodes.size();
+    fRoots.push_back(nodeOffset);
+    queue.assign(1, 0);
+
+    auto daughter = [&](int index) {
+      if (index<=0) return ~(responseOffset-index);
+      queue.push_back(index);
+      return nodeOffset + int(queue.size()) - 1;
+    };
+
+    for (unsigned int i=0; i<queue.size(); ++i) {
+      const int index = queue[i];
+      Node node;
+      node.cut = tree.CutVals()[index];
+      node.index = tree.CutIndices()[index];
+      node.left = daughter(tree.LeftIndices()[index]);
+      node.right = daughter(tree.RightIndices()[index]);
+      fNodes.push_back(node);
+    }
+  }
+}
+
+//_______________________________________________________________________
+void GBRForestFlat::GetResponses(const float* vectors, unsigned int nVectors, unsigned int stride, double* responses) const {
+
+  // the trees are walked for a block of inputs at once: the walks are
+  // independent, so their node loads overlap
+  constexpr unsigned int blockSize = 16;
+  int indices[blockSize];
+
+  for (unsigned int first=0; first<nVectors; first+=blockSize) {
+    const unsigned int n = std::min(blockSize, nVectors-first);
+    const float* block = vectors + first*stride;
+    double* blockResponses = responses + first;
+
+    std::fill(blockResponses, blockResponses+n, fInitialResponse);
+
+    for (int root : fRoots) {
+      std::fill(indices, indices+n, root);
+      bool active = root>=0;
+      while (active) {
+	active = false;
+	for (unsigned int k=0; k<n; ++k) {
+	  if (indices[k]<0) continue;
+	  indices[k] = Daughter(fNodes[indices[k]], block + k*stride);
+	  active |= indices[k]>=0;
+	}
+      }
+      for (unsigned int k=0; k<n; ++k) blockResponses[k] += fResponses[~indices[k]];
+    }
+  }
+}
+
+//_______________________________________________________________________
+void GBRForestFlat::GetGradBoostClassifiers(const float* vectors, unsigned int nVectors, unsigned int stride, double* responses) const {
+  GetResponses(vectors, nVectors, stride, responses);
+  for (unsigned int i=0; i<nVectors; ++i) {
+    responses[i] = 2.0/(1.0+exp(-2.0*responses[i]))-1; //MVA output between -1 and 1
+  }
+}
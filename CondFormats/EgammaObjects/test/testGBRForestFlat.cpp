@@ -0,0 +1,99 @@
+// GBRForestFlat must give bit by bit the responses of the GBRForest it is
+// built from, one input at a time and in batches. The forests are random
+// trees of various depths; the inputs include values equal to the cuts.
+
+#include "CondFormats/EgammaObjects/interface/GBRForest.h"
+#include "CondFormats/EgammaObjects/interface/GBRForestFlat.h"
+
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+  const unsigned int nVars = 12;
+
+  // a random tree with up to nNodes intermediate nodes, grown by replacing terminal nodes
+  GBRTree makeTree(std::mt19937 &rng, unsigned int nNodes, std::vector<float> &cuts) {
+    std::uniform_real_distribution<float> flat(-1.f, 1.f);
+    GBRTree tree;
+    auto addNode = [&]() {
+      tree.CutIndices().push_back(rng()%nVars);
+      tree.CutVals().push_back(flat(rng));
+      cuts.push_back(tree.CutVals().back());
+      tree.Responses().push_back(0.1f*flat(rng));
+      tree.LeftIndices().push_back(-int(tree.Responses().size()-1));
+      tree.Responses().push_back(0.1f*flat(rng));
+      tree.RightIndices().push_back(-int(tree.Responses().size()-1));
+      return int(tree.CutIndices().size()-1);
+    };
+    addNode();
+    while (tree.CutIndices().size()<nNodes) {
+      unsigned int node = rng()%tree.CutIndices().size();
+      bool left = rng()%2;
+      if ((left ? tree.LeftIndices()[node] : tree.RightIndices()[node])>0) continue;
+      // the terminal response left unused is harmless
+      int daughter = addNode();
+      (left ? tree.LeftIndices()[node] : tree.RightIndices()[node]) = daughter;
+    }
+    return tree;
+  }
+
+  // the bits of the doubles must be the same
+  bool same(double a, double b) { return std::memcmp(&a, &b, sizeof(double))==0; }
+
+}
+
+int main() {
+  std::mt19937 rng(2017);
+  std::uniform_real_distribution<float> flat(-1.2f, 1.2f);
+  int failures = 0;
+
+  for (unsigned int f=0; f<20; ++f) {
+    GBRForest forest;
+    forest.SetInitialResponse(0.01*f);
+    std::vector<float> cuts;
+    unsigned int nTrees = 1 + 50*f;
+    for (unsigned int t=0; t<nTrees; ++t)
+      forest.Trees().push_back(makeTree(rng, 1 + rng()%(1+3*f), cuts));
+    GBRForestFlat flatForest(forest);
+    if (flatForest.NTrees()!=nTrees) {
+      std::cout << "forest " << f << ": " << flatForest.NTrees() << " trees instead of " << nTrees << std::endl;
+      ++failures;
+    }
+
+    // a stride larger than the number of variables, and a number of inputs
+    // which is not a multiple of the batch blocks
+    for (unsigned int stride : {nVars, nVars+3}) {
+      const unsigned int nVectors = 1000 + f;
+      std::vector<float> vectors(nVectors*stride);
+      for (auto & x : vectors) x = (rng()%4==0) ? cuts[rng()%cuts.size()] : flat(rng);
+
+      std::vector<double> responses(nVectors), classifiers(nVectors);
+      flatForest.GetResponses(vectors.data(), nVectors, stride, responses.data());
+      flatForest.GetGradBoostClassifiers(vectors.data(), nVectors, stride, classifiers.data());
+
+      unsigned int nDifferent = 0;
+      for (unsigned int i=0; i<nVectors; ++i) {
+	const float* vector = &vectors[i*stride];
+	double response = forest.GetResponse(vector);
+	double classifier = forest.GetGradBoostClassifier(vector);
+	if (!same(flatForest.GetResponse(vector), response) || !same(responses[i], response) ||
+	    !same(flatForest.GetGradBoostClassifier(vector), classifier) ||
+	    !same(flatForest.GetClassifier(vector), forest.GetClassifier(vector)) ||
+	    !same(classifiers[i], classifier))
+	  ++nDifferent;
+      }
+      if (nDifferent) {
+	std::cout << "forest " << f << " stride " << stride << ": " << nDifferent << " of the "
+		  << nVectors << " responses differ" << std::endl;
+	++failures;
+      }
+    }
+  }
+
+  if (failures) return 1;
+  std::cout << "GBRForestFlat: the responses are identical to the GBRForest ones" << std::endl;
+  return 0;
+}
@@ -3,19 +3,186 @@
 
 /* Encapsulate of MonitorElement to expose *limited* support for concurrency.
  *
- * ...
+ * Histograms are not filled directly: each thread fills its own copy of the
+ * histogram, and the copies are added to the MonitorElement owned by the
+ * DQMStore at the end of each luminosity block and run (see
+ * DQMStore::mergeConcurrentFills).  The copies are kept per luminosity block
+ * of the events filling them, so that with concurrent luminosity blocks the
+ * fills of the next one are not merged at the end of the current one.  Scalars, and histograms whose axes can
+ * be extended, are filled directly under a lock.
  */
 
+#include <memory>
 #include <mutex>
+#include <vector>
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/spin_mutex.h>
 
 #include "DQMServices/Core/interface/MonitorElement.h"
 
+class ConcurrentFillBuffers
+{
+private:
+  // the fills of one luminosity block (0 if unknown) from one thread
+  struct LumiFills {
+    unsigned int lumi_;
+    std::unique_ptr<MonitorElement> me_;
+  };
+
+  struct Buffer {
+    // only contended while the buffers are being merged
+    tbb::spin_mutex lock_;
+    // usually a single entry, more if this thread analyses events from concurrent luminosity blocks
+    std::vector<LumiFills> fills_;
+  };
+
+  MonitorElement* target_;
+  tbb::enumerable_thread_specific<Buffer> buffers_;
+  // serialises the merges, the ShiftFillLast and the copies of the target
+  std::mutex merge_lock_;
+
+  // the luminosity block of the event being analysed by this thread (see LumiSentry)
+  static thread_local unsigned int currentLumi_;
+
+  // add the fills of the given luminosity block (all of them if 0) to the target; called holding merge_lock_
+  void mergeLocked(unsigned int lumi)
+  {
+    bool updated = false;
+    for (auto& buffer: buffers_) {
+      std::lock_guard<tbb::spin_mutex> guard(buffer.lock_);
+      for (auto& fills: buffer.fills_) {
+        if (lumi != 0 and fills.lumi_ != 0 and fills.lumi_ != lumi)
+          continue;
+        if (not fills.me_->wasUpdated())
+          continue;
+        target_->getTH1()->Add(fills.me_->getTH1());
+        fills.me_->getTH1()->Reset();
+        fills.me_->resetUpdate();
+        updated = true;
+      }
+    }
+    if (updated)
+      target_->update();
+  }
+
+public:
+  // tags the fills made by this thread while it exists with the luminosity block of the event
+  class LumiSentry
+  {
+  public:
+    explicit LumiSentry(unsigned int lumi) :
+      previous_(currentLumi_)
+    {
+      currentLumi_ = lumi;
+    }
+
+    ~LumiSentry(void)
+    {
+      currentLumi_ = previous_;
+    }
+
+    LumiSentry(LumiSentry const&) = delete;
+    LumiSentry& operator=(LumiSentry const&) = delete;
+
+  private:
+    unsigned int previous_;
+  };
+
+  explicit ConcurrentFillBuffers(MonitorElement* target) :
+    target_(target)
+  { }
+
+  // non-copiable, non-movable
+  ConcurrentFillBuffers(ConcurrentFillBuffers const&) = delete;
+  ConcurrentFillBuffers& operator=(ConcurrentFillBuffers const&) = delete;
+
+  // the fills still in the buffers are merged before they are destroyed
+  ~ConcurrentFillBuffers(void)
+  {
+    merge();
+  }
+
+  // can the fills to this MonitorElement be buffered ?
+  static bool canBuffer(MonitorElement const* me)
+  {
+    switch (me->kind()) {
+      case MonitorElement::DQM_KIND_INVALID:
+      case MonitorElement::DQM_KIND_INT:
+      case MonitorElement::DQM_KIND_REAL:
+      case MonitorElement::DQM_KIND_STRING:
+        return false;
+      default:
+        return not me->getTH1()->CanExtendAllAxes();
+    }
+  }
+
+  template <typename... Args>
+  void fill(Args && ... args)
+  {
+    unsigned int lumi = currentLumi_;
+    Buffer& buffer = buffers_.local();
+    MonitorElement* me = nullptr;
+    {
+      std::lock_guard<tbb::spin_mutex> guard(buffer.lock_);
+      for (auto& fills: buffer.fills_) {
+        if (fills.lumi_ == lumi) {
+          me = fills.me_.get();
+          break;
+        }
+      }
+      if (me == nullptr) {
+        // reuse the histogram of a luminosity block which has been merged
+        for (auto& fills: buffer.fills_) {
+          if (not fills.me_->wasUpdated()) {
+            fills.lumi_ = lumi;
+            me = fills.me_.get();
+            break;
+          }
+        }
+      }
+      if (me != nullptr) {
+        me->Fill(std::forward<Args>(args)...);
+        return;
+      }
+    }
+    // the histogram is copied on the first fill from each thread, once the
+    // booking (axes, labels, options) is complete; the copy is made without
+    // holding the buffer lock, which the merge takes after merge_lock_
+    std::unique_ptr<MonitorElement> copy;
+    {
+      std::lock_guard<std::mutex> merge_guard(merge_lock_);
+      copy = std::make_unique<MonitorElement>(*target_);
+    }
+    copy->getTH1()->Reset();
+    copy->resetUpdate();
+    copy->Fill(std::forward<Args>(args)...);
+    std::lock_guard<tbb::spin_mutex> guard(buffer.lock_);
+    buffer.fills_.push_back(LumiFills{lumi, std::move(copy)});
+  }
+
+  // add the contents of the per-thread histograms to the target, and reset them:
+  // only the fills of the given luminosity block and the untagged ones, or all of them if 0
+  void merge(unsigned int lumi = 0)
+  {
+    std::lock_guard<std::mutex> merge_guard(merge_lock_);
+    mergeLocked(lumi);
+  }
+
+  // the last bins depend on all previous fills, so they are merged first, under the same lock
+  void shiftFillLast(double y, double ye, int32_t xscale)
+  {
+    std::lock_guard<std::mutex> merge_guard(merge_lock_);
+    mergeLocked(0);
+    target_->ShiftFillLast(y, ye, xscale);
+  }
+};
+
 class ConcurrentMonitorElement
 {
 private:
   mutable MonitorElement* me_;
   mutable tbb::spin_mutex lock_;
+  std::shared_ptr<ConcurrentFillBuffers> buffers_;
 
 public:
   ConcurrentMonitorElement(void) :
@@ -26,6 +193,11 @@ public:
     me_(me)
   { }
 
+  ConcurrentMonitorElement(MonitorElement* me, std::shared_ptr<ConcurrentFillBuffers> buffers) :
+    me_(me),
+    buffers_(std::move(buffers))
+  { }
+
   // non-copiable
   ConcurrentMonitorElement(ConcurrentMonitorElement const&) = delete;
 
@@ -35,6 +207,7 @@ public:
     std::lock_guard<tbb::spin_mutex> guard(other.lock_);
     me_ = other.me_;
     other.me_ = nullptr;
+    buffers_ = std::move(other.buffers_);
   }
 
   // not copy-assignable
@@ -49,6 +222,7 @@ public:
     std::lock_guard<tbb::spin_mutex> others(other.lock_, std::adopt_lock);
     me_ = other.me_;
     other.me_ = nullptr;
+    buffers_ = std::move(other.buffers_);
     return *this;
   }
 
@@ -59,13 +233,22 @@ public:
   template <typename... Args>
   void fill(Args && ... args) const
   {
+    if (buffers_) {
+      buffers_->fill(std::forward<Args>(args)...);
+      return;
+    }
     std::lock_guard<tbb::spin_mutex> guard(lock_);
     me_->Fill(std::forward<Args>(args)...);
   }
 
   // expose as a const method to mean that it is concurrent-safe
+  // the fills are not buffered, since the last bins depend on all previous fills
   void shiftFillLast(double y, double ye = 0., int32_t xscale = 1) const
   {
+    if (buffers_) {
+      buffers_->shiftFillLast(y, ye, xscale);
+      return;
+    }
     std::lock_guard<tbb::spin_mutex> guard(lock_);
     me_->ShiftFillLast(y, ye, xscale);
   }
@@ -75,6 +258,7 @@ public:
   {
     std::lock_guard<tbb::spin_mutex> guard(lock_);
     me_ = nullptr;
+    buffers_.reset();
   }
 
   operator bool() const
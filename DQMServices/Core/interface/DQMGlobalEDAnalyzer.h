@@ -58,6 +58,8 @@ DQMGlobalEDAnalyzer<H, Args...>::analyze(edm::StreamID, edm::Event const& event,
 {
   //auto& h = const_cast<H&>(* this->runCache(event.getRun().index()));
   auto const& h = * this->runCache(event.getRun().index());
+  // the per-thread fills are merged at the end of the luminosity block of the event
+  ConcurrentFillBuffers::LumiSentry sentry(event.luminosityBlock());
   dqmAnalyze(event, setup, h);
 }
 
@@ -21,6 +21,7 @@
 #include <execinfo.h>
 
 #include <classlib/utils/Regexp.h>
+#include <tbb/concurrent_unordered_map.h>
 
 #include "DQMServices/Core/interface/DQMDefinitions.h"
 #include "DQMServices/Core/interface/ConcurrentMonitorElement.h"
@@ -147,7 +148,7 @@ public:
     ConcurrentMonitorElement book##suffix(Args&&... args)               \
     {                                                                   \
       MonitorElement* me = IBooker::book##suffix(std::forward<Args>(args)...); \
-      return ConcurrentMonitorElement(me);                              \
+      return store_->concurrentMonitorElement(me);                      \
     }
 
     // For the supported interface, see the DQMStore function that
@@ -177,10 +178,13 @@ public:
 
   private:
     explicit ConcurrentBooker(DQMStore* store) noexcept :
-      IBooker{store}
+      IBooker{store},
+      store_{store}
     {}
 
     ~ConcurrentBooker() = default;
+
+    DQMStore* store_;
   };
 
   class IGetter {
@@ -277,6 +281,13 @@ public:
     }
   }
 
+  // Add the per-thread fills of all the ConcurrentMonitorElements to
+  // the MonitorElements in the store: the ones made for the events of the
+  // given luminosity block and the ones not tagged with one, or all of them
+  // if lumi is 0.  This is done once before the global end of each
+  // luminosity block, and for all the fills before the end of each run.
+  void mergeConcurrentFills(uint32_t lumi = 0);
+
   // Signature needed in the harvesting where the booking is done in
   // the endJob. No handles to the run there. Two arguments ensure the
   // capability of booking and getting. The method relies on the
@@ -553,11 +564,15 @@ private:
   void reset();
   void forceReset();
   void postGlobalBeginLumi(const edm::GlobalContext&);
+  void preGlobalEndLumi(const edm::GlobalContext&);
+  void preGlobalEndRun(const edm::GlobalContext&);
 
   bool extract(TObject* obj, std::string const& dir, bool overwrite, bool collateHistograms);
   TObject* extractNextObject(TBufferFile&) const;
 
   // ---------------------- Booking ------------------------------------
+  std::string const* findDirectory(std::string const& path) const;
+  ConcurrentMonitorElement concurrentMonitorElement(MonitorElement* me);
   MonitorElement* initialise(MonitorElement* me, std::string const& path);
   MonitorElement* book_(std::string const& dir,
                         std::string const& name,
@@ -643,6 +658,10 @@ private:
   std::string pwd_{};
   MEMap data_;
   std::set<std::string> dirs_;
+  // lock-free lookup of the entries of dirs_; only modified while booking
+  tbb::concurrent_unordered_map<std::string, std::string const*> dirIndex_;
+  // fill buffers of the ConcurrentMonitorElements, protected by book_mutex_
+  std::vector<std::weak_ptr<ConcurrentFillBuffers>> concurrentFills_;
 
   QCMap qtests_;
   QAMap qalgos_;
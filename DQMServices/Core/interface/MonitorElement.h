@@ -38,6 +38,7 @@ class MonitorElement
 {
   friend class DQMStore;
   friend class DQMService;
+  friend class ConcurrentFillBuffers;
 public:
   struct Scalar
   {
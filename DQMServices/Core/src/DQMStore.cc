@@ -18,7 +18,11 @@
 #include "TBufferFile.h"
 #include <boost/algorithm/string.hpp>
 #include <boost/range/iterator_range_core.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 
+#include <algorithm>
 #include <iterator>
 #include <cerrno>
 #include <exception>
@@ -380,6 +384,8 @@ DQMStore::DQMStore(edm::ParameterSet const& pset, edm::ActivityRegistry& ar)
     ar.watchPostSourceLumi([this](edm::LuminosityBlockIndex){ forceReset(); });
   }
   ar.watchPostGlobalBeginLumi(this, &DQMStore::postGlobalBeginLumi);
+  ar.watchPreGlobalEndLumi(this, &DQMStore::preGlobalEndLumi);
+  ar.watchPreGlobalEndRun(this, &DQMStore::preGlobalEndRun);
 }
 
 DQMStore::DQMStore(edm::ParameterSet const& pset)
@@ -608,8 +614,8 @@ DQMStore::makeDirectory(std::string const& path)
                     " which already exists as a monitor element",
                     subdir.c_str());
 
-    if (! dirs_.count(subdir))
-      dirs_.insert(subdir);
+    if (! findDirectory(subdir))
+      dirIndex_.emplace(subdir, &*dirs_.insert(subdir).first);
 
     // Stop if we've reached the end (including possibly a trailing slash).
     if (slash+1 >= path.size())
@@ -628,7 +634,15 @@ DQMStore::makeDirectory(std::string const& path)
 bool
 DQMStore::dirExists(std::string const& path) const
 {
-  return dirs_.count(path) > 0;
+  return findDirectory(path) != nullptr;
+}
+
+/// get the entry of dirs_ for this path, or null if it does not exist
+std::string const*
+DQMStore::findDirectory(std::string const& path) const
+{
+  auto pos = dirIndex_.find(path);
+  return (pos == dirIndex_.end() ? nullptr : pos->second);
 }
 
 // //====================================================
@@ -932,8 +946,9 @@ DQMStore::book_(std::string const& dir,
   }
   else {
     // Create and initialise core object.
-    assert(dirs_.count(dir));
-    MonitorElement proto(&*dirs_.find(dir), name, run_, moduleId_);
+    std::string const* dirname = findDirectory(dir);
+    assert(dirname);
+    MonitorElement proto(dirname, name, run_, moduleId_);
     me = const_cast<MonitorElement&>(*data_.insert(std::move(proto)).first)
       .initialise((MonitorElement::Kind)kind, h);
 
@@ -990,8 +1005,9 @@ DQMStore::book_(std::string const& dir,
   }
   else {
     // Create it and return for initialisation.
-    assert(dirs_.count(dir));
-    MonitorElement proto(&*dirs_.find(dir), name, run_, moduleId_);
+    std::string const* dirname = findDirectory(dir);
+    assert(dirname);
+    MonitorElement proto(dirname, name, run_, moduleId_);
     return &const_cast<MonitorElement&>(*data_.insert(std::move(proto)).first);
   }
 }
@@ -1894,6 +1910,76 @@ DQMStore::postGlobalBeginLumi(edm::GlobalContext const& gc)
   }
 }
 
+/* Merge the per-thread fills of the ConcurrentMonitorElements before the
+ * output modules and harvesters look at the MonitorElements at the end of
+ * the luminosity block.  The fills already made for the events of a
+ * following, concurrent, luminosity block are left for its own end.
+ */
+void
+DQMStore::preGlobalEndLumi(edm::GlobalContext const& gc)
+{
+  mergeConcurrentFills(gc.luminosityBlockID().luminosityBlock());
+}
+
+/* Same at the end of the run, once for all the modules: all the streams
+ * are done with the run, so no fill is left behind.
+ */
+void
+DQMStore::preGlobalEndRun(edm::GlobalContext const&)
+{
+  mergeConcurrentFills();
+}
+
+//////////////////////////////////////////////////////////////////////
+thread_local unsigned int ConcurrentFillBuffers::currentLumi_ = 0;
+
+/** Wrap a MonitorElement booked by a ConcurrentBooker. When running
+ * multithreaded, the histograms are filled through per-thread buffers,
+ * which are registered here so that they can be merged later.
+ * Called while holding book_mutex_.
+ */
+ConcurrentMonitorElement
+DQMStore::concurrentMonitorElement(MonitorElement* me)
+{
+  if (not enableMultiThread_ or not ConcurrentFillBuffers::canBuffer(me))
+    return ConcurrentMonitorElement(me);
+
+  auto buffers = std::make_shared<ConcurrentFillBuffers>(me);
+  concurrentFills_.emplace_back(buffers);
+  return ConcurrentMonitorElement(me, std::move(buffers));
+}
+
+/** Add the per-thread fills to the MonitorElements. The MonitorElements
+ * are independent, so they are merged in parallel; the buffers of the
+ * ConcurrentMonitorElements which no longer exist are dropped.
+ */
+void
+DQMStore::mergeConcurrentFills(uint32_t const lumi)
+{
+  std::vector<std::shared_ptr<ConcurrentFillBuffers>> fills;
+  {
+    std::lock_guard<std::mutex> guard(book_mutex_);
+    fills.reserve(concurrentFills_.size());
+    auto last = std::remove_if(concurrentFills_.begin(), concurrentFills_.end(),
+                               [&fills](std::weak_ptr<ConcurrentFillBuffers> const& weak) {
+                                 auto buffers = weak.lock();
+                                 if (not buffers)
+                                   return true;
+                                 fills.push_back(std::move(buffers));
+                                 return false;
+                               });
+    concurrentFills_.erase(last, concurrentFills_.end());
+  }
+
+  tbb::this_task_arena::isolate([&fills, lumi]() {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, fills.size()),
+                      [&fills, lumi](tbb::blocked_range<size_t> const& range) {
+                        for (size_t i = range.begin(); i != range.end(); ++i)
+                          fills[i]->merge(lumi);
+                      });
+  });
+}
+
 //////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
@@ -3073,8 +3159,10 @@ DQMStore::rmdir(std::string const& path)
 
   auto de = dirs_.end();
   auto di = dirs_.lower_bound(*cleaned);
-  while (di != de && isSubdirectory(*cleaned, *di))
+  while (di != de && isSubdirectory(*cleaned, *di)) {
+    dirIndex_.unsafe_erase(*di);
     dirs_.erase(di++);
+  }
 }
 
 /// remove all monitoring elements from directory;
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <vector>
+
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "TH1F.h"
+#include "TH2F.h"
+#include "TProfile.h"
+
+/*
+ * Test case for the per-thread fills of the ConcurrentMonitorElements:
+ * the histograms filled concurrently from many tasks must be, once merged,
+ * identical to the same histograms filled serially, and the fills tagged
+ * with a luminosity block must only be merged at the end of that block.
+ *
+ */
+
+int main(int argc, char** argv)
+{
+	edm::ParameterSet pset;
+	pset.addUntrackedParameter<bool>("enableMultiThread", true);
+	DQMStore store(pset);
+
+	ConcurrentMonitorElement h1, h2, prof;
+	store.bookConcurrentTransaction([&](DQMStore::ConcurrentBooker &booker) {
+		booker.setCurrentFolder("Test");
+		h1 = booker.book1D("h1", "h1", 100, 0., 100.);
+		h2 = booker.book2D("h2", "h2", 10, 0., 10., 10, 0., 10.);
+		prof = booker.bookProfile("prof", "prof", 10, 0., 10., 0., 100.);
+	}, 0);
+
+	TH1F ref1("ref1", "ref1", 100, 0., 100.);
+	TH2F ref2("ref2", "ref2", 10, 0., 10., 10, 0., 10.);
+	TProfile refProf("refProf", "refProf", 10, 0., 10., 0., 100.);
+
+	// integer weights and values, so that the sums do not depend on the order
+	auto x = [](unsigned int i) { return double(i * 7 % 113); };
+	auto y = [](unsigned int i) { return double(i * 3 % 11); };
+	auto w = [](unsigned int i) { return double(1 + i % 3); };
+
+	unsigned int const entries = 200000;
+	for (int pass = 0; pass != 2; ++pass) {
+		tbb::task_arena arena(8);
+		arena.execute([&] {
+			tbb::parallel_for(0U, entries, [&](unsigned int i) {
+				h1.fill(x(i), w(i));
+				h2.fill(y(i), x(i) / 10., w(i));
+				prof.fill(y(i), x(i));
+			});
+		});
+		for (unsigned int i = 0; i != entries; ++i) {
+			ref1.Fill(x(i), w(i));
+			ref2.Fill(y(i), x(i) / 10., w(i));
+			refProf.Fill(y(i), x(i));
+		}
+		// merging twice (e.g. at the end of a lumi and of the run) must not count the fills twice
+		store.mergeConcurrentFills();
+		store.mergeConcurrentFills();
+	}
+
+	auto check = [](MonitorElement const* me, TH1 const& ref) {
+		if (me == nullptr) {
+			std::cerr << "missing MonitorElement for " << ref.GetName() << std::endl;
+			return false;
+		}
+		TH1 const* h = me->getTH1();
+		bool ok = h->GetEntries() == ref.GetEntries();
+		for (int bin = 0; ok and bin < ref.GetNcells(); ++bin)
+			ok = h->GetBinContent(bin) == ref.GetBinContent(bin) and h->GetBinError(bin) == ref.GetBinError(bin);
+		if (not ok)
+			std::cerr << me->getFullname() << " differs from the serial fill" << std::endl;
+		return ok;
+	};
+
+	bool ok = true;
+	ok &= check(store.get("Test/h1"), ref1);
+	ok &= check(store.get("Test/h2"), ref2);
+	ok &= check(store.get("Test/prof"), refProf);
+
+	// with concurrent luminosity blocks, the fills made for the events of the
+	// next one must not be merged at the end of the current one
+	ConcurrentMonitorElement lumis;
+	store.bookConcurrentTransaction([&](DQMStore::ConcurrentBooker &booker) {
+		booker.setCurrentFolder("Test");
+		lumis = booker.book1D("lumis", "lumis", 10, 0., 10.);
+	}, 0);
+	TH1F refLumi7("refLumi7", "refLumi7", 10, 0., 10.);
+	TH1F refLumis("refLumis", "refLumis", 10, 0., 10.);
+	tbb::task_arena arena(8);
+	arena.execute([&] {
+		tbb::parallel_for(0U, entries, [&](unsigned int i) {
+			ConcurrentFillBuffers::LumiSentry sentry(7 + i % 2);
+			lumis.fill(y(i), w(i));
+		});
+	});
+	for (unsigned int i = 0; i != entries; ++i) {
+		if (i % 2 == 0)
+			refLumi7.Fill(y(i), w(i));
+		refLumis.Fill(y(i), w(i));
+	}
+	store.mergeConcurrentFills(7);
+	ok &= check(store.get("Test/lumis"), refLumi7);
+	store.mergeConcurrentFills(8);
+	ok &= check(store.get("Test/lumis"), refLumis);
+
+	return ok ? 0 : 1;
+}
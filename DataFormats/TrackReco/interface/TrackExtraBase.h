@@ -73,6 +73,11 @@ public:
         return recHitRef(i);
     }
 
+    /// id of the collection the hits are in
+    edm::ProductID recHitsProductId() const {
+      return m_hitCollection.id();
+    }
+
     TrackingRecHitCollection const & recHitsProduct() const {
       return *edm::getProduct<TrackingRecHitCollection>(m_hitCollection);
 
@@ -0,0 +1,86 @@
+#ifndef DataFormats_TrackerRecHit2D_CompactTrackerRecHitCollection_h
+#define DataFormats_TrackerRecHit2D_CompactTrackerRecHitCollection_h
+
+/** \class CompactTrackerRecHitCollection
+ *
+ * Flat, non-polymorphic storage of the tracker hits of a TrackingRecHitCollection.
+ *
+ * Only what a persistent tracker hit holds is stored: the detId, the kind of
+ * hit, its type, the cluster(s) and, for pixels, the quality word.  Position
+ * and error are transient in the hits as well, they are recomputed by the CPE.
+ * The i-th entry corresponds to the i-th hit of the TrackingRecHitCollection
+ * identified by hitsProductId(), so the firstRecHit()/recHitsSize() range of a
+ * TrackExtra indexes it directly.
+ *
+ * hit(i) and hitForFit(i,det) build the concrete hit on request, with a single
+ * allocation, instead of reading back an OwnVector and cloning its hits.
+ * Hits not made of clusters (fastsim, multi, non tracker) are kept as
+ * "unsupported" placeholders and must be read from the TrackingRecHitCollection.
+ */
+
+#include "DataFormats/TrackerRecHit2D/interface/OmniClusterRef.h"
+#include "DataFormats/TrackingRecHit/interface/TrackingRecHit.h"
+#include "DataFormats/Provenance/interface/ProductID.h"
+
+#include <cstdint>
+#include <vector>
+
+class GeomDet;
+
+class CompactTrackerRecHitCollection {
+public:
+  enum Kind : uint8_t { invalid=0, pixel, strip2D, strip1D, matched, projMono, projStereo, phase2, unsupported };
+
+  CompactTrackerRecHitCollection() {}
+  explicit CompactTrackerRecHitCollection(edm::ProductID const & hitsId) : hitsId_(hitsId) {}
+
+  /// the TrackingRecHitCollection this collection is parallel to
+  edm::ProductID const & hitsProductId() const { return hitsId_;}
+
+  void reserve(unsigned int n);
+  /// returns false if the hit is stored as unsupported
+  bool push_back(TrackingRecHit const & hit);
+
+  unsigned int size() const { return detIds_.size();}
+  bool empty() const { return detIds_.empty();}
+
+  Kind kind(unsigned int i) const { return Kind(status_[i]>>4);}
+  bool isSupported(unsigned int i) const { return kind(i)!=unsupported;}
+  /// true if all the hits in [first,first+n) can be built from this collection
+  bool isSupported(unsigned int first, unsigned int n) const;
+
+  DetId geographicalId(unsigned int i) const { return DetId(detIds_[i]);}
+  TrackingRecHit::Type type(unsigned int i) const { return TrackingRecHit::Type(status_[i]&0xF);}
+  uint32_t qualWord(unsigned int i) const { return qualWords_[i];}
+
+  unsigned int nClusters(unsigned int i) const { return firstCluster_[i+1]-firstCluster_[i];}
+  /// the cluster, the mono one for matched hits
+  OmniClusterRef const & cluster(unsigned int i) const { return clusters_[firstCluster_[i]];}
+  OmniClusterRef const & stereoCluster(unsigned int i) const { return clusters_[firstCluster_[i]+1];}
+
+#ifndef __GCCXML__
+  /// the hit as read from the TrackingRecHitCollection (no det, no position)
+  TrackingRecHit::RecHitPointer hit(unsigned int i) const { return make(i,nullptr);}
+  /// the same as hit(i)->cloneForFit(det)
+  TrackingRecHit::RecHitPointer hitForFit(unsigned int i, GeomDet const & det) const { return make(i,&det);}
+#endif
+
+  void swap(CompactTrackerRecHitCollection & other);
+
+private:
+#ifndef __GCCXML__
+  TrackingRecHit::RecHitPointer make(unsigned int i, GeomDet const * det) const;
+#endif
+  void push_back(uint32_t detId, Kind kind, TrackingRecHit::Type type, uint32_t qual);
+
+  edm::ProductID hitsId_;
+  std::vector<uint32_t> detIds_;
+  std::vector<uint8_t> status_;     // kind<<4 | type
+  std::vector<uint32_t> qualWords_;
+  std::vector<uint32_t> firstCluster_ = std::vector<uint32_t>(1,0);  // size()+1 offsets in clusters_
+  std::vector<OmniClusterRef> clusters_;
+};
+
+inline void swap(CompactTrackerRecHitCollection & a, CompactTrackerRecHitCollection & b) { a.swap(b);}
+
+#endif
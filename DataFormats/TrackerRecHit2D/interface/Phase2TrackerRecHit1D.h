@@ -16,6 +16,9 @@ public:
 
   Phase2TrackerRecHit1D() {}
 
+  // no position (as in persistent)
+  Phase2TrackerRecHit1D( DetId id, OmniClusterRef const& clus) : TrackerSingleRecHit(id,clus){}
+
   ~Phase2TrackerRecHit1D() override {}
 
   Phase2TrackerRecHit1D( const LocalPoint& pos, const LocalError& err, 
@@ -17,6 +17,11 @@ public:
 
   ProjectedSiStripRecHit2D() : theOriginalDet(nullptr) {}
 
+  // no position (as in persistent), the original det is found by setDet
+  ProjectedSiStripRecHit2D( DetId id, bool mono, OmniClusterRef const& clus) :
+    TrackerSingleRecHit(id, mono ? trackerHitRTTI::projMono : trackerHitRTTI::projStereo, clus),
+    theOriginalDet(nullptr) {}
+
   ProjectedSiStripRecHit2D( const LocalPoint& pos, const LocalError& err, 
 			    GeomDet const & idet,
 			    SiStripRecHit2D const & originalHit) :
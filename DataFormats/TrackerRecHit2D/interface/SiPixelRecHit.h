@@ -30,6 +30,12 @@ public:
   
   ~SiPixelRecHit() override{}
 
+  // no position (as in persistent)
+  SiPixelRecHit( DetId id, OmniClusterRef const& clus,
+		 SiPixelRecHitQuality::QualWordType qual) :
+    TrackerSingleRecHit(id, clus){
+    qualWord_=qual; }
+
   SiPixelRecHit( const LocalPoint& pos , const LocalError& err, 
 		 SiPixelRecHitQuality::QualWordType qual,
 		 GeomDet const & idet,
@@ -12,6 +12,10 @@ class SiStripMatchedRecHit2D final : public BaseTrackerRecHit {
   SiStripMatchedRecHit2D(){}
   ~SiStripMatchedRecHit2D() override{}
 
+  // no position (as in persistent)
+  SiStripMatchedRecHit2D( DetId id, OmniClusterRef const & clusterMono, OmniClusterRef const & clusterStereo):
+    BaseTrackerRecHit(id, trackerHitRTTI::match), clusterMono_(clusterMono), clusterStereo_(clusterStereo){}
+
   SiStripMatchedRecHit2D( const LocalPoint& pos, const LocalError& err, GeomDet const & idet,
 			  const SiStripRecHit2D* rMono,const SiStripRecHit2D* rStereo):
     BaseTrackerRecHit(pos, err, idet, trackerHitRTTI::match), clusterMono_(rMono->omniClusterRef()), clusterStereo_(rStereo->omniClusterRef()){}
@@ -17,6 +17,11 @@ public:
   
   typedef OmniClusterRef::ClusterStripRef         ClusterRef;
 
+  // no position (as in persistent)
+  SiStripRecHit1D(const DetId& id,
+		  OmniClusterRef const& clus) : 
+    TrackerSingleRecHit(id, clus){}
+
   template<typename CluRef>
   SiStripRecHit1D( const LocalPoint& p, const LocalError& e,
 		   GeomDet const & idet,
@@ -26,6 +26,11 @@ public:
   TrackerSingleRecHit(DetId id,
 		      OmniClusterRef const&  clus) : 
     Base(id, trackerHitRTTI::single), cluster_(clus){}
+
+  // no position, for projected...
+  TrackerSingleRecHit(DetId id, trackerHitRTTI::RTTI rt,
+		      OmniClusterRef const&  clus) : 
+    Base(id, rt), cluster_(clus){}
   
   template<typename CluRef>
   TrackerSingleRecHit(const LocalPoint& p, const LocalError& e,
@@ -0,0 +1,120 @@
+#include "DataFormats/TrackerRecHit2D/interface/CompactTrackerRecHitCollection.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiPixelRecHit.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiStripRecHit2D.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiStripRecHit1D.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiStripMatchedRecHit2D.h"
+#include "DataFormats/TrackerRecHit2D/interface/ProjectedSiStripRecHit2D.h"
+#include "DataFormats/TrackerRecHit2D/interface/Phase2TrackerRecHit1D.h"
+#include "DataFormats/TrackingRecHit/interface/InvalidTrackingRecHit.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <typeinfo>
+
+void CompactTrackerRecHitCollection::reserve(unsigned int n) {
+  detIds_.reserve(n);
+  status_.reserve(n);
+  qualWords_.reserve(n);
+  firstCluster_.reserve(n+1);
+  clusters_.reserve(n);
+}
+
+void CompactTrackerRecHitCollection::push_back(uint32_t detId, Kind kind, TrackingRecHit::Type type, uint32_t qual) {
+  detIds_.push_back(detId);
+  status_.push_back((uint8_t(kind)<<4) | uint8_t(type));
+  qualWords_.push_back(qual);
+  firstCluster_.push_back(clusters_.size());
+}
+
+bool CompactTrackerRecHitCollection::push_back(TrackingRecHit const & hit) {
+  auto const & id = typeid(hit);
+  auto detId = hit.geographicalId().rawId();
+
+  // the exact class is required: derived classes (e.g. fastsim) have more content
+  if (id==typeid(InvalidTrackingRecHit)) {
+    push_back(detId, invalid, hit.getType(), 0);
+    return true;
+  }
+  // an invalidated hit has lost its rtti
+  if (!hit.isValid()) {
+    push_back(detId, unsupported, hit.getType(), 0);
+    return false;
+  }
+
+  if (id==typeid(SiPixelRecHit)) {
+    auto const & h = static_cast<SiPixelRecHit const &>(hit);
+    clusters_.push_back(h.omniClusterRef());
+    push_back(detId, pixel, TrackingRecHit::valid, h.rawQualityWord());
+  } else if (id==typeid(SiStripRecHit2D)) {
+    clusters_.push_back(static_cast<SiStripRecHit2D const &>(hit).omniClusterRef());
+    push_back(detId, strip2D, TrackingRecHit::valid, 0);
+  } else if (id==typeid(SiStripRecHit1D)) {
+    clusters_.push_back(static_cast<SiStripRecHit1D const &>(hit).omniClusterRef());
+    push_back(detId, strip1D, TrackingRecHit::valid, 0);
+  } else if (id==typeid(ProjectedSiStripRecHit2D)) {
+    clusters_.push_back(static_cast<ProjectedSiStripRecHit2D const &>(hit).omniClusterRef());
+    push_back(detId, trackerHitRTTI::isProjMono(hit) ? projMono : projStereo, TrackingRecHit::valid, 0);
+  } else if (id==typeid(SiStripMatchedRecHit2D)) {
+    auto const & h = static_cast<SiStripMatchedRecHit2D const &>(hit);
+    clusters_.push_back(h.monoClusterRef());
+    clusters_.push_back(h.stereoClusterRef());
+    push_back(detId, matched, TrackingRecHit::valid, 0);
+  } else if (id==typeid(Phase2TrackerRecHit1D)) {
+    clusters_.push_back(static_cast<Phase2TrackerRecHit1D const &>(hit).omniClusterRef());
+    push_back(detId, phase2, TrackingRecHit::valid, 0);
+  } else {
+    push_back(detId, unsupported, hit.getType(), 0);
+    return false;
+  }
+  return true;
+}
+
+bool CompactTrackerRecHitCollection::isSupported(unsigned int first, unsigned int n) const {
+  if (first+n>size()) return false;
+  for (auto i=first; i!=first+n; ++i) if (!isSupported(i)) return false;
+  return true;
+}
+
+namespace {
+  // the det is set as by cloneForFit: for projected hits it also finds the original det
+  template<typename T, typename... Args>
+  TrackingRecHit::RecHitPointer makeHit(GeomDet const * det, Args const &... args) {
+    auto h = std::make_shared<T>(args...);
+    if (det) h->setDet(*det);
+    return h;
+  }
+}
+
+TrackingRecHit::RecHitPointer CompactTrackerRecHitCollection::make(unsigned int i, GeomDet const * det) const {
+  DetId id(detIds_[i]);
+  switch (kind(i)) {
+  case invalid:
+    return makeHit<InvalidTrackingRecHit>(det, id, type(i));
+  case pixel:
+    return makeHit<SiPixelRecHit>(det, id, cluster(i), SiPixelRecHitQuality::QualWordType(qualWords_[i]));
+  case strip2D:
+    return makeHit<SiStripRecHit2D>(det, id, cluster(i));
+  case strip1D:
+    return makeHit<SiStripRecHit1D>(det, id, cluster(i));
+  case matched:
+    return makeHit<SiStripMatchedRecHit2D>(det, id, cluster(i), stereoCluster(i));
+  case projMono:
+    return makeHit<ProjectedSiStripRecHit2D>(det, id, true, cluster(i));
+  case projStereo:
+    return makeHit<ProjectedSiStripRecHit2D>(det, id, false, cluster(i));
+  case phase2:
+    return makeHit<Phase2TrackerRecHit1D>(det, id, cluster(i));
+  default:
+    throw cms::Exception("CompactTrackerRecHitCollection")
+      << "hit " << i << " on " << detIds_[i] << " is not stored in the compact format, "
+      << "read it from the TrackingRecHitCollection";
+  }
+}
+
+void CompactTrackerRecHitCollection::swap(CompactTrackerRecHitCollection & other) {
+  std::swap(hitsId_, other.hitsId_);
+  detIds_.swap(other.detIds_);
+  status_.swap(other.status_);
+  qualWords_.swap(other.qualWords_);
+  firstCluster_.swap(other.firstCluster_);
+  clusters_.swap(other.clusters_);
+}
@@ -27,6 +27,7 @@
 #include "DataFormats/TrackerRecHit2D/interface/FastTrackerRecHitCollection.h"
 #include "DataFormats/TrackerRecHit2D/interface/Phase2TrackerRecHit1D.h"
 #include "DataFormats/TrackerRecHit2D/interface/BaseTrackerRecHit.h"
+#include "DataFormats/TrackerRecHit2D/interface/CompactTrackerRecHitCollection.h"
 #include <vector>
 
 namespace DataFormats_TrackerRecHit2D {
@@ -118,6 +119,8 @@ namespace DataFormats_TrackerRecHit2D {
 
     edm::Wrapper<reco::ClusterRemovalInfo> clusterRemovalInfo;
 
+    edm::Wrapper<CompactTrackerRecHitCollection> wcompactHits;
+
       edm::OwnVector<FastTrackerRecHit,edm::ClonePolicy<FastTrackerRecHit> > fastsimTrackerRecHitCollection;
       edm::Wrapper<edm::OwnVector<FastTrackerRecHit,edm::ClonePolicy<FastTrackerRecHit> > > fastsimTrackerRecHitCollection_Wrapper;
 
@@ -0,0 +1,172 @@
+// Round trip of the tracker hits through CompactTrackerRecHitCollection:
+// hit(i) must give back the hit that was pushed, and hitForFit(i,det) the same
+// as cloneForFit(det) on it.
+
+#include "DataFormats/Common/interface/Ref.h"
+#include "DataFormats/Common/interface/TestHandle.h"
+#include "DataFormats/Provenance/interface/ProductID.h"
+#include "DataFormats/GeometrySurface/interface/BoundPlane.h"
+#include "DataFormats/TrackerRecHit2D/interface/CompactTrackerRecHitCollection.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiPixelRecHit.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiStripRecHit2D.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiStripRecHit1D.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiStripMatchedRecHit2D.h"
+#include "DataFormats/TrackerRecHit2D/interface/ProjectedSiStripRecHit2D.h"
+#include "DataFormats/TrackerRecHit2D/interface/Phase2TrackerRecHit1D.h"
+#include "DataFormats/TrackingRecHit/interface/InvalidTrackingRecHit.h"
+#include "Geometry/CommonDetUnit/interface/GeomDet.h"
+#include "Geometry/CommonDetUnit/interface/GluedGeomDet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <cassert>
+#include <memory>
+#include <typeinfo>
+#include <vector>
+
+namespace {
+
+  class MyDet : public GeomDet {
+  public:
+    MyDet(BoundPlane * bp, DetId id) : GeomDet(bp) { setDetId(id); }
+    std::vector<const GeomDet*> components() const override { return std::vector<const GeomDet*>(); }
+    SubDetector subDetector() const override { return GeomDetEnumerators::TIB; }
+  };
+
+  BoundPlane * plane() { return new BoundPlane(Surface::PositionType(0,0,0), Surface::RotationType()); }
+
+  // the clusters of the hit, mono first
+  std::vector<OmniClusterRef> clusters(TrackingRecHit const & hit) {
+    if (typeid(hit)==typeid(SiStripMatchedRecHit2D)) {
+      auto const & h = static_cast<SiStripMatchedRecHit2D const &>(hit);
+      return {h.monoClusterRef(), h.stereoClusterRef()};
+    }
+    if (typeid(hit)==typeid(InvalidTrackingRecHit)) return {};
+    return {static_cast<TrackerSingleRecHit const &>(hit).omniClusterRef()};
+  }
+
+  void checkSame(TrackingRecHit const & built, TrackingRecHit const & hit) {
+    assert(typeid(built)==typeid(hit));
+    assert(built.geographicalId()==hit.geographicalId());
+    assert(built.getType()==hit.getType());
+    assert(trackerHitRTTI::rtti(built)==trackerHitRTTI::rtti(hit));
+    assert(clusters(built)==clusters(hit));
+    if (typeid(hit)==typeid(SiPixelRecHit))
+      assert(static_cast<SiPixelRecHit const &>(built).rawQualityWord()==
+             static_cast<SiPixelRecHit const &>(hit).rawQualityWord());
+  }
+
+}
+
+int main() {
+
+  using PixelColl = edmNew::DetSetVector<SiPixelCluster>;
+  using StripColl = edmNew::DetSetVector<SiStripCluster>;
+  using Phase2Coll = edmNew::DetSetVector<Phase2TrackerCluster1D>;
+
+  PixelColl pixels;
+  StripColl strips;
+  Phase2Coll phase2s;
+  edm::TestHandle<PixelColl> pixelsH(&pixels, edm::ProductID(1, 1));
+  edm::TestHandle<StripColl> stripsH(&strips, edm::ProductID(1, 2));
+  edm::TestHandle<Phase2Coll> phase2sH(&phase2s, edm::ProductID(1, 3));
+  {
+    PixelColl::FastFiller ff(pixels, 1);
+    for (int i=0; i!=3; ++i) ff.push_back(SiPixelCluster());
+  }
+  {
+    StripColl::FastFiller ff(strips, 2);
+    for (int i=0; i!=5; ++i) ff.push_back(SiStripCluster());
+  }
+  {
+    Phase2Coll::FastFiller ff(phase2s, 3);
+    for (int i=0; i!=2; ++i) ff.push_back(Phase2TrackerCluster1D(i, 0, 1));
+  }
+  auto pixel = [&](int i) { return OmniClusterRef(edmNew::makeRefTo(pixelsH, &pixels.data()[i])); };
+  auto strip = [&](int i) { return OmniClusterRef(edmNew::makeRefTo(stripsH, &strips.data()[i])); };
+  auto phase2 = [&](int i) { return OmniClusterRef(edmNew::makeRefTo(phase2sH, &phase2s.data()[i])); };
+
+  const DetId pixelId(DetId::Tracker, 1), stripId(DetId::Tracker, 3), gluedId(DetId::Tracker, 6),
+    phase2Id(DetId::Tracker, 5);
+
+  // the hits as read from a TrackingRecHitCollection
+  std::vector<std::unique_ptr<TrackingRecHit>> hits;
+  hits.emplace_back(new SiPixelRecHit(pixelId, pixel(0), 0x12345678));
+  hits.emplace_back(new SiPixelRecHit(pixelId, pixel(2), 0));
+  hits.emplace_back(new InvalidTrackingRecHit(stripId, TrackingRecHit::missing));
+  hits.emplace_back(new SiStripRecHit2D(stripId, strip(1)));
+  hits.emplace_back(new SiStripRecHit1D(stripId, strip(2)));
+  hits.emplace_back(new SiStripMatchedRecHit2D(gluedId, strip(3), strip(4)));
+  hits.emplace_back(new ProjectedSiStripRecHit2D(gluedId, true, strip(3)));
+  hits.emplace_back(new ProjectedSiStripRecHit2D(gluedId, false, strip(4)));
+  hits.emplace_back(new InvalidTrackingRecHit(gluedId, TrackingRecHit::inactive));
+  hits.emplace_back(new Phase2TrackerRecHit1D(phase2Id, phase2(1)));
+  // a derived class has more content and cannot be built back
+  std::unique_ptr<BoundPlane> surface(plane());
+  hits.emplace_back(new InvalidTrackingRecHitNoDet(*surface, TrackingRecHit::bad));
+  const unsigned int nSupported = hits.size()-1;
+
+  CompactTrackerRecHitCollection compact(edm::ProductID(1, 4));
+  compact.reserve(hits.size());
+  for (unsigned int i=0; i!=hits.size(); ++i)
+    assert(compact.push_back(*hits[i]) == (i<nSupported));
+  assert(compact.size()==hits.size());
+  assert(compact.hitsProductId()==edm::ProductID(1, 4));
+  assert(compact.isSupported(0, nSupported));
+  assert(!compact.isSupported(0, hits.size()));
+  assert(!compact.isSupported(nSupported, 1));
+  assert(!compact.isSupported(nSupported, 2));  // beyond the end
+
+  assert(compact.kind(0)==CompactTrackerRecHitCollection::pixel);
+  assert(compact.qualWord(0)==0x12345678);
+  assert(compact.kind(2)==CompactTrackerRecHitCollection::invalid);
+  assert(compact.type(2)==TrackingRecHit::missing);
+  assert(compact.kind(5)==CompactTrackerRecHitCollection::matched);
+  assert(compact.nClusters(5)==2);
+  assert(compact.cluster(5)==strip(3) && compact.stereoCluster(5)==strip(4));
+  assert(compact.kind(6)==CompactTrackerRecHitCollection::projMono);
+  assert(compact.kind(7)==CompactTrackerRecHitCollection::projStereo);
+  assert(compact.type(8)==TrackingRecHit::inactive);
+  assert(compact.nClusters(8)==0);
+  assert(compact.kind(nSupported)==CompactTrackerRecHitCollection::unsupported);
+  assert(compact.type(nSupported)==TrackingRecHit::bad);
+
+  // hit(i)
+  for (unsigned int i=0; i!=nSupported; ++i) {
+    auto built = compact.hit(i);
+    checkSame(*built, *hits[i]);
+    assert(built->det()==nullptr);
+  }
+  bool thrown = false;
+  try { compact.hit(nSupported); } catch (cms::Exception const &) { thrown = true; }
+  assert(thrown);
+
+  // hitForFit(i,det)
+  MyDet pixelDet(plane(), pixelId), monoDet(plane(), DetId(stripId.rawId()+1)),
+    stereoDet(plane(), DetId(stripId.rawId()+2)), stripDet(plane(), stripId), phase2Det(plane(), phase2Id);
+  GluedGeomDet gluedDet(plane(), &monoDet, &stereoDet, gluedId);
+  std::vector<GeomDet const *> dets = {&pixelDet, &pixelDet, &stripDet, &stripDet, &stripDet,
+                                       &gluedDet, &gluedDet, &gluedDet, &gluedDet, &phase2Det};
+  assert(dets.size()==nSupported);
+  for (unsigned int i=0; i!=nSupported; ++i) {
+    auto built = compact.hitForFit(i, *dets[i]);
+    auto cloned = hits[i]->cloneForFit(*dets[i]);
+    checkSame(*built, *cloned);
+    assert(built->det()==dets[i] && cloned->det()==dets[i]);
+    if (typeid(*cloned)==typeid(ProjectedSiStripRecHit2D))
+      assert(static_cast<ProjectedSiStripRecHit2D const &>(*built).originalDet()==
+             static_cast<ProjectedSiStripRecHit2D const &>(*cloned).originalDet());
+  }
+  assert(static_cast<ProjectedSiStripRecHit2D const &>(*compact.hitForFit(6, gluedDet)).originalDet()==&monoDet);
+  assert(static_cast<ProjectedSiStripRecHit2D const &>(*compact.hitForFit(7, gluedDet)).originalDet()==&stereoDet);
+
+  // swap
+  CompactTrackerRecHitCollection other;
+  swap(compact, other);
+  assert(compact.empty() && other.size()==hits.size());
+  assert(other.hitsProductId()==edm::ProductID(1, 4));
+  checkSame(*other.hit(5), *hits[5]);
+  compact.push_back(*hits[3]);
+  assert(compact.size()==1 && compact.cluster(0)==strip(1));
+
+  return 0;
+}
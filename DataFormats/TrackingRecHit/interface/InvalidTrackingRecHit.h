@@ -11,6 +11,7 @@ public:
   
   InvalidTrackingRecHit(GeomDet const & idet, Type type ) : TrackingRecHit(idet, type)  {}
   explicit InvalidTrackingRecHit(Type type) : TrackingRecHit(DetId(0), type) {}
+  InvalidTrackingRecHit(DetId id, Type type) : TrackingRecHit(id, type) {}
 
   InvalidTrackingRecHit() : TrackingRecHit(DetId(0), TrackingRecHit::missing) {}
 
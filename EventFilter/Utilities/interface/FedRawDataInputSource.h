@@ -91,6 +91,8 @@ private:
   const bool verifyAdler32_;
   const bool verifyChecksum_;
   const bool useL1EventID_;
+  // map raw files in memory instead of reading them into chunks
+  const bool useMmap_;
   std::vector<std::string> fileNames_;
   bool useFileBroker_;
   //std::vector<std::string> fileNamesSorted_;
@@ -215,6 +217,9 @@ struct InputFile {
   uint32_t  chunkPosition_ = 0;
   unsigned int currentChunk_ = 0;
 
+  //start of the file mapping in mmap mode (no chunks are used then)
+  unsigned char *mmapStart_ = nullptr;
+
   InputFile(evf::EvFDaqDirector::FileStatus status, unsigned int lumi = 0, std::string const& name = std::string(),
       uint64_t fileSize =0, uint32_t nChunks=0, int nEvents=0, FedRawDataInputSource *parent = nullptr):
     parent_(parent),
@@ -231,6 +236,9 @@ struct InputFile {
   }
 
   InputFile(std::string & name):fileName_(name) {}
+  ~InputFile();
+
+  bool map();
 
   bool waitForChunk(unsigned int chunkid) {
     //some atomics to make sure everything is cache synchronized for the main thread
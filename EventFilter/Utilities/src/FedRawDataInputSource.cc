@@ -5,6 +5,7 @@
 #include <sstream>
 #include <sys/types.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/time.h>
 #include <unistd.h>
 #include <vector>
@@ -64,6 +65,7 @@ FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset,
   verifyAdler32_(pset.getUntrackedParameter<bool> ("verifyAdler32", true)),
   verifyChecksum_(pset.getUntrackedParameter<bool> ("verifyChecksum", true)),
   useL1EventID_(pset.getUntrackedParameter<bool> ("useL1EventID", false)),
+  useMmap_(pset.getUntrackedParameter<bool> ("useMmap", false)),
   fileNames_(pset.getUntrackedParameter<std::vector<std::string>> ("fileNames",std::vector<std::string>())),
   fileListMode_(pset.getUntrackedParameter<bool> ("fileListMode", false)),
   fileListLoopMode_(pset.getUntrackedParameter<bool> ("fileListLoopMode", false)),
@@ -214,6 +216,7 @@ void FedRawDataInputSource::fillDescriptions(edm::ConfigurationDescriptions& des
   desc.addUntracked<bool> ("verifyAdler32", true)->setComment("Verify event Adler32 checksum with FRDv3 or v4");
   desc.addUntracked<bool> ("verifyChecksum", true)->setComment("Verify event CRC-32C checksum of FRDv5 or higher");
   desc.addUntracked<bool> ("useL1EventID", false)->setComment("Use L1 event ID from FED header if true or from TCDS FED if false");
+  desc.addUntracked<bool> ("useMmap", false)->setComment("Map raw files in memory and unpack events in place instead of reading them into chunk buffers");
   desc.addUntracked<bool> ("fileListMode", false)->setComment("Use fileNames parameter to directly specify raw files to open");
   desc.addUntracked<std::vector<std::string>> ("fileNames", std::vector<std::string>())->setComment("file list used when fileListMode is enabled");
   desc.setAllowAnything();
@@ -422,7 +425,8 @@ inline evf::EvFDaqDirector::FileStatus FedRawDataInputSource::getNextEvent()
   if (currentFile_->bufferPosition_==currentFile_->fileSize_) {
     readingFilesCount_--;
     //release last chunk (it is never released elsewhere)
-    freeChunks_.push(currentFile_->chunks_[currentFile_->currentChunk_]);
+    if (!currentFile_->mmapStart_)
+      freeChunks_.push(currentFile_->chunks_[currentFile_->currentChunk_]);
     if (currentFile_->nEvents_>=0 && currentFile_->nEvents_!=int(currentFile_->nProcessed_))
     {
       throw cms::Exception("FedRawDataInputSource::getNextEvent")
@@ -458,7 +462,33 @@ inline evf::EvFDaqDirector::FileStatus FedRawDataInputSource::getNextEvent()
     throw cms::Exception("FedRawDataInputSource::getNextEvent") <<
       "Premature end of input file while reading event header";
   }
-  if (singleBufferMode_) {
+  if (currentFile_->mmapStart_) {
+
+    //the whole file is mapped, events are used in place and never cross a chunk boundary
+    unsigned char *dataPosition = currentFile_->mmapStart_ + currentFile_->bufferPosition_;
+    if (detectedFRDversion_==0) {
+      detectedFRDversion_=*((uint32*)dataPosition);
+      if (detectedFRDversion_>5)
+        throw cms::Exception("FedRawDataInputSource::getNextEvent")
+            << "Unknown FRD version -: " << detectedFRDversion_;
+      assert(detectedFRDversion_>=1);
+      if (currentFile_->fileSize_ - currentFile_->bufferPosition_ < FRDHeaderVersionSize[detectedFRDversion_])
+      {
+        throw cms::Exception("FedRawDataInputSource::getNextEvent") <<
+          "Premature end of input file while reading event header";
+      }
+    }
+
+    event_.reset( new FRDEventMsgView(dataPosition) );
+    if (currentFile_->fileSize_ - currentFile_->bufferPosition_ < event_->size())
+    {
+      throw cms::Exception("FedRawDataInputSource::getNextEvent") <<
+        "Premature end of input file while reading event data";
+    }
+    currentFile_->bufferPosition_ += event_->size();
+    chunkIsFree_ = false;
+  }
+  else if (singleBufferMode_) {
 
     //should already be there
     if (fms_) fms_->setInState(evf::FastMonitoringThread::inWaitChunk);
@@ -1004,7 +1034,21 @@ void FedRawDataInputSource::readSupervisor()
         assert((eventsInNewFile>0) == (fileSize>0));//file without events must be empty
       }
 
-      if (!singleBufferMode_) {
+      if (useMmap_) {
+        //map the whole file, the mapping is released with the InputFile once no stream uses it
+        InputFile * newInputFile = new InputFile(evf::EvFDaqDirector::FileStatus::newFile,ls,rawFile,fileSize,0,eventsInNewFile,this);
+        if (fileSize && !newInputFile->map()) {
+          edm::LogError("FedRawDataInputSource") << "Can not map file (" << errno << "):-"<< rawFile << std::endl;
+          delete newInputFile;
+          setExceptionState_=true;
+          break;
+        }
+        std::unique_lock<std::mutex> lkw(mWakeup_);
+        readingFilesCount_++;
+        fileQueue_.push(newInputFile);
+        cvWakeup_.notify_one();
+      }
+      else if (!singleBufferMode_) {
 	//calculate number of needed chunks
 	unsigned int neededChunks = fileSize/eventChunkSize_;
 	if (fileSize%eventChunkSize_) neededChunks++;
@@ -1218,6 +1262,25 @@ void FedRawDataInputSource::threadError()
 }
 
 
+InputFile::~InputFile()
+{
+  if (mmapStart_) munmap(mmapStart_,fileSize_);
+}
+
+bool InputFile::map()
+{
+  int fileDescriptor = open(fileName_.c_str(), O_RDONLY);
+  if (fileDescriptor<0) return false;
+  void *start = mmap(nullptr, fileSize_, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+  close(fileDescriptor);
+  if (start==MAP_FAILED) return false;
+  //events are consumed in order, let the kernel read ahead
+  madvise(start, fileSize_, MADV_SEQUENTIAL);
+  madvise(start, fileSize_, MADV_WILLNEED);
+  mmapStart_ = (unsigned char*)start;
+  return true;
+}
+
 inline bool InputFile::advance(unsigned char* & dataPosition, const size_t size)
 {
   //wait for chunk
@@ -0,0 +1,58 @@
+/** \file
+ *
+ * Writes one line per event to a text file, with the event number and the
+ * size and CRC-32C of each FED fragment, so that the FEDRawDataCollections
+ * unpacked by two jobs can be compared with diff (after sorting the lines,
+ * as the events may be processed in a different order by several streams).
+ *
+ */
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
+#include "DataFormats/FEDRawData/interface/FEDNumbering.h"
+
+#include "EventFilter/Utilities/interface/crc32c.h"
+
+#include <fstream>
+#include <string>
+
+namespace test{
+
+  class FEDRawDataDigest: public edm::one::EDAnalyzer<> {
+    private:
+    edm::EDGetTokenT<FEDRawDataCollection> m_fedRawDataCollectionToken;
+    std::ofstream m_file;
+    unsigned int m_nEvents;
+    public:
+    FEDRawDataDigest(const edm::ParameterSet& pset):
+      m_fedRawDataCollectionToken( consumes<FEDRawDataCollection>( pset.getUntrackedParameter<edm::InputTag>( "inputTag", edm::InputTag( "source" ) ) ) ),
+      m_file( pset.getUntrackedParameter<std::string>( "fileName" ) ),
+      m_nEvents(0) {
+      if ( !m_file )
+        throw cms::Exception( "FEDRawDataDigest" ) << "can not open " << pset.getUntrackedParameter<std::string>( "fileName" );
+    }
+
+    void analyze(const edm::Event & e, const edm::EventSetup& c) override {
+      const FEDRawDataCollection& rawdata = edm::get( e, m_fedRawDataCollectionToken );
+      m_file << e.id().run() << " " << e.luminosityBlock() << " " << e.id().event();
+      for ( int id = 0; id <= FEDNumbering::lastFEDId(); ++id ) {
+        const FEDRawData& data = rawdata.FEDData( id );
+        if ( data.size() > 0 )
+          m_file << " " << id << ":" << data.size() << ":" << crc32c( 0U, data.data(), data.size() );
+      }
+      m_file << "\n";
+      ++m_nEvents;
+    }
+
+    void endJob() override {
+      if ( m_nEvents == 0 )
+        throw cms::Exception( "FEDRawDataDigest" ) << "no event was read, the comparison is not meaningful";
+    }
+  };
+DEFINE_FWK_MODULE(FEDRawDataDigest);
+}
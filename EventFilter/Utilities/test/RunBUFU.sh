@@ -0,0 +1,32 @@
+#!/bin/bash
+
+function die { echo $1: status $2 ;  exit $2; }
+
+# Writes raw files with a fake BU, then reads them with FedRawDataInputSource
+# reading the files into chunk buffers and mapping them in memory: the events
+# must have the same FED fragments.
+
+OUTDIR=${LOCAL_TMP_DIR}/RunBUFU
+rm -rf ${OUTDIR}
+mkdir -p ${OUTDIR}
+pushd ${OUTDIR}
+
+cmsRun ${LOCAL_TEST_DIR}/startBU.py runNumber=100 buBaseDir=${OUTDIR}/bu maxEvents=300 > bu.log 2>&1 || die 'Failed in startBU.py' $?
+
+# the FU takes the files out of the BU directory: each FU reads its own copy
+for mode in buffers mmap; do
+  if [ ${mode} == mmap ]; then
+    args="useMmap=True numThreads=2"
+  else
+    args="useMmap=False numThreads=1"
+  fi
+  cp -r ${OUTDIR}/bu ${OUTDIR}/ramdisk_${mode}
+  cmsRun ${LOCAL_TEST_DIR}/unittest_FU.py runNumber=100 buBaseDir=${OUTDIR}/ramdisk_${mode} fuBaseDir=${OUTDIR}/data_${mode} \
+    digestFile=digest_${mode}.txt ${args} > fu_${mode}.log 2>&1 || die "Failed in unittest_FU.py with ${args}" $?
+  sort digest_${mode}.txt > digest_${mode}_sorted.txt
+done
+
+[ $(wc -l < digest_buffers_sorted.txt) -eq 300 ] || die 'Not all the events were read with the chunk buffers' 1
+diff digest_buffers_sorted.txt digest_mmap_sorted.txt || die 'The events read from the mapped files differ' $?
+
+popd
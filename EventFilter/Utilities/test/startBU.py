@@ -27,7 +27,7 @@ cmsswbase = os.path.expandvars("$CMSSW_BASE/")
 
 process = cms.Process("FAKEBU")
 process.maxEvents = cms.untracked.PSet(
-    input = cms.untracked.int32(-1)
+    input = cms.untracked.int32(options.maxEvents)
 )
 
 process.options = cms.untracked.PSet(
@@ -30,6 +30,12 @@ options.register ('numThreads',
                   VarParsing.VarParsing.varType.int,          # string, int, or float
                   "Number of CMSSW threads")
 
+options.register ('useMmap',
+                  False, # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.bool,          # string, int, or float
+                  "Map raw files in memory instead of reading them into buffers")
+
 options.parseArguments()
 
 cmsswbase = os.path.expandvars("$CMSSW_BASE/")
@@ -92,7 +98,8 @@ process.source = cms.Source("FedRawDataInputSource",
     useL1EventID = cms.untracked.bool(True),
     eventChunkSize = cms.untracked.uint32(16),
     numBuffers = cms.untracked.uint32(2),
-    eventChunkBlock = cms.untracked.uint32(1)
+    eventChunkBlock = cms.untracked.uint32(1),
+    useMmap = cms.untracked.bool(options.useMmap)
     )
 
 process.PrescaleService = cms.Service( "PrescaleService",
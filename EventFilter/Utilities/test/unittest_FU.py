@@ -0,0 +1,103 @@
+from __future__ import print_function
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+import os
+
+# reads the raw files written by startBU.py and writes a digest of the
+# FEDRawDataCollection of each event (see RunBUFU.sh)
+
+options = VarParsing.VarParsing ('analysis')
+
+options.register ('runNumber',
+                  100, # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.int,          # string, int, or float
+                  "Run Number")
+
+options.register ('buBaseDir',
+                  'ramdisk', # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.string,          # string, int, or float
+                  "BU base directory")
+
+options.register ('fuBaseDir',
+                  'data', # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.string,          # string, int, or float
+                  "FU base directory")
+
+options.register ('numThreads',
+                  1, # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.int,          # string, int, or float
+                  "Number of CMSSW threads")
+
+options.register ('useMmap',
+                  False, # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.bool,          # string, int, or float
+                  "Map raw files in memory instead of reading them into buffers")
+
+options.register ('digestFile',
+                  'digest.txt', # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.string,          # string, int, or float
+                  "File with the size and checksum of the FED fragments of each event")
+
+options.parseArguments()
+
+cmsswbase = os.path.expandvars("$CMSSW_BASE/")
+
+process = cms.Process("TESTFU")
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(-1)
+)
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(options.numThreads),
+    numberOfStreams = cms.untracked.uint32(options.numThreads),
+)
+process.MessageLogger = cms.Service("MessageLogger",
+    cout = cms.untracked.PSet(threshold = cms.untracked.string( "INFO" )),
+    destinations = cms.untracked.vstring( 'cout' ))
+
+process.FastMonitoringService = cms.Service("FastMonitoringService",
+    sleepTime = cms.untracked.int32(1),
+    microstateDefPath = cms.untracked.string( cmsswbase+'/src/EventFilter/Utilities/plugins/microstatedef.jsd'),
+    fastMicrostateDefPath = cms.untracked.string( cmsswbase+'/src/EventFilter/Utilities/plugins/microstatedeffast.jsd'),
+    fastName = cms.untracked.string( 'fastmoni' ),
+    slowName = cms.untracked.string( 'slowmoni' ))
+
+process.EvFDaqDirector = cms.Service("EvFDaqDirector",
+    useFileService = cms.untracked.bool(False),
+    runNumber = cms.untracked.uint32(options.runNumber),
+    baseDir = cms.untracked.string(options.fuBaseDir),
+    buBaseDir = cms.untracked.string(options.buBaseDir),
+    directorIsBu = cms.untracked.bool(False),
+    testModeNoBuilderUnit = cms.untracked.bool(False))
+
+try:
+  os.makedirs(options.fuBaseDir+"/run"+str(options.runNumber).zfill(6))
+except Exception as ex:
+  print(str(ex))
+  pass
+
+# chunks of 1 MB, smaller than the files, so that in the buffered mode
+# events straddle chunk boundaries
+process.source = cms.Source("FedRawDataInputSource",
+    runNumber = cms.untracked.uint32(options.runNumber),
+    getLSFromFilename = cms.untracked.bool(True),
+    testModeNoBuilderUnit = cms.untracked.bool(False),
+    verifyAdler32 = cms.untracked.bool(True),
+    verifyChecksum = cms.untracked.bool(True),
+    useL1EventID = cms.untracked.bool(True),
+    eventChunkSize = cms.untracked.uint32(1),
+    numBuffers = cms.untracked.uint32(3),
+    eventChunkBlock = cms.untracked.uint32(1),
+    useMmap = cms.untracked.bool(options.useMmap)
+    )
+
+process.digest = cms.EDAnalyzer("test::FEDRawDataDigest",
+    fileName = cms.untracked.string(options.digestFile))
+
+process.p = cms.Path(process.digest)
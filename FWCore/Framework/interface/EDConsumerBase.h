@@ -21,6 +21,7 @@
 // system include files
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <array>
 // user include files
@@ -93,6 +94,14 @@ namespace edm {
     /// Convert "@currentProcess" in InputTag process names to the actual current process name.
     void convertCurrentProcessAlias(std::string const& processName);
 
+    /// Reorder the Event products to prefetch so that those made in the current process by the
+    /// modules with the largest priority are started first (see orderTasksForWorkStealing).
+    /// Modules missing from the map, and products from earlier processes, have priority 0.
+    /// Returns the labels of the prioritized modules in the order their products are prefetched.
+    std::vector<std::string> orderItemsToGetFromEvent(std::unordered_map<std::string, double> const& modulePriorities,
+                                  ProductRegistry const& preg,
+                                  std::string const& processName);
+
     std::vector<ConsumesInfo> consumesInfo() const;
 
   protected:
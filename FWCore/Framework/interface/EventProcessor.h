@@ -37,6 +37,7 @@ configured in the user's main() function, and is set running.
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <exception>
 #include <mutex>
@@ -346,6 +347,8 @@ namespace edm {
     ExcludedDataMap                               eventSetupDataToExcludeFromPrefetching_;
     
     bool printDependencies_ = false;
+    bool orderPrefetchingByCriticalPath_ = false;
+    std::unordered_map<std::string, double> moduleTimeEstimates_;
   }; // class EventProcessor
 
   //--------------------------------------------------------------------
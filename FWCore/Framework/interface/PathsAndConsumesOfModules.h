@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -72,5 +73,13 @@ namespace edm {
   void
   checkForModuleDependencyCorrectness(edm::PathsAndConsumesOfModulesBase const& iPnC,
                                       bool iPrintDependencies);
+
+  // Estimates, for each module ID, the time from the start of the Event until the module
+  // can finish if there were enough threads: its own time plus the largest estimate of the
+  // modules whose products it consumes. Modules missing from iModuleTimes take iDefaultTime.
+  std::vector<double>
+  criticalPathEstimates(edm::PathsAndConsumesOfModulesBase const& iPnC,
+                        std::unordered_map<std::string, double> const& iModuleTimes,
+                        double iDefaultTime);
 }
 #endif
@@ -86,6 +86,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <sstream>
 #include <utility>
@@ -101,6 +102,7 @@ namespace edm {
   class ExceptionCollector;
   class MergeableRunProductMetadata;
   class OutputModuleCommunicator;
+  class PathsAndConsumesOfModulesBase;
   class ProcessContext;
   class ProductRegistry;
   class PreallocationConfiguration;
@@ -277,6 +279,13 @@ namespace edm {
     /// Convert "@currentProcess" in InputTag process names to the actual current process name.
     void convertCurrentProcessAlias(std::string const& processName);
 
+    /// Start the prefetching of the Event products of each module, and the trigger Paths of
+    /// each stream, by decreasing estimate of the critical path which leads to them.
+    /// The times are given per module label, in any unit.
+    void orderByCriticalPath(PathsAndConsumesOfModulesBase const& pathsAndConsumes,
+                             std::unordered_map<std::string, double> const& moduleTimes,
+                             ProductRegistry const& preg);
+
   private:
 
     void limitOutput(ParameterSet const& proc_pset,
@@ -21,6 +21,7 @@
 // system include files
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // user include files
@@ -106,6 +107,10 @@ namespace edm {
 
       void convertCurrentProcessAlias(std::string const& processName);
 
+      std::vector<std::string> orderItemsToGetFromEvent(std::unordered_map<std::string, double> const& modulePriorities,
+                                                        ProductRegistry const& preg,
+                                                        std::string const& processName);
+
       std::vector<ConsumesInfo> consumesInfo() const;
 
     private:
@@ -98,6 +98,10 @@ namespace edm {
 
       void convertCurrentProcessAlias(std::string const& processName);
 
+      std::vector<std::string> orderItemsToGetFromEvent(std::unordered_map<std::string, double> const& modulePriorities,
+                                                        ProductRegistry const& preg,
+                                                        std::string const& processName);
+
       std::vector<ConsumesInfo> consumesInfo() const;
 
       using ModuleToResolverIndicies = std::unordered_multimap<std::string,
@@ -15,11 +15,13 @@
 #include <cassert>
 #include <cstring>
 #include <set>
+#include <tuple>
 #include <utility>
 
 // user include files
 #include "FWCore/Framework/interface/EDConsumerBase.h"
 #include "FWCore/Framework/interface/ConsumesCollector.h"
+#include "FWCore/Framework/src/orderTasksForWorkStealing.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/BranchType.h"
 #include "FWCore/Utilities/interface/Likely.h"
@@ -475,6 +477,103 @@ EDConsumerBase::modulesWhoseProductsAreConsumed(std::vector<ModuleDescription co
   }
 }
 
+namespace {
+  // Convert an EDAlias label to the label of the module which made the product
+  std::string originalModuleLabel(const char* consumedModuleLabel, ProductRegistry const& preg) {
+    std::vector<std::pair<std::string, std::string> > const& aliasToOriginal = preg.aliasToOriginal();
+    std::pair<std::string, std::string> target(consumedModuleLabel, std::string());
+    auto iter = std::lower_bound(aliasToOriginal.begin(), aliasToOriginal.end(), target);
+    if(iter != aliasToOriginal.end() && iter->first == consumedModuleLabel) {
+      return iter->second;
+    }
+    return consumedModuleLabel;
+  }
+}
+
+std::vector<std::string>
+EDConsumerBase::orderItemsToGetFromEvent(std::unordered_map<std::string, double> const& modulePriorities,
+                                         ProductRegistry const& preg,
+                                         std::string const& processName) {
+  std::vector<std::string> orderedLabels;
+  auto& items = itemsToGetFromBranch_[InEvent];
+  if(items.size() < 2) {
+    return orderedLabels;
+  }
+
+  ProductResolverIndexHelper const& iHelper = *preg.productLookup(InEvent);
+
+  // priority of the products made in this process, found the same way as in modulesWhoseProductsAreConsumed
+  std::vector<std::tuple<ProductResolverIndex, double, std::string> > indexPriorities;
+  auto itKind = m_tokenInfo.begin<kKind>();
+  auto itLabels = m_tokenInfo.begin<kLabels>();
+  for(auto itInfo = m_tokenInfo.begin<kLookupInfo>(),itEnd = m_tokenInfo.end<kLookupInfo>();
+      itInfo != itEnd; ++itInfo,++itKind,++itLabels) {
+
+    if(itInfo->m_branchType != InEvent or itInfo->m_index.skipCurrentProcess()) {
+      continue;
+    }
+    const unsigned int labelStart = itLabels->m_startOfModuleLabel;
+    const char* consumedModuleLabel = &(m_tokenLabels[labelStart]);
+    const char* consumedProcessName = consumedModuleLabel+itLabels->m_deltaToProcessName;
+    if(*consumedModuleLabel == '\0') { // consumesMany are never prefetched
+      continue;
+    }
+
+    bool madeInThisProcess = false;
+    if(*consumedProcessName != '\0') {
+      madeInThisProcess = (processName == consumedProcessName);
+    } else {
+      auto matches = iHelper.relatedIndexes(*itKind,
+                                            itInfo->m_type,
+                                            consumedModuleLabel,
+                                            consumedModuleLabel+itLabels->m_deltaToProductInstance);
+      for(unsigned int j = 0; j < matches.numberOfMatches(); ++j) {
+        if(processName == matches.processName(j)) {
+          madeInThisProcess = true;
+        }
+      }
+    }
+    if(madeInThisProcess) {
+      auto label = originalModuleLabel(consumedModuleLabel, preg);
+      auto it = modulePriorities.find(label);
+      if(it != modulePriorities.end()) {
+        indexPriorities.emplace_back(itInfo->m_index.productResolverIndex(), it->second, std::move(label));
+      }
+    }
+  }
+
+  std::vector<double> priorities;
+  std::vector<std::string const*> labels;
+  priorities.reserve(items.size());
+  labels.reserve(items.size());
+  for(auto const& item : items) {
+    double priority = 0.;
+    std::string const* label = nullptr;
+    if(not item.skipCurrentProcess()) {
+      for(auto const& indexPriority : indexPriorities) {
+        if(std::get<0>(indexPriority) == item.productResolverIndex() and
+           (label == nullptr or std::get<1>(indexPriority) > priority)) {
+          priority = std::get<1>(indexPriority);
+          label = &std::get<2>(indexPriority);
+        }
+      }
+    }
+    priorities.push_back(priority);
+    labels.push_back(label);
+  }
+
+  std::vector<ProductResolverIndexAndSkipBit> ordered;
+  ordered.reserve(items.size());
+  for(unsigned int i : orderTasksForWorkStealing(priorities)) {
+    ordered.push_back(items[i]);
+    if(labels[i] != nullptr) {
+      orderedLabels.push_back(*labels[i]);
+    }
+  }
+  items = std::move(ordered);
+  return orderedLabels;
+}
+
 void
 EDConsumerBase::convertCurrentProcessAlias(std::string const& processName) {
 
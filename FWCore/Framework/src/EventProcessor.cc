@@ -449,6 +449,18 @@ namespace edm {
 
     printDependencies_ =  optionsPset.getUntrackedParameter<bool>("printDependencies");
 
+    auto const& prefetchOrdering = optionsPset.getUntrackedParameter<std::string>("prefetchOrdering");
+    if (prefetchOrdering != "declaration" and prefetchOrdering != "criticalPath") {
+      throw Exception(errors::Configuration, "Illegal prefetchOrdering parameter value: ")
+        << prefetchOrdering << ".\n"
+        << "Legal values are 'declaration' and 'criticalPath'.\n";
+    }
+    orderPrefetchingByCriticalPath_ = (prefetchOrdering == "criticalPath");
+    ParameterSet const& moduleTimes = optionsPset.getUntrackedParameterSet("moduleTimeEstimates");
+    for (auto const& label : moduleTimes.getParameterNamesForType<double>(false)) {
+      moduleTimeEstimates_.emplace(label, moduleTimes.getUntrackedParameter<double>(label));
+    }
+
     // Now do general initialization
     ScheduleItems items;
 
@@ -585,6 +597,9 @@ namespace edm {
 
     //NOTE: this may throw
     checkForModuleDependencyCorrectness(pathsAndConsumesOfModules_, printDependencies_);
+    if(orderPrefetchingByCriticalPath_) {
+      schedule_->orderByCriticalPath(pathsAndConsumesOfModules_, moduleTimeEstimates_, *preg());
+    }
     actReg_->preBeginJobSignal_(pathsAndConsumesOfModules_, processContext_);
 
     //NOTE:  This implementation assumes 'Job' means one call
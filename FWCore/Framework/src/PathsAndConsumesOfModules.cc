@@ -347,4 +347,49 @@ namespace edm {
     }
     graph::throwIfImproperDependencies(edgeToPathMap,pathIndexToModuleIndexOrder,pathNames,moduleIndexToNames);
   }
+
+  std::vector<double>
+  criticalPathEstimates(edm::PathsAndConsumesOfModulesBase const& iPnC,
+                        std::unordered_map<std::string, double> const& iModuleTimes,
+                        double iDefaultTime) {
+    unsigned int largestID = 0;
+    for(auto const& description: iPnC.allModules()) {
+      largestID = std::max(largestID, description->id());
+    }
+    std::vector<double> estimates(largestID + 1, 0.);
+    // 0: not visited, 1: being visited, 2: done
+    std::vector<char> state(largestID + 1, 0);
+
+    // cycles are not possible here since checkForModuleDependencyCorrectness would have thrown
+    std::vector<std::pair<ModuleDescription const*, unsigned int>> stack;
+    for(auto const& description: iPnC.allModules()) {
+      if(state[description->id()] != 0) {
+        continue;
+      }
+      stack.emplace_back(description, 0);
+      state[description->id()] = 1;
+      while(not stack.empty()) {
+        auto& top = stack.back();
+        unsigned int const moduleID = top.first->id();
+        auto const& dependencies = iPnC.modulesWhoseProductsAreConsumedBy(moduleID);
+        if(top.second != dependencies.size()) {
+          ModuleDescription const* dependency = dependencies[top.second++];
+          if(state[dependency->id()] == 0) {
+            state[dependency->id()] = 1;
+            stack.emplace_back(dependency, 0);
+          }
+          continue;
+        }
+        double longest = 0.;
+        for(auto const& dependency: dependencies) {
+          longest = std::max(longest, estimates[dependency->id()]);
+        }
+        auto itTime = iModuleTimes.find(top.first->moduleLabel());
+        estimates[moduleID] = longest + (itTime != iModuleTimes.end() ? itTime->second : iDefaultTime);
+        state[moduleID] = 2;
+        stack.pop_back();
+      }
+    }
+    return estimates;
+  }
 }
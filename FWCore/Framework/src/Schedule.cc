@@ -9,6 +9,7 @@
 #include "DataFormats/Provenance/interface/ProductResolverIndexHelper.h"
 #include "FWCore/Framework/interface/EDConsumerBase.h"
 #include "FWCore/Framework/interface/OutputModuleDescription.h"
+#include "FWCore/Framework/interface/PathsAndConsumesOfModules.h"
 #include "FWCore/Framework/interface/SubProcess.h"
 #include "FWCore/Framework/interface/TriggerNamesService.h"
 #include "FWCore/Framework/interface/TriggerReport.h"
@@ -1128,6 +1129,59 @@ namespace edm {
     }
   }
 
+  void Schedule::orderByCriticalPath(PathsAndConsumesOfModulesBase const& pathsAndConsumes,
+                                     std::unordered_map<std::string, double> const& moduleTimes,
+                                     ProductRegistry const& preg) {
+    // modules without a time are given the average one, so that long chains still come first
+    double defaultTime = 1.;
+    if(not moduleTimes.empty()) {
+      defaultTime = 0.;
+      for(auto const& labelAndTime : moduleTimes) {
+        defaultTime += labelAndTime.second;
+      }
+      defaultTime /= moduleTimes.size();
+    }
+    std::vector<double> estimates = criticalPathEstimates(pathsAndConsumes, moduleTimes, defaultTime);
+
+    std::unordered_map<std::string, double> modulePriorities;
+    for(auto const& description : pathsAndConsumes.allModules()) {
+      modulePriorities.emplace(description->moduleLabel(), estimates[description->id()]);
+    }
+    // the orders are reported so that they can be checked, the last one spawned is run first
+    LogInfo order("CriticalPathOrdering");
+    for(auto const& worker : allWorkers()) {
+      auto labels = worker->orderItemsToGetFromEvent(modulePriorities, preg);
+      if(labels.size() > 1) {
+        order << "prefetch order of module '" << worker->description().moduleLabel() << "':";
+        for(auto const& label : labels) {
+          order << " " << label;
+        }
+        order << "\n";
+      }
+    }
+
+    // a module on a Path also waits for the modules before it on that Path
+    std::unordered_map<std::string, double> pathPriorities;
+    auto const& paths = pathsAndConsumes.paths();
+    for(unsigned int i = 0; i != paths.size(); ++i) {
+      double finish = 0.;
+      for(auto const& description : pathsAndConsumes.modulesOnPath(i)) {
+        auto itTime = moduleTimes.find(description->moduleLabel());
+        finish = std::max(finish + (itTime != moduleTimes.end() ? itTime->second : defaultTime),
+                          estimates[description->id()]);
+      }
+      pathPriorities.emplace(paths[i], finish);
+    }
+    std::vector<std::string> pathOrder;
+    for(auto& stream : streamSchedules_) {
+      pathOrder = stream->orderPathStarts(pathPriorities);
+    }
+    order << "start order of the Paths:";
+    for(auto const& name : pathOrder) {
+      order << " " << name;
+    }
+  }
+
   void
   Schedule::availablePaths(std::vector<std::string>& oLabelsToFill) const {
     streamSchedules_[0]->availablePaths(oLabelsToFill);
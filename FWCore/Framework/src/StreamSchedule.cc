@@ -16,6 +16,7 @@
 #include "FWCore/Framework/src/ModuleHolder.h"
 #include "FWCore/Framework/src/WorkerT.h"
 #include "FWCore/Framework/src/ModuleRegistry.h"
+#include "FWCore/Framework/src/orderTasksForWorkStealing.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
@@ -624,9 +625,15 @@ namespace edm {
         it->processOneOccurrenceAsync(allPathsDone,ep, es, serviceToken, streamID_, &streamContext_);
       }
 
-      for(auto it = trig_paths_.rbegin(), itEnd = trig_paths_.rend();
-          it != itEnd; ++ it) {
-        it->processOneOccurrenceAsync(pathsDone,ep, es, serviceToken, streamID_, &streamContext_);
+      if(trig_path_start_order_.empty()) {
+        for(auto it = trig_paths_.rbegin(), itEnd = trig_paths_.rend();
+            it != itEnd; ++ it) {
+          it->processOneOccurrenceAsync(pathsDone,ep, es, serviceToken, streamID_, &streamContext_);
+        }
+      } else {
+        for(unsigned int index : trig_path_start_order_) {
+          trig_paths_[index].processOneOccurrenceAsync(pathsDone,ep, es, serviceToken, streamID_, &streamContext_);
+        }
       }
 
       ParentContext parentContext(&streamContext_);
@@ -745,6 +752,24 @@ namespace edm {
                    std::bind(&Path::name, std::placeholders::_1));
   }
 
+  std::vector<std::string>
+  StreamSchedule::orderPathStarts(std::unordered_map<std::string, double> const& pathPriorities) {
+    std::vector<double> priorities;
+    priorities.reserve(trig_paths_.size());
+    for(auto const& path : trig_paths_) {
+      auto itFound = pathPriorities.find(path.name());
+      priorities.push_back(itFound != pathPriorities.end() ? itFound->second : 0.);
+    }
+    trig_path_start_order_ = orderTasksForWorkStealing(priorities);
+
+    std::vector<std::string> names;
+    names.reserve(trig_path_start_order_.size());
+    for(unsigned int i : trig_path_start_order_) {
+      names.push_back(trig_paths_[i].name());
+    }
+    return names;
+  }
+
   void
   StreamSchedule::modulesInPath(std::string const& iPathLabel,
                           std::vector<std::string>& oLabelsToFill) const {
@@ -90,6 +90,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <sstream>
 #include <atomic>
@@ -205,6 +206,10 @@ namespace edm {
     ///adds to oLabelsToFill the labels for all paths in the process
     void availablePaths(std::vector<std::string>& oLabelsToFill) const;
 
+    ///start the trigger Paths by decreasing priority instead of in configuration order,
+    ///returns the names of the Paths in the order they are spawned
+    std::vector<std::string> orderPathStarts(std::unordered_map<std::string, double> const& pathPriorities);
+
     ///adds to oLabelsToFill in execution order the labels of all modules in path iPathLabel
     void modulesInPath(std::string const& iPathLabel,
                        std::vector<std::string>& oLabelsToFill) const;
@@ -347,6 +352,7 @@ namespace edm {
 
     TrigPaths                trig_paths_;
     TrigPaths                end_paths_;
+    std::vector<unsigned int> trig_path_start_order_; // empty for configuration order
     std::vector<int>         empty_trig_paths_;
     std::vector<int>         empty_end_paths_;
 
@@ -205,6 +205,9 @@ namespace edm {
 
     virtual void convertCurrentProcessAlias(std::string const& processName) = 0;
 
+    virtual std::vector<std::string> orderItemsToGetFromEvent(std::unordered_map<std::string, double> const& modulePriorities,
+                                          ProductRegistry const& preg) = 0;
+
     virtual std::vector<ConsumesInfo> consumesInfo() const = 0;
 
     virtual Types moduleType() const =0;
@@ -16,6 +16,7 @@ WorkerT: Code common to all workers.
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace edm {
@@ -135,6 +136,11 @@ namespace edm {
       module_->convertCurrentProcessAlias(processName);
     }
 
+    std::vector<std::string> orderItemsToGetFromEvent(std::unordered_map<std::string, double> const& modulePriorities,
+                                                      ProductRegistry const& preg) override {
+      return module_->orderItemsToGetFromEvent(modulePriorities, preg, module_->moduleDescription().processName());
+    }
+
     std::vector<ConsumesInfo> consumesInfo() const override {
       return module_->consumesInfo();
     }
@@ -0,0 +1,38 @@
+#ifndef FWCore_Framework_orderTasksForWorkStealing_h
+#define FWCore_Framework_orderTasksForWorkStealing_h
+
+/*----------------------------------------------------------------------
+
+orderTasksForWorkStealing: returns the order in which to spawn tasks
+with the given priorities so that those with the largest priorities
+start first.
+
+A TBB thread runs the task it spawned last, while idle threads steal
+the tasks it spawned first. Therefore the task with the largest
+priority is spawned last, and the others are spawned by decreasing
+priority so that the next largest ones are the first to be stolen.
+Tasks with equal priorities keep their original relative order.
+
+----------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace edm {
+
+  inline
+  std::vector<unsigned int>
+  orderTasksForWorkStealing(std::vector<double> const& priorities) {
+    std::vector<unsigned int> order(priorities.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&priorities](unsigned int a, unsigned int b) { return priorities[a] > priorities[b]; });
+    if(order.size() > 1 and priorities[order.front()] > 0.) {
+      std::rotate(order.begin(), order.begin() + 1, order.end());
+    }
+    return order;
+  }
+}
+
+#endif
@@ -131,6 +131,18 @@ EDAnalyzerAdaptorBase::convertCurrentProcessAlias(std::string const& processName
   }
 }
 
+std::vector<std::string>
+EDAnalyzerAdaptorBase::orderItemsToGetFromEvent(std::unordered_map<std::string, double> const& modulePriorities,
+                                                ProductRegistry const& preg,
+                                                std::string const& processName) {
+  // all the stream modules consume the same products, so they get the same order
+  std::vector<std::string> orderedLabels;
+  for(auto mod: m_streamModules) {
+    orderedLabels = mod->orderItemsToGetFromEvent(modulePriorities, preg, processName);
+  }
+  return orderedLabels;
+}
+
 std::vector<edm::ConsumesInfo>
 EDAnalyzerAdaptorBase::consumesInfo() const {
   assert(not m_streamModules.empty());
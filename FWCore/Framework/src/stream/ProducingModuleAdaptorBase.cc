@@ -124,6 +124,19 @@ namespace edm {
       }
     }
 
+    template< typename T>
+    std::vector<std::string>
+    ProducingModuleAdaptorBase<T>::orderItemsToGetFromEvent(std::unordered_map<std::string, double> const& modulePriorities,
+                                                            ProductRegistry const& preg,
+                                                            std::string const& processName) {
+      // all the stream modules consume the same products, so they get the same order
+      std::vector<std::string> orderedLabels;
+      for(auto mod: m_streamModules) {
+        orderedLabels = mod->orderItemsToGetFromEvent(modulePriorities, preg, processName);
+      }
+      return orderedLabels;
+    }
+
     template< typename T>
     std::vector<edm::ConsumesInfo>
     ProducingModuleAdaptorBase<T>::consumesInfo() const {
@@ -0,0 +1,24 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/testCriticalPathPrefetching_cfg.py
+
+cmsRun $F1 > criticalPathPrefetching.log || die "Failure using $F1" $?
+
+# the Task or product with the longest chain behind it is spawned last, so that it runs first:
+# sum waits for long4 (one, long1, long2, long4) rather than short, long2 for long1 rather
+# than one, and pLong (sum, getSum) takes longer than pShort (getShort)
+grep -q "prefetch order of module 'sum': short long4" criticalPathPrefetching.log || die "wrong prefetch order for sum" 1
+grep -q "prefetch order of module 'long2': one long1" criticalPathPrefetching.log || die "wrong prefetch order for long2" 1
+grep -q "start order of the Paths: pShort pLong" criticalPathPrefetching.log || die "wrong start order of the Paths" 1
+
+# an unknown ordering must be rejected
+cat > criticalPathPrefetching_bad_cfg.py <<EOT
+from FWCore.Framework.test.testCriticalPathPrefetching_cfg import *
+process.options.prefetchOrdering = "fastest"
+EOT
+(cmsRun criticalPathPrefetching_bad_cfg.py 2>&1 | grep -q "Illegal prefetchOrdering") || die "prefetchOrdering was not checked" 1
+
+rm -f criticalPathPrefetching.log criticalPathPrefetching_bad_cfg.py
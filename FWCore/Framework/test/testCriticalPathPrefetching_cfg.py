@@ -0,0 +1,81 @@
+# Runs a long and a short chain of producers with the prefetching
+# ordered by the critical path estimated from moduleTimeEstimates.
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+import FWCore.Framework.test.cmsExceptionsFatalOption_cff
+process.options = cms.untracked.PSet(
+    Rethrow = FWCore.Framework.test.cmsExceptionsFatalOption_cff.Rethrow,
+    numberOfThreads = cms.untracked.uint32(4),
+    numberOfStreams = cms.untracked.uint32(2),
+    prefetchOrdering = cms.untracked.string('criticalPath'),
+    moduleTimeEstimates = cms.untracked.PSet(
+        one = cms.untracked.double(1.),
+        long1 = cms.untracked.double(10.),
+        long2 = cms.untracked.double(10.),
+        long4 = cms.untracked.double(10.),
+        short = cms.untracked.double(0.5)
+    )
+)
+
+# the computed orders are reported in the CriticalPathOrdering category
+process.MessageLogger = cms.Service("MessageLogger",
+    destinations = cms.untracked.vstring('cout'),
+    categories = cms.untracked.vstring(
+        'CriticalPathOrdering'
+    ),
+    cout = cms.untracked.PSet(
+        default = cms.untracked.PSet(
+            limit = cms.untracked.int32(0)
+        ),
+        CriticalPathOrdering = cms.untracked.PSet(
+            limit = cms.untracked.int32(100)
+        )
+    )
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(10)
+)
+process.source = cms.Source("EmptySource")
+
+process.one = cms.EDProducer("IntProducer",
+    ivalue = cms.int32(1)
+)
+
+process.long1 = cms.EDProducer("AddIntsProducer",
+    labels = cms.vstring('one')
+)
+
+process.long2 = cms.EDProducer("AddIntsProducer",
+    labels = cms.vstring('long1', 'one')
+)
+
+process.long4 = cms.EDProducer("AddIntsProducer",
+    labels = cms.vstring('long2', 'long2')
+)
+
+process.short = cms.EDProducer("AddIntsProducer",
+    labels = cms.vstring('one')
+)
+
+# not in moduleTimeEstimates, so it gets the average time
+process.sum = cms.EDProducer("AddIntsProducer",
+    labels = cms.vstring('short', 'long4')
+)
+
+process.getSum = cms.EDAnalyzer("IntTestAnalyzer",
+    valueMustMatch = cms.untracked.int32(5),
+    moduleLabel = cms.untracked.string('sum')
+)
+
+process.getShort = cms.EDAnalyzer("IntTestAnalyzer",
+    valueMustMatch = cms.untracked.int32(1),
+    moduleLabel = cms.untracked.string('short')
+)
+
+process.t = cms.Task(process.one, process.long1, process.long2, process.long4, process.short)
+
+process.pShort = cms.Path(process.getShort, process.t)
+process.pLong = cms.Path(process.sum + process.getSum)
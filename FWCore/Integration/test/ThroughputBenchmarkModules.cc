@@ -0,0 +1,235 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Integration
+//
+/**
+
+ Description: Synthetic modules used by throughputBenchmark_cfg.py to
+ measure the cost of the framework itself.  Each module busy waits for a
+ configurable time, reads all of its inputs and puts a std::vector<int>
+ of a configurable size.  BenchmarkAcquireProducer also hands part of its
+ work to an external thread through edm::ExternalWork.
+
+*/
+
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDFilter.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/src/PreallocationConfiguration.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace edmtest {
+  namespace benchmark {
+
+    // Spin rather than sleep, so that the time is spent on the thread
+    // the framework gave to the module.
+    void busyWait(std::chrono::microseconds duration) {
+      auto const end = std::chrono::steady_clock::now() + duration;
+      while(std::chrono::steady_clock::now() < end) {}
+    }
+
+    std::vector<edm::InputTag> inputTags(edm::ParameterSet const& pset) {
+      return pset.getParameter<std::vector<edm::InputTag>>("inputs");
+    }
+
+    void fillCommonDescription(edm::ParameterSetDescription& desc) {
+      desc.add<std::vector<edm::InputTag>>("inputs", std::vector<edm::InputTag>())
+        ->setComment("Products read before the module does its work.");
+      desc.add<unsigned int>("busyWaitMicroseconds", 0)
+        ->setComment("Time spent by the module on the framework thread.");
+    }
+
+    // Reads all the inputs, so that the cost of the product lookup is measured too.
+    int readInputs(edm::Event const& event, std::vector<edm::EDGetTokenT<std::vector<int>>> const& tokens) {
+      int sum = 0;
+      for(auto const& token : tokens) {
+        edm::Handle<std::vector<int>> h;
+        event.getByToken(token, h);
+        sum += h->size();
+      }
+      return sum;
+    }
+
+    // Threads standing in for an external device or service.  Each
+    // request is served after the requested delay, and its task is then
+    // resumed with doneWaiting.
+    class ExternalWorkers {
+    public:
+      explicit ExternalWorkers(unsigned int nThreads) {
+        for(unsigned int i = 0; i != nThreads; ++i) {
+          threads_.emplace_back([this]() { run(); });
+        }
+      }
+
+      ~ExternalWorkers() {
+        {
+          std::lock_guard<std::mutex> guard(mutex_);
+          stop_ = true;
+        }
+        cond_.notify_all();
+        for(auto& thread : threads_) {
+          thread.join();
+        }
+      }
+
+      void push(std::chrono::microseconds duration, edm::WaitingTaskWithArenaHolder holder) {
+        {
+          std::lock_guard<std::mutex> guard(mutex_);
+          requests_.emplace_back(duration, std::move(holder));
+        }
+        cond_.notify_one();
+      }
+
+    private:
+      void run() {
+        while(true) {
+          std::pair<std::chrono::microseconds, edm::WaitingTaskWithArenaHolder> request;
+          {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this]() { return stop_ or not requests_.empty(); });
+            if(requests_.empty()) return;
+            request = std::move(requests_.front());
+            requests_.pop_front();
+          }
+          busyWait(request.first);
+          request.second.doneWaiting(std::exception_ptr());
+        }
+      }
+
+      std::mutex mutex_;
+      std::condition_variable cond_;
+      std::deque<std::pair<std::chrono::microseconds, edm::WaitingTaskWithArenaHolder>> requests_;
+      std::vector<std::thread> threads_;
+      bool stop_ = false;
+    };
+  }
+
+  class BenchmarkProducer : public edm::global::EDProducer<> {
+  public:
+    explicit BenchmarkProducer(edm::ParameterSet const& pset) :
+      putToken_{produces<std::vector<int>>()},
+      busyWait_(pset.getParameter<unsigned int>("busyWaitMicroseconds")),
+      productSize_(pset.getParameter<unsigned int>("productSize")) {
+      for(auto const& tag : benchmark::inputTags(pset)) {
+        tokens_.emplace_back(consumes<std::vector<int>>(tag));
+      }
+    }
+
+    void produce(edm::StreamID, edm::Event& event, edm::EventSetup const&) const override {
+      int value = benchmark::readInputs(event, tokens_);
+      benchmark::busyWait(busyWait_);
+      event.emplace(putToken_, productSize_, value);
+    }
+
+    static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+      edm::ParameterSetDescription desc;
+      benchmark::fillCommonDescription(desc);
+      desc.add<unsigned int>("productSize", 1)
+        ->setComment("Number of elements of the std::vector<int> put in the event.");
+      descriptions.addDefault(desc);
+    }
+
+  private:
+    std::vector<edm::EDGetTokenT<std::vector<int>>> tokens_;
+    const edm::EDPutTokenT<std::vector<int>> putToken_;
+    const std::chrono::microseconds busyWait_;
+    const unsigned int productSize_;
+  };
+
+  class BenchmarkAcquireProducer : public edm::global::EDProducer<edm::ExternalWork> {
+  public:
+    explicit BenchmarkAcquireProducer(edm::ParameterSet const& pset) :
+      putToken_{produces<std::vector<int>>()},
+      busyWait_(pset.getParameter<unsigned int>("busyWaitMicroseconds")),
+      externalWork_(pset.getParameter<unsigned int>("externalWorkMicroseconds")),
+      productSize_(pset.getParameter<unsigned int>("productSize")) {
+      for(auto const& tag : benchmark::inputTags(pset)) {
+        tokens_.emplace_back(consumes<std::vector<int>>(tag));
+      }
+    }
+
+    void acquire(edm::StreamID, edm::Event const& event, edm::EventSetup const&, edm::WaitingTaskWithArenaHolder holder) const override {
+      benchmark::readInputs(event, tokens_);
+      workers_->push(externalWork_, std::move(holder));
+    }
+
+    void produce(edm::StreamID, edm::Event& event, edm::EventSetup const&) const override {
+      benchmark::busyWait(busyWait_);
+      event.emplace(putToken_, productSize_, 0);
+    }
+
+    static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+      edm::ParameterSetDescription desc;
+      benchmark::fillCommonDescription(desc);
+      desc.add<unsigned int>("externalWorkMicroseconds", 0)
+        ->setComment("Time spent by the external thread between acquire and produce.");
+      desc.add<unsigned int>("productSize", 1)
+        ->setComment("Number of elements of the std::vector<int> put in the event.");
+      descriptions.addDefault(desc);
+    }
+
+  private:
+    void preallocate(edm::PreallocationConfiguration const& iPrealloc) override {
+      // one external thread per stream, so that the external work never queues
+      workers_ = std::make_unique<benchmark::ExternalWorkers>(iPrealloc.numberOfStreams());
+    }
+
+    std::vector<edm::EDGetTokenT<std::vector<int>>> tokens_;
+    const edm::EDPutTokenT<std::vector<int>> putToken_;
+    const std::chrono::microseconds busyWait_;
+    const std::chrono::microseconds externalWork_;
+    const unsigned int productSize_;
+    std::unique_ptr<benchmark::ExternalWorkers> workers_;
+  };
+
+  class BenchmarkFilter : public edm::global::EDFilter<> {
+  public:
+    explicit BenchmarkFilter(edm::ParameterSet const& pset) :
+      busyWait_(pset.getParameter<unsigned int>("busyWaitMicroseconds")),
+      acceptEvery_(pset.getParameter<unsigned int>("acceptEvery")) {
+      for(auto const& tag : benchmark::inputTags(pset)) {
+        tokens_.emplace_back(consumes<std::vector<int>>(tag));
+      }
+    }
+
+    bool filter(edm::StreamID, edm::Event& event, edm::EventSetup const&) const override {
+      benchmark::readInputs(event, tokens_);
+      benchmark::busyWait(busyWait_);
+      return acceptEvery_ != 0 and event.id().event() % acceptEvery_ == 0;
+    }
+
+    static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+      edm::ParameterSetDescription desc;
+      benchmark::fillCommonDescription(desc);
+      desc.add<unsigned int>("acceptEvery", 1)
+        ->setComment("Accept the events whose number is a multiple of this value, none if 0.");
+      descriptions.addDefault(desc);
+    }
+
+  private:
+    std::vector<edm::EDGetTokenT<std::vector<int>>> tokens_;
+    const std::chrono::microseconds busyWait_;
+    const unsigned int acceptEvery_;
+  };
+}
+
+DEFINE_FWK_MODULE(edmtest::BenchmarkProducer);
+DEFINE_FWK_MODULE(edmtest::BenchmarkAcquireProducer);
+DEFINE_FWK_MODULE(edmtest::BenchmarkFilter);
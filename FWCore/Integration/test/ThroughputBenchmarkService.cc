@@ -0,0 +1,223 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Integration
+// Class  :     ThroughputBenchmarkService
+//
+/**\class edmtest::ThroughputBenchmarkService
+
+ Description: Measures the throughput of a job and how the time of the
+ module calls is split, and prints a summary at the end of the job.
+
+ Usage:
+    For each module, and for all modules together, the service reports
+  - prefetch: time between the start of the prefetching of the module's
+    inputs and its end, i.e. the time the module was stalled waiting for
+    the modules it depends on,
+  - schedule: time between the end of the prefetching and the start of
+    the module, i.e. the time the task spent in the scheduler,
+  - run: time spent in the module's acquire and produce/filter/analyze.
+    The first line of the summary is meant to be parsed by scripts:
+
+  ThroughputBenchmark threads 4 streams 4 lumis 1 events 1000 events/s 1234.5 run/call[us] 10.1 schedule/call[us] 1.2 prefetch/call[us] 3.4
+
+*/
+
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/PathsAndConsumesOfModulesBase.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/ServiceRegistry/interface/SystemBounds.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace edmtest {
+  class ThroughputBenchmarkService {
+  public:
+    ThroughputBenchmarkService(edm::ParameterSet const& pset, edm::ActivityRegistry& iRegistry);
+
+    static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+  private:
+    using clock = std::chrono::steady_clock;
+
+    struct ModuleTimes {
+      std::string label_;
+      std::atomic<unsigned long long> calls_{0};
+      std::atomic<long long> prefetch_{0};  // in ns
+      std::atomic<long long> schedule_{0};
+      std::atomic<long long> run_{0};
+    };
+
+    // start of the current step of a module on a stream; each one is only
+    // used by one stream and one module, so they need no synchronisation
+    struct ModuleOnStream {
+      clock::time_point prefetchStart_;
+      clock::time_point prefetchEnd_;
+      clock::time_point runStart_;
+    };
+
+    void preallocate(edm::service::SystemBounds const&);
+    void preBeginJob(edm::PathsAndConsumesOfModulesBase const&, edm::ProcessContext const&);
+    void preEvent(edm::StreamContext const&);
+    void postEvent(edm::StreamContext const&);
+    void preModuleEventPrefetching(edm::StreamContext const&, edm::ModuleCallingContext const&);
+    void postModuleEventPrefetching(edm::StreamContext const&, edm::ModuleCallingContext const&);
+    void preModuleRun(edm::StreamContext const&, edm::ModuleCallingContext const&);
+    void postModuleAcquire(edm::StreamContext const&, edm::ModuleCallingContext const&);
+    void postModuleEvent(edm::StreamContext const&, edm::ModuleCallingContext const&);
+    void postEndJob();
+
+    ModuleOnStream& slot(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc) {
+      return slots_[sc.streamID().value() * modules_.size() + mcc.moduleDescription()->id()];
+    }
+    static long long elapsed(clock::time_point begin, clock::time_point end) {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    }
+    static long long now() {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch()).count();
+    }
+
+    unsigned int nThreads_ = 0;
+    unsigned int nStreams_ = 0;
+    unsigned int nLumis_ = 0;
+    std::vector<ModuleTimes> modules_;
+    std::vector<ModuleOnStream> slots_;
+    std::atomic<unsigned long long> events_{0};
+    std::atomic<long long> firstEvent_{std::numeric_limits<long long>::max()}; // see now()
+    std::atomic<long long> lastEvent_{0};
+  };
+
+  ThroughputBenchmarkService::ThroughputBenchmarkService(edm::ParameterSet const&, edm::ActivityRegistry& iRegistry) {
+    iRegistry.watchPreallocate(this, &ThroughputBenchmarkService::preallocate);
+    iRegistry.watchPreBeginJob(this, &ThroughputBenchmarkService::preBeginJob);
+    iRegistry.watchPreEvent(this, &ThroughputBenchmarkService::preEvent);
+    iRegistry.watchPostEvent(this, &ThroughputBenchmarkService::postEvent);
+    iRegistry.watchPreModuleEventPrefetching(this, &ThroughputBenchmarkService::preModuleEventPrefetching);
+    iRegistry.watchPostModuleEventPrefetching(this, &ThroughputBenchmarkService::postModuleEventPrefetching);
+    iRegistry.watchPreModuleEventAcquire(this, &ThroughputBenchmarkService::preModuleRun);
+    iRegistry.watchPostModuleEventAcquire(this, &ThroughputBenchmarkService::postModuleAcquire);
+    iRegistry.watchPreModuleEvent(this, &ThroughputBenchmarkService::preModuleRun);
+    iRegistry.watchPostModuleEvent(this, &ThroughputBenchmarkService::postModuleEvent);
+    iRegistry.watchPostEndJob(this, &ThroughputBenchmarkService::postEndJob);
+  }
+
+  void ThroughputBenchmarkService::preallocate(edm::service::SystemBounds const& bounds) {
+    nThreads_ = bounds.maxNumberOfThreads();
+    nStreams_ = bounds.maxNumberOfStreams();
+    nLumis_ = bounds.maxNumberOfConcurrentLuminosityBlocks();
+  }
+
+  void ThroughputBenchmarkService::preBeginJob(edm::PathsAndConsumesOfModulesBase const& pathsAndConsumes, edm::ProcessContext const&) {
+    unsigned int nModules = 0;
+    for(auto const* description : pathsAndConsumes.allModules()) {
+      nModules = std::max(nModules, description->id() + 1);
+    }
+    modules_ = std::vector<ModuleTimes>(nModules);
+    for(auto const* description : pathsAndConsumes.allModules()) {
+      modules_[description->id()].label_ = description->moduleLabel();
+    }
+    slots_.resize(nStreams_ * nModules);
+  }
+
+  void ThroughputBenchmarkService::preEvent(edm::StreamContext const&) {
+    long long start = now();
+    long long first = firstEvent_.load();
+    while(start < first and not firstEvent_.compare_exchange_weak(first, start)) {}
+  }
+
+  void ThroughputBenchmarkService::postEvent(edm::StreamContext const&) {
+    ++events_;
+    long long end = now();
+    long long last = lastEvent_.load();
+    while(end > last and not lastEvent_.compare_exchange_weak(last, end)) {}
+  }
+
+  void ThroughputBenchmarkService::preModuleEventPrefetching(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc) {
+    slot(sc, mcc).prefetchStart_ = clock::now();
+  }
+
+  void ThroughputBenchmarkService::postModuleEventPrefetching(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc) {
+    auto& s = slot(sc, mcc);
+    s.prefetchEnd_ = clock::now();
+    modules_[mcc.moduleDescription()->id()].prefetch_ += elapsed(s.prefetchStart_, s.prefetchEnd_);
+  }
+
+  void ThroughputBenchmarkService::preModuleRun(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc) {
+    slot(sc, mcc).runStart_ = clock::now();
+  }
+
+  void ThroughputBenchmarkService::postModuleAcquire(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc) {
+    auto& s = slot(sc, mcc);
+    auto& times = modules_[mcc.moduleDescription()->id()];
+    times.schedule_ += elapsed(s.prefetchEnd_, s.runStart_);
+    times.run_ += elapsed(s.runStart_, clock::now());
+    // the time waiting for the external work is not counted as scheduling
+    s.prefetchEnd_ = clock::time_point();
+  }
+
+  void ThroughputBenchmarkService::postModuleEvent(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc) {
+    auto& s = slot(sc, mcc);
+    auto& times = modules_[mcc.moduleDescription()->id()];
+    if(s.prefetchEnd_ != clock::time_point()) {
+      times.schedule_ += elapsed(s.prefetchEnd_, s.runStart_);
+    }
+    times.run_ += elapsed(s.runStart_, clock::now());
+    ++times.calls_;
+  }
+
+  void ThroughputBenchmarkService::postEndJob() {
+    unsigned long long calls = 0;
+    long long prefetch = 0, schedule = 0, run = 0;
+    for(auto const& times : modules_) {
+      calls += times.calls_;
+      prefetch += times.prefetch_;
+      schedule += times.schedule_;
+      run += times.run_;
+    }
+    auto perCall = [](long long ns, unsigned long long n) { return n == 0 ? 0. : ns / 1000. / n; };
+    double seconds = events_ == 0 ? 0. : (lastEvent_ - firstEvent_) / 1.e9;
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1)
+        << "ThroughputBenchmark threads " << nThreads_ << " streams " << nStreams_ << " lumis " << nLumis_
+        << " events " << events_.load()
+        << " events/s " << (seconds > 0. ? events_ / seconds : 0.)
+        << " run/call[us] " << perCall(run, calls)
+        << " schedule/call[us] " << perCall(schedule, calls)
+        << " prefetch/call[us] " << perCall(prefetch, calls) << "\n";
+    out << std::setw(30) << std::left << "module" << std::right
+        << std::setw(10) << "calls" << std::setw(14) << "run[us]" << std::setw(14) << "schedule[us]" << std::setw(14) << "prefetch[us]"
+        << "\n";
+    for(auto const& times : modules_) {
+      if(times.calls_ == 0) continue;
+      out << std::setw(30) << std::left << times.label_ << std::right
+          << std::setw(10) << times.calls_.load()
+          << std::setw(14) << perCall(times.run_, times.calls_)
+          << std::setw(14) << perCall(times.schedule_, times.calls_)
+          << std::setw(14) << perCall(times.prefetch_, times.calls_) << "\n";
+    }
+    edm::LogAbsolute("ThroughputBenchmark") << out.str();
+  }
+
+  void ThroughputBenchmarkService::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.setComment("Reports the throughput of the job and the time spent running, scheduling and prefetching modules.");
+    descriptions.add("ThroughputBenchmarkService", desc);
+  }
+}
+
+using edmtest::ThroughputBenchmarkService;
+DEFINE_FWK_SERVICE(ThroughputBenchmarkService);
@@ -0,0 +1,24 @@
+#!/bin/bash
+# Scan the throughput of throughputBenchmark_cfg.py over threads, streams
+# and concurrent lumis.  Extra arguments are passed to the configuration,
+# e.g.
+#   throughputBenchmark.sh width=8 depth=3 cost=20 external=100
+# The scanned values can be changed with THREADS, STREAMS_PER_THREAD and
+# LUMIS; one summary line is printed per configuration.
+
+function die { echo $1: status $2 ;  exit $2; }
+
+CONFIG=${LOCAL_TEST_DIR:-$(dirname $0)}/throughputBenchmark_cfg.py
+THREADS=${THREADS:-"1 2 4 8"}
+STREAMS_PER_THREAD=${STREAMS_PER_THREAD:-"1"}
+LUMIS=${LUMIS:-"1 2"}
+
+for threads in $THREADS; do
+  for ratio in $STREAMS_PER_THREAD; do
+    for lumis in $LUMIS; do
+      streams=$((threads * ratio))
+      cmsRun $CONFIG threads=$threads streams=$streams lumis=$lumis "$@" > throughputBenchmark.log 2>&1 || { cat throughputBenchmark.log; die "Failed in $CONFIG threads=$threads streams=$streams lumis=$lumis" $?; }
+      grep "^ThroughputBenchmark" throughputBenchmark.log || { cat throughputBenchmark.log; die "No summary from $CONFIG" 1; }
+    done
+  done
+done
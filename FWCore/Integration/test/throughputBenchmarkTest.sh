@@ -0,0 +1,10 @@
+#!/bin/bash
+
+function die { echo $1: status $2 ;  exit $2; }
+
+pushd ${LOCAL_TMP_DIR}
+
+# A short scan, only checking that the benchmark runs and reports
+THREADS="1 2" LUMIS="1 2" /bin/bash ${LOCAL_TEST_DIR}/throughputBenchmark.sh events=200 eventsPerLumi=20 width=2 depth=2 cost=5 external=20 productSize=10 acceptEvery=2 || die 'Failed in throughputBenchmark.sh' $?
+
+popd
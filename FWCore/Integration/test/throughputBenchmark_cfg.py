@@ -0,0 +1,75 @@
+# Synthetic job measuring the throughput of the framework itself.
+# The modules do no physics: each one busy waits for a given time, reads
+# its inputs and puts a std::vector<int>.  The modules are arranged in
+# 'depth' layers of 'width' producers, each reading all the producers of
+# the previous layer, followed by a filter.
+#
+#   cmsRun throughputBenchmark_cfg.py threads=8 streams=8 lumis=2 width=4 depth=5 cost=10 external=50
+#
+# ThroughputBenchmarkService prints the throughput and the split of the
+# module call times at the end of the job; throughputBenchmark.sh scans
+# threads, streams and concurrent lumis.
+
+import FWCore.ParameterSet.Config as cms
+from FWCore.ParameterSet.VarParsing import VarParsing
+
+options = VarParsing()
+options.register("threads", 1, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of threads")
+options.register("streams", 0, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of streams, 0 for one per thread")
+options.register("lumis", 1, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of concurrent luminosity blocks")
+options.register("events", 1000, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of events")
+options.register("eventsPerLumi", 100, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of events per luminosity block")
+options.register("width", 4, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of producers per layer")
+options.register("depth", 4, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of layers of producers")
+options.register("cost", 0, VarParsing.multiplicity.singleton, VarParsing.varType.int, "busy wait of each module, in microseconds")
+options.register("external", 0, VarParsing.multiplicity.singleton, VarParsing.varType.int, "external work of the first layer, in microseconds; 0 to not use ExternalWork")
+options.register("productSize", 1, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of elements of each product")
+options.register("acceptEvery", 1, VarParsing.multiplicity.singleton, VarParsing.varType.int, "the filter accepts one event in acceptEvery")
+options.parseArguments()
+
+process = cms.Process("BENCHMARK")
+
+process.source = cms.Source("EmptySource",
+                            numberEventsInLuminosityBlock = cms.untracked.uint32(options.eventsPerLumi))
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(options.events))
+
+process.options = cms.untracked.PSet(numberOfThreads = cms.untracked.uint32(options.threads),
+                                     numberOfStreams = cms.untracked.uint32(options.streams),
+                                     numberOfConcurrentLuminosityBlocks = cms.untracked.uint32(options.lumis))
+
+process.ThroughputBenchmarkService = cms.Service("ThroughputBenchmarkService")
+
+process.MessageLogger = cms.Service("MessageLogger",
+                                    destinations = cms.untracked.vstring("cout"),
+                                    cout = cms.untracked.PSet(threshold = cms.untracked.string("WARNING")))
+
+task = cms.Task()
+previous = []
+for layer in range(options.depth):
+    current = []
+    for i in range(options.width):
+        label = "layer%dproducer%d" % (layer, i)
+        inputs = cms.VInputTag(*[cms.InputTag(p) for p in previous])
+        if layer == 0 and options.external > 0:
+            module = cms.EDProducer("edmtest::BenchmarkAcquireProducer",
+                                    inputs = inputs,
+                                    busyWaitMicroseconds = cms.uint32(options.cost),
+                                    externalWorkMicroseconds = cms.uint32(options.external),
+                                    productSize = cms.uint32(options.productSize))
+        else:
+            module = cms.EDProducer("edmtest::BenchmarkProducer",
+                                    inputs = inputs,
+                                    busyWaitMicroseconds = cms.uint32(options.cost),
+                                    productSize = cms.uint32(options.productSize))
+        setattr(process, label, module)
+        task.add(module)
+        current.append(label)
+    previous = current
+
+process.filter = cms.EDFilter("edmtest::BenchmarkFilter",
+                              inputs = cms.VInputTag(*[cms.InputTag(p) for p in previous]),
+                              busyWaitMicroseconds = cms.uint32(options.cost),
+                              acceptEvery = cms.uint32(options.acceptEvery))
+
+process.p = cms.Path(process.filter, task)
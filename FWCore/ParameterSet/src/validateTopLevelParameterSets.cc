@@ -29,6 +29,15 @@ void fillOptionsDescription(ParameterSetDescription& description) {
     setComment("Set false to disable exception throws when configuration validation detects illegal parameters");
   description.addUntracked<bool>("printDependencies", false)->
     setComment("Print data dependencies between modules");
+  description.addUntracked<std::string>("prefetchOrdering", "declaration")->
+    setComment("Legal values are 'declaration' and 'criticalPath'. With 'criticalPath' the products a module "
+               "reads from the Event, and the Paths, are started by decreasing length of the chain of modules "
+               "needed to make them, estimated from moduleTimeEstimates");
+  ParameterSetDescription moduleTimesDescription;
+  moduleTimesDescription.addWildcardUntracked<double>("*")->
+    setComment("Time of the module with this label per Event, in any unit. "
+               "Modules without an estimate are given the average of the others");
+  description.addUntracked<ParameterSetDescription>("moduleTimeEstimates", moduleTimesDescription);
 
 
   // No default for this one because the parameter value is
@@ -248,6 +248,48 @@ def customiseFor24329(process):
     return process
 
 # CMSSW version specific customizations
+# the trajectories of the seeds are built one after the other, as before the seed batches
+def customiseForCkfSeedBatchSize(process):
+    for producer in producers_by_type(process, "CkfTrackCandidateMaker", "CkfTrajectoryMaker"):
+        if not hasattr(producer, 'seedBatchSize'):
+            producer.seedBatchSize = cms.uint32(0)
+    return process
+
+# the pixel clusters are made on the module buffer, as before the occupancy bitmap
+def customiseForPixelBitmapLabeling(process):
+    for producer in producers_by_type(process, "SiPixelClusterProducer"):
+        if not hasattr(producer, 'BitmapLabeling'):
+            producer.BitmapLabeling = cms.bool(False)
+    return process
+
+# the PF blocks are linked serially, with the link grids
+def customiseForPFLinkGrids(process):
+    for producer in producers_by_type(process, "PFBlockProducer"):
+        if not hasattr(producer, 'parallelLinking'):
+            producer.parallelLinking = cms.bool(False)
+        if not hasattr(producer, 'useLinkGrids'):
+            producer.useLinkGrids = cms.bool(True)
+    return process
+
+# the DA vertices are annealed in a single region, against all the vertices
+def customiseForDAVertexRegions(process):
+    for producer in producers_by_type(process, "PrimaryVertexProducer"):
+        if producer.TkClusParameters.algorithm.value() not in ('DA_vect', 'DA2D_vect'):
+            continue
+        pset = producer.TkClusParameters.TkDAClusParameters
+        if not hasattr(pset, 'zgap'):
+            pset.zgap = cms.double(0.)
+        if not hasattr(pset, 'zrange'):
+            pset.zrange = cms.double(0.)
+    return process
+
+# the Mahi pulse shapes are evaluated for every fit, as before the tabulated templates
+def customiseForMahiPulseTemplates(process):
+    for producer in producers_by_type(process, "HBHEPhase1Reconstructor"):
+        if not hasattr(producer.algorithm, 'pulseTemplateStep'):
+            producer.algorithm.pulseTemplateStep = cms.double(0.)
+    return process
+
 def customizeHLTforCMSSW(process, menuType="GRun"):
 
     # add call to action function in proper order: newest last!
@@ -259,4 +301,14 @@ def customizeHLTforCMSSW(process, menuType="GRun"):
 
     process = customiseFor24329(process)
 
+    process = customiseForCkfSeedBatchSize(process)
+
+    process = customiseForPixelBitmapLabeling(process)
+
+    process = customiseForPFLinkGrids(process)
+
+    process = customiseForDAVertexRegions(process)
+
+    process = customiseForMahiPulseTemplates(process)
+
     return process
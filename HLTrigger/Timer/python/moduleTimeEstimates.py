@@ -0,0 +1,47 @@
+"""Build the process.options.moduleTimeEstimates used by prefetchOrdering = 'criticalPath'
+from the job summary printed by the FastTimerService.
+
+    from HLTrigger.Timer.moduleTimeEstimates import moduleTimeEstimatesFromFastReport
+    process.options.prefetchOrdering = cms.untracked.string('criticalPath')
+    process.options.moduleTimeEstimates = moduleTimeEstimatesFromFastReport('timing.log')
+
+The estimates are the average real time per event of each module, in ms, taken from
+the last "Modules" table of the log, i.e. the one of the job summary.
+"""
+
+import FWCore.ParameterSet.Config as cms
+
+def readFastReport(fileName):
+    """Return a dictionary from module label to average real time per event in ms.
+
+    Raise a RuntimeError if the log has no "Modules" table, or if a line of the table
+    is not in the detailed format printed by the FastTimerService."""
+    times = None
+    inModules = False
+    with open(fileName) as log:
+        for number, line in enumerate(log, 1):
+            fields = line.split()
+            if not fields or fields[0] != 'FastReport':
+                # each table ends with an empty line
+                inModules = False
+            elif len(fields) > 1 and fields[1] == 'CPU':
+                # table header, the last "Modules" table is the one of the job summary
+                inModules = (fields[-1] == 'Modules')
+                if inModules:
+                    times = {}
+            elif inModules:
+                if len(fields) == 18:
+                    # FastReport  cpu ms  cpu ms  real ms  real ms  alloc kB  alloc kB  dealloc kB  dealloc kB  label
+                    times[fields[17]] = float(fields[5])
+                elif len(fields) >= 10 and fields[9] in ('process', 'total'):
+                    # FastReport  cpu ms  real ms  alloc kB  dealloc kB  process name / total
+                    pass
+                else:
+                    raise RuntimeError('%s:%d: unexpected line in the FastReport "Modules" table:\n%s' % (fileName, number, line))
+    if times is None:
+        raise RuntimeError('%s: no FastReport "Modules" table found, is the FastTimerService summary enabled?' % fileName)
+    return times
+
+def moduleTimeEstimatesFromFastReport(fileName):
+    """Return a cms.untracked.PSet usable as process.options.moduleTimeEstimates."""
+    return cms.untracked.PSet(**{label: cms.untracked.double(time) for label, time in readFastReport(fileName).items()})
@@ -0,0 +1,217 @@
+//----------------------------------------------------------------------
+// EdmCompressionBenchmark.cpp
+//
+// Rewrites the event branches of an EDM file with a set of candidate
+// compression settings and reports, for each branch and candidate, the
+// compressed size and the time needed to read the branch back.
+// The output is meant to help choose the 'overrideBranchesCompression'
+// settings of PoolOutputModule.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+#include "IOPool/Common/bin/CollUtil.h"
+#include "IOPool/Common/interface/getCompressionSettings.h"
+#include "DataFormats/Provenance/interface/BranchType.h"
+#include "FWCore/PluginManager/interface/PluginManager.h"
+#include "FWCore/PluginManager/interface/standard.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "TBranch.h"
+#include "TClass.h"
+#include "TError.h"
+#include "TFile.h"
+#include "TMemFile.h"
+#include "TObjArray.h"
+#include "TTree.h"
+
+namespace {
+  struct Candidate {
+    std::string algorithm_;
+    int level_;
+    int settings_;
+  };
+
+  struct Measurement {
+    Long64_t totBytes_;
+    Long64_t zipBytes_;
+    double readSeconds_;
+  };
+
+  std::vector<Candidate> parseCandidates(std::vector<std::string> const& names) {
+    std::vector<Candidate> candidates;
+    for(auto const& name : names) {
+      // Candidates are given as ALGORITHM:LEVEL, e.g. LZ4:4
+      std::vector<std::string> tokens;
+      boost::split(tokens, name, boost::is_any_of(":"));
+      if(tokens.size() != 2) {
+        throw cms::Exception("Configuration") << "Compression candidate '" << name << "' is not of the form ALGORITHM:LEVEL\n";
+      }
+      int level = std::stoi(tokens[1]);
+      candidates.push_back(Candidate{tokens[0], level, edm::getCompressionSettings(tokens[0], level)});
+    }
+    return candidates;
+  }
+
+  // CloneTree keeps the compression settings of the input branches, so they are overridden on every (sub)branch.
+  void setCompressionSettings(TObjArray* branches, int settings) {
+    for(int i = 0, n = branches->GetEntriesFast(); i < n; ++i) {
+      TBranch* branch = static_cast<TBranch*>(branches->UncheckedAt(i));
+      branch->SetCompressionSettings(settings);
+      setCompressionSettings(branch->GetListOfBranches(), settings);
+    }
+  }
+
+  Measurement measure(TTree* inputTree, std::string const& branchName, Candidate const& candidate, Long64_t nEntries) {
+    TMemFile memFile("edmCompressionBenchmark.root", "RECREATE", "", candidate.settings_);
+    memFile.SetCompressionSettings(candidate.settings_);
+
+    inputTree->SetBranchStatus("*", 0);
+    inputTree->SetBranchStatus((branchName + "*").c_str(), 1);
+    std::unique_ptr<TTree> outputTree(inputTree->CloneTree(0));
+    outputTree->SetDirectory(&memFile);
+    setCompressionSettings(outputTree->GetListOfBranches(), candidate.settings_);
+    for(Long64_t entry = 0; entry < nEntries; ++entry) {
+      inputTree->GetEntry(entry);
+      outputTree->Fill();
+    }
+    TBranch* outputBranch = outputTree->GetBranch(branchName.c_str());
+    outputTree->FlushBaskets();
+    Measurement result{outputBranch->GetTotBytes("*"), outputBranch->GetZipBytes("*"), 0.};
+    outputTree->Write();
+    outputTree.reset();
+
+    // Read the branch back from the in memory file, so only decompression and streaming are timed.
+    std::unique_ptr<TTree> readTree(dynamic_cast<TTree*>(memFile.Get(edm::poolNames::eventTreeName().c_str())));
+    TBranch* readBranch = readTree->GetBranch(branchName.c_str());
+    // The object is owned here: with a null address ROOT would allocate one that ResetAddress never frees.
+    TClass* branchClass = TClass::GetClass(readBranch->GetClassName());
+    if(branchClass == nullptr) {
+      throw cms::Exception("Configuration") << "No dictionary for the class of branch '" << branchName << "'\n";
+    }
+    void* address = branchClass->New();
+    readBranch->SetAddress(&address);
+    auto start = std::chrono::steady_clock::now();
+    for(Long64_t entry = 0; entry < nEntries; ++entry) {
+      readBranch->GetEntry(entry);
+    }
+    result.readSeconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    readBranch->ResetAddress();
+    branchClass->Destructor(address);
+    inputTree->SetBranchStatus("*", 1);
+    return result;
+  }
+}
+
+int main(int argc, char* argv[]) {
+
+  gErrorIgnoreLevel = kError;
+
+  boost::program_options::options_description desc("Allowed options");
+  desc.add_options()
+    ("help,h", "print help message")
+    ("file,f", boost::program_options::value<std::string>(), "data file")
+    ("branches,b", boost::program_options::value<std::string>()->default_value("*"), "branches to benchmark, wildcards '*' and '?' are allowed")
+    ("events,e", boost::program_options::value<Long64_t>()->default_value(100), "number of events used for each measurement")
+    ("candidates,c", boost::program_options::value<std::vector<std::string> >()->multitoken(),
+     "compression settings to compare, as ALGORITHM:LEVEL (default: ZLIB:9 LZMA:4 LZ4:4)");
+
+  boost::program_options::positional_options_description p;
+  p.add("file", -1);
+
+  boost::program_options::variables_map vm;
+
+  try {
+      boost::program_options::store(boost::program_options::command_line_parser(argc, argv).
+                                    options(desc).positional(p).run(), vm);
+  } catch (boost::program_options::error const& x) {
+      std::cerr << "Option parsing failure:\n"
+                << x.what() << "\n\n";
+      std::cerr << desc << "\n";
+      return 1;
+  }
+
+  boost::program_options::notify(vm);
+
+  if (vm.count("help") || !vm.count("file")) {
+    std::cout << desc << "\n";
+    std::cout << "Available algorithms:";
+    for(auto const& name : edm::allowedCompressionAlgorithms()) {
+      std::cout << ' ' << name;
+    }
+    std::cout << "\n";
+    return 1;
+  }
+
+  int rc = 0;
+  try {
+    edmplugin::PluginManager::configure(edmplugin::standard::config());
+
+    std::vector<std::string> candidateNames = vm.count("candidates") ?
+      vm["candidates"].as<std::vector<std::string> >() :
+      std::vector<std::string>{"ZLIB:9", "LZMA:4", "LZ4:4"};
+    std::vector<Candidate> candidates = parseCandidates(candidateNames);
+
+    std::string pattern(vm["branches"].as<std::string>());
+    boost::replace_all(pattern, "*", ".*");
+    boost::replace_all(pattern, "?", ".");
+    std::regex branchRegex(pattern);
+
+    std::unique_ptr<TFile> tfile{edm::openFileHdl(vm["file"].as<std::string>())};
+    if (tfile == nullptr) return 1;
+    TTree* eventTree = dynamic_cast<TTree*>(tfile->Get(edm::poolNames::eventTreeName().c_str()));
+    if (eventTree == nullptr) {
+      std::cout << "Tree " << edm::poolNames::eventTreeName() << " appears to be missing. Not a valid collection\n";
+      return 1;
+    }
+    Long64_t nEntries = std::min(eventTree->GetEntries(), vm["events"].as<Long64_t>());
+
+    std::cout << std::left << std::setw(70) << "branch" << std::setw(10) << "candidate"
+              << std::right << std::setw(14) << "bytes" << std::setw(9) << "ratio"
+              << std::setw(14) << "read ms/evt" << "\n";
+    TObjArray* branches = eventTree->GetListOfBranches();
+    for(int i = 0; i < branches->GetEntriesFast(); ++i) {
+      std::string branchName(static_cast<TBranch*>(branches->UncheckedAt(i))->GetName());
+      if(!std::regex_match(branchName, branchRegex)) continue;
+      for(auto const& candidate : candidates) {
+        Measurement m = measure(eventTree, branchName, candidate, nEntries);
+        std::cout << std::left << std::setw(70) << branchName
+                  << std::setw(10) << (candidate.algorithm_ + ':' + std::to_string(candidate.level_))
+                  << std::right << std::setw(14) << m.zipBytes_
+                  << std::setw(9) << std::fixed << std::setprecision(2) << (m.zipBytes_ > 0 ? double(m.totBytes_)/m.zipBytes_ : 0.)
+                  << std::setw(14) << std::setprecision(4) << (nEntries > 0 ? 1000.*m.readSeconds_/nEntries : 0.)
+                  << "\n";
+      }
+    }
+    tfile->Close();
+  }
+  catch (cms::Exception const& e) {
+    std::cout << "cms::Exception caught in "
+              <<"EdmCompressionBenchmark"
+              << '\n'
+              << e.explainSelf();
+    rc = 1;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Standard library exception caught in "
+              << "EdmCompressionBenchmark"
+              << '\n'
+              << e.what();
+    rc = 1;
+  }
+  catch (...) {
+    std::cout << "Unknown exception caught in "
+              << "EdmCompressionBenchmark";
+    rc = 2;
+  }
+  return rc;
+}
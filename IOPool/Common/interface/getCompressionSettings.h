@@ -0,0 +1,16 @@
+#ifndef IOPool_Common_getCompressionSettings_h
+#define IOPool_Common_getCompressionSettings_h
+
+#include <string>
+#include <vector>
+
+namespace edm {
+  // Returns the ROOT compression settings (algorithm * 100 + level) for the
+  // named algorithm.  Throws a Configuration exception for unknown names.
+  int getCompressionSettings(std::string const& algorithm, int level);
+
+  // Names of the algorithms supported by the ROOT version in use.
+  std::vector<std::string> const& allowedCompressionAlgorithms();
+}
+
+#endif
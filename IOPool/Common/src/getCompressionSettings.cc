@@ -0,0 +1,53 @@
+#include "IOPool/Common/interface/getCompressionSettings.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+#include "Compression.h"
+#include "RVersion.h"
+
+namespace edm {
+  namespace {
+    struct NamedAlgorithm {
+      char const* name_;
+      ROOT::ECompressionAlgorithm algorithm_;
+    };
+
+    std::vector<NamedAlgorithm> const& namedAlgorithms() {
+      static std::vector<NamedAlgorithm> const algorithms = {
+        {"ZLIB", ROOT::kZLIB},
+        {"LZMA", ROOT::kLZMA},
+        {"LZ4", ROOT::kLZ4},
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,20,0)
+        {"ZSTD", ROOT::kZSTD},
+#endif
+      };
+      return algorithms;
+    }
+  }
+
+  int getCompressionSettings(std::string const& algorithm, int level) {
+    for(auto const& named : namedAlgorithms()) {
+      if(algorithm == named.name_) {
+        return ROOT::CompressionSettings(named.algorithm_, level);
+      }
+    }
+    Exception ex(errors::Configuration);
+    ex << "Unknown compression algorithm '" << algorithm << "'\n"
+       << "Allowed compression algorithms are";
+    for(auto const& name : allowedCompressionAlgorithms()) {
+      ex << ' ' << name;
+    }
+    ex << "\n";
+    throw ex;
+  }
+
+  std::vector<std::string> const& allowedCompressionAlgorithms() {
+    static std::vector<std::string> const names = [] {
+      std::vector<std::string> result;
+      for(auto const& named : namedAlgorithms()) {
+        result.emplace_back(named.name_);
+      }
+      return result;
+    }();
+    return names;
+  }
+}
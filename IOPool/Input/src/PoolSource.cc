@@ -8,7 +8,9 @@
 #include "DataFormats/Common/interface/ThinnedAssociation.h"
 #include "DataFormats/Provenance/interface/BranchDescription.h"
 #include "DataFormats/Provenance/interface/IndexIntoFile.h"
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "DataFormats/Provenance/interface/ProductRegistry.h"
+#include "DataFormats/Provenance/interface/ProductResolverIndexHelper.h"
 #include "DataFormats/Provenance/interface/ThinnedAssociationsHelper.h"
 #include "FWCore/Framework/interface/EventPrincipal.h"
 #include "FWCore/Framework/interface/FileBlock.h"
@@ -20,6 +22,9 @@
 #include "FWCore/Framework/interface/RunPrincipal.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ConsumesInfo.h"
+#include "FWCore/ServiceRegistry/interface/PathsAndConsumesOfModulesBase.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/Utilities/interface/InputType.h"
@@ -42,6 +47,21 @@ namespace edm {
           "The secondary file is not an ancestor of the primary file\n";
       }
     }
+    bool consumedBy(ConsumesInfo const& info, BranchDescription const& branch, ProductResolverIndexHelper const& lookup) {
+      if(info.branchType() != InEvent) return false;
+      if(info.kindOfType() == PRODUCT_TYPE) {
+        if(info.type() != branch.unwrappedTypeID()) return false;
+      } else {
+        // A View is consumed: the type must be the element type of the product, or one of its bases.
+        if(lookup.index(ELEMENT_TYPE, info.type(), branch.moduleLabel().c_str(), branch.productInstanceName().c_str(),
+                        branch.processName().c_str()) == ProductResolverIndexInvalid) return false;
+      }
+      // An empty label means consumesMany: every product of the type may be read.
+      if(info.label().empty()) return true;
+      if(info.label() != branch.moduleLabel()) return false;
+      if(info.instance() != branch.productInstanceName()) return false;
+      return info.process().empty() || info.process() == branch.processName();
+    }
     void checkConsistency(EventPrincipal const& primary, EventPrincipal const& secondary) {
       if(!isSameEvent(primary, secondary)) {
         throw Exception(errors::MismatchedInputFiles, "PoolSource::checkConsistency") <<
@@ -93,6 +113,10 @@ namespace edm {
     resourceSharedWithDelayedReaderPtr_ = std::make_unique<SharedResourcesAcquirer>(std::move(resources.first));
     mutexSharedWithDelayedReader_ = resources.second;
 
+    if(primaryFileSequence_->readAheadEntries() != 0U) {
+      desc.actReg_->watchPreBeginJob(this, &PoolSource::preBeginJob);
+    }
+
     if (secondaryCatalog_.empty() && pset.getUntrackedParameter<bool>("needSecondaryFileNames", false)) {
       throw Exception(errors::Configuration, "PoolSource") << "'secondaryFileNames' must be specified\n";
     }
@@ -148,6 +172,32 @@ namespace edm {
 
   PoolSource::~PoolSource() {}
 
+  void
+  PoolSource::preBeginJob(PathsAndConsumesOfModulesBase const& pathsAndConsumes, ProcessContext const&) {
+    // Collect the event products from the input that some module in the job declared it consumes.
+    // These are the branches which will be read for (nearly) every event, so they can be read ahead
+    // without waiting for the TTreeCache learning phase.
+    std::vector<BranchDescription const*> inputProducts;
+    for(auto const& product : productRegistry()->productList()) {
+      BranchDescription const& desc = product.second;
+      if(desc.branchType() == InEvent && desc.present() && !desc.produced()) {
+        inputProducts.push_back(&desc);
+      }
+    }
+    ProductResolverIndexHelper const& lookup = *productRegistry()->productLookup(InEvent);
+    std::set<BranchID> consumed;
+    for(auto const* module : pathsAndConsumes.allModules()) {
+      for(auto const& info : pathsAndConsumes.consumesInfo(module->id())) {
+        for(auto const* desc : inputProducts) {
+          if(consumedBy(info, *desc, lookup)) {
+            consumed.insert(desc->branchID());
+          }
+        }
+      }
+    }
+    primaryFileSequence_->setReadAheadBranches(consumed);
+  }
+
   void
   PoolSource::endJob() {
     if(secondaryFileSequence_) secondaryFileSequence_->endJob();
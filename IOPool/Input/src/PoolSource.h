@@ -28,6 +28,8 @@ namespace edm {
   class RootPrimaryFileSequence;
   class RootSecondaryFileSequence;
   class RunHelperBase;
+  class PathsAndConsumesOfModulesBase;
+  class ProcessContext;
 
   class PoolSource : public InputSource {
   public:
@@ -68,6 +70,8 @@ namespace edm {
     ProcessingController::ReverseState reverseState_() const override;
 
     std::pair<SharedResourcesAcquirer*,std::recursive_mutex*> resourceSharedWithDelayedReader_() override;
+
+    void preBeginJob(PathsAndConsumesOfModulesBase const& pathsAndConsumes, ProcessContext const& processContext);
     
     RootServiceChecker rootServiceChecker_;
     InputFileCatalog catalog_;
@@ -718,6 +718,21 @@ namespace edm {
     thinnedAssociationsHelper_->initAssociationsFromSecondary(associationsFromSecondary, *fileThinnedAssociationsHelper_);
   }
 
+  void
+  RootFile::setReadAheadBranches(std::set<BranchID> const& branchIDs, unsigned int readAheadEntries) {
+    std::vector<TBranch*> branches;
+    branches.reserve(branchIDs.size());
+    for(auto const& branchID : branchIDs) {
+      roottree::BranchInfo const* info = eventTree_.branches().find(branchID);
+      if(info != nullptr && info->productBranch_ != nullptr) {
+        branches.push_back(info->productBranch_);
+      }
+    }
+    if(!branches.empty()) {
+      eventTree_.setReadAheadBranches(branches, readAheadEntries);
+    }
+  }
+
   bool
   RootFile::skipThisEntry() {
     if(indexIntoFileIter_ == indexIntoFileEnd_) {
@@ -28,6 +28,7 @@ RootFile.h // used by ROOT input sources
 #include <array>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -214,6 +215,7 @@ namespace edm {
     IndexIntoFile::IndexIntoFileItr indexIntoFileIter() const;
     void setPosition(IndexIntoFile::IndexIntoFileItr const& position);
     void initAssociationsFromSecondary(std::vector<BranchID> const&);
+    void setReadAheadBranches(std::set<BranchID> const& branchIDs, unsigned int readAheadEntries);
 
     void setSignals(signalslot::Signal<void(StreamContext const&, ModuleCallingContext const&)> const* preEventReadSource,
                     signalslot::Signal<void(StreamContext const&, ModuleCallingContext const&)> const* postEventReadSource);
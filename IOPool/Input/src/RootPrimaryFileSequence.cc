@@ -17,6 +17,10 @@
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "Utilities/StorageFactory/interface/StorageFactory.h"
 
+#include "TTreeCacheUnzip.h"
+
+#include <mutex>
+
 namespace edm {
   RootPrimaryFileSequence::RootPrimaryFileSequence(
                 ParameterSet const& pset,
@@ -33,7 +37,10 @@ namespace edm {
     treeCacheSize_(noEventSort_ ? pset.getUntrackedParameter<unsigned int>("cacheSize") : 0U),
     duplicateChecker_(new DuplicateChecker(pset)),
     usingGoToEvent_(false),
-    enablePrefetching_(false) {
+    enablePrefetching_(false),
+    parallelUnzip_(pset.getUntrackedParameter<bool>("parallelUnzip")),
+    readAheadEntries_(pset.getUntrackedParameter<unsigned int>("readAheadEntries")),
+    readAheadBranchIDs_() {
 
     // The SiteLocalConfig controls the TTreeCache size and the prefetching settings.
     Service<SiteLocalConfig> pSLC;
@@ -44,6 +51,13 @@ namespace edm {
       enablePrefetching_ = pSLC->enablePrefetching();
     }
 
+    // The parallel unzip mode of ROOT is process-wide and is read whenever a TTreeCache is created,
+    // so it is switched on once, before any file is opened, and never switched back off.
+    if(parallelUnzip_) {
+      static std::once_flag enableParallelUnzip;
+      std::call_once(enableParallelUnzip, [] { TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable); });
+    }
+
     std::string branchesMustMatch = pset.getUntrackedParameter<std::string>("branchesMustMatch", std::string("permissive"));
     if(branchesMustMatch == std::string("strict")) branchesMustMatch_ = BranchDescription::Strict;
 
@@ -114,7 +128,7 @@ namespace edm {
   RootPrimaryFileSequence::RootFileSharedPtr
   RootPrimaryFileSequence::makeRootFile(std::shared_ptr<InputFile> filePtr) {
       size_t currentIndexIntoFile = sequenceNumberOfFile();
-      return std::make_shared<RootFile>(
+      auto rootFile = std::make_shared<RootFile>(
           fileName(),
           input_.processConfiguration(),
           logicalFileName(),
@@ -144,6 +158,18 @@ namespace edm {
           input_.labelRawDataLikeMC(),
           usingGoToEvent_,
           enablePrefetching_);
+      if(!readAheadBranchIDs_.empty()) {
+        rootFile->setReadAheadBranches(readAheadBranchIDs_, readAheadEntries_);
+      }
+      return rootFile;
+  }
+
+  void
+  RootPrimaryFileSequence::setReadAheadBranches(std::set<BranchID> const& branchIDs) {
+    readAheadBranchIDs_ = branchIDs;
+    if(rootFile() && !readAheadBranchIDs_.empty()) {
+      rootFile()->setReadAheadBranches(readAheadBranchIDs_, readAheadEntries_);
+    }
   }
 
   bool RootPrimaryFileSequence::nextFile() {
@@ -330,6 +356,16 @@ namespace edm {
                      "Note 3: Any sorting occurs independently in each input file (no sorting across input files).");
     desc.addUntracked<unsigned int>("cacheSize", roottree::defaultCacheSize)
         ->setComment("Size of ROOT TTree prefetch cache.  Affects performance.");
+    desc.addUntracked<bool>("parallelUnzip", false)
+        ->setComment("True:  Decompress the baskets held in the TTreeCaches concurrently, outside of the\n"
+                     "       source's serialized section, instead of on the stream which first reads the product.\n"
+                     "       This switches on ROOT's process-wide parallel unzip mode for the whole job.\n"
+                     "False: Each basket is decompressed when its product is read (default).");
+    desc.addUntracked<unsigned int>("readAheadEntries", 0U)
+        ->setComment("0:  Learn which event branches to cache from the first events read (default).\n"
+                     ">0: Cache exactly the event branches consumed by the modules in the job, and read their\n"
+                     "    baskets for the next 'readAheadEntries' events asynchronously, with ROOT's prefetching thread\n"
+                     "    (whatever the prefetching setting of the site is).  Affects performance only.");
     std::string defaultString("permissive");
     desc.addUntracked<std::string>("branchesMustMatch", defaultString)
         ->setComment("'strict':     Branches in each input file must match those in the first file.\n"
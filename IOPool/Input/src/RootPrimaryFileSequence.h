@@ -15,15 +15,16 @@ RootPrimaryFileSequence: This is an InputSource
 #include "FWCore/Sources/interface/EventSkipperByID.h"
 #include "FWCore/Utilities/interface/get_underlying_safe.h"
 #include "DataFormats/Provenance/interface/BranchDescription.h"
+#include "DataFormats/Provenance/interface/BranchID.h"
 #include "DataFormats/Provenance/interface/ProcessHistoryID.h"
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 namespace edm {
 
-  class BranchID;
   class DuplicateChecker;
   class FileCatalogItem;
   class InputFileCatalog;
@@ -48,6 +49,8 @@ namespace edm {
     bool skipEvents(int offset);
     bool goToEvent(EventID const& eventID);
     void rewind_();
+    void setReadAheadBranches(std::set<BranchID> const& branchIDs);
+    unsigned int readAheadEntries() const {return readAheadEntries_;}
     static void fillDescription(ParameterSetDescription & desc);
     ProcessingController::ForwardState forwardState() const;
     ProcessingController::ReverseState reverseState() const;
@@ -78,6 +81,9 @@ namespace edm {
     edm::propagate_const<std::shared_ptr<DuplicateChecker>> duplicateChecker_;
     bool usingGoToEvent_;
     bool enablePrefetching_;
+    bool parallelUnzip_;
+    unsigned int readAheadEntries_;
+    std::set<BranchID> readAheadBranchIDs_;
   }; // class RootPrimaryFileSequence
 }
 #endif
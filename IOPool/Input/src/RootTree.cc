@@ -1,5 +1,6 @@
 #include "RootTree.h"
 #include "RootDelayedReader.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "FWCore/Utilities/interface/Exception.h"
 #include "DataFormats/Provenance/interface/BranchDescription.h"
@@ -7,7 +8,9 @@
 #include "TTree.h"
 #include "TTreeIndex.h"
 #include "TTreeCache.h"
+#include "TTreeCacheUnzip.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -58,6 +61,8 @@ namespace edm {
     treeAutoFlush_(0),
     enablePrefetching_(enablePrefetching),
     enableTriggerCache_(branchType_ == InEvent),
+    readAheadBranches_(),
+    readAheadEntries_(0),
     rootDelayedReader_(new RootDelayedReader(*this, filePtr, inputType)),
     branchEntryInfoBranch_(metaTree_ ? getProductProvenanceBranch(metaTree_, branchType_) : (tree_ ? getProductProvenanceBranch(tree_, branchType_) : nullptr)),
     infoTree_(dynamic_cast<TTree*>(filePtr_.get() != nullptr ? filePtr->Get(BranchTypeToInfoTreeName(branchType).c_str()) : nullptr)) // backward compatibility
@@ -177,11 +182,20 @@ namespace edm {
   roottree::BranchMap const&
   RootTree::branches() const {return branches_;}
 
+  void
+  RootTree::createTreeCache(Long64_t cacheSize) {
+    tree_->SetCacheSize(cacheSize);
+    treeCache_.reset(dynamic_cast<TTreeCache*>(filePtr_->GetCacheRead()));
+    // ROOT silently falls back to a serial TTreeCache if the parallel unzip mode cannot be used.
+    if(branchType_ == InEvent && dynamic_cast<TTreeCacheUnzip*>(treeCache_.get()) != nullptr) {
+      LogInfo("RootTree") << "The baskets of the event tree are decompressed in parallel by a TTreeCacheUnzip";
+    }
+  }
+
   void
   RootTree::setCacheSize(unsigned int cacheSize) {
     cacheSize_ = cacheSize;
-    tree_->SetCacheSize(static_cast<Long64_t>(cacheSize));
-    treeCache_.reset(dynamic_cast<TTreeCache*>(filePtr_->GetCacheRead()));
+    createTreeCache(static_cast<Long64_t>(cacheSize));
     if(treeCache_) treeCache_->SetEnablePrefetching(enablePrefetching_);
     filePtr_->SetCacheRead(nullptr);
     rawTreeCache_.reset();
@@ -243,6 +257,11 @@ namespace edm {
     tree_->LoadTree(entryNumber_);
     filePtr_->SetCacheRead(nullptr);
     if(treeCache_ && trainNow_ && entryNumber_ >= 0) {
+      if(!readAheadBranches_.empty()) {
+        startReadAhead();
+        trainNow_ = false;
+        return;
+      }
       startTraining();
       trainNow_ = false;
       trainedSet_.clear();
@@ -445,6 +464,58 @@ namespace edm {
     rawTreeCache_.reset();
   }
 
+  void
+  RootTree::setReadAheadBranches(std::vector<TBranch*> const& branches, unsigned int readAheadEntries) {
+    assert(branchType_ == InEvent);
+    readAheadBranches_ = branches;
+    readAheadEntries_ = readAheadEntries;
+    trainNow_ = true;
+  }
+
+  void
+  RootTree::startReadAhead() {
+    if (cacheSize_ == 0) {
+      return;
+    }
+    assert(treeCache_);
+    // Size the cache so that it holds the compressed baskets of the read-ahead branches
+    // for the next readAheadEntries_ entries, but never shrink below the configured size.
+    Long64_t bytesPerEntry = 0;
+    for(auto branch : readAheadBranches_) {
+      bytesPerEntry += branch->GetZipBytes() / (entries_ + 1) + 1;
+    }
+    Long64_t cacheSize = std::max(static_cast<Long64_t>(cacheSize_), bytesPerEntry * readAheadEntries_);
+    createTreeCache(cacheSize);
+    assert(treeCache_);
+    rawTreeCache_.reset();
+    // The baskets for the next cluster(s) are fetched with a single vectored read by the ROOT
+    // prefetching thread while the current ones are being unpacked.  This is what the read-ahead
+    // was asked for, so it is done even if the site does not enable prefetching for the other caches.
+    treeCache_->SetEnablePrefetching(true);
+    treeCache_->SetLearnEntries(0);
+    treeCache_->StartLearningPhase();
+    treeCache_->SetEntryRange(entryNumber_, entries_);
+    if (filePtr_->Get(poolNames::branchListIndexesBranchName().c_str()) != nullptr) {
+      treeCache_->AddBranch(poolNames::branchListIndexesBranchName().c_str(), kTRUE);
+    }
+    treeCache_->AddBranch(BranchTypeToAuxiliaryBranchName(branchType_).c_str(), kTRUE);
+    trainedSet_.clear();
+    triggerSet_.clear();
+    rawTriggerSwitchOverEntry_ = -1;
+    LogInfo message("RootTree");
+    message << "Reading ahead " << readAheadEntries_ << " entries of the event branches:";
+    for(auto branch : readAheadBranches_) {
+      treeCache_->AddBranch(branch, kTRUE);
+      trainedSet_.insert(branch);
+      message << "\n  " << branch->GetName();
+    }
+    treeCache_->StopLearningPhase();
+    treeCache_->FillBuffer();
+    switchOverEntry_ = entryNumber_;
+    filePtr_->SetCacheRead(nullptr);
+    assert(treeCache_->GetTree() == tree_);
+  }
+
   void
   RootTree::close () {
     // The TFile is about to be closed, and destructed.
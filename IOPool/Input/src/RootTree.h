@@ -188,7 +188,9 @@ namespace edm {
     inline TTreeCache* selectCache(TBranch* branch, EntryNumber entryNumber) const;
     void trainCache(char const* branchNames);
     void resetTraining() {trainNow_ = true;}
-
+    // Replace the TTreeCache learning phase by a cache trained up front on the given
+    // branches, sized to hold readAheadEntries entries and filled asynchronously.
+    void setReadAheadBranches(std::vector<TBranch*> const& branches, unsigned int readAheadEntries);
     BranchType branchType() const {return branchType_;}
     
     void setSignals(signalslot::Signal<void(StreamContext const&, ModuleCallingContext const&)> const* preEventReadSource,
@@ -196,9 +198,11 @@ namespace edm {
 
   private:
     void setCacheSize(unsigned int cacheSize);
+    void createTreeCache(Long64_t cacheSize);
     void setTreeMaxVirtualSize(int treeMaxVirtualSize);
     void startTraining();
     void stopTraining();
+    void startReadAhead();
 
     std::shared_ptr<InputFile> filePtr_;
 // We use bare pointers for pointers to some ROOT entities.
@@ -233,6 +237,10 @@ namespace edm {
 // effect on the primary treeCache_; all other caches have this explicitly disabled.
     bool enablePrefetching_;
     bool enableTriggerCache_;
+// Branches known (from the consumes declarations of the job) to be read for every event.
+// When non-empty, the learning phase is skipped and these branches are read ahead.
+    std::vector<TBranch*> readAheadBranches_;
+    unsigned int readAheadEntries_;
     std::unique_ptr<RootDelayedReader> rootDelayedReader_;
 
     TBranch* branchEntryInfoBranch_; //backwards compatibility
@@ -0,0 +1,52 @@
+# Reads the file written by PrePoolInputTest_parallelUnzip_cfg.py with the
+# parallel unzip mode switched on (argument 1) or off (argument 0), and dumps
+# the Things read to <argument 2>_content.log and the kind of event tree cache
+# used to <argument 2>_mode.log, so that the two modes can be compared.
+# A single stream is used so that the events are dumped in the same order.
+
+import FWCore.ParameterSet.Config as cms
+from sys import argv
+from string import atoi
+
+parallelUnzip = bool(atoi(argv[2]))
+logName = argv[3]
+
+process = cms.Process("TESTRECO")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+process.load("FWCore.MessageService.MessageLogger_cfi")
+
+process.options = cms.untracked.PSet(numberOfThreads = cms.untracked.uint32(4), numberOfStreams = cms.untracked.uint32(1))
+
+process.MessageLogger.categories.extend(['EventContent', 'RootTree'])
+process.MessageLogger.destinations.extend([logName + '_content', logName + '_mode'])
+setattr(process.MessageLogger, logName + '_content', cms.untracked.PSet(
+    threshold = cms.untracked.string('INFO'),
+    noTimeStamps = cms.untracked.bool(True),
+    default = cms.untracked.PSet(limit = cms.untracked.int32(0)),
+    EventContent = cms.untracked.PSet(limit = cms.untracked.int32(10000000))
+))
+setattr(process.MessageLogger, logName + '_mode', cms.untracked.PSet(
+    threshold = cms.untracked.string('INFO'),
+    noTimeStamps = cms.untracked.bool(True),
+    default = cms.untracked.PSet(limit = cms.untracked.int32(0)),
+    RootTree = cms.untracked.PSet(limit = cms.untracked.int32(10000000))
+))
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(-1)
+)
+process.OtherThing = cms.EDProducer("OtherThingProducer")
+
+process.Analysis = cms.EDAnalyzer("OtherThingAnalyzer")
+
+process.Content = cms.EDAnalyzer("EventContentAnalyzer",
+    verboseForModuleLabels = cms.untracked.vstring('Thing'),
+    getDataForModuleLabels = cms.untracked.vstring('Thing')
+)
+
+process.source = cms.Source("PoolSource",
+    parallelUnzip = cms.untracked.bool(parallelUnzip),
+    fileNames = cms.untracked.vstring('file:PoolInputTest_parallelUnzip.root')
+)
+
+process.p = cms.Path(process.OtherThing*process.Analysis*process.Content)
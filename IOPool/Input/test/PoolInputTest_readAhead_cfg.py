@@ -0,0 +1,37 @@
+# Reads ahead the event branches consumed by the job, and writes the branches
+# read ahead to readAhead_branches.log so that the test can check them.
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTRECO")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+process.load("FWCore.MessageService.MessageLogger_cfi")
+
+process.MessageLogger.categories.append('RootTree')
+process.MessageLogger.destinations.append('readAhead_branches')
+process.MessageLogger.readAhead_branches = cms.untracked.PSet(
+    threshold = cms.untracked.string('INFO'),
+    noTimeStamps = cms.untracked.bool(True),
+    default = cms.untracked.PSet(limit = cms.untracked.int32(0)),
+    RootTree = cms.untracked.PSet(limit = cms.untracked.int32(10000000))
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(-1)
+)
+process.OtherThing = cms.EDProducer("OtherThingProducer")
+
+process.Analysis = cms.EDAnalyzer("OtherThingAnalyzer")
+
+process.View = cms.EDAnalyzer("TestFindProduct",
+    inputTags = cms.untracked.VInputTag(),
+    inputTagsView = cms.untracked.VInputTag(cms.InputTag("intvec")),
+    expectedSum = cms.untracked.int32(330)
+)
+
+process.source = cms.Source("PoolSource",
+    readAheadEntries = cms.untracked.uint32(10),
+    fileNames = cms.untracked.vstring('file:PoolInputTest_readAhead.root')
+)
+
+process.p = cms.Path(process.OtherThing*process.Analysis*process.View)
@@ -0,0 +1,30 @@
+# Writes the input of PoolInputTest_parallelUnzip_cfg.py: Things with values
+# which differ from event to event, in small baskets and clusters so that the
+# TTreeCache holds many baskets to decompress for each event.
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTPROD")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(200)
+)
+
+process.Thing = cms.EDProducer("ThingProducer",
+    offsetDelta = cms.int32(1),
+    nThings = cms.int32(50)
+)
+
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('PoolInputTest_parallelUnzip.root'),
+    basketSize = cms.untracked.int32(1024),
+    eventAutoFlushCompressedSize = cms.untracked.int32(4096)
+)
+
+process.source = cms.Source("EmptySource",
+    numberEventsInLuminosityBlock = cms.untracked.uint32(20)
+)
+
+process.p = cms.Path(process.Thing)
+process.ep = cms.EndPath(process.output)
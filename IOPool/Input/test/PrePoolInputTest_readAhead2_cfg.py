@@ -0,0 +1,19 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("READAHEAD2")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.intvec = cms.EDProducer("IntProducer",
+    ivalue = cms.int32(3)
+)
+
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('PoolInputTest_readAhead.root')
+)
+
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring('file:PoolInputTest_readAhead1.root')
+)
+
+process.p = cms.Path(process.intvec)
+process.ep = cms.EndPath(process.output)
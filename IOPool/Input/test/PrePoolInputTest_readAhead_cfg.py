@@ -0,0 +1,34 @@
+# Writes the input of PoolInputTest_readAhead_cfg.py, with the products which
+# are consumed by that job and some which are not.  The std::vector<int>
+# 'intvec' is read through a View<int>, the IntProduct 'intvec' added by
+# PrePoolInputTest_readAhead2_cfg.py has the same label and is not.
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("READAHEAD1")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(30)
+)
+
+process.Thing = cms.EDProducer("ThingProducer")
+
+process.intvec = cms.EDProducer("IntVectorProducer",
+    count = cms.int32(5),
+    ivalue = cms.int32(11),
+    delta = cms.int32(1)
+)
+
+process.ints = cms.EDProducer("IntProducer",
+    ivalue = cms.int32(7)
+)
+
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('PoolInputTest_readAhead1.root')
+)
+
+process.source = cms.Source("EmptySource")
+
+process.p = cms.Path(process.Thing*process.intvec*process.ints)
+process.ep = cms.EndPath(process.output)
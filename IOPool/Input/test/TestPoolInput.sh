@@ -11,6 +11,24 @@ cp PoolInputTest.root PoolInputOther.root
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolInputTest_cfg.py || die 'Failure using PoolInputTest_cfg.py' $?
 cmsRun  ${LOCAL_TEST_DIR}/PoolInputTest_noDelay_cfg.py >& ${LOCAL_TMP_DIR}/PoolInputTest_noDelay_cfg.txt || die 'Failure using PoolInputTest_noDelay_cfg.py' $?
 grep 'event delayed read from source' ${LOCAL_TMP_DIR}/PoolInputTest_noDelay_cfg.txt && die 'Failure in PoolInputTest_noDelay_cfg.py, found delay reads from source' 1
+cmsRun ${LOCAL_TEST_DIR}/PrePoolInputTest_readAhead_cfg.py || die 'Failure using PrePoolInputTest_readAhead_cfg.py' $?
+cmsRun ${LOCAL_TEST_DIR}/PrePoolInputTest_readAhead2_cfg.py || die 'Failure using PrePoolInputTest_readAhead2_cfg.py' $?
+cmsRun ${LOCAL_TEST_DIR}/PoolInputTest_readAhead_cfg.py || die 'Failure using PoolInputTest_readAhead_cfg.py' $?
+for branch in edmtestThings_Thing__READAHEAD1. ints_intvec__READAHEAD1.
+do
+  grep -q "^  ${branch}\$" readAhead_branches.log || die "The consumed branch ${branch} was not read ahead by PoolInputTest_readAhead_cfg.py" 1
+done
+for branch in edmtestIntProduct_ints__READAHEAD1. edmtestIntProduct_intvec__READAHEAD2.
+do
+  grep -q "^  ${branch}\$" readAhead_branches.log && die "The branch ${branch}, which is not consumed, was read ahead by PoolInputTest_readAhead_cfg.py" 1
+done
+cmsRun ${LOCAL_TEST_DIR}/PrePoolInputTest_parallelUnzip_cfg.py || die 'Failure using PrePoolInputTest_parallelUnzip_cfg.py' $?
+cmsRun ${LOCAL_TEST_DIR}/PoolInputTest_parallelUnzip_cfg.py 1 parallelUnzip || die 'Failure using PoolInputTest_parallelUnzip_cfg.py' $?
+grep -q 'decompressed in parallel by a TTreeCacheUnzip' parallelUnzip_mode.log || die 'The parallel unzip mode was not used by PoolInputTest_parallelUnzip_cfg.py' 1
+cmsRun ${LOCAL_TEST_DIR}/PoolInputTest_parallelUnzip_cfg.py 0 serialUnzip || die 'Failure using PoolInputTest_parallelUnzip_cfg.py without parallel unzip' $?
+grep -q 'decompressed in parallel by a TTreeCacheUnzip' serialUnzip_mode.log && die 'The parallel unzip mode was used by PoolInputTest_parallelUnzip_cfg.py without parallel unzip' 1
+grep -q 'Thing' parallelUnzip_content.log || die 'No Thing was dumped by PoolInputTest_parallelUnzip_cfg.py' 1
+diff serialUnzip_content.log parallelUnzip_content.log || die 'The products read with parallel unzip differ from the ones read with serial unzip' $?
 
 cmsRun ${LOCAL_TEST_DIR}/PrePool2FileInputTest_cfg.py || die 'Failure using PrePool2FileInputTest_cfg.py' $?
 cmsRun ${LOCAL_TEST_DIR}/Pool2FileInputTest_cfg.py || die 'Failure using Pool2FileInputTest_cfg.py' $?
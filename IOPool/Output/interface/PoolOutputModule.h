@@ -39,6 +39,7 @@ namespace edm {
   class PoolOutputModule : public one::OutputModule<WatchInputFiles> {
   public:
     enum DropMetaData { DropNone, DropDroppedPrior, DropPrior, DropAll };
+    static constexpr int useFileCompressionSettings = -1;
     explicit PoolOutputModule(ParameterSet const& ps);
     ~PoolOutputModule() override;
     PoolOutputModule(PoolOutputModule const&) = delete; // Disallow copying and moving
@@ -47,6 +48,7 @@ namespace edm {
     std::string const& logicalFileName() const {return logicalFileName_;}
     int const& compressionLevel() const {return compressionLevel_;}
     std::string const& compressionAlgorithm() const {return compressionAlgorithm_;}
+    int compressionSettings() const {return compressionSettings_;}
     int const& basketSize() const {return basketSize_;}
     int eventAutoFlushSize() const {return eventAutoFlushSize_;}
     int const& splitLevel() const {return splitLevel_;}
@@ -86,7 +88,8 @@ namespace edm {
 
       OutputItem();
 
-      explicit OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize);
+      explicit OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize,
+                          int compressionSettings = useFileCompressionSettings);
 
       ~OutputItem() {}
 
@@ -102,6 +105,7 @@ namespace edm {
       mutable void const* product_;
       int splitLevel_;
       int basketSize_;
+      int compressionSettings_;
     };
 
     typedef std::vector<OutputItem> OutputItemList;
@@ -119,6 +123,15 @@ namespace edm {
       std::regex branch_;
       int splitLevel_;
     };
+
+    struct SpecialCompressionForBranch {
+      SpecialCompressionForBranch(std::string const& iBranchName, int iCompressionSettings, int iBasketSize);
+      bool match(std::string const& iBranchName) const;
+
+      std::regex branch_;
+      int compressionSettings_;
+      int basketSize_;
+    };
     
     OutputItemListArray const& selectedOutputItemList() const {return selectedOutputItemList_;}
 
@@ -173,12 +186,14 @@ namespace edm {
     AuxItemArray auxItems_;
     OutputItemListArray selectedOutputItemList_;
     std::vector<SpecialSplitLevelForBranch> specialSplitLevelForBranches_;
+    std::vector<SpecialCompressionForBranch> specialCompressionForBranches_;
     std::string const fileName_;
     std::string const logicalFileName_;
     std::string const catalog_;
     unsigned int const maxFileSize_;
     int const compressionLevel_;
     std::string const compressionAlgorithm_;
+    int const compressionSettings_;
     int const basketSize_;
     int const eventAutoFlushSize_;
     int const splitLevel_;
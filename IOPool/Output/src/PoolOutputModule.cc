@@ -1,6 +1,7 @@
 #include "IOPool/Output/interface/PoolOutputModule.h"
 
 #include "IOPool/Output/src/RootOutputFile.h"
+#include "IOPool/Common/interface/getCompressionSettings.h"
 
 #include "FWCore/Framework/interface/ConstProductRegistry.h"
 #include "FWCore/Framework/interface/EventForOutput.h"
@@ -34,6 +35,15 @@
 
 
 namespace edm {
+  namespace {
+    std::regex globToRegex(std::string const& iGlobBranchExpression) {
+      std::string tmp(iGlobBranchExpression);
+      boost::replace_all(tmp, "*", ".*");
+      boost::replace_all(tmp, "?", ".");
+      return std::regex(tmp);
+    }
+  }
+
   PoolOutputModule::PoolOutputModule(ParameterSet const& pset) :
   edm::one::OutputModuleBase::OutputModuleBase(pset),
   one::OutputModule<WatchInputFiles>(pset),
@@ -46,6 +56,7 @@ namespace edm {
     maxFileSize_(pset.getUntrackedParameter<int>("maxSize")),
     compressionLevel_(pset.getUntrackedParameter<int>("compressionLevel")),
     compressionAlgorithm_(pset.getUntrackedParameter<std::string>("compressionAlgorithm")),
+    compressionSettings_(getCompressionSettings(compressionAlgorithm_, compressionLevel_)),
     basketSize_(pset.getUntrackedParameter<int>("basketSize")),
     eventAutoFlushSize_(pset.getUntrackedParameter<int>("eventAutoFlushCompressedSize")),
     splitLevel_(std::min<int>(pset.getUntrackedParameter<int>("splitLevel") + 1, 99)),
@@ -94,6 +105,16 @@ namespace edm {
       specialSplitLevelForBranches_.emplace_back(s.getUntrackedParameter<std::string>("branch"),
                                                  s.getUntrackedParameter<int>("splitLevel"));
     }
+
+    auto const& specialCompression {pset.getUntrackedParameterSetVector("overrideBranchesCompression")};
+
+    specialCompressionForBranches_.reserve(specialCompression.size());
+    for(auto const& s: specialCompression) {
+      specialCompressionForBranches_.emplace_back(s.getUntrackedParameter<std::string>("branch"),
+                                                  getCompressionSettings(s.getUntrackedParameter<std::string>("compressionAlgorithm"),
+                                                                         s.getUntrackedParameter<int>("compressionLevel")),
+                                                  s.getUntrackedParameter<int>("basketSize"));
+    }
       
     // We don't use this next parameter, but we read it anyway because it is part
     // of the configuration of this module.  An external parser creates the
@@ -123,14 +144,17 @@ namespace edm {
         token_(),
         product_(nullptr),
         splitLevel_(BranchDescription::invalidSplitLevel),
-        basketSize_(BranchDescription::invalidBasketSize) {}
+        basketSize_(BranchDescription::invalidBasketSize),
+        compressionSettings_(useFileCompressionSettings) {}
 
-  PoolOutputModule::OutputItem::OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize) :
+  PoolOutputModule::OutputItem::OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize,
+                                           int compressionSettings) :
         branchDescription_(bd),
         token_(token),
         product_(nullptr),
         splitLevel_(splitLevel),
-        basketSize_(basketSize) {}
+        basketSize_(basketSize),
+        compressionSettings_(compressionSettings) {}
 
 
   PoolOutputModule::OutputItem::Sorter::Sorter(TTree* tree) : treeMap_(new std::map<std::string, int>) {
@@ -170,10 +194,18 @@ namespace edm {
   }
 
   std::regex PoolOutputModule::SpecialSplitLevelForBranch::convert( std::string const& iGlobBranchExpression) const {
-    std::string tmp(iGlobBranchExpression);
-    boost::replace_all(tmp, "*", ".*");
-    boost::replace_all(tmp, "?", ".");
-    return std::regex(tmp);
+    return globToRegex(iGlobBranchExpression);
+  }
+
+  PoolOutputModule::SpecialCompressionForBranch::SpecialCompressionForBranch(std::string const& iBranchName,
+                                                                             int iCompressionSettings,
+                                                                             int iBasketSize) :
+    branch_(globToRegex(iBranchName)),
+    compressionSettings_(iCompressionSettings),
+    basketSize_(iBasketSize) {}
+
+  inline bool PoolOutputModule::SpecialCompressionForBranch::match(std::string const& iBranchName) const {
+    return std::regex_match(iBranchName, branch_);
   }
   
   void PoolOutputModule::fillSelectedItemList(BranchType branchType, TTree* theInputTree) {
@@ -214,7 +246,18 @@ namespace edm {
         }
         basketSize = (prod.basketSize() == BranchDescription::invalidBasketSize ? basketSize_ : prod.basketSize());
       }
-      outputItemList.emplace_back(&prod, kept.second, splitLevel, basketSize);
+      // Per branch compression settings apply even if the layout is taken from the input file.
+      // The last matching entry wins.
+      int compressionSettings = useFileCompressionSettings;
+      for(auto const& c: specialCompressionForBranches_) {
+        if(c.match(prod.branchName())) {
+          compressionSettings = c.compressionSettings_;
+          if(c.basketSize_ > 0) {
+            basketSize = c.basketSize_;
+          }
+        }
+      }
+      outputItemList.emplace_back(&prod, kept.second, splitLevel, basketSize, compressionSettings);
     }
 
     // Sort outputItemList to allow fast copying.
@@ -446,7 +489,7 @@ namespace edm {
     desc.addUntracked<int>("compressionLevel", 9)
         ->setComment("ROOT compression level of output file.");
     desc.addUntracked<std::string>("compressionAlgorithm", "ZLIB")
-        ->setComment("Algorithm used to compress data in the ROOT output file, allowed values are ZLIB and LZMA");
+        ->setComment("Algorithm used to compress data in the ROOT output file, allowed values are ZLIB, LZMA, LZ4 and (depending on the ROOT version) ZSTD");
     desc.addUntracked<int>("basketSize", 16384)
         ->setComment("Default ROOT basket size in output file.");
     desc.addUntracked<int>("eventAutoFlushCompressedSize",20*1024*1024)
@@ -484,6 +527,16 @@ namespace edm {
       specialSplit.addUntracked<int>("splitLevel")->setComment("The special split level for the branch");
       desc.addVPSetUntracked("overrideBranchesSplitLevel",specialSplit, std::vector<ParameterSet>());
     }
+    {
+      ParameterSetDescription specialCompression;
+      specialCompression.addUntracked<std::string>("branch")->setComment("Name of branch needing special compression settings. The name can contain wildcards '*' and '?'. If several entries match a branch, the last one is used.");
+      specialCompression.addUntracked<std::string>("compressionAlgorithm")->setComment("Compression algorithm for the branch, same values as 'compressionAlgorithm'");
+      specialCompression.addUntracked<int>("compressionLevel")->setComment("Compression level for the branch");
+      specialCompression.addUntracked<int>("basketSize", 0)->setComment("Basket size for the branch. 0 means use the size otherwise chosen for the branch.");
+      desc.addVPSetUntracked("overrideBranchesCompression",specialCompression, std::vector<ParameterSet>())
+        ->setComment("Allows frequently read branches to use a fast to decompress algorithm while the rest of the file favours size.\n"
+                     "Branches with overridden settings are not fast cloned if the input file used different settings.");
+    }
     OutputModule::fillDescription(desc);
   }
 
@@ -115,14 +115,8 @@ namespace edm {
       parentageIDs_(),
       branchesWithStoredHistory_(),
       wrapperBaseTClass_(TClass::GetClass("edm::WrapperBase")) {
-    if (om_->compressionAlgorithm() == std::string("ZLIB")) {
-      filePtr_->SetCompressionAlgorithm(ROOT::kZLIB);
-    } else if (om_->compressionAlgorithm() == std::string("LZMA")) {
-      filePtr_->SetCompressionAlgorithm(ROOT::kLZMA);
-    } else {
-      throw Exception(errors::Configuration) << "PoolOutputModule configured with unknown compression algorithm '" << om_->compressionAlgorithm() << "'\n"
-					     << "Allowed compression algorithms are ZLIB and LZMA\n";
-    }
+    // The algorithm name was validated when the module was constructed.
+    filePtr_->SetCompressionSettings(om_->compressionSettings());
     if (-1 != om->eventAutoFlushSize()) {
       eventTree_.setAutoFlush(-1*om->eventAutoFlushSize());
     }
@@ -156,6 +150,7 @@ namespace edm {
                            item.product_,
                            item.splitLevel_,
                            item.basketSize_,
+                           item.compressionSettings_,
                            item.branchDescription_->produced());
         //make sure we always store product registry info for all branches we create
         branchesWithStoredHistory_.insert(item.branchID());
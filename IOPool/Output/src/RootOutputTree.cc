@@ -1,6 +1,8 @@
 
 #include "RootOutputTree.h"
 
+#include "IOPool/Output/interface/PoolOutputModule.h"
+
 #include "DataFormats/Common/interface/RefCoreStreamer.h"
 #include "DataFormats/Provenance/interface/BranchDescription.h"
 #include "FWCore/MessageLogger/interface/JobReport.h"
@@ -140,6 +142,11 @@ namespace edm {
               inputBranch->GetBasketSize() != outputBranch->GetBasketSize()) {
             return false;
           }
+          // Fast cloning copies the compressed baskets, so explicitly requested settings must match too.
+          if(branchesWithOwnCompression_.find(outputBranch) != branchesWithOwnCompression_.end() &&
+              inputBranch->GetCompressionSettings() != outputBranch->GetCompressionSettings()) {
+            return false;
+          }
         }
       }
     }
@@ -316,11 +323,17 @@ namespace edm {
   void
   RootOutputTree::fillTree() {
     if(currentlyFastCloning_) {
+      // The branches are filled one at a time, so their baskets are compressed serially.
+      // ROOT only accumulates the tree's byte counts safely from concurrent compression
+      // tasks inside TTree::Fill, which cannot be used here as it would also fill the
+      // fast cloned branches and advance the entry count and auto flush of the tree.
       if(!fastCloneAuxBranches_)fillTTree(auxBranches_);
       fillTTree(unclonedAuxBranches_);
       fillTTree(producedBranches_);
       fillTTree(unclonedReadBranches_);
     } else {
+      // With implicit multi-threading enabled, TTree::Fill compresses the baskets of
+      // different branches concurrently.
       // Isolate the fill operation so that IMT doesn't grab other large tasks
       // that could lead to PoolOutputModule stalling
       tbb::this_task_arena::isolate( [&]{ tree_->Fill(); } );
@@ -333,6 +346,7 @@ namespace edm {
                             void const*& pProd,
                             int splitLevel,
                             int basketSize,
+                            int compressionSettings,
                             bool produced) {
       assert(splitLevel != BranchDescription::invalidSplitLevel);
       assert(basketSize != BranchDescription::invalidBasketSize);
@@ -342,6 +356,10 @@ namespace edm {
                  basketSize,
                  splitLevel);
       assert(branch != nullptr);
+      if(compressionSettings != PoolOutputModule::useFileCompressionSettings) {
+        branch->SetCompressionSettings(compressionSettings);
+        branchesWithOwnCompression_.insert(branch);
+      }
 /*
       if(pProd != nullptr) {
         // Delete the product that ROOT has allocated.
@@ -366,6 +384,7 @@ namespace edm {
     producedBranches_.clear();
     readBranches_.clear();
     unclonedReadBranches_.clear();
+    branchesWithOwnCompression_.clear();
     tree_ = nullptr; // propagate_const<T> has no reset() function
     filePtr_ = nullptr; // propagate_const<T> has no reset() function
   }
@@ -68,6 +68,7 @@ namespace edm {
                    void const*& pProd,
                    int splitLevel,
                    int basketSize,
+                   int compressionSettings,
                    bool produced);
 
     bool checkSplitLevelsAndBasketSizes(TTree* inputTree) const;
@@ -123,6 +124,7 @@ namespace edm {
     std::vector<TBranch*> unclonedReadBranches_;
 
     std::set<std::string> clonedReadBranchNames_;
+    std::set<TBranch const*> branchesWithOwnCompression_;
     bool currentlyFastCloning_;
     bool fastCloneAuxBranches_;
   };
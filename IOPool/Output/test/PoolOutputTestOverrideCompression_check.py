@@ -0,0 +1,48 @@
+from __future__ import print_function
+import ROOT as R
+import fnmatch
+import sys
+
+# Checks the compression settings of the event branches written by
+# PoolOutputTestOverrideCompression_cfg.py: LZ4 level 4 for the branches
+# matching the override, and the file's LZMA level 4 for the others.
+# ROOT encodes the settings as 100*algorithm+level (kLZMA=2, kLZ4=4).
+
+overridden = 'edmtestThings_Thing_*'
+expectedOverridden = 100*4 + 4
+expectedDefault = 100*2 + 4
+
+f = R.TFile.Open("PoolOutputTestOverrideCompression.root")
+events = f.Get("Events")
+
+def subBranches(branch):
+    yield branch
+    for sub in branch.GetListOfBranches():
+        for b in subBranches(sub):
+            yield b
+
+failures = 0
+nOverridden = 0
+nDefault = 0
+for branch in events.GetListOfBranches():
+    name = branch.GetName()
+    if fnmatch.fnmatch(name, overridden):
+        expected = expectedOverridden
+        nOverridden += 1
+    elif name.startswith('edmtest'):
+        expected = expectedDefault
+        nDefault += 1
+    else:
+        continue
+    for b in subBranches(branch):
+        if b.GetCompressionSettings() != expected:
+            print("branch %s: compression settings %d instead of %d" % (b.GetName(), b.GetCompressionSettings(), expected))
+            failures += 1
+
+if nOverridden == 0 or nDefault == 0:
+    print("no branch to check (%d overridden, %d with the file settings)" % (nOverridden, nDefault))
+    failures += 1
+
+if failures:
+    sys.exit(1)
+print("the compression settings of the %d overridden and %d other product branches are as configured" % (nOverridden, nDefault))
@@ -6,6 +6,10 @@ pushd ${LOCAL_TMP_DIR}
 
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolOutputTest_cfg.py || die 'Failure using PoolOutputTest_cfg.py' $?
 
+cmsRun ${LOCAL_TEST_DIR}/PoolOutputTestOverrideCompression_cfg.py || die 'Failure using PoolOutputTestOverrideCompression_cfg.py' $?
+python ${LOCAL_TEST_DIR}/PoolOutputTestOverrideCompression_check.py || die 'Failure using PoolOutputTestOverrideCompression_check.py' $?
+edmCompressionBenchmark -e 10 -b 'edmtestThings_Thing_*' -c ZLIB:9 LZ4:4 PoolOutputTestOverrideCompression.root || die 'Failure using edmCompressionBenchmark' $?
+
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolDropTest_cfg.py || die 'Failure using PoolDropTest_cfg.py' $?
 
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolMissingTest_cfg.py || die 'Failure using PoolMissingTest_cfg.py' $?
@@ -0,0 +1,85 @@
+#ifndef IOPool_SoATable_SoATableFileFormat_h
+#define IOPool_SoATable_SoATableFileFormat_h
+
+/*----------------------------------------------------------------------
+
+SoATableFileFormat.h
+
+Layout of the flat files written by SoATableOutputModule.  Each
+edm::soa::Table product of each event is stored as one contiguous array
+per column, so a reader can map the file and use the columns in place.
+
+  magic 8 | column arrays var | catalog var | index var | trailer
+
+column arrays: each array starts at a multiple of columnAlignment bytes
+               from the start of the file
+catalog:       product count 4 | product var (repeated)
+product:       branch name str | class name str | module label str |
+               product instance name str | process name str |
+               column count 4 | (column label str | column type str | element size 4) (repeated)
+str:           length 4 | characters var
+index:         EventRecord (event count + 1, the last one closes the table range) |
+               TableRecord (table count) | column offset 8 (column entry count)
+trailer:       Trailer
+
+Numbers are stored in the byte order of the machine which wrote the file.
+Only columns of arithmetic types are stored.
+
+----------------------------------------------------------------------*/
+
+#include <cstdint>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace edm {
+  namespace soatable {
+    constexpr char fileMagic[8] = {'E', 'D', 'M', 'S', 'O', 'A', '0', '1'};
+    constexpr uint64_t columnAlignment = 64;
+
+    struct EventRecord {
+      uint32_t run_;
+      uint32_t luminosityBlock_;
+      uint64_t event_;
+      uint64_t time_;
+      uint64_t firstTable_; // tables of this event are [firstTable_, next event's firstTable_)
+    };
+
+    struct TableRecord {
+      uint32_t product_;     // index in the catalog
+      uint32_t rows_;
+      uint64_t firstColumn_; // index of the offset of the first column
+    };
+
+    struct Trailer {
+      uint64_t catalogOffset_;
+      uint64_t indexOffset_;
+      uint64_t events_;
+      uint64_t tables_;
+      uint64_t columnEntries_;
+      char magic_[8];
+    };
+
+    struct ColumnEntry {
+      std::string label_;
+      std::string typeName_;
+      uint32_t elementSize_;
+    };
+
+    struct ProductEntry {
+      std::string branchName_;
+      std::string className_;
+      std::string moduleLabel_;
+      std::string productInstanceName_;
+      std::string processName_;
+      std::vector<ColumnEntry> columns_;
+    };
+
+    // Name and size of the column types which can be stored.
+    // Returns nullptr for the others.
+    char const* columnTypeName(std::type_index const& type);
+    uint32_t columnTypeSize(std::type_index const& type);
+  }
+}
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef IOPool_SoATable_SoATableFileReader_h
+#define IOPool_SoATable_SoATableFileReader_h
+
+/*----------------------------------------------------------------------
+
+SoATableFileReader: maps a file written by SoATableOutputModule (see
+SoATableFileFormat.h) and gives access to the stored columns in place,
+without any deserialization.  Only the pages of the columns actually
+used are read from disk.
+
+  edm::SoATableFileReader reader("tables.soa");
+  unsigned int product = reader.productIndex("edmtestTableTest_table__TEST.");
+  for(size_t i = 0; i != reader.numberOfEvents(); ++i) {
+    auto view = reader.view<edmtest::AnInt, edmtest::AFloat>(i, product);
+    for(auto const& row : view) { ... }
+  }
+
+----------------------------------------------------------------------*/
+
+#include "IOPool/SoATable/interface/SoATableFileFormat.h"
+#include "FWCore/SOA/interface/TableView.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace edm {
+  class SoATableFileReader {
+  public:
+    explicit SoATableFileReader(std::string const& fileName);
+    ~SoATableFileReader();
+
+    SoATableFileReader(SoATableFileReader const&) = delete; // Disallow copying and moving
+    SoATableFileReader& operator=(SoATableFileReader const&) = delete; // Disallow copying and moving
+
+    std::vector<soatable::ProductEntry> const& products() const {return products_;}
+    // Returns products().size() if no product has this branch name.
+    unsigned int productIndex(std::string const& branchName) const;
+
+    size_t numberOfEvents() const {return trailer_.events_;}
+    soatable::EventRecord const& event(size_t iEvent) const {return events_[iEvent];}
+
+    // Returns nullptr if the product is not stored for this event.
+    soatable::TableRecord const* table(size_t iEvent, unsigned int iProduct) const;
+    void const* column(soatable::TableRecord const& table, unsigned int iColumn) const {
+      return start_ + columnOffsets_[table.firstColumn_ + iColumn];
+    }
+    // Index of the column with this label, or the number of columns if there is none.
+    unsigned int columnIndex(unsigned int iProduct, char const* label) const;
+
+    // A view of the columns Args of a product, pointing into the mapped file.
+    // An empty view is returned if the product is not stored for this event.
+    template <typename... Args>
+    soa::TableView<Args...> view(size_t iEvent, unsigned int iProduct) const {
+      std::array<void const*, sizeof...(Args)> columns = {{nullptr}};
+      soatable::TableRecord const* record = table(iEvent, iProduct);
+      if(record == nullptr) {
+        return soa::TableView<Args...>(0, columns);
+      }
+      unsigned int i = 0;
+      ((columns[i++] = columnAddress(*record, Args::label(), sizeof(typename Args::type))), ...);
+      return soa::TableView<Args...>(record->rows_, columns);
+    }
+
+  private:
+    // Throws if the product has no column with this label and element size.
+    void const* columnAddress(soatable::TableRecord const& table, char const* label, uint32_t elementSize) const;
+
+    std::string fileName_;
+    char const* start_;
+    uint64_t size_;
+    soatable::Trailer trailer_;
+    std::vector<soatable::ProductEntry> products_;
+    soatable::EventRecord const* events_;
+    soatable::TableRecord const* tables_;
+    uint64_t const* columnOffsets_;
+  };
+}
+
+#endif
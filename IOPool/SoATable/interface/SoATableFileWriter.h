@@ -0,0 +1,53 @@
+#ifndef IOPool_SoATable_SoATableFileWriter_h
+#define IOPool_SoATable_SoATableFileWriter_h
+
+/*----------------------------------------------------------------------
+
+SoATableFileWriter: writes edm::soa::Table columns to a flat file
+(see SoATableFileFormat.h).  Not thread safe.
+
+----------------------------------------------------------------------*/
+
+#include "IOPool/SoATable/interface/SoATableFileFormat.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace edm {
+  class SoATableFileWriter {
+  public:
+    explicit SoATableFileWriter(std::string const& fileName);
+    ~SoATableFileWriter();
+
+    SoATableFileWriter(SoATableFileWriter const&) = delete; // Disallow copying and moving
+    SoATableFileWriter& operator=(SoATableFileWriter const&) = delete; // Disallow copying and moving
+
+    // Returns the index of the product in the catalog.
+    unsigned int addProduct(soatable::ProductEntry const& product);
+    std::vector<soatable::ProductEntry> const& products() const {return products_;}
+
+    void beginEvent(uint32_t run, uint32_t luminosityBlock, uint64_t event, uint64_t time);
+    // columns are given in the order of the catalog entry of the product
+    void writeTable(unsigned int product, uint32_t rows, std::vector<void const*> const& columns);
+    // Writes the catalog and the index.  Called by the destructor if needed.
+    void close();
+
+    std::string const& fileName() const {return fileName_;}
+
+  private:
+    void write(void const* data, uint64_t size);
+    void writeString(std::string const& value);
+    void align(uint64_t alignment);
+
+    std::string fileName_;
+    FILE* file_;
+    uint64_t position_;
+    std::vector<soatable::ProductEntry> products_;
+    std::vector<soatable::EventRecord> events_;
+    std::vector<soatable::TableRecord> tables_;
+    std::vector<uint64_t> columnOffsets_;
+  };
+}
+
+#endif
@@ -0,0 +1,136 @@
+// -*- C++ -*-
+//
+// Package:     IOPool/SoATable
+// Class  :     SoATableOutputModule
+//
+/**\class SoATableOutputModule
+
+ Description: Writes the edm::soa::Table products of each event to a flat
+ file of column arrays (see IOPool/SoATable/interface/SoATableFileFormat.h).
+
+ Usage:
+    The kept products which are not edm::soa::Tables are ignored, as are
+ the columns which are not of an arithmetic type.  The files can be read
+ back with SoATableSource, or used in place with edm::SoATableFileReader.
+
+*/
+
+#include "DataFormats/Common/interface/WrapperBase.h"
+#include "DataFormats/Provenance/interface/BranchDescription.h"
+#include "FWCore/Framework/interface/EventForOutput.h"
+#include "FWCore/Framework/interface/LuminosityBlockForOutput.h"
+#include "FWCore/Framework/interface/RunForOutput.h"
+#include "FWCore/Framework/interface/one/OutputModule.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/SOA/interface/TableExaminerBase.h"
+#include "IOPool/SoATable/interface/SoATableFileWriter.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace edm {
+  class SoATableOutputModule : public one::OutputModule<> {
+  public:
+    explicit SoATableOutputModule(ParameterSet const& pset);
+    ~SoATableOutputModule() override;
+
+    static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+  private:
+    struct StoredProduct {
+      unsigned int index_;                       // in the catalog of the file
+      std::vector<unsigned int> examinerColumns_; // examiner column of each stored column
+    };
+
+    void write(EventForOutput const& e) override;
+    void writeLuminosityBlock(LuminosityBlockForOutput const&) override {}
+    void writeRun(RunForOutput const&) override {}
+    void endJob() override;
+
+    StoredProduct const& storedProduct(BranchDescription const& branchDescription, soa::TableExaminerBase const& examiner);
+
+    std::unique_ptr<SoATableFileWriter> writer_;
+    std::map<BranchID, StoredProduct> storedProducts_;
+  };
+
+  SoATableOutputModule::SoATableOutputModule(ParameterSet const& pset) :
+    one::OutputModuleBase(pset),
+    one::OutputModule<>(pset),
+    writer_(std::make_unique<SoATableFileWriter>(pset.getUntrackedParameter<std::string>("fileName"))),
+    storedProducts_() {
+  }
+
+  SoATableOutputModule::~SoATableOutputModule() {}
+
+  void
+  SoATableOutputModule::write(EventForOutput const& e) {
+    std::vector<void const*> columns;
+    writer_->beginEvent(e.run(), e.luminosityBlock(), e.id().event(), e.time().value());
+    for(auto const& product : keptProducts()[InEvent]) {
+      BranchDescription const* branchDescription = product.first;
+      BasicHandle bh;
+      e.getByToken(product.second, branchDescription->unwrappedTypeID(), bh);
+      if(!bh.isValid()) continue;
+      auto examiner = bh.wrapper()->tableExaminer();
+      if(!examiner) continue;
+
+      StoredProduct const& stored = storedProduct(*branchDescription, *examiner);
+      columns.clear();
+      for(unsigned int column : stored.examinerColumns_) {
+        columns.push_back(examiner->columnAddress(column));
+      }
+      writer_->writeTable(stored.index_, examiner->size(), columns);
+    }
+  }
+
+  SoATableOutputModule::StoredProduct const&
+  SoATableOutputModule::storedProduct(BranchDescription const& branchDescription, soa::TableExaminerBase const& examiner) {
+    auto it = storedProducts_.find(branchDescription.branchID());
+    if(it != storedProducts_.end()) return it->second;
+
+    soatable::ProductEntry entry;
+    entry.branchName_ = branchDescription.branchName();
+    entry.className_ = branchDescription.className();
+    entry.moduleLabel_ = branchDescription.moduleLabel();
+    entry.productInstanceName_ = branchDescription.productInstanceName();
+    entry.processName_ = branchDescription.processName();
+    StoredProduct stored;
+    auto const descriptions = examiner.columnDescriptions();
+    for(unsigned int i = 0; i != descriptions.size(); ++i) {
+      char const* typeName = soatable::columnTypeName(descriptions[i].second);
+      if(typeName == nullptr) {
+        LogWarning("SoATableOutputModule")
+          << "Column '" << descriptions[i].first << "' of " << entry.branchName_
+          << " is not of an arithmetic type and will not be written to " << writer_->fileName();
+        continue;
+      }
+      entry.columns_.push_back(soatable::ColumnEntry{descriptions[i].first, typeName, soatable::columnTypeSize(descriptions[i].second)});
+      stored.examinerColumns_.push_back(i);
+    }
+    stored.index_ = writer_->addProduct(entry);
+    return storedProducts_.emplace(branchDescription.branchID(), std::move(stored)).first->second;
+  }
+
+  void
+  SoATableOutputModule::endJob() {
+    writer_->close();
+  }
+
+  void
+  SoATableOutputModule::fillDescriptions(ConfigurationDescriptions& descriptions) {
+    ParameterSetDescription desc;
+    desc.setComment("Writes the edm::soa::Table products of each event as flat column arrays.");
+    desc.addUntracked<std::string>("fileName")
+      ->setComment("Name of the output file.");
+    OutputModule::fillDescription(desc);
+    descriptions.add("soaTableOutput", desc);
+  }
+}
+
+using edm::SoATableOutputModule;
+DEFINE_FWK_MODULE(SoATableOutputModule);
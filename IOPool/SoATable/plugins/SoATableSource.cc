@@ -0,0 +1,277 @@
+// -*- C++ -*-
+//
+// Package:     IOPool/SoATable
+// Class  :     SoATableSource
+//
+/**\class SoATableSource
+
+ Description: Reads the files written by SoATableOutputModule back into
+ edm::soa::Table products.
+
+ Usage:
+    The products are registered from the catalog of the first file; all
+ the files must hold the same products.  Columns which were not stored
+ (those not of an arithmetic type) are left default constructed.
+    Since an edm::soa::Table owns its column arrays, each stored column is
+ copied once from the mapped file into the product.  Code which only
+ needs to look at the columns should use edm::SoATableFileReader, which
+ gives edm::soa::TableViews pointing directly into the file.
+
+*/
+
+#include "DataFormats/Common/interface/WrapperBase.h"
+#include "DataFormats/Provenance/interface/BranchDescription.h"
+#include "DataFormats/Provenance/interface/EventAuxiliary.h"
+#include "DataFormats/Provenance/interface/LuminosityBlockAuxiliary.h"
+#include "DataFormats/Provenance/interface/ProcessHistory.h"
+#include "DataFormats/Provenance/interface/ProcessHistoryRegistry.h"
+#include "DataFormats/Provenance/interface/ProductProvenance.h"
+#include "DataFormats/Provenance/interface/ProductRegistry.h"
+#include "DataFormats/Provenance/interface/RunAuxiliary.h"
+#include "DataFormats/Provenance/interface/Timestamp.h"
+#include "FWCore/Framework/interface/EventPrincipal.h"
+#include "FWCore/Framework/interface/InputSourceMacros.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/SOA/interface/TableExaminerBase.h"
+#include "FWCore/Sources/interface/RawInputSource.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+#include "FWCore/Utilities/interface/FriendlyName.h"
+#include "FWCore/Utilities/interface/FunctionWithDict.h"
+#include "FWCore/Utilities/interface/GetPassID.h"
+#include "FWCore/Utilities/interface/MemberWithDict.h"
+#include "FWCore/Utilities/interface/ObjectWithDict.h"
+#include "FWCore/Utilities/interface/TypeWithDict.h"
+#include "FWCore/Version/interface/GetReleaseVersion.h"
+#include "IOPool/Common/interface/getWrapperBasePtr.h"
+#include "IOPool/SoATable/interface/SoATableFileReader.h"
+
+#include "TClass.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace edm {
+  class SoATableSource : public RawInputSource {
+  public:
+    SoATableSource(ParameterSet const& pset, InputSourceDescription const& desc);
+    ~SoATableSource() override;
+
+    static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+  private:
+    // How to build the product of one catalog entry.
+    struct ProductInfo {
+      BranchDescription branchDescription_;
+      ProductProvenance provenance_;
+      TClass* wrapperClass_;
+      int offsetToWrapperBase_;
+      size_t offsetToPresent_;
+      size_t offsetToTable_;
+      TypeWithDict tableType_;
+      FunctionWithDict resize_;
+    };
+
+    bool checkNextEvent() override;
+    void read(EventPrincipal& eventPrincipal) override;
+
+    bool openNextFile();
+    void registerProducts(SoATableFileReader const& reader);
+    void fillTable(ProductInfo const& info, soatable::TableRecord const& table, void* wrapper, WrapperBase const& base) const;
+
+    std::vector<std::string> fileNames_;
+    size_t nextFile_;
+    std::unique_ptr<SoATableFileReader> reader_;
+    size_t nextEvent_;
+    size_t currentEvent_;
+    std::vector<ProductInfo> products_;
+    std::vector<unsigned int> fileToProduct_; // catalog index of the current file -> products_
+    ProcessHistoryID processHistoryID_;
+  };
+
+  SoATableSource::SoATableSource(ParameterSet const& pset, InputSourceDescription const& desc) :
+    RawInputSource(pset, desc),
+    fileNames_(pset.getUntrackedParameter<std::vector<std::string>>("fileNames")),
+    nextFile_(0),
+    reader_(),
+    nextEvent_(0),
+    currentEvent_(0),
+    products_(),
+    fileToProduct_(),
+    processHistoryID_() {
+    if(fileNames_.empty()) {
+      throw Exception(errors::Configuration) << "SoATableSource: no input file was given\n";
+    }
+    openNextFile();
+    registerProducts(*reader_);
+  }
+
+  SoATableSource::~SoATableSource() {}
+
+  void
+  SoATableSource::registerProducts(SoATableFileReader const& reader) {
+    ProductRegistry& productRegistry = productRegistryUpdate();
+    TClass* wrapperBaseClass = TClass::GetClass("edm::WrapperBase");
+    ProcessHistory ph;
+    for(auto const& entry : reader.products()) {
+      TypeWithDict type = TypeWithDict::byName(entry.className_);
+      if(!bool(type)) {
+        throw Exception(errors::DictionaryNotFound)
+          << "SoATableSource: no dictionary for class " << entry.className_ << " stored in " << fileNames_[0] << "\n";
+      }
+      BranchDescription branchDescription(InEvent,
+                                          entry.moduleLabel_,
+                                          entry.processName_,
+                                          entry.className_,
+                                          friendlyname::friendlyName(entry.className_),
+                                          entry.productInstanceName_,
+                                          "SoATableSource",
+                                          ParameterSetID(),
+                                          type,
+                                          false);
+      productRegistry.copyProduct(branchDescription);
+
+      TClass* wrapperClass = TClass::GetClass(branchDescription.wrappedName().c_str());
+      TypeWithDict wrapperType(wrapperClass);
+      ProductInfo info{branchDescription,
+                       ProductProvenance(branchDescription.branchID()),
+                       wrapperClass,
+                       wrapperClass->GetBaseClassOffset(wrapperBaseClass),
+                       wrapperType.dataMemberByName("present").offset(),
+                       wrapperType.dataMemberByName("obj").offset(),
+                       type,
+                       type.functionMemberByName("resize")};
+      if(!bool(info.resize_)) {
+        throw Exception(errors::DictionaryNotFound)
+          << "SoATableSource: class " << entry.className_ << " has no resize function in its dictionary\n";
+      }
+      products_.push_back(std::move(info));
+
+      bool known = false;
+      for(auto const& pc : ph) {
+        if(pc.processName() == entry.processName_) known = true;
+      }
+      if(!known) {
+        ParameterSet processParameterSet;
+        processParameterSet.addParameter<std::string>("@process_name", entry.processName_);
+        processParameterSet.registerIt();
+        ph.emplace_back(entry.processName_, processParameterSet.id(), getReleaseVersion(), getPassID());
+      }
+    }
+    processHistoryRegistryForUpdate().registerProcessHistory(ph);
+    processHistoryID_ = ph.setProcessHistoryID();
+
+    fileToProduct_.clear();
+    for(unsigned int i = 0; i != products_.size(); ++i) {
+      fileToProduct_.push_back(i);
+    }
+  }
+
+  bool
+  SoATableSource::openNextFile() {
+    if(nextFile_ == fileNames_.size()) return false;
+    reader_ = std::make_unique<SoATableFileReader>(fileNames_[nextFile_]);
+    nextEvent_ = 0;
+    if(nextFile_ != 0) {
+      fileToProduct_.clear();
+      for(auto const& entry : reader_->products()) {
+        unsigned int i = 0;
+        for(; i != products_.size(); ++i) {
+          if(products_[i].branchDescription_.branchName() == entry.branchName_) break;
+        }
+        if(i == products_.size()) {
+          throw Exception(errors::FormatIncompatibility)
+            << "SoATableSource: product " << entry.branchName_ << " of file " << fileNames_[nextFile_]
+            << " is not in the first file " << fileNames_[0] << "\n";
+        }
+        fileToProduct_.push_back(i);
+      }
+    }
+    ++nextFile_;
+    return true;
+  }
+
+  bool
+  SoATableSource::checkNextEvent() {
+    while(nextEvent_ == reader_->numberOfEvents()) {
+      if(!openNextFile()) return false;
+    }
+    currentEvent_ = nextEvent_++;
+    soatable::EventRecord const& event = reader_->event(currentEvent_);
+    Timestamp time(event.time_);
+    if(runAuxiliary().get() == nullptr || runAuxiliary()->run() != event.run_) {
+      RunAuxiliary* runAuxiliary = new RunAuxiliary(event.run_, time, Timestamp::invalidTimestamp());
+      runAuxiliary->setProcessHistoryID(processHistoryID_);
+      setRunAuxiliary(runAuxiliary);
+      resetLuminosityBlockAuxiliary();
+    }
+    if(!luminosityBlockAuxiliary() || luminosityBlockAuxiliary()->luminosityBlock() != event.luminosityBlock_) {
+      LuminosityBlockAuxiliary* luminosityBlockAuxiliary =
+        new LuminosityBlockAuxiliary(event.run_, event.luminosityBlock_, time, Timestamp::invalidTimestamp());
+      luminosityBlockAuxiliary->setProcessHistoryID(processHistoryID_);
+      setLuminosityBlockAuxiliary(luminosityBlockAuxiliary);
+    }
+    setEventCached();
+    return true;
+  }
+
+  void
+  SoATableSource::read(EventPrincipal& eventPrincipal) {
+    soatable::EventRecord const& event = reader_->event(currentEvent_);
+    EventAuxiliary aux(EventID(event.run_, event.luminosityBlock_, event.event_), processGUID(), Timestamp(event.time_), false);
+    aux.setProcessHistoryID(processHistoryID_);
+    makeEvent(eventPrincipal, aux);
+
+    for(unsigned int i = 0; i != reader_->products().size(); ++i) {
+      soatable::TableRecord const* table = reader_->table(currentEvent_, i);
+      if(table == nullptr) continue;
+      ProductInfo const& info = products_[fileToProduct_[i]];
+      void* wrapper = info.wrapperClass_->New();
+      std::unique_ptr<WrapperBase> edp = getWrapperBasePtr(wrapper, info.offsetToWrapperBase_);
+      fillTable(info, *table, wrapper, *edp);
+      eventPrincipal.put(info.branchDescription_, std::move(edp), info.provenance_);
+    }
+  }
+
+  void
+  SoATableSource::fillTable(ProductInfo const& info, soatable::TableRecord const& table, void* wrapper, WrapperBase const& base) const {
+    char* address = static_cast<char*>(wrapper);
+    unsigned int rows = table.rows_;
+    ObjectWithDict tableObject(info.tableType_, address + info.offsetToTable_);
+    info.resize_.invoke(tableObject, nullptr, std::vector<void*>{&rows});
+    *reinterpret_cast<bool*>(address + info.offsetToPresent_) = true;
+
+    auto examiner = base.tableExaminer();
+    auto const& columns = reader_->products()[table.product_].columns_;
+    auto const descriptions = examiner->columnDescriptions();
+    for(unsigned int i = 0; i != descriptions.size(); ++i) {
+      unsigned int column = reader_->columnIndex(table.product_, descriptions[i].first);
+      if(column == columns.size()) continue;
+      if(columns[column].elementSize_ != soatable::columnTypeSize(descriptions[i].second)) {
+        throw Exception(errors::FormatIncompatibility)
+          << "SoATableSource: column '" << descriptions[i].first << "' of " << info.branchDescription_.branchName()
+          << " is stored as " << columns[column].typeName_ << " which does not match the type in the dictionary\n";
+      }
+      // The column arrays are owned by the Table, which only gives const access through the examiner.
+      std::memcpy(const_cast<void*>(examiner->columnAddress(i)), reader_->column(table, column),
+                  size_t(rows) * columns[column].elementSize_);
+    }
+  }
+
+  void
+  SoATableSource::fillDescriptions(ConfigurationDescriptions& descriptions) {
+    ParameterSetDescription desc;
+    desc.setComment("Reads edm::soa::Table products from files written by SoATableOutputModule.");
+    desc.addUntracked<std::vector<std::string>>("fileNames")
+      ->setComment("Names of the files to be read.");
+    desc.addUntracked<bool>("inputFileTransitionsEachEvent", false);
+    RawInputSource::fillDescription(desc);
+    descriptions.add("source", desc);
+  }
+}
+
+using edm::SoATableSource;
+DEFINE_FWK_INPUT_SOURCE(SoATableSource);
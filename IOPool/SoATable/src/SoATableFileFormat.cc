@@ -0,0 +1,57 @@
+#include "IOPool/SoATable/interface/SoATableFileFormat.h"
+
+#include <typeinfo>
+
+namespace edm {
+  namespace soatable {
+    namespace {
+      struct ColumnType {
+        std::type_index type_;
+        char const* name_;
+        uint32_t size_;
+      };
+
+      template <typename T>
+      ColumnType columnType(char const* name) {
+        return ColumnType{std::type_index(typeid(T)), name, sizeof(T)};
+      }
+
+      std::vector<ColumnType> const& columnTypes() {
+        static std::vector<ColumnType> const types = {
+          columnType<bool>("bool"),
+          columnType<char>("char"),
+          columnType<signed char>("signed char"),
+          columnType<unsigned char>("unsigned char"),
+          columnType<short>("short"),
+          columnType<unsigned short>("unsigned short"),
+          columnType<int>("int"),
+          columnType<unsigned int>("unsigned int"),
+          columnType<long>("long"),
+          columnType<unsigned long>("unsigned long"),
+          columnType<long long>("long long"),
+          columnType<unsigned long long>("unsigned long long"),
+          columnType<float>("float"),
+          columnType<double>("double")
+        };
+        return types;
+      }
+
+      ColumnType const* findColumnType(std::type_index const& type) {
+        for(auto const& columnType : columnTypes()) {
+          if(columnType.type_ == type) return &columnType;
+        }
+        return nullptr;
+      }
+    }
+
+    char const* columnTypeName(std::type_index const& type) {
+      ColumnType const* columnType = findColumnType(type);
+      return columnType == nullptr ? nullptr : columnType->name_;
+    }
+
+    uint32_t columnTypeSize(std::type_index const& type) {
+      ColumnType const* columnType = findColumnType(type);
+      return columnType == nullptr ? 0 : columnType->size_;
+    }
+  }
+}
@@ -0,0 +1,176 @@
+#include "IOPool/SoATable/interface/SoATableFileReader.h"
+
+#include "FWCore/Utilities/interface/EDMException.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace edm {
+  namespace {
+    class CatalogParser {
+    public:
+      CatalogParser(char const* begin, char const* end, std::string const& fileName) :
+        current_(begin), end_(end), fileName_(fileName) {}
+
+      uint32_t readUInt32() {
+        uint32_t value;
+        std::memcpy(&value, take(sizeof(value)), sizeof(value));
+        return value;
+      }
+
+      std::string readString() {
+        uint32_t size = readUInt32();
+        char const* data = take(size);
+        return std::string(data, size);
+      }
+
+    private:
+      char const* take(uint64_t size) {
+        if(uint64_t(end_ - current_) < size) {
+          throw Exception(errors::FileReadError)
+            << "SoATableFileReader: the catalog of file " << fileName_ << " is truncated\n";
+        }
+        char const* data = current_;
+        current_ += size;
+        return data;
+      }
+
+      char const* current_;
+      char const* end_;
+      std::string const& fileName_;
+    };
+  }
+
+  SoATableFileReader::SoATableFileReader(std::string const& fileName) :
+    fileName_(fileName),
+    start_(nullptr),
+    size_(0),
+    trailer_(),
+    products_(),
+    events_(nullptr),
+    tables_(nullptr),
+    columnOffsets_(nullptr) {
+    int fd = ::open(fileName_.c_str(), O_RDONLY);
+    if(fd < 0) {
+      throw Exception(errors::FileOpenError)
+        << "SoATableFileReader could not open file " << fileName_ << ": " << std::strerror(errno) << "\n";
+    }
+    struct stat st;
+    if(::fstat(fd, &st) != 0) {
+      int error = errno;
+      ::close(fd);
+      throw Exception(errors::FileReadError)
+        << "SoATableFileReader could not stat file " << fileName_ << ": " << std::strerror(error) << "\n";
+    }
+    size_ = st.st_size;
+    if(size_ < sizeof(soatable::fileMagic) + sizeof(soatable::Trailer)) {
+      ::close(fd);
+      throw Exception(errors::FormatIncompatibility)
+        << "SoATableFileReader: file " << fileName_ << " is too short to be a SoA table file\n";
+    }
+    void* start = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    int error = errno;
+    ::close(fd);
+    if(start == MAP_FAILED) {
+      throw Exception(errors::FileReadError)
+        << "SoATableFileReader could not map file " << fileName_ << ": " << std::strerror(error) << "\n";
+    }
+    start_ = static_cast<char const*>(start);
+
+    std::memcpy(&trailer_, start_ + size_ - sizeof(trailer_), sizeof(trailer_));
+    if(std::memcmp(start_, soatable::fileMagic, sizeof(soatable::fileMagic)) != 0 ||
+       std::memcmp(trailer_.magic_, soatable::fileMagic, sizeof(soatable::fileMagic)) != 0) {
+      ::munmap(const_cast<char*>(start_), size_);
+      throw Exception(errors::FormatIncompatibility)
+        << "SoATableFileReader: file " << fileName_ << " is not a SoA table file or was not closed properly\n";
+    }
+    uint64_t indexSize = (trailer_.events_ + 1) * sizeof(soatable::EventRecord) +
+                         trailer_.tables_ * sizeof(soatable::TableRecord) +
+                         trailer_.columnEntries_ * sizeof(uint64_t);
+    if(trailer_.catalogOffset_ > trailer_.indexOffset_ ||
+       trailer_.indexOffset_ + indexSize != size_ - sizeof(trailer_)) {
+      ::munmap(const_cast<char*>(start_), size_);
+      throw Exception(errors::FileReadError)
+        << "SoATableFileReader: the index of file " << fileName_ << " is inconsistent\n";
+    }
+
+    // The index is aligned to 8 bytes by the writer, so the records can be used in place.
+    events_ = reinterpret_cast<soatable::EventRecord const*>(start_ + trailer_.indexOffset_);
+    tables_ = reinterpret_cast<soatable::TableRecord const*>(events_ + trailer_.events_ + 1);
+    columnOffsets_ = reinterpret_cast<uint64_t const*>(tables_ + trailer_.tables_);
+
+    try {
+      CatalogParser parser(start_ + trailer_.catalogOffset_, start_ + trailer_.indexOffset_, fileName_);
+      uint32_t nProducts = parser.readUInt32();
+      products_.reserve(nProducts);
+      for(uint32_t i = 0; i != nProducts; ++i) {
+        soatable::ProductEntry product;
+        product.branchName_ = parser.readString();
+        product.className_ = parser.readString();
+        product.moduleLabel_ = parser.readString();
+        product.productInstanceName_ = parser.readString();
+        product.processName_ = parser.readString();
+        uint32_t nColumns = parser.readUInt32();
+        product.columns_.reserve(nColumns);
+        for(uint32_t j = 0; j != nColumns; ++j) {
+          soatable::ColumnEntry column;
+          column.label_ = parser.readString();
+          column.typeName_ = parser.readString();
+          column.elementSize_ = parser.readUInt32();
+          product.columns_.push_back(std::move(column));
+        }
+        products_.push_back(std::move(product));
+      }
+    } catch(...) {
+      ::munmap(const_cast<char*>(start_), size_);
+      throw;
+    }
+  }
+
+  SoATableFileReader::~SoATableFileReader() {
+    ::munmap(const_cast<char*>(start_), size_);
+  }
+
+  unsigned int
+  SoATableFileReader::productIndex(std::string const& branchName) const {
+    unsigned int i = 0;
+    for(; i != products_.size(); ++i) {
+      if(products_[i].branchName_ == branchName) break;
+    }
+    return i;
+  }
+
+  soatable::TableRecord const*
+  SoATableFileReader::table(size_t iEvent, unsigned int iProduct) const {
+    for(uint64_t i = events_[iEvent].firstTable_; i != events_[iEvent + 1].firstTable_; ++i) {
+      if(tables_[i].product_ == iProduct) return tables_ + i;
+    }
+    return nullptr;
+  }
+
+  unsigned int
+  SoATableFileReader::columnIndex(unsigned int iProduct, char const* label) const {
+    auto const& columns = products_[iProduct].columns_;
+    unsigned int i = 0;
+    for(; i != columns.size(); ++i) {
+      if(columns[i].label_ == label) break;
+    }
+    return i;
+  }
+
+  void const*
+  SoATableFileReader::columnAddress(soatable::TableRecord const& table, char const* label, uint32_t elementSize) const {
+    auto const& product = products_[table.product_];
+    unsigned int index = columnIndex(table.product_, label);
+    if(index == product.columns_.size() || product.columns_[index].elementSize_ != elementSize) {
+      throw Exception(errors::ProductNotFound)
+        << "SoATableFileReader: column '" << label << "' of the requested type is not stored for product "
+        << product.branchName_ << " in file " << fileName_ << "\n";
+    }
+    return column(table, index);
+  }
+}
@@ -0,0 +1,126 @@
+#include "IOPool/SoATable/interface/SoATableFileWriter.h"
+
+#include "FWCore/Utilities/interface/EDMException.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+
+namespace edm {
+  SoATableFileWriter::SoATableFileWriter(std::string const& fileName) :
+    fileName_(fileName),
+    file_(std::fopen(fileName.c_str(), "wb")),
+    position_(0),
+    products_(),
+    events_(),
+    tables_(),
+    columnOffsets_() {
+    if(file_ == nullptr) {
+      throw Exception(errors::FileOpenError)
+        << "SoATableFileWriter could not open file " << fileName_ << " for writing: " << std::strerror(errno) << "\n";
+    }
+    write(soatable::fileMagic, sizeof(soatable::fileMagic));
+  }
+
+  SoATableFileWriter::~SoATableFileWriter() {
+    try {
+      close();
+    } catch(...) {
+    }
+  }
+
+  unsigned int
+  SoATableFileWriter::addProduct(soatable::ProductEntry const& product) {
+    products_.push_back(product);
+    return products_.size() - 1;
+  }
+
+  void
+  SoATableFileWriter::beginEvent(uint32_t run, uint32_t luminosityBlock, uint64_t event, uint64_t time) {
+    events_.push_back(soatable::EventRecord{run, luminosityBlock, event, time, tables_.size()});
+  }
+
+  void
+  SoATableFileWriter::writeTable(unsigned int product, uint32_t rows, std::vector<void const*> const& columns) {
+    assert(!events_.empty());
+    assert(product < products_.size());
+    auto const& productColumns = products_[product].columns_;
+    assert(columns.size() == productColumns.size());
+    tables_.push_back(soatable::TableRecord{product, rows, columnOffsets_.size()});
+    for(unsigned int i = 0; i != columns.size(); ++i) {
+      align(soatable::columnAlignment);
+      columnOffsets_.push_back(position_);
+      write(columns[i], uint64_t(rows) * productColumns[i].elementSize_);
+    }
+  }
+
+  void
+  SoATableFileWriter::close() {
+    if(file_ == nullptr) return;
+
+    align(sizeof(uint64_t));
+    soatable::Trailer trailer;
+    trailer.catalogOffset_ = position_;
+    uint32_t nProducts = products_.size();
+    write(&nProducts, sizeof(nProducts));
+    for(auto const& product : products_) {
+      writeString(product.branchName_);
+      writeString(product.className_);
+      writeString(product.moduleLabel_);
+      writeString(product.productInstanceName_);
+      writeString(product.processName_);
+      uint32_t nColumns = product.columns_.size();
+      write(&nColumns, sizeof(nColumns));
+      for(auto const& column : product.columns_) {
+        writeString(column.label_);
+        writeString(column.typeName_);
+        write(&column.elementSize_, sizeof(column.elementSize_));
+      }
+    }
+
+    align(sizeof(uint64_t));
+    trailer.indexOffset_ = position_;
+    trailer.events_ = events_.size();
+    trailer.tables_ = tables_.size();
+    trailer.columnEntries_ = columnOffsets_.size();
+    events_.push_back(soatable::EventRecord{0, 0, 0, 0, tables_.size()});
+    write(events_.data(), events_.size() * sizeof(soatable::EventRecord));
+    write(tables_.data(), tables_.size() * sizeof(soatable::TableRecord));
+    write(columnOffsets_.data(), columnOffsets_.size() * sizeof(uint64_t));
+    std::memcpy(trailer.magic_, soatable::fileMagic, sizeof(trailer.magic_));
+    write(&trailer, sizeof(trailer));
+
+    FILE* file = file_;
+    file_ = nullptr;
+    if(std::fclose(file) != 0) {
+      throw Exception(errors::FileWriteError)
+        << "SoATableFileWriter could not close file " << fileName_ << ": " << std::strerror(errno) << "\n";
+    }
+  }
+
+  void
+  SoATableFileWriter::write(void const* data, uint64_t size) {
+    if(size == 0) return;
+    if(std::fwrite(data, 1, size, file_) != size) {
+      throw Exception(errors::FileWriteError)
+        << "SoATableFileWriter could not write to file " << fileName_ << ": " << std::strerror(errno) << "\n";
+    }
+    position_ += size;
+  }
+
+  void
+  SoATableFileWriter::writeString(std::string const& value) {
+    uint32_t size = value.size();
+    write(&size, sizeof(size));
+    write(value.data(), size);
+  }
+
+  void
+  SoATableFileWriter::align(uint64_t alignment) {
+    static char const padding[soatable::columnAlignment] = {};
+    uint64_t remainder = position_ % alignment;
+    if(remainder != 0) {
+      write(padding, alignment - remainder);
+    }
+  }
+}
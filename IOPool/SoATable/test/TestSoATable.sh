@@ -0,0 +1,6 @@
+#!/bin/sh
+
+function die { echo $1: status $2 ;  exit $2; }
+
+cmsRun ${LOCAL_TEST_DIR}/testSoATable_write_cfg.py || die 'Failed in testSoATable_write_cfg.py' $?
+cmsRun ${LOCAL_TEST_DIR}/testSoATable_read_cfg.py || die 'Failed in testSoATable_read_cfg.py' $?
@@ -0,0 +1,202 @@
+/*----------------------------------------------------------------------
+
+Test program for edm::SoATableFileReader: tables written with
+edm::SoATableFileWriter must be read back in place, column by column,
+through SoATableFileReader::view.
+
+ ----------------------------------------------------------------------*/
+
+#include "IOPool/SoATable/interface/SoATableFileReader.h"
+#include "IOPool/SoATable/interface/SoATableFileWriter.h"
+#include "FWCore/SOA/interface/Column.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+class testSoATableFileReader: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(testSoATableFileReader);
+
+  CPPUNIT_TEST(catalogTest);
+  CPPUNIT_TEST(eventTest);
+  CPPUNIT_TEST(viewTest);
+  CPPUNIT_TEST(missingTableTest);
+  CPPUNIT_TEST(wrongColumnTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp();
+  void tearDown();
+
+  void catalogTest();
+  void eventTest();
+  void viewTest();
+  void missingTableTest();
+  void wrongColumnTest();
+
+private:
+  std::string fileName_;
+};
+
+namespace ts {
+  SOA_DECLARE_COLUMN(Eta, float, "eta");
+  SOA_DECLARE_COLUMN(ID, int, "id");
+  SOA_DECLARE_COLUMN(Px, double, "p_x");
+  SOA_DECLARE_COLUMN(Flag, bool, "flag");
+  // same label as Eta, but a different type
+  SOA_DECLARE_COLUMN(EtaD, double, "eta");
+  SOA_DECLARE_COLUMN(Phi, float, "phi");
+}
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(testSoATableFileReader);
+
+namespace {
+  unsigned int const nEvents = 4;
+
+  edm::soatable::ColumnEntry columnEntry(char const* label, std::type_info const& type) {
+    return edm::soatable::ColumnEntry{label, edm::soatable::columnTypeName(type), edm::soatable::columnTypeSize(type)};
+  }
+
+  // jets have 3*iEvent rows, none in the first event; muons are only stored for odd events
+  unsigned int nJets(unsigned int iEvent) {return 3 * iEvent;}
+  float jetEta(unsigned int iEvent, unsigned int iRow) {return 0.25f * iRow - float(iEvent);}
+  int jetID(unsigned int iEvent, unsigned int iRow) {return 1000 * iEvent + iRow;}
+  double jetPx(unsigned int iEvent, unsigned int iRow) {return 1.5 * iRow + 0.125 * iEvent;}
+  bool hasMuons(unsigned int iEvent) {return iEvent % 2 == 1;}
+  unsigned int nMuons(unsigned int iEvent) {return iEvent + 1;}
+  bool muonFlag(unsigned int iEvent, unsigned int iRow) {return (iEvent + iRow) % 3 == 0;}
+}
+
+void testSoATableFileReader::setUp()
+{
+  fileName_ = "testSoATableFileReader.soa";
+  edm::SoATableFileWriter writer(fileName_);
+
+  edm::soatable::ProductEntry jets{"edmtestJets_jets__TEST.", "edm::soa::Table<...>", "jets", "", "TEST",
+      {columnEntry("eta", typeid(float)), columnEntry("id", typeid(int)), columnEntry("p_x", typeid(double))}};
+  edm::soatable::ProductEntry muons{"edmtestMuons_muons__TEST.", "edm::soa::Table<...>", "muons", "", "TEST",
+      {columnEntry("flag", typeid(bool))}};
+  unsigned int jetProduct = writer.addProduct(jets);
+  unsigned int muonProduct = writer.addProduct(muons);
+
+  for(unsigned int iEvent = 0; iEvent != nEvents; ++iEvent) {
+    writer.beginEvent(1, 1 + iEvent / 2, 10 + iEvent, 100 * iEvent);
+    std::vector<float> etas;
+    std::vector<int> ids;
+    std::vector<double> pxs;
+    for(unsigned int iRow = 0; iRow != nJets(iEvent); ++iRow) {
+      etas.push_back(jetEta(iEvent, iRow));
+      ids.push_back(jetID(iEvent, iRow));
+      pxs.push_back(jetPx(iEvent, iRow));
+    }
+    writer.writeTable(jetProduct, nJets(iEvent), {etas.data(), ids.data(), pxs.data()});
+    if(hasMuons(iEvent)) {
+      std::vector<char> flags;
+      for(unsigned int iRow = 0; iRow != nMuons(iEvent); ++iRow) {
+        flags.push_back(muonFlag(iEvent, iRow));
+      }
+      writer.writeTable(muonProduct, nMuons(iEvent), {flags.data()});
+    }
+  }
+  writer.close();
+}
+
+void testSoATableFileReader::tearDown()
+{
+  std::remove(fileName_.c_str());
+}
+
+void testSoATableFileReader::catalogTest()
+{
+  edm::SoATableFileReader reader(fileName_);
+  CPPUNIT_ASSERT(reader.products().size() == 2);
+  CPPUNIT_ASSERT(reader.productIndex("edmtestJets_jets__TEST.") == 0);
+  CPPUNIT_ASSERT(reader.productIndex("edmtestMuons_muons__TEST.") == 1);
+  CPPUNIT_ASSERT(reader.productIndex("edmtestTaus_taus__TEST.") == 2);
+
+  auto const& jets = reader.products()[0];
+  CPPUNIT_ASSERT(jets.moduleLabel_ == "jets");
+  CPPUNIT_ASSERT(jets.processName_ == "TEST");
+  CPPUNIT_ASSERT(jets.columns_.size() == 3);
+  CPPUNIT_ASSERT(jets.columns_[1].label_ == "id");
+  CPPUNIT_ASSERT(jets.columns_[1].typeName_ == "int");
+  CPPUNIT_ASSERT(jets.columns_[2].elementSize_ == sizeof(double));
+  CPPUNIT_ASSERT(reader.columnIndex(0, "p_x") == 2);
+  CPPUNIT_ASSERT(reader.columnIndex(0, "phi") == 3);
+}
+
+void testSoATableFileReader::eventTest()
+{
+  edm::SoATableFileReader reader(fileName_);
+  CPPUNIT_ASSERT(reader.numberOfEvents() == nEvents);
+  for(unsigned int iEvent = 0; iEvent != nEvents; ++iEvent) {
+    auto const& event = reader.event(iEvent);
+    CPPUNIT_ASSERT(event.run_ == 1);
+    CPPUNIT_ASSERT(event.luminosityBlock_ == 1 + iEvent / 2);
+    CPPUNIT_ASSERT(event.event_ == 10 + iEvent);
+    CPPUNIT_ASSERT(event.time_ == 100 * iEvent);
+  }
+}
+
+void testSoATableFileReader::viewTest()
+{
+  edm::SoATableFileReader reader(fileName_);
+  for(unsigned int iEvent = 0; iEvent != nEvents; ++iEvent) {
+    // the columns are not asked for in the order they are stored
+    auto jets = reader.view<ts::Px, ts::Eta, ts::ID>(iEvent, 0);
+    CPPUNIT_ASSERT(jets.size() == nJets(iEvent));
+    unsigned int iRow = 0;
+    for(auto const& row : jets) {
+      CPPUNIT_ASSERT(row.get<ts::Eta>() == jetEta(iEvent, iRow));
+      CPPUNIT_ASSERT(row.get<ts::ID>() == jetID(iEvent, iRow));
+      CPPUNIT_ASSERT(row.get<ts::Px>() == jetPx(iEvent, iRow));
+      ++iRow;
+    }
+    CPPUNIT_ASSERT(iRow == nJets(iEvent));
+
+    // the columns are used in place, at aligned addresses in the mapped file
+    auto const* record = reader.table(iEvent, 0);
+    CPPUNIT_ASSERT(record != nullptr);
+    for(unsigned int iColumn = 0; iColumn != 3; ++iColumn) {
+      CPPUNIT_ASSERT(reinterpret_cast<uintptr_t>(reader.column(*record, iColumn)) % edm::soatable::columnAlignment == 0);
+    }
+    if(nJets(iEvent) > 0) {
+      CPPUNIT_ASSERT(jets.column<ts::ID>().begin() == reader.column(*record, 1));
+    }
+
+    if(hasMuons(iEvent)) {
+      auto muons = reader.view<ts::Flag>(iEvent, 1);
+      CPPUNIT_ASSERT(muons.size() == nMuons(iEvent));
+      iRow = 0;
+      for(auto flag : muons.column<ts::Flag>()) {
+        CPPUNIT_ASSERT(flag == muonFlag(iEvent, iRow));
+        ++iRow;
+      }
+    }
+  }
+}
+
+void testSoATableFileReader::missingTableTest()
+{
+  edm::SoATableFileReader reader(fileName_);
+  for(unsigned int iEvent = 0; iEvent != nEvents; ++iEvent) {
+    if(hasMuons(iEvent)) continue;
+    CPPUNIT_ASSERT(reader.table(iEvent, 1) == nullptr);
+    CPPUNIT_ASSERT(reader.view<ts::Flag>(iEvent, 1).size() == 0);
+  }
+}
+
+void testSoATableFileReader::wrongColumnTest()
+{
+  edm::SoATableFileReader reader(fileName_);
+  CPPUNIT_ASSERT_THROW(reader.view<ts::EtaD>(1, 0), edm::Exception);
+  CPPUNIT_ASSERT_THROW((reader.view<ts::Eta, ts::Phi>(1, 0)), edm::Exception);
+}
+
+#include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
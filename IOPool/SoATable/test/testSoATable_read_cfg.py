@@ -0,0 +1,15 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TABLEREAD")
+
+process.source = cms.Source("SoATableSource",
+                            fileNames = cms.untracked.vstring("testSoATable.soa"))
+
+# std::string columns are not written to the file, so they come back empty
+process.checkTable = cms.EDAnalyzer("edmtest::TableTestAnalyzer",
+                                    table = cms.untracked.InputTag("tableTest", "", "TABLEWRITE"),
+                                    anInts = cms.untracked.vint32(1,2,3),
+                                    aFloats = cms.untracked.vdouble(4.,5.,6.),
+                                    aStrings = cms.untracked.vstring("", "", "") )
+
+process.p = cms.Path(process.checkTable)
@@ -0,0 +1,21 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TABLEWRITE")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(3))
+
+process.tableTest = cms.EDProducer("edmtest::TableTestProducer",
+                                   anInts = cms.vint32(1,2,3),
+                                   aFloats = cms.vdouble(4.,5.,6.),
+                                   aStrings = cms.vstring("einie", "meanie", "meinie") )
+
+process.out = cms.OutputModule("SoATableOutputModule",
+                               fileName = cms.untracked.string("testSoATable.soa"),
+                               outputCommands = cms.untracked.vstring("drop *",
+                                                                      "keep *_tableTest_*_*"
+                                                                    ))
+
+process.p = cms.Path(process.tableTest)
+process.o = cms.EndPath(process.out)
@@ -6,8 +6,9 @@
        if any header information that should be the same is different
 
   uncompressBuffer:
-       Tries to uncompress the event data blob if it was compressed
-       and return true if successful (or was not compressed)
+       Tries to uncompress the event data blob if it was compressed, with the
+       algorithm and chunk size of the INIT message, using the decoder of
+       StreamerInputSource, and return true if successful (or was not compressed)
 
   readfile:
        Reads a streamer file, dumps the headers for the INIT message
@@ -28,10 +29,9 @@
 #include "IOPool/Streamer/interface/InitMessage.h"
 #include "IOPool/Streamer/interface/MsgTools.h"
 #include "IOPool/Streamer/interface/StreamerInputFile.h"
+#include "IOPool/Streamer/interface/StreamerInputSource.h"
 #include "IOPool/Streamer/interface/StreamerOutputFile.h"
 
-#include "zlib.h"
-
 #include <iostream>
 #include <map>
 #include <memory>
@@ -40,9 +40,10 @@ bool compares_bad(EventMsgView const* eview1, EventMsgView const* eview2);
 bool uncompressBuffer(unsigned char* inputBuffer,
                               unsigned int inputSize,
                               std::vector<unsigned char> &outputBuffer,
-                              unsigned int expectedFullSize);
+                              unsigned int expectedFullSize,
+                              InitMsgView const* init);
 bool test_chksum(EventMsgView const* eview);
-bool test_uncompress(EventMsgView const* eview, std::vector<unsigned char> &dest);
+bool test_uncompress(EventMsgView const* eview, InitMsgView const* init, std::vector<unsigned char> &dest);
 void readfile(std::string filename, std::string outfile);
 void help();
 
@@ -144,7 +145,7 @@ void readfile(std::string filename, std::string outfile) {
           dumpEventView(eview);
           good_event = false;
         }
-        if(!test_uncompress(eview, compress_buffer)) {
+        if(!test_uncompress(eview, init, compress_buffer)) {
           std::cout << "uncompress error for count " << num_events
                     << " event number " << firstEvtView->event() << std::endl;
           ++num_baduncompress;
@@ -169,7 +170,7 @@ void readfile(std::string filename, std::string outfile) {
           dumpEventView(eview);
           good_event = false;
         }
-        if(!test_uncompress(eview, compress_buffer)) {
+        if(!test_uncompress(eview, init, compress_buffer)) {
           std::cout << "uncompress error for count " << num_events
                     << " event number " << eview->event() << std::endl;
           ++num_baduncompress;
@@ -266,14 +267,14 @@ bool test_chksum(EventMsgView const* eview) {
 }
 
 //==========================================================================
-bool test_uncompress(EventMsgView const* eview, std::vector<unsigned char> &dest) {
+bool test_uncompress(EventMsgView const* eview, InitMsgView const* init, std::vector<unsigned char> &dest) {
   unsigned long origsize = eview->origDataSize();
   bool success = false;
   if(origsize != 0 && origsize != 78)
   {
     // compressed
     success = uncompressBuffer(const_cast<unsigned char*>((unsigned char const*)eview->eventData()),
-                                   eview->eventLength(), dest, origsize);
+                                   eview->eventLength(), dest, origsize, init);
   } else {
     // uncompressed anyway
     success = true;
@@ -285,23 +286,15 @@ bool test_uncompress(EventMsgView const* eview, std::vector<unsigned char> &dest
 bool uncompressBuffer(unsigned char *inputBuffer,
                               unsigned int inputSize,
                               std::vector<unsigned char> &outputBuffer,
-                              unsigned int expectedFullSize)
+                              unsigned int expectedFullSize,
+                              InitMsgView const* init)
   {
-    unsigned long origSize = expectedFullSize;
-    unsigned long uncompressedSize = expectedFullSize*1.1;
-    outputBuffer.resize(uncompressedSize);
-    int ret = uncompress(&outputBuffer[0], &uncompressedSize,
-                         inputBuffer, inputSize);
-    if(ret == Z_OK) {
-        // check the length against original uncompressed length
-        if(origSize != uncompressedSize) {
-            std::cout << "Problem with uncompress, original size = "
-                 << origSize << " uncompress size = " << uncompressedSize << std::endl;
-            return false;
-        }
-    } else {
-        std::cout << "Problem with uncompress, return value = "
-             << ret << std::endl;
+    // the decoder checks the chunk table and the length against the original uncompressed length
+    try {
+        edm::StreamerInputSource::uncompressBuffer(inputBuffer, inputSize, outputBuffer, expectedFullSize,
+                                                   init->compressionAlgorithm(), init->compressionChunkSize());
+    } catch(cms::Exception const& e) {
+        std::cout << "Problem with uncompress: " << e.explainSelf() << std::endl;
         return false;
     }
     return true;
@@ -28,6 +28,14 @@ code 1 | size 4 | protocol version 1 | pset 16 | run 4 | Init Header Size 4| Eve
 
 Protocol Version 11: identical to version 10, but incremented to keep in sync with event msg protocol version
 
+Protocol Version 12: added the compression algorithm and chunk size of the event data blobs (event msg protocol version unchanged).
+Only written for LZ4 or ZSTD compression or a non-zero chunk size: ZLIB single frames are still written with version 11.
+code 1 | size 4 | protocol version 1 | pset 16 | run 4 | Init Header Size 4| Event Header Size 4| releaseTagLength 1 | ReleaseTag var| processNameLength 1 | processName var| outputModuleLabelLength 1 | outputModuleLabel var | outputModuleId 4 | HLT Trig count 4| HLT Trig Length 4 | HLT Trig names var | HLT Selection count 4| HLT Selection Length 4 | HLT Selection names var | L1 Trig Count 4| L1 TrigName len 4| L1 Trig Names var | adler32 chksum 4| compression algorithm 1| compression chunk size 4| desc legth 4 | description blob var
+
+With a compression chunk size of 0 a compressed event data blob is a single compressed frame.
+Otherwise the uncompressed event is cut in chunks of (at most) that size, each compressed independently, and the blob is
+chunk count 4 | compressed chunk size 4 (repeated chunk count times) | compressed chunks var
+
 */
 
 #ifndef IOPool_Streamer_InitMessage_h
@@ -36,6 +44,12 @@ Protocol Version 11: identical to version 10, but incremented to keep in sync wi
 #include "IOPool/Streamer/interface/MsgTools.h"
 #include "IOPool/Streamer/interface/MsgHeader.h"
 
+namespace edm {
+  // Algorithm used to compress the event data blobs, stored in the INIT message
+  enum class StreamerCompressionAlgo : uint8 { UNCOMPRESSED = 0, ZLIB = 1, LZ4 = 2, ZSTD = 3 };
+}
+
+// The protocol version is raised to 12 by InitMsgBuilder only for the files that need it
 struct Version
 {
   Version(const uint8* pset):protocol_(11)
@@ -96,6 +110,8 @@ public:
   uint32 adler32_chksum() const {return adler32_chksum_;}
   std::string hostName() const;
   uint32 hostName_len() const {return host_name_len_;}
+  edm::StreamerCompressionAlgo compressionAlgorithm() const {return compression_algorithm_;}
+  uint32 compressionChunkSize() const {return compression_chunk_size_;}
 
 private:
   uint8* buf_;
@@ -123,6 +139,8 @@ private:
   uint32 adler32_chksum_;
   uint8* host_name_start_;
   uint32 host_name_len_;
+  edm::StreamerCompressionAlgo compression_algorithm_;
+  uint32 compression_chunk_size_;
 
   // does not need to be present in the message sent over the network,
   // but is needed for the index file
@@ -18,7 +18,9 @@ public:
                  const Strings& hlt_names,
                  const Strings& hlt_selections,
                  const Strings& l1_names,
-                 uint32 adler32_chksum);
+                 uint32 adler32_chksum,
+                 edm::StreamerCompressionAlgo compression_algorithm = edm::StreamerCompressionAlgo::ZLIB,
+                 uint32 compression_chunk_size = 0);
 
   uint8* startAddress() const { return buf_; }
   void setDataLength(uint32 registry_length);
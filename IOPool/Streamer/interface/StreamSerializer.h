@@ -17,6 +17,7 @@
 #include "DataFormats/Provenance/interface/ParameterSetID.h"
 #include "DataFormats/Provenance/interface/SelectedProducts.h"
 #include "FWCore/Utilities/interface/get_underlying_safe.h"
+#include "IOPool/Streamer/interface/InitMessage.h"
 
 const int init_size = 1024*1024;
 
@@ -33,6 +34,7 @@ struct SerializeDataBuffer
     ptr_((unsigned char*)rootbuf_.Buffer()),
     header_buf_(),
     bufs_(),
+    chunk_bufs_(),
     adler32_chksum_(0)
   { }
 
@@ -53,6 +55,7 @@ struct SerializeDataBuffer
   edm::propagate_const<unsigned char*> ptr_; // set to the place where the last event stored
   SBuffer header_buf_; // place for INIT message creation
   SBuffer bufs_;       // place for EVENT message creation
+  std::vector<std::vector<unsigned char> > chunk_bufs_; // space for independently compressed chunks
   uint32_t  adler32_chksum_; // adler32 check sum for the (compressed) data
 };
 
@@ -77,7 +80,8 @@ namespace edm
                           ThinnedAssociationsHelper const& thinnedAssociationsHelper);
 
     int serializeEvent(EventForOutput const& event, ParameterSetID const& selectorConfig,
-                       bool use_compression, int compression_level,
+                       StreamerCompressionAlgo compression_algo, int compression_level,
+                       unsigned int compression_chunk_size,
                        SerializeDataBuffer &data_buffer);
 
     /**
@@ -88,7 +92,22 @@ namespace edm
     static unsigned int compressBuffer(unsigned char *inputBuffer,
                                        unsigned int inputSize,
                                        std::vector<unsigned char> &outputBuffer,
-                                       int compressionLevel);
+                                       int compressionLevel,
+                                       StreamerCompressionAlgo compressionAlgo = StreamerCompressionAlgo::ZLIB);
+
+    /**
+     * Cuts the data in the specified input buffer in chunks of chunkSize
+     * bytes, compresses the chunks concurrently and writes them, preceded
+     * by the table of their compressed sizes, into the specified output
+     * buffer.  Returns the size of the output or zero if compression failed.
+     */
+    static unsigned int compressBufferInChunks(unsigned char *inputBuffer,
+                                               unsigned int inputSize,
+                                               std::vector<unsigned char> &outputBuffer,
+                                               std::vector<std::vector<unsigned char> > &chunkBuffers,
+                                               int compressionLevel,
+                                               StreamerCompressionAlgo compressionAlgo,
+                                               unsigned int chunkSize);
 
   private:
 
@@ -17,6 +17,7 @@
 
 #include "DataFormats/Streamer/interface/StreamedProducts.h"
 #include "DataFormats/Common/interface/EDProductGetter.h"
+#include "IOPool/Streamer/interface/InitMessage.h"
 
 #include <memory>
 #include <vector>
@@ -54,13 +55,17 @@ namespace edm {
      * specified output buffer.  The inputSize should be set to the size
      * of the compressed data in the inputBuffer.  The expectedFullSize should
      * be set to the original size of the data (before compression).
+     * The algorithm and chunk size are the ones recorded in the INIT message;
+     * chunked data are uncompressed concurrently.
      * Returns the actual size of the uncompressed data.
      * Errors are reported by throwing exceptions.
      */
     static unsigned int uncompressBuffer(unsigned char* inputBuffer,
                                          unsigned int inputSize,
                                          std::vector<unsigned char>& outputBuffer,
-                                         unsigned int expectedFullSize);
+                                         unsigned int expectedFullSize,
+                                         StreamerCompressionAlgo compressionAlgo = StreamerCompressionAlgo::ZLIB,
+                                         unsigned int compressionChunkSize = 0);
   protected:
     static void declareStreamers(SendDescs const& descs);
     static void buildClassCache(SendDescs const& descs);
@@ -105,6 +110,8 @@ namespace edm {
 
     std::string processName_;
     unsigned int protocolVersion_;
+    StreamerCompressionAlgo compressionAlgorithm_;
+    unsigned int compressionChunkSize_;
   }; //end-of-class-def
 } // end of namespace-edm
   
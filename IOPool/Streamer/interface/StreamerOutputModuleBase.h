@@ -47,6 +47,8 @@ namespace edm {
     int maxEventSize_;
     bool useCompression_;
     int compressionLevel_;
+    StreamerCompressionAlgo compressionAlgorithm_;
+    unsigned int compressionChunkSize_;
 
     // test luminosity sections
     int lumiSectionInterval_;  
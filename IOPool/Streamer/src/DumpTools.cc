@@ -36,6 +36,10 @@ void dumpInitHeader(const InitMsgView* view)
     std::cout << "Checksum for Registry data = " << view->adler32_chksum()
               << " Hostname = " << view->hostName() << std::endl;
   }
+  if (view->protocolVersion() >= 12) {
+    std::cout << "Compression algorithm = " << static_cast<unsigned int>(view->compressionAlgorithm())
+              << " chunk size = " << view->compressionChunkSize() << std::endl;
+  }
 
   //PSet 16 byte non-printable representation, stored in message.
   uint8 vpset[16];
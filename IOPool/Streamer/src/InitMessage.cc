@@ -26,6 +26,8 @@ InitMsgView::InitMsgView(void* buf) :
   adler32_chksum_(0),
   host_name_start_(nullptr),
   host_name_len_(0),
+  compression_algorithm_(edm::StreamerCompressionAlgo::ZLIB),
+  compression_chunk_size_(0),
   desc_start_(nullptr),
   desc_len_(0) {
   if (protocolVersion() == 2) {
@@ -96,6 +98,13 @@ InitMsgView::InitMsgView(void* buf) :
     }
   }
 
+  if (protocolVersion() > 11) {
+    compression_algorithm_ = static_cast<edm::StreamerCompressionAlgo>(*pos);
+    pos += sizeof(uint8);
+    compression_chunk_size_ = convert32(pos);
+    pos += sizeof(char_uint32);
+  }
+
   desc_start_ = pos;
   desc_len_ = convert32(desc_start_);
   desc_start_ += sizeof(char_uint32);
@@ -15,7 +15,9 @@ InitMsgBuilder::InitMsgBuilder(void* buf, uint32 size,
                                const Strings& hlt_names,
                                const Strings& hlt_selections,
                                const Strings& l1_names,
-                               uint32 adler_chksum):
+                               uint32 adler_chksum,
+                               edm::StreamerCompressionAlgo compression_algorithm,
+                               uint32 compression_chunk_size):
   buf_((uint8*)buf),size_(size)
 {
   InitHeader* h = (InitHeader*)buf_;
@@ -59,6 +61,17 @@ InitMsgBuilder::InitMsgBuilder(void* buf, uint32 size,
   convert(adler_chksum, pos);
   pos = pos + sizeof(uint32);
 
+  // how the event data blobs are compressed, only recorded (protocol version 12) when it
+  // is not the single ZLIB frame (or uncompressed blob) that version 11 readers expect
+  if(compression_chunk_size != 0 ||
+     compression_algorithm == edm::StreamerCompressionAlgo::LZ4 ||
+     compression_algorithm == edm::StreamerCompressionAlgo::ZSTD) {
+    h->version_.protocol_ = 12;
+    *pos++ = static_cast<uint8>(compression_algorithm);
+    convert(compression_chunk_size, pos);
+    pos = pos + sizeof(char_uint32);
+  }
+
   data_addr_ = pos + sizeof(char_uint32);
   setDataLength(0);
 
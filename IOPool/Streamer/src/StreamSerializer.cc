@@ -22,6 +22,11 @@
 #include "FWCore/ServiceRegistry/interface/Service.h"
 
 #include "zlib.h"
+#include "lz4.h"
+#include "lz4hc.h"
+#include "zstd.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
 #include <algorithm>
 #include <cstdlib>
 #include <iostream>
@@ -127,7 +132,8 @@ namespace edm {
    */
   int StreamSerializer::serializeEvent(EventForOutput const& event,
                                        ParameterSetID const& selectorConfig,
-                                       bool use_compression, int compression_level,
+                                       StreamerCompressionAlgo compression_algo, int compression_level,
+                                       unsigned int compression_chunk_size,
                                        SerializeDataBuffer& data_buffer) {
 
     EventSelectionIDVector selectionIDs = event.eventSelectionIDs();
@@ -222,9 +228,12 @@ namespace edm {
     // compress before return if we need to
     // should test if compressed already - should never be?
     //   as double compression can have problems
-    if(use_compression) {
-      unsigned int dest_size =
-        compressBuffer(data_buffer.ptr_, data_buffer.curr_event_size_, data_buffer.comp_buf_, compression_level);
+    if(compression_algo != StreamerCompressionAlgo::UNCOMPRESSED) {
+      unsigned int dest_size = compression_chunk_size == 0 ?
+        compressBuffer(data_buffer.ptr_, data_buffer.curr_event_size_, data_buffer.comp_buf_,
+                       compression_level, compression_algo) :
+        compressBufferInChunks(data_buffer.ptr_, data_buffer.curr_event_size_, data_buffer.comp_buf_,
+                               data_buffer.chunk_bufs_, compression_level, compression_algo, compression_chunk_size);
       if(dest_size != 0) {
         data_buffer.ptr_ = &data_buffer.comp_buf_[0]; // reset to point at compressed area
         data_buffer.curr_space_used_ = dest_size;
@@ -246,36 +255,112 @@ namespace edm {
   StreamSerializer::compressBuffer(unsigned char *inputBuffer,
                                    unsigned int inputSize,
                                    std::vector<unsigned char> &outputBuffer,
-                                   int compressionLevel) {
+                                   int compressionLevel,
+                                   StreamerCompressionAlgo compressionAlgo) {
     unsigned int resultSize = 0;
+    int ret = 0;
+    bool ok = false;
 
-    // what are these magic numbers? (jbk)
-    unsigned long dest_size = (unsigned long)(double(inputSize)*
-                                              1.002 + 1.0) + 12;
-    if(outputBuffer.size() < dest_size) outputBuffer.resize(dest_size);
+    switch(compressionAlgo) {
+      case StreamerCompressionAlgo::ZLIB:
+      {
+        // what are these magic numbers? (jbk)
+        unsigned long dest_size = (unsigned long)(double(inputSize)*
+                                                  1.002 + 1.0) + 12;
+        if(outputBuffer.size() < dest_size) outputBuffer.resize(dest_size);
 
-    // compression 1-9, 6 is zlib default, 0 none
-    int ret = compress2(&outputBuffer[0], &dest_size, inputBuffer,
+        // compression 1-9, 6 is zlib default, 0 none
+        ret = compress2(&outputBuffer[0], &dest_size, inputBuffer,
                         inputSize, compressionLevel);
-
-    // check status
-    if(ret == Z_OK) {
-        // return the correct length
+        ok = (ret == Z_OK);
         resultSize = dest_size;
+        break;
+      }
+      case StreamerCompressionAlgo::LZ4:
+      {
+        int dest_size = LZ4_compressBound(inputSize);
+        if(outputBuffer.size() < (unsigned int)dest_size) outputBuffer.resize(dest_size);
+
+        // the fast compressor is used for the lowest levels, the high compression one above
+        ret = compressionLevel < LZ4HC_CLEVEL_MIN ?
+          LZ4_compress_default((char const*)inputBuffer, (char*)&outputBuffer[0], inputSize, dest_size) :
+          LZ4_compress_HC((char const*)inputBuffer, (char*)&outputBuffer[0], inputSize, dest_size, compressionLevel);
+        ok = (ret > 0);
+        resultSize = ret;
+        break;
+      }
+      case StreamerCompressionAlgo::ZSTD:
+      {
+        size_t dest_size = ZSTD_compressBound(inputSize);
+        if(outputBuffer.size() < dest_size) outputBuffer.resize(dest_size);
 
+        size_t zret = ZSTD_compress(&outputBuffer[0], dest_size, inputBuffer, inputSize, compressionLevel);
+        ok = !ZSTD_isError(zret);
+        ret = ok ? 0 : -1;
+        resultSize = zret;
+        break;
+      }
+      default:
+        break;
+    }
+
+    // check status
+    if(ok) {
         FDEBUG(1) << " original size = " << inputSize
-                  << " final size = " << dest_size
-                  << " ratio = " << double(dest_size)/double(inputSize)
+                  << " final size = " << resultSize
+                  << " ratio = " << double(resultSize)/double(inputSize)
                   << std::endl;
     } else {
         // compression failed, return a size of zero
-        FDEBUG(9) << "Compression Return value: " << ret
-                  << " Okay = " << Z_OK << std::endl;
+        resultSize = 0;
+        FDEBUG(9) << "Compression algorithm " << static_cast<unsigned>(compressionAlgo)
+                  << " Return value: " << ret << std::endl;
         // do we throw an exception here?
-        std::cerr << "Compression Return value: " << ret << " Okay = " << Z_OK << std::endl;
-
+        std::cerr << "Compression algorithm " << static_cast<unsigned>(compressionAlgo) << " Return value: " << ret << std::endl;
     }
 
     return resultSize;
   }
+
+  unsigned int
+  StreamSerializer::compressBufferInChunks(unsigned char *inputBuffer,
+                                           unsigned int inputSize,
+                                           std::vector<unsigned char> &outputBuffer,
+                                           std::vector<std::vector<unsigned char> > &chunkBuffers,
+                                           int compressionLevel,
+                                           StreamerCompressionAlgo compressionAlgo,
+                                           unsigned int chunkSize) {
+    unsigned int nChunks = inputSize == 0 ? 0 : 1 + (inputSize - 1)/chunkSize;
+    if(chunkBuffers.size() < nChunks) chunkBuffers.resize(nChunks);
+    std::vector<unsigned int> chunkSizes(nChunks, 0);
+
+    // The chunks are independent, so they are compressed concurrently.
+    // Isolate the loop so this thread does not pick up unrelated framework tasks while waiting.
+    tbb::this_task_arena::isolate([&]() {
+      tbb::parallel_for(0U, nChunks, [&](unsigned int i) {
+        unsigned int offset = i*chunkSize;
+        chunkSizes[i] = compressBuffer(inputBuffer + offset, std::min(chunkSize, inputSize - offset),
+                                       chunkBuffers[i], compressionLevel, compressionAlgo);
+      });
+    });
+
+    unsigned int resultSize = sizeof(char_uint32)*(1 + nChunks);
+    for(auto size : chunkSizes) {
+      if(size == 0) return 0;
+      resultSize += size;
+    }
+    if(outputBuffer.size() < resultSize) outputBuffer.resize(resultSize);
+
+    unsigned char* pos = &outputBuffer[0];
+    convert(nChunks, pos);
+    pos += sizeof(char_uint32);
+    for(auto size : chunkSizes) {
+      convert(size, pos);
+      pos += sizeof(char_uint32);
+    }
+    for(unsigned int i = 0; i != nChunks; ++i) {
+      pos = std::copy(chunkBuffers[i].begin(), chunkBuffers[i].begin() + chunkSizes[i], pos);
+    }
+    return resultSize;
+  }
 }
@@ -17,6 +17,10 @@
 #include "DataFormats/Provenance/interface/ThinnedAssociationsHelper.h"
 
 #include "zlib.h"
+#include "lz4.h"
+#include "zstd.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
 
 #include "DataFormats/Common/interface/RefCoreStreamer.h"
 #include "FWCore/Utilities/interface/WrappedClassName.h"
@@ -38,6 +42,48 @@
 namespace edm {
   namespace {
     int const init_size = 1024*1024;
+
+    // Uncompresses one compressed frame into outputSize bytes at outputBuffer
+    // and returns the uncompressed size.
+    unsigned long uncompressFrame(StreamerCompressionAlgo compressionAlgo,
+                                  unsigned char* inputBuffer,
+                                  unsigned int inputSize,
+                                  unsigned char* outputBuffer,
+                                  unsigned long outputSize) {
+      switch(compressionAlgo) {
+        case StreamerCompressionAlgo::ZLIB:
+        {
+          int ret = uncompress(outputBuffer, &outputSize,
+                               inputBuffer, inputSize); // do not need compression level
+          if(ret != Z_OK) {
+            throw cms::Exception("StreamDeserialization","Uncompression error")
+              << "Error code = " << ret << "\n ";
+          }
+          return outputSize;
+        }
+        case StreamerCompressionAlgo::LZ4:
+        {
+          int ret = LZ4_decompress_safe((char const*)inputBuffer, (char*)outputBuffer, inputSize, outputSize);
+          if(ret < 0) {
+            throw cms::Exception("StreamDeserialization","Uncompression error")
+              << "LZ4 error code = " << ret << "\n ";
+          }
+          return ret;
+        }
+        case StreamerCompressionAlgo::ZSTD:
+        {
+          size_t ret = ZSTD_decompress(outputBuffer, outputSize, inputBuffer, inputSize);
+          if(ZSTD_isError(ret)) {
+            throw cms::Exception("StreamDeserialization","Uncompression error")
+              << "ZSTD error: " << ZSTD_getErrorName(ret) << "\n ";
+          }
+          return ret;
+        }
+        default:
+          throw cms::Exception("StreamDeserialization","Uncompression error")
+            << "Unknown compression algorithm " << static_cast<unsigned int>(compressionAlgo) << "\n ";
+      }
+    }
   }
 
   StreamerInputSource::StreamerInputSource(
@@ -51,7 +97,9 @@ namespace edm {
     eventPrincipalHolder_(),
     adjustEventToNewProductRegistry_(false),
     processName_(),
-    protocolVersion_(0U) {
+    protocolVersion_(0U),
+    compressionAlgorithm_(StreamerCompressionAlgo::ZLIB),
+    compressionChunkSize_(0U) {
   }
 
   StreamerInputSource::~StreamerInputSource() {}
@@ -145,6 +193,8 @@ namespace edm {
          FDEBUG(10) << "StreamerInputSource::deserializeRegistry processName = "<< processName_<< std::endl;
          FDEBUG(10) << "StreamerInputSource::deserializeRegistry protocolVersion_= "<< protocolVersion_<< std::endl;
     }
+    compressionAlgorithm_ = initView.compressionAlgorithm();
+    compressionChunkSize_ = initView.compressionChunkSize();
 
    // calculate the adler32 checksum
    uint32_t adler32_chksum = cms::Adler32((char const*)initView.descData(),initView.descLength());
@@ -230,7 +280,8 @@ namespace edm {
     if(origsize != 78 && origsize != 0) {
       // compressed
       dest_size = uncompressBuffer(const_cast<unsigned char*>((unsigned char const*)eventView.eventData()),
-                                   eventView.eventLength(), dest_, origsize);
+                                   eventView.eventLength(), dest_, origsize,
+                                   compressionAlgorithm_, compressionChunkSize_);
     } else { // not compressed
       // we need to copy anyway the buffer as we are using dest in xbuf
       dest_size = eventView.eventLength();
@@ -359,30 +410,56 @@ namespace edm {
   StreamerInputSource::uncompressBuffer(unsigned char* inputBuffer,
                                         unsigned int inputSize,
                                         std::vector<unsigned char>& outputBuffer,
-                                        unsigned int expectedFullSize) {
+                                        unsigned int expectedFullSize,
+                                        StreamerCompressionAlgo compressionAlgo,
+                                        unsigned int compressionChunkSize) {
     unsigned long origSize = expectedFullSize;
-    unsigned long uncompressedSize = expectedFullSize*1.1;
+    unsigned long uncompressedSize = 0;
     FDEBUG(1) << "Uncompress: original size = " << origSize
               << ", compressed size = " << inputSize
               << std::endl;
-    outputBuffer.resize(uncompressedSize);
-    int ret = uncompress(&outputBuffer[0], &uncompressedSize,
-                         inputBuffer, inputSize); // do not need compression level
-    //std::cout << "unCompress Return value: " << ret << " Okay = " << Z_OK << std::endl;
-    if(ret == Z_OK) {
-        // check the length against original uncompressed length
-        FDEBUG(10) << " original size = " << origSize << " final size = "
-                   << uncompressedSize << std::endl;
-        if(origSize != uncompressedSize) {
-            // we throw an error and return without event! null pointer
-            throw cms::Exception("StreamDeserialization","Uncompression error")
-              << "mismatch event lengths should be" << origSize << " got "
-              << uncompressedSize << "\n";
-        }
+    if(compressionChunkSize == 0) {
+      outputBuffer.resize(expectedFullSize*1.1);
+      uncompressedSize = uncompressFrame(compressionAlgo, inputBuffer, inputSize, &outputBuffer[0], outputBuffer.size());
     } else {
+      // chunk count | compressed chunk sizes | compressed chunks, see InitMessage.h
+      unsigned int nChunks = convert32(inputBuffer);
+      if(nChunks != (origSize == 0 ? 0 : 1 + (origSize - 1)/compressionChunkSize) ||
+         sizeof(char_uint32)*(1 + nChunks) > inputSize) {
+        throw cms::Exception("StreamDeserialization","Uncompression error")
+          << "inconsistent chunk table: " << nChunks << " chunks for " << origSize
+          << " bytes with chunk size " << compressionChunkSize << "\n";
+      }
+      std::vector<unsigned int> offsets(nChunks + 1, sizeof(char_uint32)*(1 + nChunks));
+      for(unsigned int i = 0; i != nChunks; ++i) {
+        offsets[i+1] = offsets[i] + convert32(inputBuffer + sizeof(char_uint32)*(1 + i));
+      }
+      if(offsets[nChunks] != inputSize) {
+        throw cms::Exception("StreamDeserialization","Uncompression error")
+          << "compressed chunks use " << offsets[nChunks] << " bytes, event data has "
+          << inputSize << "\n";
+      }
+      outputBuffer.resize(origSize);
+      std::vector<unsigned long> chunkSizes(nChunks, 0);
+      tbb::this_task_arena::isolate([&]() {
+        tbb::parallel_for(0U, nChunks, [&](unsigned int i) {
+          unsigned long offset = static_cast<unsigned long>(i)*compressionChunkSize;
+          chunkSizes[i] = uncompressFrame(compressionAlgo, inputBuffer + offsets[i], offsets[i+1] - offsets[i],
+                                          &outputBuffer[offset], std::min<unsigned long>(compressionChunkSize, origSize - offset));
+        });
+      });
+      for(auto size : chunkSizes) {
+        uncompressedSize += size;
+      }
+    }
+    // check the length against original uncompressed length
+    FDEBUG(10) << " original size = " << origSize << " final size = "
+               << uncompressedSize << std::endl;
+    if(origSize != uncompressedSize) {
         // we throw an error and return without event! null pointer
         throw cms::Exception("StreamDeserialization","Uncompression error")
-            << "Error code = " << ret << "\n ";
+          << "mismatch event lengths should be" << origSize << " got "
+          << uncompressedSize << "\n";
     }
     return (unsigned int) uncompressedSize;
   }
@@ -8,6 +8,7 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/Utilities/interface/DebugMacros.h"
+#include "FWCore/Utilities/interface/EDMException.h"
 //#include "FWCore/Utilities/interface/Digest.h"
 #include "FWCore/Version/interface/GetReleaseVersion.h"
 #include "DataFormats/Common/interface/TriggerResults.h"
@@ -51,6 +52,23 @@ namespace {
     // std::cout << std::endl;
 
   }
+
+  edm::StreamerCompressionAlgo compressionAlgorithmFromName(std::string const& name) {
+    if(name == "ZLIB") return edm::StreamerCompressionAlgo::ZLIB;
+    if(name == "LZ4") return edm::StreamerCompressionAlgo::LZ4;
+    if(name == "ZSTD") return edm::StreamerCompressionAlgo::ZSTD;
+    throw edm::Exception(edm::errors::Configuration)
+      << "Unknown streamer compression algorithm '" << name << "'.\n"
+      << "Allowed values are ZLIB, LZ4 and ZSTD.\n";
+  }
+
+  int maxCompressionLevel(edm::StreamerCompressionAlgo algorithm) {
+    switch(algorithm) {
+      case edm::StreamerCompressionAlgo::LZ4: return 12;
+      case edm::StreamerCompressionAlgo::ZSTD: return 22;
+      default: return 9;
+    }
+  }
 }
 
 namespace edm {
@@ -61,6 +79,8 @@ namespace edm {
     maxEventSize_(ps.getUntrackedParameter<int>("max_event_size")),
     useCompression_(ps.getUntrackedParameter<bool>("use_compression")),
     compressionLevel_(ps.getUntrackedParameter<int>("compression_level")),
+    compressionAlgorithm_(compressionAlgorithmFromName(ps.getUntrackedParameter<std::string>("compression_algorithm"))),
+    compressionChunkSize_(ps.getUntrackedParameter<unsigned int>("compression_chunk_size")),
     lumiSectionInterval_(ps.getUntrackedParameter<int>("lumiSection_interval")),
     serializer_(selections_),
     serializeDataBuffer_(),
@@ -87,12 +107,13 @@ namespace edm {
                   << " no compression" << std::endl;
         compressionLevel_ = 0;
         useCompression_ = false;
-      } else if(compressionLevel_ > 9) {
-        FDEBUG(9) << "Compression Level = " << compressionLevel_
-                  << " using max compression level 9" << std::endl;
-        compressionLevel_ = 9;
+      } else if(compressionLevel_ > maxCompressionLevel(compressionAlgorithm_)) {
+        compressionLevel_ = maxCompressionLevel(compressionAlgorithm_);
+        FDEBUG(9) << "Compression Level too high, using max compression level "
+                  << compressionLevel_ << std::endl;
       }
     }
+    if(!useCompression_) compressionAlgorithm_ = StreamerCompressionAlgo::UNCOMPRESSED;
     serializeDataBuffer_.bufs_.resize(maxEventSize_);
     int got_host = gethostname(host_name_, 255);
     if(got_host != 0) strncpy(host_name_, "noHostNameFoundOrTooLong", sizeof(host_name_));
@@ -188,7 +209,8 @@ namespace edm {
                            getReleaseVersion().c_str() , processName.c_str(),
                            moduleLabel.c_str(), outputModuleId_,
                            hltTriggerNames, hltTriggerSelections_, l1_names,
-                           (uint32)serializeDataBuffer_.adler32_chksum());
+                           (uint32)serializeDataBuffer_.adler32_chksum(),
+                           compressionAlgorithm_, compressionChunkSize_);
 
     // copy data into the destination message
     unsigned char* src = serializeDataBuffer_.bufferPointer();
@@ -264,7 +286,8 @@ namespace edm {
       setLumiSection();
     }
 
-    serializer_.serializeEvent(e, selectorConfig(), useCompression_, compressionLevel_, serializeDataBuffer_);
+    serializer_.serializeEvent(e, selectorConfig(), compressionAlgorithm_, compressionLevel_, compressionChunkSize_,
+                               serializeDataBuffer_);
 
     // resize bufs_ to reflect space used in serializer_ + header
     // I just added an overhead for header of 50000 for now
@@ -304,7 +327,13 @@ namespace edm {
     desc.addUntracked<bool>("use_compression", true)
         ->setComment("If True, compression will be used to write streamer file.");
     desc.addUntracked<int>("compression_level", 1)
-        ->setComment("ROOT compression level to use.");
+        ->setComment("Compression level to use, capped at the maximum of the algorithm (9 for ZLIB, 12 for LZ4, 22 for ZSTD).");
+    desc.addUntracked<std::string>("compression_algorithm", "ZLIB")
+        ->setComment("Algorithm used to compress the events: ZLIB, LZ4 or ZSTD.\n"
+                     "The algorithm is recorded in the INIT message, so readers pick the matching decoder.");
+    desc.addUntracked<unsigned int>("compression_chunk_size", 0U)
+        ->setComment("If 0, each event is compressed as a single frame.\n"
+                     "If not 0, events are cut in chunks of this many bytes which are compressed concurrently.");
     desc.addUntracked<int>("lumiSection_interval", 0)
         ->setComment("If 0, use lumi section number from event.\n"
                      "If not 0, the interval in seconds between fake lumi sections.");
@@ -0,0 +1,8 @@
+import FWCore.ParameterSet.Config as cms
+
+from NewStreamIn_cfg import process
+
+process.options.numberOfThreads = cms.untracked.uint32(4)
+
+process.source.fileNames = ['file:teststreamfile_chunked.dat']
+process.out.fileName = 'myout_chunked.root'
@@ -0,0 +1,11 @@
+import FWCore.ParameterSet.Config as cms
+
+from NewStreamOut_cfg import process
+
+process.options.numberOfThreads = cms.untracked.uint32(4)
+
+process.out.fileName = 'teststreamfile_chunked.dat'
+process.out.compression_algorithm = cms.untracked.string('ZSTD')
+process.out.compression_level = 4
+# small chunks so every event is compressed in several concurrent pieces
+process.out.compression_chunk_size = cms.untracked.uint32(256)
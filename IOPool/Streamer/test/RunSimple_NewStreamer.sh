@@ -21,6 +21,8 @@ cmsRun --parameter-set NewStreamIn_cfg.py  > in  2>&1 || die "cmsRun NewStreamIn
 cmsRun --parameter-set NewStreamIn2_cfg.py  > in2  2>&1 || die "cmsRun NewStreamIn2_cfg.py" $?
 cmsRun --parameter-set NewStreamCopy_cfg.py  > copy  2>&1 || die "cmsRun NewStreamCopy_cfg.py" $?
 cmsRun --parameter-set NewStreamCopy2_cfg.py  > copy2  2>&1 || die "cmsRun NewStreamCopy2_cfg.py" $?
+cmsRun --parameter-set NewStreamOutChunked_cfg.py > outChunked 2>&1 || die "cmsRun NewStreamOutChunked_cfg.py" $?
+cmsRun --parameter-set NewStreamInChunked_cfg.py  > inChunked  2>&1 || die "cmsRun NewStreamInChunked_cfg.py" $?
 
 # echo "CHECKSUM = 1" > out
 # echo "CHECKSUM = 1" > in
@@ -30,6 +32,8 @@ ANS_OUT=`grep CHECKSUM out`
 ANS_IN=`grep CHECKSUM in`
 ANS_IN2=`grep CHECKSUM in2`
 ANS_COPY=`grep CHECKSUM copy`
+ANS_OUT_CHUNKED=`grep CHECKSUM outChunked`
+ANS_IN_CHUNKED=`grep CHECKSUM inChunked`
 
 if [ "${ANS_OUT_SIZE}" == "0" ]
 then
@@ -55,5 +59,11 @@ then
     RC=1
 fi
 
+if [ "${ANS_OUT_CHUNKED}" != "${ANS_IN_CHUNKED}" ]
+then
+    echo "New Stream Test Failed (outChunked!=inChunked)"
+    RC=1
+fi
+
 #rm -rf ${OUTDIR}
 exit ${RC}
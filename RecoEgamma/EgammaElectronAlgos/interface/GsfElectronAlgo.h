@@ -212,7 +212,7 @@ class GsfElectronAlgo {
     typedef std::list<reco::GsfElectron *> GsfElectronPtrCollection ; // for temporary collections
 
     // main methods
-    void checkSetup( const edm::EventSetup & ) ;
+    void checkSetup( const edm::EventSetup &, const gsfAlgoHelpers::HeavyObjectCache* ) ;
     void beginEvent( edm::Event & ) ;
     void displayInternalElectrons( const std::string & title ) const ;
     void clonePreviousElectrons() ;
@@ -4,6 +4,7 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "RecoEgamma/ElectronIdentification/interface/ElectronMVAEstimator.h"
 #include "RecoEgamma/ElectronIdentification/interface/SoftElectronMVAEstimator.h"
+#include "CondFormats/EgammaObjects/interface/GBRForestFlatCache.h"
 #include <memory>
 
 namespace gsfAlgoHelpers {
@@ -12,6 +13,8 @@ namespace gsfAlgoHelpers {
     HeavyObjectCache(const edm::ParameterSet&);
     std::unique_ptr<const SoftElectronMVAEstimator> sElectronMVAEstimator;
     std::unique_ptr<const ElectronMVAEstimator> iElectronMVAEstimator;
+    // flattened regression forests, built once per IOV for all the streams
+    GBRForestFlatCache regressionForests;
   };
 }
 
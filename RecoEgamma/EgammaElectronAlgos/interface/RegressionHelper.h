@@ -9,6 +9,8 @@
 #include "FWCore/Framework/interface/ConsumesCollector.h"
 
 #include "CondFormats/EgammaObjects/interface/GBRForest.h"
+#include "CondFormats/EgammaObjects/interface/GBRForestFlat.h"
+#include "CondFormats/EgammaObjects/interface/GBRForestFlatCache.h"
 #include "Geometry/CaloTopology/interface/CaloTopology.h"
 #include "Geometry/CaloGeometry/interface/CaloGeometry.h"
 
@@ -40,7 +42,8 @@ class RegressionHelper {
   };
   
   RegressionHelper( const Configuration & ) ;
-  void checkSetup( const edm::EventSetup & ) ;
+  // the flattened forests come from the cache shared by the streams
+  void checkSetup( const edm::EventSetup &, const GBRForestFlatCache & ) ;
   void readEvent( const edm::Event & ) ;
   void applyEcalRegression(reco::GsfElectron & electron,
 			   const edm::Handle<reco::VertexCollection>& vertices,
@@ -70,12 +73,12 @@ class RegressionHelper {
   unsigned long long caloGeometryCacheId_;
   unsigned long long regressionCacheId_;
 
-  //  edm::ESHandle<GBRForest> ecalRegBarrel_ ;
-  const GBRForest * ecalRegBarrel_ ;
-  const GBRForest * ecalRegEndcap_ ;
-  const GBRForest * ecalRegErrorBarrel_ ;  
-  const GBRForest * ecalRegErrorEndcap_ ;  
-  const GBRForest * combinationReg_ ;
+  // flattened copies of the forests, shared by the streams and rebuilt when the weights change
+  std::shared_ptr<const GBRForestFlat> ecalRegBarrel_ ;
+  std::shared_ptr<const GBRForestFlat> ecalRegEndcap_ ;
+  std::shared_ptr<const GBRForestFlat> ecalRegErrorBarrel_ ;  
+  std::shared_ptr<const GBRForestFlat> ecalRegErrorEndcap_ ;  
+  std::shared_ptr<const GBRForestFlat> combinationReg_ ;
    
   EcalClusterLocal ecl_;
 };
@@ -766,7 +766,7 @@ GsfElectronAlgo::~GsfElectronAlgo()
   delete electronData_ ;
  }
 
-void GsfElectronAlgo::checkSetup( const edm::EventSetup & es )
+void GsfElectronAlgo::checkSetup( const edm::EventSetup & es, const gsfAlgoHelpers::HeavyObjectCache* hoc )
  {
   // get EventSetupRecords if needed
   bool updateField(false);
@@ -803,7 +803,7 @@ void GsfElectronAlgo::checkSetup( const edm::EventSetup & es )
   generalData_->hcalHelper->checkSetup(es) ;
   generalData_->hcalHelperPflow->checkSetup(es) ;
   if(generalData_->strategyCfg.useEcalRegression || generalData_->strategyCfg.useCombinationRegression)
-    generalData_->regHelper->checkSetup(es);
+    generalData_->regHelper->checkSetup(es,hoc->regressionForests);
 
 
   if (generalData_->superClusterErrorFunction)
@@ -26,7 +26,7 @@ void RegressionHelper::applyEcalRegression(reco::GsfElectron & ele,
 
 }
 
-void RegressionHelper::checkSetup(const edm::EventSetup & es) {
+void RegressionHelper::checkSetup(const edm::EventSetup & es, const GBRForestFlatCache & forests) {
 
   // Topology 
   unsigned long long newCaloTopologyCacheId 
@@ -51,85 +51,64 @@ void RegressionHelper::checkSetup(const edm::EventSetup & es) {
     }
 
   // Ecal regression 
-  
+
+  // the flattened forests are shared by the streams: each is built once per IOV
+  auto fromDB = [&](const std::string & label, unsigned long long cacheId) {
+    return forests.Get(label, cacheId, [&]() {
+	edm::ESHandle<GBRForest> forestH;
+	es.get<GBRWrapperRcd>().get(label,forestH);
+	return forestH;
+      });
+  };
+  // or once from the weight file, for debugging
+  auto fromFile = [&](const std::string & file, const std::string & label) {
+    return forests.Get(file+":"+label, 0, [&]() {
+	TFile gbrfile(edm::FileInPath(file).fullPath().c_str());
+	std::unique_ptr<const GBRForest> forest(static_cast<const GBRForest*>(gbrfile.Get(label.c_str())));
+	gbrfile.Close();
+	return forest;
+      });
+  };
+
   // if at least one of the set of weights come from the DB
-  if(cfg_.ecalWeightsFromDB)
+  unsigned long long newRegressionCacheId = 0;
+  if(cfg_.ecalWeightsFromDB || cfg_.combinationWeightsFromDB)
+    newRegressionCacheId = es.get<GBRWrapperRcd>().cacheIdentifier();
+  const bool newRegression = !regressionCacheId_ || (newRegressionCacheId != regressionCacheId_);
+
+  if(cfg_.ecalWeightsFromDB && newRegression)
     {
-      unsigned long long newRegressionCacheId
-	= es.get<GBRWrapperRcd>().cacheIdentifier() ;
-      if ( !regressionCacheId_ || (newRegressionCacheId != regressionCacheId_ ) ) {
-	
-	const GBRWrapperRcd& gbrRcd = es.get<GBRWrapperRcd>();
-
-	// ECAL barrel
-	edm::ESHandle<GBRForest> ecalRegBarrelH;
-	gbrRcd.get(cfg_.ecalRegressionWeightLabels[0].c_str(),ecalRegBarrelH);
-	ecalRegBarrel_ = &(*ecalRegBarrelH);
-	
-	// ECAL endcaps
-	edm::ESHandle<GBRForest> ecalRegEndcapH;
-	gbrRcd.get(cfg_.ecalRegressionWeightLabels[1].c_str(),ecalRegEndcapH);
-	ecalRegEndcap_= &(*ecalRegEndcapH);
-	
-	// ECAL barrel error
-	edm::ESHandle<GBRForest> ecalRegErrorBarrelH;
-	gbrRcd.get(cfg_.ecalRegressionWeightLabels[2].c_str(),ecalRegErrorBarrelH);
-	ecalRegErrorBarrel_ = &(*ecalRegErrorBarrelH);
-	
-	// ECAL endcap error
-	edm::ESHandle<GBRForest> ecalRegErrorEndcapH;
-	gbrRcd.get(cfg_.ecalRegressionWeightLabels[3].c_str(),ecalRegErrorEndcapH);
-	ecalRegErrorEndcap_ = &(*ecalRegErrorEndcapH);
-	
-	ecalRegressionInitialized_ = true;
-      }
+      ecalRegBarrel_ = fromDB(cfg_.ecalRegressionWeightLabels[0], newRegressionCacheId);
+      ecalRegEndcap_ = fromDB(cfg_.ecalRegressionWeightLabels[1], newRegressionCacheId);
+      ecalRegErrorBarrel_ = fromDB(cfg_.ecalRegressionWeightLabels[2], newRegressionCacheId);
+      ecalRegErrorEndcap_ = fromDB(cfg_.ecalRegressionWeightLabels[3], newRegressionCacheId);
+      ecalRegressionInitialized_ = true;
     }
-  if( cfg_.combinationWeightsFromDB) 
+  if(cfg_.combinationWeightsFromDB && newRegression)
     {
-
-	// Combination
-	if(cfg_.combinationWeightsFromDB) 
-	  {
-	    unsigned long long newRegressionCacheId
-	      = es.get<GBRWrapperRcd>().cacheIdentifier() ;
-	    if ( !regressionCacheId_ || (newRegressionCacheId != regressionCacheId_ ) ) {
-
-	      const GBRWrapperRcd& gbrRcd = es.get<GBRWrapperRcd>();
-
-	      edm::ESHandle<GBRForest> combinationRegH;
-	      gbrRcd.get(cfg_.combinationRegressionWeightLabels[0].c_str(),combinationRegH);
-	      combinationReg_ = &(*combinationRegH);
-	      
-	      combinationRegressionInitialized_ = true;
-	    }
-	  }
+      combinationReg_ = fromDB(cfg_.combinationRegressionWeightLabels[0], newRegressionCacheId);
+      combinationRegressionInitialized_ = true;
     }
 
+  // the flattened forests are only rebuilt when the weights change
+  if(cfg_.ecalWeightsFromDB || cfg_.combinationWeightsFromDB)
+    regressionCacheId_ = newRegressionCacheId;
+
   // read weights from file - for debugging. Even if it is one single files, 4 files should b set in the vector
   if(!cfg_.ecalWeightsFromDB && !ecalRegressionInitialized_ &&
      !cfg_.ecalRegressionWeightFiles.empty() ) {
-    TFile file0 (edm::FileInPath(cfg_.ecalRegressionWeightFiles[0].c_str()).fullPath().c_str());
-    ecalRegBarrel_ = (const GBRForest*)file0.Get(cfg_.ecalRegressionWeightLabels[0].c_str());
-    file0.Close();
-    TFile file1 (edm::FileInPath(cfg_.ecalRegressionWeightFiles[1].c_str()).fullPath().c_str());
-    ecalRegEndcap_ = (const GBRForest*)file1.Get(cfg_.ecalRegressionWeightLabels[1].c_str());
-    file1.Close();
-    TFile file2 (edm::FileInPath(cfg_.ecalRegressionWeightFiles[2].c_str()).fullPath().c_str());
-    ecalRegErrorBarrel_ = (const GBRForest*)file2.Get(cfg_.ecalRegressionWeightLabels[2].c_str());
-    file2.Close();
-    TFile file3 (edm::FileInPath(cfg_.ecalRegressionWeightFiles[3].c_str()).fullPath().c_str());
-    ecalRegErrorEndcap_ = (const GBRForest*)file3.Get(cfg_.ecalRegressionWeightLabels[3].c_str());
+    ecalRegBarrel_ = fromFile(cfg_.ecalRegressionWeightFiles[0], cfg_.ecalRegressionWeightLabels[0]);
+    ecalRegEndcap_ = fromFile(cfg_.ecalRegressionWeightFiles[1], cfg_.ecalRegressionWeightLabels[1]);
+    ecalRegErrorBarrel_ = fromFile(cfg_.ecalRegressionWeightFiles[2], cfg_.ecalRegressionWeightLabels[2]);
+    ecalRegErrorEndcap_ = fromFile(cfg_.ecalRegressionWeightFiles[3], cfg_.ecalRegressionWeightLabels[3]);
     ecalRegressionInitialized_ = true;
-    file3.Close();
   }
   
   if(!cfg_.combinationWeightsFromDB && !combinationRegressionInitialized_ && 
      !cfg_.combinationRegressionWeightFiles.empty() ) 
     {
-      TFile file0 (edm::FileInPath(cfg_.combinationRegressionWeightFiles[0].c_str()).fullPath().c_str());
-      combinationReg_ = (const GBRForest*)file0.Get(cfg_.combinationRegressionWeightLabels[0].c_str());
+      combinationReg_ = fromFile(cfg_.combinationRegressionWeightFiles[0], cfg_.combinationRegressionWeightLabels[0]);
       combinationRegressionInitialized_ = true;
-      file0.Close();
     }
   
 }
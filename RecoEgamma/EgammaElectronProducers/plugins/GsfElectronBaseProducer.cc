@@ -401,7 +401,7 @@ void GsfElectronBaseProducer::beginEvent( edm::Event & event, const edm::EventSe
    }
 
   // init the algo
-  algo_->checkSetup(setup) ;
+  algo_->checkSetup(setup,globalCache()) ;
   algo_->beginEvent(event) ;
  }
 
@@ -9,6 +9,8 @@ from RecoParticleFlow.PFClusterProducer.particleFlowCluster_cff import *
 hltParticleFlowBlock = cms.EDProducer("PFBlockProducer",
     debug = cms.untracked.bool(False),
     verbose = cms.untracked.bool(False),
+    parallelLinking = cms.bool(False),
+    useLinkGrids = cms.bool(True),
     elementImporters = cms.VPSet(
         cms.PSet(
             source = cms.InputTag("particleFlowClusterECAL"),
@@ -16,7 +16,9 @@ class PulseChiSqSNNLS {
     ~PulseChiSqSNNLS();
     
     
-    bool DoFit(const SampleVector &samples, const SampleMatrix &samplecov, const BXVector &bxs, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov, const SampleGainVector &gains = -1*SampleGainVector::Ones(), const SampleGainVector &badSamples = SampleGainVector::Zero());
+    //noisecovL, if given, is the Cholesky factor L of samplecov (samplecov = L*L^T):
+    //it is used instead of decomposing the covariance as long as no pulse contributes to it
+    bool DoFit(const SampleVector &samples, const SampleMatrix &samplecov, const BXVector &bxs, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov, const SampleGainVector &gains = -1*SampleGainVector::Ones(), const SampleGainVector &badSamples = SampleGainVector::Zero(), const SampleMatrix *noisecovL = nullptr);
     
     const SamplePulseMatrix &pulsemat() const { return _pulsemat; }
     const SampleMatrix &invcov() const { return _invcov; }
@@ -40,6 +42,7 @@ class PulseChiSqSNNLS {
     bool updateCov(const SampleMatrix &samplecov, const FullSampleMatrix &fullpulsecov);
     double ComputeChiSq();
     double ComputeApproxUncertainty(unsigned int ipulse);
+    Eigen::TriangularView<const SampleMatrix,Eigen::Lower> covL() const { return _covL->triangularView<Eigen::Lower>(); }
     
     
     SampleVector _sampvec;
@@ -50,6 +53,8 @@ class PulseChiSqSNNLS {
     PulseVector _ampvecmin;
     
     SampleDecompLLT _covdecomp;
+    const SampleMatrix *_noisecovL;
+    const SampleMatrix *_covL; //lower triangle of the current covariance decomposition
     SampleMatrix _covdecompLinv;
     PulseMatrix _topleft_work;
     PulseDecompLDLT _pulsedecomp;
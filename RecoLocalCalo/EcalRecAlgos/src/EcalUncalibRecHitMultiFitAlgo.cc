@@ -26,7 +26,7 @@ EcalUncalibRecHitMultiFitAlgo::EcalUncalibRecHitMultiFitAlgo() :
 }
 
 /// compute rechits
-EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataFrame& dataFrame, const EcalPedestals::Item * aped, const EcalMGPAGainRatio * aGain, const SampleMatrixGainArray &noisecors, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov, const BXVector &activeBX) {
+EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataFrame& dataFrame, const EcalPedestals::Item * aped, const EcalMGPAGainRatio * aGain, const SampleMatrixGainArray &noisecors, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov, const BXVector &activeBX, const SampleMatrixGainArray *noisecorsL) {
 
   uint32_t flags = 0;
   
@@ -133,12 +133,19 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
   
   //compute noise covariance matrix, which depends on the sample gains
   SampleMatrix noisecov;
+  //and its decomposition, when it is just a scaled correlation matrix: L(c^2*C) = c*L(C)
+  const SampleMatrix *noisecovL = nullptr;
+  const bool scaledNoiseCor = noisecorsL && (dynamicPedestal || _addPedestalUncertainty<=0.);
   if (hasGainSwitch) {
     std::array<double,3> pedrmss = {{aped->rms_x12, aped->rms_x6, aped->rms_x1}};
     std::array<double,3> gainratios = {{ 1., aGain->gain12Over6(), aGain->gain6Over1()*aGain->gain12Over6()}};
     if (_simplifiedNoiseModelForGainSwitch) {
       int gainidxmax = gainsNoise[iSampleMax];
       noisecov = gainratios[gainidxmax]*gainratios[gainidxmax]*pedrmss[gainidxmax]*pedrmss[gainidxmax]*noisecors[gainidxmax];
+      if (scaledNoiseCor) {
+        _noisecovL = gainratios[gainidxmax]*pedrmss[gainidxmax]*(*noisecorsL)[gainidxmax];
+        noisecovL = &_noisecovL;
+      }
       if (!dynamicPedestal && _addPedestalUncertainty>0.) {
         //add fully correlated component to noise covariance to inflate pedestal uncertainty
         noisecov += _addPedestalUncertainty*_addPedestalUncertainty*SampleMatrix::Ones();
@@ -163,6 +170,10 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
   }
   else {
     noisecov = aped->rms_x12*aped->rms_x12*noisecors[0];
+    if (scaledNoiseCor) {
+      _noisecovL = aped->rms_x12*(*noisecorsL)[0];
+      noisecovL = &_noisecovL;
+    }
     if (!dynamicPedestal && _addPedestalUncertainty>0.) {
       //add fully correlated component to noise covariance to inflate pedestal uncertainty
       noisecov += _addPedestalUncertainty*_addPedestalUncertainty*SampleMatrix::Ones();
@@ -172,7 +183,7 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
   //optimized one-pulse fit for hlt
   bool usePrefit = false;
   if (_doPrefit) {
-    status = _pulsefuncSingle.DoFit(amplitudes,noisecov,_singlebx,fullpulse,fullpulsecov,gainsPedestal,badSamples);
+    status = _pulsefuncSingle.DoFit(amplitudes,noisecov,_singlebx,fullpulse,fullpulsecov,gainsPedestal,badSamples,noisecovL);
     amplitude = status ? _pulsefuncSingle.X()[0] : 0.;
     amperr = status ? _pulsefuncSingle.Errors()[0] : 0.;
     chisq = _pulsefuncSingle.ChiSq();
@@ -185,7 +196,7 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
   if (!usePrefit) {
   
     if(!_computeErrors) _pulsefunc.disableErrorCalculation();
-    status = _pulsefunc.DoFit(amplitudes,noisecov,activeBX,fullpulse,fullpulsecov,gainsPedestal,badSamples);
+    status = _pulsefunc.DoFit(amplitudes,noisecov,activeBX,fullpulse,fullpulsecov,gainsPedestal,badSamples,noisecovL);
     chisq = _pulsefunc.ChiSq();
     
     if (!status) {
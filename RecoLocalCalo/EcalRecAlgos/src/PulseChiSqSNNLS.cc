@@ -73,6 +73,8 @@ void eigen_solve_submatrix(PulseMatrix& mat, PulseVector& invec, PulseVector& ou
 }
 
 PulseChiSqSNNLS::PulseChiSqSNNLS() :
+  _noisecovL(nullptr),
+  _covL(nullptr),
   _chisq(0.),
   _computeErrors(true),
   _maxiters(50),
@@ -85,9 +87,10 @@ PulseChiSqSNNLS::~PulseChiSqSNNLS() {
   
 }
 
-bool PulseChiSqSNNLS::DoFit(const SampleVector &samples, const SampleMatrix &samplecov, const BXVector &bxs, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov, const SampleGainVector &gains, const SampleGainVector &badSamples) {
+bool PulseChiSqSNNLS::DoFit(const SampleVector &samples, const SampleMatrix &samplecov, const BXVector &bxs, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov, const SampleGainVector &gains, const SampleGainVector &badSamples, const SampleMatrix *noisecovL) {
  
   int npulse = bxs.rows();
+  _noisecovL = noisecovL;
   
   _sampvec = samples;
   _bxs = bxs;
@@ -279,10 +282,12 @@ bool PulseChiSqSNNLS::updateCov(const SampleMatrix &samplecov, const FullSampleM
 
   _invcov = samplecov; //
   
+  bool noiseonly = true;
   for (unsigned int ipulse=0; ipulse<npulse; ++ipulse) {
     if (_ampvec.coeff(ipulse)==0.) continue;
     int bx = _bxs.coeff(ipulse);
     if (std::abs(bx)>=100) continue; //no contribution to covariance from pedestal or saturation/slew step correction
+    noiseonly = false;
     
     int firstsamplet = std::max(0,bx + 3);
     int offset = 7-3-bx;
@@ -295,7 +300,14 @@ bool PulseChiSqSNNLS::updateCov(const SampleMatrix &samplecov, const FullSampleM
       ampsq*fullpulsecov.block(firstsamplet+offset,firstsamplet+offset,nsamplepulse,nsamplepulse);   
   }
   
+  //the decomposition of the noise alone is known already
+  if (noiseonly && _noisecovL) {
+    _covL = _noisecovL;
+    return true;
+  }
+  
   _covdecomp.compute(_invcov);
+  _covL = &_covdecomp.matrixLLT();
   
   bool status = true;
   return status;
@@ -307,7 +319,7 @@ double PulseChiSqSNNLS::ComputeChiSq() {
 //   SampleVector resvec = _pulsemat*_ampvec - _sampvec;
 //   return resvec.transpose()*_covdecomp.solve(resvec);
   
-  return _covdecomp.matrixL().solve(_pulsemat*_ampvec - _sampvec).squaredNorm();
+  return covL().solve(_pulsemat*_ampvec - _sampvec).squaredNorm();
   
 }
 
@@ -316,7 +328,7 @@ double PulseChiSqSNNLS::ComputeApproxUncertainty(unsigned int ipulse) {
   //(using 1/second derivative since full Hessian is not meaningful in
   //presence of positive amplitude boundaries.)
       
-  return 1./_covdecomp.matrixL().solve(_pulsemat.col(ipulse)).norm();
+  return 1./covL().solve(_pulsemat.col(ipulse)).norm();
   
 }
 
@@ -327,9 +339,9 @@ bool PulseChiSqSNNLS::NNLS() {
   const unsigned int npulse = _bxs.rows();
   constexpr unsigned int nsamples = SampleVector::RowsAtCompileTime;
 
-  invcovp = _covdecomp.matrixL().solve(_pulsemat);
+  invcovp = covL().solve(_pulsemat);
   aTamat.noalias() = invcovp.transpose().lazyProduct(invcovp);
-  aTbvec.noalias() = invcovp.transpose().lazyProduct(_covdecomp.matrixL().solve(_sampvec));
+  aTbvec.noalias() = invcovp.transpose().lazyProduct(covL().solve(_sampvec));
   
   int iter = 0;
   Index idxwmax = 0;
@@ -449,12 +461,12 @@ bool PulseChiSqSNNLS::OnePulseMinimize() {
   
 //   const unsigned int npulse = 1;
 
-  invcovp = _covdecomp.matrixL().solve(_pulsemat);
+  invcovp = covL().solve(_pulsemat);
 //   aTamat = invcovp.transpose()*invcovp;
 //   aTbvec = invcovp.transpose()*_covdecomp.matrixL().solve(_sampvec);
 
   SingleMatrix aTamatval = invcovp.transpose()*invcovp;
-  SingleVector aTbvecval = invcovp.transpose()*_covdecomp.matrixL().solve(_sampvec);
+  SingleVector aTbvecval = invcovp.transpose()*covL().solve(_sampvec);
   _ampvec.coeffRef(0) = std::max(0.,aTbvecval.coeff(0)/aTamatval.coeff(0));
   
   return true;
@@ -0,0 +1,220 @@
+// The fits given the Cholesky factor of the noise covariance, as
+// EcalUncalibRecHitWorkerMultiFit does with the factors of the noise
+// correlations computed once per IOV, must give the same amplitudes,
+// uncertainties and chi2 as the fits decomposing the covariance themselves.
+// PulseChiSqSNNLS::DoFit is run on noise only, with static and dynamic
+// pedestals, and on in-time and out-of-time pulses; the whole
+// EcalUncalibRecHitMultiFitAlgo::makeRecHit is run on frames without and with
+// gain switch (simplified noise model) and with an additional pedestal
+// uncertainty, where the noise covariance is not a scaled correlation matrix,
+// so that the factors must not be used at all: the results must then be
+// identical to the last bit.
+
+#include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqSNNLS.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalUncalibRecHitMultiFitAlgo.h"
+#include "DataFormats/EcalDigi/interface/EcalDigiCollections.h"
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+  // to know whether the factor given was used by the last step of the fit
+  class PulseFit : public PulseChiSqSNNLS {
+  public:
+    bool usedNoiseFactor() const { return _noisecovL && _covL == _noisecovL; }
+  };
+
+  // EB correlations between the samples, for gain 12, 6 and 1
+  const double correlations[NGains][SampleVectorSize] = {
+    {1.00, 0.71, 0.44, 0.34, 0.30, 0.26, 0.26, 0.22, 0.22, 0.20},
+    {1.00, 0.70, 0.43, 0.35, 0.30, 0.27, 0.25, 0.23, 0.21, 0.20},
+    {1.00, 0.73, 0.57, 0.48, 0.43, 0.40, 0.37, 0.35, 0.34, 0.33}
+  };
+
+  // the default EB pulse shape template
+  const double pulseShape[12] = {1.13979e-02, 7.58151e-01, 1.00000e+00, 8.87744e-01, 6.73548e-01, 4.74332e-01,
+                                 3.19561e-01, 2.15144e-01, 1.47464e-01, 1.01087e-01, 6.93181e-02, 4.75044e-02};
+
+  const double gain12Over6 = 2.;
+  const double gain6Over1 = 6.;
+
+  struct Setup {
+    SampleMatrixGainArray noisecors;
+    SampleMatrixGainArray noisecorsL;
+    FullSampleVector fullpulse;
+    FullSampleMatrix fullpulsecov;
+    BXVector activeBX;
+  };
+
+  Setup makeSetup() {
+    Setup setup;
+    for (int igain=0; igain<NGains; ++igain) {
+      for (int i=0; i<SampleVectorSize; ++i)
+        for (int j=0; j<SampleVectorSize; ++j)
+          setup.noisecors[igain](i,j) = correlations[igain][std::abs(j-i)];
+      setup.noisecorsL[igain] = SampleDecompLLT(setup.noisecors[igain]).matrixL();
+    }
+
+    // as filled by the worker, the template starting at sample 7
+    setup.fullpulse = FullSampleVector::Zero();
+    setup.fullpulsecov = FullSampleMatrix::Zero();
+    for (int i=0; i<12; ++i) {
+      setup.fullpulse(i+7) = pulseShape[i];
+      for (int j=0; j<12; ++j)
+        setup.fullpulsecov(i+7,j+7) = 1e-5*pulseShape[i]*pulseShape[j]*(i==j ? 1. : 0.5);
+    }
+
+    setup.activeBX.resize(10);
+    setup.activeBX << -5,-4,-3,-2,-1,0,1,2,3,4;
+    return setup;
+  }
+
+  // the samples of pulses of the given amplitudes in each of the active bunch crossings
+  SampleVector pulses(const Setup &setup, const std::vector<double> &amplitudes) {
+    SampleVector samples = SampleVector::Zero();
+    for (unsigned int ibx=0; ibx<amplitudes.size(); ++ibx) {
+      int bx = setup.activeBX.coeff(ibx);
+      samples += amplitudes[ibx]*setup.fullpulse.segment<SampleVectorSize>(7-3-bx);
+    }
+    return samples;
+  }
+
+  SampleVector noise(const SampleMatrix &noisecorL, double rms, std::mt19937 &rng) {
+    std::normal_distribution<double> gauss;
+    SampleVector z;
+    for (int i=0; i<SampleVectorSize; ++i) z[i] = gauss(rng);
+    return rms*noisecorL*z;
+  }
+
+  bool close(double a, double b) {
+    return std::abs(a-b) <= 1e-6*std::max(1., std::max(std::abs(a), std::abs(b)));
+  }
+
+  bool sameFit(const PulseChiSqSNNLS &a, const PulseChiSqSNNLS &b) {
+    if (a.BXs() != b.BXs() || !close(a.ChiSq(), b.ChiSq())) return false;
+    for (int i=0; i<a.X().rows(); ++i)
+      if (!close(a.X()[i], b.X()[i]) || !close(a.Errors()[i], b.Errors()[i])) return false;
+    return true;
+  }
+
+  // the frame of the samples given in gain 12 ADC counts, switching gain when needed
+  EBDataFrame frame(EBDigiCollection &digis, const SampleVector &samples, const EcalPedestals::Item &ped) {
+    digis.push_back(EBDetId(1, 1 + digis.size()));
+    EBDataFrame df(digis.back());
+    for (int i=0; i<SampleVectorSize; ++i) {
+      if (samples[i] + ped.mean_x12 < 4000.)
+        df.setSample(i, EcalMGPASample(std::lround(samples[i] + ped.mean_x12), 1));
+      else if (samples[i]/gain12Over6 + ped.mean_x6 < 4000.)
+        df.setSample(i, EcalMGPASample(std::lround(samples[i]/gain12Over6 + ped.mean_x6), 2));
+      else
+        df.setSample(i, EcalMGPASample(std::lround(samples[i]/(gain12Over6*gain6Over1) + ped.mean_x1), 3));
+    }
+    return df;
+  }
+
+  bool sameRecHit(const EcalUncalibratedRecHit &a, const EcalUncalibratedRecHit &b, bool identical) {
+    auto same = [identical](double x, double y) { return identical ? x == y : close(x, y); };
+    if (!same(a.amplitude(), b.amplitude()) || !same(a.amplitudeError(), b.amplitudeError()) ||
+        !same(a.chi2(), b.chi2()) || !same(a.pedestal(), b.pedestal()))
+      return false;
+    for (int bx=0; bx<SampleVectorSize; ++bx)
+      if (!same(a.outOfTimeAmplitude(bx), b.outOfTimeAmplitude(bx))) return false;
+    return true;
+  }
+
+}
+
+int main() {
+  std::mt19937 rng(2017);
+  std::uniform_real_distribution<double> flat(0., 1.);
+  const Setup setup = makeSetup();
+  const double rms = 1.1;
+  const SampleMatrix noisecov = rms*rms*setup.noisecors[0];
+  const SampleMatrix noisecovL = rms*setup.noisecorsL[0];
+  int failures = 0;
+
+  // the fits themselves
+  for (const std::string name : {"noise only", "noise only, dynamic pedestal", "in-time pulse", "out-of-time pulses"}) {
+    const bool dynamicPedestal = name == "noise only, dynamic pedestal";
+    const SampleGainVector gains = dynamicPedestal ? SampleGainVector::Zero() : SampleGainVector(-1*SampleGainVector::Ones());
+    unsigned int nDifferent = 0, nFactorUsed = 0;
+    const unsigned int n = 1000;
+    for (unsigned int i=0; i<n; ++i) {
+      std::vector<double> amplitudes(setup.activeBX.rows(), 0.);
+      if (name == "in-time pulse") amplitudes[5] = 1000.*flat(rng);
+      if (name == "out-of-time pulses")
+        for (auto &amplitude : amplitudes) amplitude = flat(rng) < 0.3 ? 100.*flat(rng) : 0.;
+      SampleVector samples = pulses(setup, amplitudes) + noise(setup.noisecorsL[0], rms, rng);
+      if (dynamicPedestal) samples += 200.*SampleVector::Ones();
+
+      PulseFit cached, decomposed;
+      const bool cachedStatus = cached.DoFit(samples, noisecov, setup.activeBX, setup.fullpulse, setup.fullpulsecov, gains, SampleGainVector::Zero(), &noisecovL);
+      const bool decomposedStatus = decomposed.DoFit(samples, noisecov, setup.activeBX, setup.fullpulse, setup.fullpulsecov, gains);
+      if (cachedStatus != decomposedStatus || !sameFit(cached, decomposed)) ++nDifferent;
+      if (cached.usedNoiseFactor()) ++nFactorUsed;
+    }
+    if (nDifferent) {
+      std::cout << name << ": " << nDifferent << " of the " << n << " fits differ with the factor of the noise covariance" << std::endl;
+      ++failures;
+    }
+    // without any pulse and with a static pedestal, many fits end with no pulse at all, that is with the factor
+    // (with a dynamic pedestal, the earliest pulses take up the noise around it and almost always remain)
+    if (name == "noise only" && nFactorUsed == 0) {
+      std::cout << name << ": the factor of the noise covariance was never used" << std::endl;
+      ++failures;
+    }
+  }
+
+  // the rechits, from frames
+  EcalPedestals::Item ped;
+  ped.mean_x12 = 200.;
+  ped.rms_x12 = rms;
+  ped.mean_x6 = 201.;
+  ped.rms_x6 = 0.9;
+  ped.mean_x1 = 199.;
+  ped.rms_x1 = 0.7;
+  EcalMGPAGainRatio gainRatio;
+  gainRatio.setGain12Over6(gain12Over6);
+  gainRatio.setGain6Over1(gain6Over1);
+
+  for (const std::string name : {"no gain switch", "gain switch", "additional pedestal uncertainty",
+        "gain switch, additional pedestal uncertainty"}) {
+    const bool gainSwitch = name.find("gain switch") == 0;
+    const bool addPedestalUncertainty = name.find("additional pedestal uncertainty") != std::string::npos;
+    EcalUncalibRecHitMultiFitAlgo cached, decomposed;
+    for (auto algo : {&cached, &decomposed}) {
+      algo->setSimplifiedNoiseModelForGainSwitch(true);
+      if (addPedestalUncertainty) algo->setAddPedestalUncertainty(0.5);
+    }
+
+    EBDigiCollection digis;
+    unsigned int nDifferent = 0;
+    const unsigned int n = 500;
+    for (unsigned int i=0; i<n; ++i) {
+      std::vector<double> amplitudes(setup.activeBX.rows(), 0.);
+      const double amplitude = gainSwitch ? 4000. + 20000.*flat(rng) : 3000.*flat(rng);
+      amplitudes[5] = amplitude;
+      EBDataFrame df = frame(digis, pulses(setup, amplitudes) + noise(setup.noisecorsL[0], rms, rng), ped);
+      if (gainSwitch != (df.hasSwitchToGain6() || df.hasSwitchToGain1())) {
+        std::cout << name << ": the frame of amplitude " << amplitude << " does not switch gain as expected" << std::endl;
+        return 1;
+      }
+      auto cachedRecHit = cached.makeRecHit(df, &ped, &gainRatio, setup.noisecors, setup.fullpulse, setup.fullpulsecov, setup.activeBX, &setup.noisecorsL);
+      auto decomposedRecHit = decomposed.makeRecHit(df, &ped, &gainRatio, setup.noisecors, setup.fullpulse, setup.fullpulsecov, setup.activeBX);
+      if (!sameRecHit(cachedRecHit, decomposedRecHit, addPedestalUncertainty)) ++nDifferent;
+    }
+    if (nDifferent) {
+      std::cout << name << ": " << nDifferent << " of the " << n << " rechits differ with the factors of the noise correlations" << std::endl;
+      ++failures;
+    }
+  }
+
+  if (failures) return 1;
+  std::cout << "PulseChiSqSNNLS: the fits are identical with and without the factors of the noise covariance" << std::endl;
+  return 0;
+}
@@ -137,6 +137,11 @@ EcalUncalibRecHitWorkerMultiFit::set(const edm::EventSetup& es)
         // for the time correction methods
         es.get<EcalTimeBiasCorrectionsRcd>().get(timeCorrBias_);
 
+        // the noise correlations and their decomposition only change with the IOV of their record
+        const unsigned long long noisecovariancesCacheId = es.get<EcalSamplesCorrelationRcd>().cacheIdentifier();
+        if (noisecovariancesCacheId == noisecovariancesCacheId_) return;
+        noisecovariancesCacheId_ = noisecovariancesCacheId;
+
         int nnoise = SampleVector::RowsAtCompileTime;
         SampleMatrix &noisecorEBg12 = noisecors_[1][0];
         SampleMatrix &noisecorEBg6 = noisecors_[1][1];
@@ -156,6 +161,13 @@ EcalUncalibRecHitWorkerMultiFit::set(const edm::EventSetup& es)
             noisecorEEg1(i,j)  = noisecovariances->EEG1SamplesCorrelation[vidx];
           }
 	}
+
+        // decomposed once per IOV rather than for every channel
+        for (unsigned int isub=0; isub<noisecors_.size(); ++isub) {
+          for (unsigned int igain=0; igain<noisecors_[isub].size(); ++igain) {
+            noisecorsL_[isub][igain] = SampleDecompLLT(noisecors_[isub][igain]).matrixL();
+          }
+        }
 }
 
 void
@@ -371,7 +383,7 @@ EcalUncalibRecHitWorkerMultiFit::run( const edm::Event & evt,
             // multifit
             const SampleMatrixGainArray &noisecors = noisecor(barrel);
             
-            result.push_back(multiFitMethod_.makeRecHit(*itdg, aped, aGain, noisecors, fullpulse, fullpulsecov, activeBX));
+            result.push_back(multiFitMethod_.makeRecHit(*itdg, aped, aGain, noisecors, fullpulse, fullpulsecov, activeBX, &noisecorsL_[barrel?1:0]));
             auto & uncalibRecHit = result.back();
             
             // === time computation ===
@@ -65,6 +65,8 @@ class EcalUncalibRecHitWorkerMultiFit final : public EcalUncalibRecHitWorkerBase
                 
                 // multifit method
                 std::array<SampleMatrixGainArray, 2> noisecors_;
+                std::array<SampleMatrixGainArray, 2> noisecorsL_; // their Cholesky factors
+                unsigned long long noisecovariancesCacheId_ = 0; // of the EcalSamplesCorrelationRcd they come from
                 BXVector activeBX;
                 bool ampErrorCalculation_;
                 bool useLumiInfoRunHeader_;
@@ -23,6 +23,7 @@
 #include <numeric>
 
 #include "KDTreeLinkerAlgoT.h"
+#include "HGCalLayerTiles.h"
 
 
 template <typename T>
@@ -161,6 +162,9 @@ static const unsigned int maxlayer = 52;
 
 
 private:
+// compares the layer steps with the ones on KD trees
+friend class testHGCalImagingAlgo;
+
 // last layer per subdetector
 static const unsigned int lastLayerEE = 28;
 static const unsigned int lastLayerFH = 40;
@@ -280,9 +284,15 @@ inline double distance2(const Hexel &pt1, const Hexel &pt2) const{   //distance
 inline double distance(const Hexel &pt1, const Hexel &pt2) const{   //2-d distance on the layer (x-y)
         return std::sqrt(distance2(pt1,pt2));
 }
-double calculateLocalDensity(std::vector<KDNode> &, KDTree &, const unsigned int) const;   //return max density
-double calculateDistanceToHigher(std::vector<KDNode> &) const;
-int findAndAssignClusters(std::vector<KDNode> &, KDTree &, double, KDTreeBox &, const unsigned int, std::vector<std::vector<KDNode> >&) const;
+// critical distance for the local density and the cluster borders on a layer
+float criticalDistance(const unsigned int layer) const {
+        if (layer <= lastLayerEE) return vecDeltas_[0];
+        else if (layer <= lastLayerFH) return vecDeltas_[1];
+        return vecDeltas_[2];
+}
+double calculateLocalDensity(std::vector<KDNode> &, const HGCalLayerTiles &, const unsigned int) const;   //return max density
+double calculateDistanceToHigher(std::vector<KDNode> &, const HGCalLayerTiles &) const;
+int findAndAssignClusters(std::vector<KDNode> &, const HGCalLayerTiles &, double, const unsigned int, std::vector<std::vector<KDNode> >&) const;
 math::XYZPoint calculatePosition(std::vector<KDNode> &) const;
 
 // attempt to find subclusters within a given set of hexels
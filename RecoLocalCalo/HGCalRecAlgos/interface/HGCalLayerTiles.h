@@ -0,0 +1,87 @@
+#ifndef RecoLocalCalo_HGCalRecAlgos_HGCalLayerTiles_h
+#define RecoLocalCalo_HGCalRecAlgos_HGCalLayerTiles_h
+
+#include <algorithm>
+#include <vector>
+
+// A grid of square tiles in (x,y) over the hits of one layer.
+// The coordinates and weights of the hits are stored as contiguous arrays
+// ordered by tile, and the tiles of a row are contiguous, so that the hits
+// around a point are read from a few short ranges instead of searching a tree.
+
+class HGCalLayerTiles
+{
+
+public:
+
+// largest number of tiles along x or y: on larger layers the tiles are
+// made larger than the requested size
+static const int maxTilesPerDim = 256;
+
+void fill(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& weight,
+          float xmin, float xmax, float ymin, float ymax, float tileSize);
+
+int xBin(double x) const {
+        int b = int((x - xmin_)*invTileSize_);
+        return std::min(std::max(b,0), nx_-1);
+}
+int yBin(double y) const {
+        int b = int((y - ymin_)*invTileSize_);
+        return std::min(std::max(b,0), ny_-1);
+}
+
+// calls f(first,last) for the ranges of hits in the tiles overlapping [x0,x1]x[y0,y1]
+template <typename F>
+void forEachTileInBox(double x0, double x1, double y0, double y1, F f) const {
+        const int ix0 = xBin(x0), ix1 = xBin(x1);
+        for (int iy = yBin(y0), iy1 = yBin(y1); iy <= iy1; ++iy)
+                f(tileBegin_[iy*nx_+ix0], tileBegin_[iy*nx_+ix1+1]);
+}
+
+// calls f(first,last) for the ranges of hits in the tiles r tiles away from tile (ix,iy)
+template <typename F>
+void forEachTileInRing(int ix, int iy, int r, F f) const {
+        const int ix0 = std::max(ix-r,0), ix1 = std::min(ix+r,nx_-1);
+        if (iy-r >= 0) f(tileBegin_[(iy-r)*nx_+ix0], tileBegin_[(iy-r)*nx_+ix1+1]);
+        if (r == 0) return;
+        if (iy+r < ny_) f(tileBegin_[(iy+r)*nx_+ix0], tileBegin_[(iy+r)*nx_+ix1+1]);
+        for (int row = std::max(iy-r+1,0), last = std::min(iy+r-1,ny_-1); row <= last; ++row) {
+                if (ix-r >= 0) f(tileBegin_[row*nx_+ix-r], tileBegin_[row*nx_+ix-r+1]);
+                if (ix+r < nx_) f(tileBegin_[row*nx_+ix+r], tileBegin_[row*nx_+ix+r+1]);
+        }
+}
+
+// lower bound on the distance from (x,y) of the hits in the tiles more than
+// r tiles away from tile (ix,iy), infinity if there are no such tiles
+double distanceOutside(double x, double y, int ix, int iy, int r) const;
+
+// the nearest hit to (x,y) among the hits j with order[j] < o, searched in
+// rings of tiles of increasing size until no hit outside of them can be closer:
+// on input dist2 is the largest squared distance, on output the one of the hit
+// found, and -1 is returned if there is none. Of equally distant hits the one
+// with the largest order is returned, as with a scan in order keeping the last.
+int nearestBefore(double x, double y, unsigned int o, const std::vector<unsigned int>& order,
+                  double& dist2) const;
+
+unsigned int size() const { return index_.size(); }
+double x(unsigned int k) const { return x_[k]; }
+double y(unsigned int k) const { return y_[k]; }
+double weight(unsigned int k) const { return weight_[k]; }
+// position of the hit in the input vectors
+unsigned int index(unsigned int k) const { return index_[k]; }
+
+private:
+int nx_ = 1;
+int ny_ = 1;
+double xmin_ = 0.;
+double ymin_ = 0.;
+double tileSize_ = 1.;
+double invTileSize_ = 1.;
+std::vector<unsigned int> tileBegin_;   // nx_*ny_+1 offsets, tile (ix,iy) is iy*nx_+ix
+std::vector<double> x_;
+std::vector<double> y_;
+std::vector<double> weight_;
+std::vector<unsigned int> index_;
+};
+
+#endif
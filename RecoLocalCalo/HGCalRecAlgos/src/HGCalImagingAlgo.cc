@@ -86,23 +86,32 @@ void HGCalImagingAlgo::makeClusters() {
   // assign all hits in each layer to a cluster core or halo
   tbb::this_task_arena::isolate([&] {
     tbb::parallel_for(size_t(0), size_t(2 * maxlayer + 2), [&](size_t i) {
-      KDTreeBox bounds(minpos_[i][0], maxpos_[i][0], minpos_[i][1], maxpos_[i][1]);
-      KDTree hit_kdtree;
-      hit_kdtree.build(points_[i], bounds);
-
       unsigned int actualLayer =
           i > maxlayer
               ? (i - (maxlayer + 1))
-              : i; // maps back from index used for KD trees to actual layer
+              : i; // maps back from index used for the layers to actual layer
+
+      // tiles of the size of the critical distance, holding the positions
+      // and energies of the hits contiguously
+      const std::vector<KDNode> &nd = points_[i];
+      std::vector<double> x(nd.size()), y(nd.size()), weight(nd.size());
+      for (unsigned int j = 0; j < nd.size(); ++j) {
+        x[j] = nd[j].data.x;
+        y[j] = nd[j].data.y;
+        weight[j] = nd[j].data.weight;
+      }
+      HGCalLayerTiles tiles;
+      tiles.fill(x, y, weight, minpos_[i][0], maxpos_[i][0], minpos_[i][1],
+                 maxpos_[i][1], criticalDistance(actualLayer));
 
       double maxdensity = calculateLocalDensity(
-          points_[i], hit_kdtree, actualLayer); // also stores rho (energy
-                                               // density) for each point (node)
+          points_[i], tiles, actualLayer); // also stores rho (energy
+                                           // density) for each point (node)
       // calculate distance to nearest point with higher density storing
       // distance (delta) and point's index
-      calculateDistanceToHigher(points_[i]);
-      findAndAssignClusters(points_[i], hit_kdtree, maxdensity, bounds,
-                            actualLayer, layerClustersPerLayer_[i]);
+      calculateDistanceToHigher(points_[i], tiles);
+      findAndAssignClusters(points_[i], tiles, maxdensity, actualLayer,
+                            layerClustersPerLayer_[i]);
     });
   });
 }
@@ -229,39 +238,44 @@ HGCalImagingAlgo::calculatePosition(std::vector<KDNode> &v) const {
 }
 
 double HGCalImagingAlgo::calculateLocalDensity(std::vector<KDNode> &nd,
-                                               KDTree &lp,
+                                               const HGCalLayerTiles &tiles,
                                                const unsigned int layer) const {
 
-  double maxdensity = 0.;
-  float delta_c; // maximum search distance (critical distance) for local
-                 // density calculation
-  if (layer <= lastLayerEE)
-    delta_c = vecDeltas_[0];
-  else if (layer <= lastLayerFH)
-    delta_c = vecDeltas_[1];
-  else
-    delta_c = vecDeltas_[2];
+  // maximum search distance (critical distance) for local density calculation
+  const float delta_c = criticalDistance(layer);
 
   // for each node calculate local density rho and store it
-  for (unsigned int i = 0; i < nd.size(); ++i) {
-    // speec up search by looking within +/- delta_c window only
-    KDTreeBox search_box(nd[i].dims[0] - delta_c, nd[i].dims[0] + delta_c,
-                         nd[i].dims[1] - delta_c, nd[i].dims[1] + delta_c);
-    std::vector<KDNode> found;
-    lp.search(search_box, found);
-    const unsigned int found_size = found.size();
-    for (unsigned int j = 0; j < found_size; j++) {
-      if (distance(nd[i].data, found[j].data) < delta_c) {
-        nd[i].data.rho += found[j].data.weight;
-        maxdensity = std::max(maxdensity, nd[i].data.rho);
-      }
-    } // end loop found
-  }   // end loop nodes
+  tbb::parallel_for(
+      tbb::blocked_range<unsigned int>(0, nd.size(), 256),
+      [&](const tbb::blocked_range<unsigned int> &range) {
+        for (unsigned int i = range.begin(); i != range.end(); ++i) {
+          const double xi = nd[i].data.x;
+          const double yi = nd[i].data.y;
+          double rho = 0.;
+          // speed up search by looking within +/- delta_c window only
+          tiles.forEachTileInBox(
+              xi - delta_c, xi + delta_c, yi - delta_c, yi + delta_c,
+              [&](unsigned int first, unsigned int last) {
+                for (unsigned int k = first; k < last; ++k) {
+                  const double dx = xi - tiles.x(k);
+                  const double dy = yi - tiles.y(k);
+                  if (std::sqrt(dx * dx + dy * dy) < delta_c)
+                    rho += tiles.weight(k);
+                }
+              });
+          nd[i].data.rho += rho;
+        }
+      });
+
+  double maxdensity = 0.;
+  for (auto &it : nd)
+    maxdensity = std::max(maxdensity, it.data.rho);
   return maxdensity;
 }
 
 double
-HGCalImagingAlgo::calculateDistanceToHigher(std::vector<KDNode> &nd) const {
+HGCalImagingAlgo::calculateDistanceToHigher(std::vector<KDNode> &nd,
+                                            const HGCalLayerTiles &tiles) const {
 
   // sort vector of Hexels by decreasing local density
   std::vector<size_t> rs = sorted_indices(nd);
@@ -289,31 +303,46 @@ HGCalImagingAlgo::calculateDistanceToHigher(std::vector<KDNode> &nd) const {
   const double max_dist2 = dist2;
   const unsigned int nd_size = nd.size();
 
+  // position of each hit in the ordering by decreasing density: all points
+  // coming BEFORE oi are guaranteed to have higher rho and the ones AFTER to
+  // have lower rho
+  std::vector<unsigned int> order(nd_size);
+  for (unsigned int oi = 0; oi < nd_size; ++oi)
+    order[rs[oi]] = oi;
+
+  // the nearest hit with higher density within max_dist, or -1, searched in
+  // rings of tiles of increasing size around the hit until no hit outside of
+  // them can be closer
+  std::vector<int> nearest(nd_size, -1);
+  std::vector<double> nearestDist2(nd_size, max_dist2);
+  tbb::parallel_for(
+      tbb::blocked_range<unsigned int>(1, nd_size, 256),
+      [&](const tbb::blocked_range<unsigned int> &range) {
+        for (unsigned int oi = range.begin(); oi != range.end(); ++oi) {
+          const unsigned int i = rs[oi];
+          // of equally distant hits the last one in density order is kept,
+          // as the "<=" of a scan in that order (which addresses the (rare)
+          // case when there are only two hits)
+          nearest[i] = tiles.nearestBefore(nd[i].data.x, nd[i].data.y, oi,
+                                           order, nearestDist2[i]);
+        }
+      });
+
   for (unsigned int oi = 1; oi < nd_size;
        ++oi) { // start from second-highest density
-    dist2 = max_dist2;
     unsigned int i = rs[oi];
-    // we only need to check up to oi since hits
-    // are ordered by decreasing density
-    // and all points coming BEFORE oi are guaranteed to have higher rho
-    // and the ones AFTER to have lower rho
-    for (unsigned int oj = 0; oj < oi; ++oj) {
-      unsigned int j = rs[oj];
-      double tmp = distance2(nd[i].data, nd[j].data);
-      if (tmp <= dist2) { // this "<=" instead of "<" addresses the (rare) case
-                          // when there are only two hits
-        dist2 = tmp;
-        nearestHigher = j;
-      }
-    }
-    nd[i].data.delta = std::sqrt(dist2);
+    // a hit with no higher one within max_dist keeps the nearestHigher of
+    // the previous hit
+    if (nearest[i] != -1)
+      nearestHigher = nearest[i];
+    nd[i].data.delta = std::sqrt(nearestDist2[i]);
     nd[i].data.nearestHigher =
         nearestHigher; // this uses the original unsorted hitlist
   }
   return maxdensity;
 }
 int HGCalImagingAlgo::findAndAssignClusters(
-    std::vector<KDNode> &nd, KDTree &lp, double maxdensity, KDTreeBox &bounds,
+    std::vector<KDNode> &nd, const HGCalLayerTiles &tiles, double maxdensity,
     const unsigned int layer,
     std::vector<std::vector<KDNode>> &clustersOnLayer) const {
 
@@ -323,13 +352,7 @@ int HGCalImagingAlgo::findAndAssignClusters(
   // cluster centers...
 
   unsigned int nClustersOnLayer = 0;
-  float delta_c; // critical distance
-  if (layer <= lastLayerEE)
-    delta_c = vecDeltas_[0];
-  else if (layer <= lastLayerFH)
-    delta_c = vecDeltas_[1];
-  else
-    delta_c = vecDeltas_[2];
+  const float delta_c = criticalDistance(layer); // critical distance
 
   std::vector<size_t> rs =
       sorted_indices(nd); // indices sorted by decreasing rho
@@ -387,46 +410,50 @@ int HGCalImagingAlgo::findAndAssignClusters(
   // assign points closer than dc to other clusters to border region
   // and find critical border density
   std::vector<double> rho_b(nClustersOnLayer, 0.);
-  lp.clear();
-  lp.build(nd, bounds);
   // now loop on all hits again :( and check: if there are hits from another
   // cluster within d_c -> flag as border hit
-  for (unsigned int i = 0; i < nd_size; ++i) {
-    int ci = nd[i].data.clusterIndex;
-    bool flag_isolated = true;
-    if (ci != -1) {
-      KDTreeBox search_box(nd[i].dims[0] - delta_c, nd[i].dims[0] + delta_c,
-                           nd[i].dims[1] - delta_c, nd[i].dims[1] + delta_c);
-      std::vector<KDNode> found;
-      lp.search(search_box, found);
-
-      const unsigned int found_size = found.size();
-      for (unsigned int j = 0; j < found_size;
-           j++) { // start from 0 here instead of 1
-        // check if the hit is not within d_c of another cluster
-        if (found[j].data.clusterIndex != -1) {
-          float dist = distance(found[j].data, nd[i].data);
-          if (dist < delta_c && found[j].data.clusterIndex != ci) {
-            // in which case we assign it to the border
+  tbb::parallel_for(
+      tbb::blocked_range<unsigned int>(0, nd_size, 256),
+      [&](const tbb::blocked_range<unsigned int> &range) {
+        for (unsigned int i = range.begin(); i != range.end(); ++i) {
+          int ci = nd[i].data.clusterIndex;
+          if (ci == -1)
+            continue;
+          bool flag_border = false;
+          bool flag_isolated = true;
+          tiles.forEachTileInBox(
+              nd[i].data.x - delta_c, nd[i].data.x + delta_c,
+              nd[i].data.y - delta_c, nd[i].data.y + delta_c,
+              [&](unsigned int first, unsigned int last) {
+                for (unsigned int k = first; k < last; ++k) {
+                  const auto &found = nd[tiles.index(k)].data;
+                  // check if the hit is not within d_c of another cluster
+                  if (found.clusterIndex == -1)
+                    continue;
+                  float dist = distance(found, nd[i].data);
+                  if (dist < delta_c && found.clusterIndex != ci) {
+                    // in which case we assign it to the border
+                    flag_border = true;
+                  }
+                  // make sure that we don't unflag the hit when it finds
+                  // *itself* closer than delta_c
+                  if (dist < delta_c && dist != 0. && found.clusterIndex == ci) {
+                    // in this case it is not an isolated hit
+                    // the dist!=0 is because the hit being looked at is also
+                    // inside the search box and at dist==0
+                    flag_isolated = false;
+                  }
+                }
+              });
+          // the hit is either within delta_c of another cluster or more than
+          // delta_c from any of its brethren
+          if (flag_border || flag_isolated)
             nd[i].data.isBorder = true;
-            break;
-          }
-          // because we are using two different containers, we have to make sure
-          // that we don't unflag the
-          // hit when it finds *itself* closer than delta_c
-          if (dist < delta_c && dist != 0. &&
-              found[j].data.clusterIndex == ci) {
-            // in this case it is not an isolated hit
-            // the dist!=0 is because the hit being looked at is also inside the
-            // search box and at dist==0
-            flag_isolated = false;
-          }
         }
-      }
-      if (flag_isolated)
-        nd[i].data.isBorder =
-            true; // the hit is more than delta_c from any of its brethren
-    }
+      });
+
+  for (unsigned int i = 0; i < nd_size; ++i) {
+    int ci = nd[i].data.clusterIndex;
     // check if this border hit has density larger than the current rho_b and
     // update
     if (nd[i].data.isBorder && rho_b[ci] < nd[i].data.rho)
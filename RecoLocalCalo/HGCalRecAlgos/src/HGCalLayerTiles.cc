@@ -0,0 +1,89 @@
+#include "RecoLocalCalo/HGCalRecAlgos/interface/HGCalLayerTiles.h"
+
+#include <cmath>
+#include <limits>
+
+void HGCalLayerTiles::fill(const std::vector<double>& x, const std::vector<double>& y,
+                           const std::vector<double>& weight, float xmin, float xmax,
+                           float ymin, float ymax, float tileSize) {
+  const double extent = std::max(xmax - xmin, ymax - ymin);
+  tileSize_ = std::max(double(tileSize), extent / maxTilesPerDim);
+  if (!(tileSize_ > 0.))
+    tileSize_ = 1.;
+  invTileSize_ = 1. / tileSize_;
+  xmin_ = xmin;
+  ymin_ = ymin;
+  nx_ = std::min(int((xmax - xmin) * invTileSize_) + 1, maxTilesPerDim);
+  ny_ = std::min(int((ymax - ymin) * invTileSize_) + 1, maxTilesPerDim);
+
+  // counting sort of the hits by tile
+  const unsigned int nHits = x.size();
+  std::vector<unsigned int> tile(nHits);
+  tileBegin_.assign(nx_ * ny_ + 1, 0);
+  for (unsigned int i = 0; i < nHits; ++i) {
+    tile[i] = yBin(y[i]) * nx_ + xBin(x[i]);
+    ++tileBegin_[tile[i] + 1];
+  }
+  for (unsigned int t = 0; t + 1 < tileBegin_.size(); ++t)
+    tileBegin_[t + 1] += tileBegin_[t];
+
+  x_.resize(nHits);
+  y_.resize(nHits);
+  weight_.resize(nHits);
+  index_.resize(nHits);
+  std::vector<unsigned int> next(tileBegin_.begin(), tileBegin_.end() - 1);
+  for (unsigned int i = 0; i < nHits; ++i) {
+    const unsigned int k = next[tile[i]]++;
+    x_[k] = x[i];
+    y_[k] = y[i];
+    weight_[k] = weight[i];
+    index_[k] = i;
+  }
+}
+
+double HGCalLayerTiles::distanceOutside(double x, double y, int ix, int iy,
+                                        int r) const {
+  double d = std::numeric_limits<double>::infinity();
+  if (ix - r > 0)
+    d = std::min(d, x - (xmin_ + (ix - r) * tileSize_));
+  if (ix + r < nx_ - 1)
+    d = std::min(d, xmin_ + (ix + r + 1) * tileSize_ - x);
+  if (iy - r > 0)
+    d = std::min(d, y - (ymin_ + (iy - r) * tileSize_));
+  if (iy + r < ny_ - 1)
+    d = std::min(d, ymin_ + (iy + r + 1) * tileSize_ - y);
+  // the bins are found as int((x - xmin_)*invTileSize_), with the reciprocal,
+  // while the edges above are xmin_ + b*tileSize_: a hit a few ulps from an
+  // edge can be binned on either side of it. The slack, much larger than that
+  // and much smaller than a tile, keeps the bound below the distance of any
+  // hit binned outside of the ring
+  return std::isinf(d) ? d : std::max(d - 1e-3 * tileSize_, 0.);
+}
+
+int HGCalLayerTiles::nearestBefore(double x, double y, unsigned int o,
+                                   const std::vector<unsigned int>& order,
+                                   double& dist2) const {
+  const int ix = xBin(x);
+  const int iy = yBin(y);
+  int best = -1;
+  for (int r = 0;; ++r) {
+    forEachTileInRing(ix, iy, r, [&](unsigned int first, unsigned int last) {
+      for (unsigned int k = first; k < last; ++k) {
+        const unsigned int j = index_[k];
+        if (order[j] >= o)
+          continue;
+        const double dx = x - x_[k];
+        const double dy = y - y_[k];
+        const double tmp = dx * dx + dy * dy;
+        if (tmp < dist2 ||
+            (tmp == dist2 && (best == -1 || order[j] > order[best]))) {
+          dist2 = tmp;
+          best = j;
+        }
+      }
+    });
+    const double outside = distanceOutside(x, y, ix, iy, r);
+    if (outside * outside > dist2)
+      return best;
+  }
+}
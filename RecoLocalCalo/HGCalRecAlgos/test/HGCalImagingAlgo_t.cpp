@@ -0,0 +1,293 @@
+// The layer steps of HGCalImagingAlgo::makeClusters on the tiles must give the
+// densities, distances to the nearest higher hit, nearest higher hits, cluster
+// indices and border flags of the KD-tree searches they replace. The layers are
+// the ones of HGCalLayerTiles_t, on a layer of each subdetector (each with its
+// critical distance, the last one in the other endcap). The energies are
+// multiples of 1/64, so that the densities are exact whatever the order in
+// which the hits are summed; the KD tree reorders the hits, which are put back
+// in their order after the density, so that the hits of equal density are
+// sorted alike on both sides. The lattices on the critical distance find the
+// hits the KD tree missed on the edges of its search boxes (see searchBox).
+
+#include "RecoLocalCalo/HGCalRecAlgos/interface/HGCalImagingAlgo.h"
+
+#include "DataFormats/DetId/interface/DetId.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+  struct Layer {
+    std::string name;
+    std::vector<double> x;
+    std::vector<double> y;
+  };
+
+  // the positions of the hits are floats, as the ones of the geometry
+  void addHit(Layer &layer, float x, float y) {
+    layer.x.push_back(x);
+    layer.y.push_back(y);
+  }
+
+  std::vector<Layer> makeLayers(std::mt19937 &rng) {
+    std::uniform_real_distribution<float> flat(-50.f, 50.f);
+    std::normal_distribution<float> gauss(0.f, 1.5f);
+    std::vector<Layer> layers;
+
+    for (unsigned int n : {100u, 1000u, 5000u}) {
+      Layer layer{"random " + std::to_string(n)};
+      for (unsigned int i = 0; i < n; ++i)
+        addHit(layer, flat(rng), flat(rng));
+      layers.push_back(layer);
+    }
+
+    Layer clustered{"clustered"};
+    for (unsigned int c = 0; c < 20; ++c) {
+      float x0 = flat(rng), y0 = flat(rng);
+      for (unsigned int i = 0; i < 100; ++i)
+        addHit(clustered, x0 + gauss(rng), y0 + gauss(rng));
+    }
+    layers.push_back(clustered);
+
+    // a pitch commensurate with the critical distances, so that hits lie on
+    // the tile edges and at the critical distance of each other
+    for (float pitch : {0.5f, 1.f, 1.3f}) {
+      Layer lattice{"lattice " + std::to_string(pitch)};
+      for (int i = 0; i < 40; ++i)
+        for (int j = 0; j < 40; ++j)
+          addHit(lattice, i * pitch, j * pitch);
+      layers.push_back(lattice);
+    }
+
+    Layer stacked{"stacked"};
+    for (unsigned int i = 0; i < 500; ++i) {
+      float x = std::round(flat(rng) / 5.f), y = std::round(flat(rng) / 5.f);
+      addHit(stacked, x, y);
+    }
+    layers.push_back(stacked);
+
+    Layer samePoint{"same point"};
+    for (unsigned int i = 0; i < 50; ++i)
+      addHit(samePoint, 3.f, -7.f);
+    layers.push_back(samePoint);
+
+    Layer single{"single hit"};
+    addHit(single, 1.f, 2.f);
+    layers.push_back(single);
+
+    Layer two{"two hits"};
+    addHit(two, 1.f, 2.f);
+    addHit(two, 4.f, -2.f);
+    layers.push_back(two);
+
+    Layer line{"line"};
+    for (unsigned int i = 0; i < 300; ++i)
+      addHit(line, flat(rng), 10.f);
+    layers.push_back(line);
+
+    Layer large{"larger than the tiles"};
+    std::uniform_real_distribution<float> wide(-1500.f, 1500.f);
+    for (unsigned int i = 0; i < 3000; ++i)
+      addHit(large, wide(rng), i % 10 ? flat(rng) : wide(rng));
+    layers.push_back(large);
+
+    return layers;
+  }
+
+}
+
+class testHGCalImagingAlgo {
+public:
+  typedef HGCalImagingAlgo::KDNode KDNode;
+  typedef HGCalImagingAlgo::KDTree KDTree;
+
+  // the hits of a layer, the DetId holding the position of the hit + 1
+  static std::vector<KDNode> nodes(const Layer &layer, std::mt19937 &rng) {
+    std::uniform_int_distribution<int> energy(1, 1024);
+    std::vector<KDNode> nd;
+    for (unsigned int i = 0; i < layer.x.size(); ++i) {
+      HGCalImagingAlgo::Hexel hexel;
+      hexel.x = layer.x[i];
+      hexel.y = layer.y[i];
+      hexel.weight = energy(rng) / 64.;
+      hexel.detid = DetId(i + 1);
+      nd.emplace_back(hexel, float(layer.x[i]), float(layer.y[i]));
+    }
+    return nd;
+  }
+
+  // the box around a hit: the KD tree skips the subtrees which only touch
+  // the box (their regions are compared strictly), so it misses the hits
+  // on its edges although they are closer than delta_c. The box is widened
+  // by a float step, so that the reference finds them as the tiles do
+  static KDTreeBox searchBox(const KDNode &n, float delta_c) {
+    auto below = [](float v) { return std::nextafter(v, -std::numeric_limits<float>::infinity()); };
+    auto above = [](float v) { return std::nextafter(v, std::numeric_limits<float>::infinity()); };
+    return KDTreeBox(below(n.dims[0] - delta_c), above(n.dims[0] + delta_c),
+                     below(n.dims[1] - delta_c), above(n.dims[1] + delta_c));
+  }
+
+  // makeClusters on one layer before the tiles, up to the border flags
+  static void kdTreeReference(const HGCalImagingAlgo &algo, std::vector<KDNode> &nd,
+                              const KDTreeBox &bounds, unsigned int layer) {
+    const float delta_c = algo.criticalDistance(layer);
+    KDTree lp;
+    lp.build(nd, bounds);
+
+    double maxdensity = 0.;
+    for (unsigned int i = 0; i < nd.size(); ++i) {
+      std::vector<KDNode> found;
+      lp.search(searchBox(nd[i], delta_c), found);
+      for (const auto &f : found) {
+        if (algo.distance(nd[i].data, f.data) < delta_c) {
+          nd[i].data.rho += f.data.weight;
+          maxdensity = std::max(maxdensity, nd[i].data.rho);
+        }
+      }
+    }
+    std::sort(nd.begin(), nd.end(),
+              [](const KDNode &a, const KDNode &b) { return a.data.detid < b.data.detid; });
+    if (nd.empty())
+      return;
+
+    // the full scan of the hits in density order
+    std::vector<size_t> rs = sorted_indices(nd);
+    double dist2 = 0.;
+    for (const auto &j : nd)
+      dist2 = std::max(dist2, algo.distance2(nd[rs[0]].data, j.data));
+    nd[rs[0]].data.delta = std::sqrt(dist2);
+    nd[rs[0]].data.nearestHigher = -1;
+    const double max_dist2 = dist2;
+    int nearestHigher = -1;
+    for (unsigned int oi = 1; oi < nd.size(); ++oi) {
+      const unsigned int i = rs[oi];
+      dist2 = max_dist2;
+      for (unsigned int oj = 0; oj < oi; ++oj) {
+        const unsigned int j = rs[oj];
+        const double tmp = algo.distance2(nd[i].data, nd[j].data);
+        if (tmp <= dist2) {
+          dist2 = tmp;
+          nearestHigher = j;
+        }
+      }
+      nd[i].data.delta = std::sqrt(dist2);
+      nd[i].data.nearestHigher = nearestHigher;
+    }
+
+    // the cluster centers and the other hits, as on the tiles
+    std::vector<size_t> ds = algo.sort_by_delta(nd);
+    unsigned int nClusters = 0;
+    for (unsigned int i = 0; i < nd.size(); ++i) {
+      if (nd[ds[i]].data.delta < delta_c)
+        break;
+      if (nd[ds[i]].data.rho * algo.kappa_ < maxdensity)
+        continue;
+      nd[ds[i]].data.clusterIndex = nClusters++;
+    }
+    if (nClusters == 0)
+      return;
+    for (unsigned int oi = 1; oi < nd.size(); ++oi) {
+      const unsigned int i = rs[oi];
+      if (nd[i].data.clusterIndex == -1)
+        nd[i].data.clusterIndex = nd[nd[i].data.nearestHigher].data.clusterIndex;
+    }
+
+    // the border hits, on a new tree with the cluster indices
+    lp.clear();
+    lp.build(nd, bounds);
+    for (unsigned int i = 0; i < nd.size(); ++i) {
+      const int ci = nd[i].data.clusterIndex;
+      if (ci == -1)
+        continue;
+      bool flag_isolated = true;
+      std::vector<KDNode> found;
+      lp.search(searchBox(nd[i], delta_c), found);
+      for (const auto &f : found) {
+        if (f.data.clusterIndex == -1)
+          continue;
+        float dist = algo.distance(f.data, nd[i].data);
+        if (dist < delta_c && f.data.clusterIndex != ci) {
+          nd[i].data.isBorder = true;
+          break;
+        }
+        if (dist < delta_c && dist != 0. && f.data.clusterIndex == ci)
+          flag_isolated = false;
+      }
+      if (flag_isolated)
+        nd[i].data.isBorder = true;
+    }
+  }
+
+  // makeClusters with the layer at the given index of points_, compared with
+  // the reference hit by hit
+  static bool same(const Layer &layer, unsigned int index, std::mt19937 &rng,
+                   unsigned int &nClusters, unsigned int &nBorder) {
+    const std::vector<double> vecDeltas = {1.3, 2., 9.};
+    const std::vector<double> none;
+    HGCalImagingAlgo algo(vecDeltas, 9., 0., reco::CaloCluster::hgcal_mixed, false,
+                          none, none, none, 0., none, 0.);
+    const unsigned int maxlayer = HGCalImagingAlgo::maxlayer;
+    const unsigned int actualLayer = index > maxlayer ? index - (maxlayer + 1) : index;
+
+    std::vector<KDNode> nd = nodes(layer, rng);
+    float xmin = nd[0].dims[0], xmax = xmin, ymin = nd[0].dims[1], ymax = ymin;
+    for (const auto &n : nd) {
+      xmin = std::min(xmin, n.dims[0]);
+      xmax = std::max(xmax, n.dims[0]);
+      ymin = std::min(ymin, n.dims[1]);
+      ymax = std::max(ymax, n.dims[1]);
+    }
+    algo.points_[index] = nd;
+    algo.minpos_[index] = {{xmin, ymin}};
+    algo.maxpos_[index] = {{xmax, ymax}};
+    algo.makeClusters();
+    const std::vector<KDNode> &tiled = algo.points_[index];
+
+    KDTreeBox bounds(xmin, xmax, ymin, ymax);
+    kdTreeReference(algo, nd, bounds, actualLayer);
+
+    unsigned int nRho = 0, nDelta = 0, nNearest = 0, nIndex = 0, nFlag = 0;
+    for (const auto &ref : nd) {
+      const auto &hit = tiled[ref.data.detid.rawId() - 1].data;
+      nRho += hit.rho != ref.data.rho;
+      nDelta += hit.delta != ref.data.delta;
+      nNearest += hit.nearestHigher != ref.data.nearestHigher;
+      nIndex += hit.clusterIndex != ref.data.clusterIndex;
+      nFlag += hit.isBorder != ref.data.isBorder;
+      nBorder += hit.isBorder;
+    }
+    nClusters += algo.layerClustersPerLayer_[index].size();
+    if (nRho || nDelta || nNearest || nIndex || nFlag) {
+      std::cout << layer.name << ", critical distance " << algo.criticalDistance(actualLayer)
+                << ": of the " << nd.size() << " hits, " << nRho << " have a different density, "
+                << nDelta << " delta, " << nNearest << " nearest higher hit, " << nIndex
+                << " cluster and " << nFlag << " border flag" << std::endl;
+      return false;
+    }
+    return true;
+  }
+};
+
+int main() {
+  std::mt19937 rng(2017);
+  int failures = 0;
+  unsigned int nClusters = 0, nBorder = 0;
+
+  // EE, FH and BH layers, the last one in the positive endcap
+  const unsigned int indices[] = {10, 35, HGCalImagingAlgo::maxlayer + 1 + 45};
+  for (const auto &layer : makeLayers(rng))
+    for (unsigned int index : indices)
+      if (!testHGCalImagingAlgo::same(layer, index, rng, nClusters, nBorder))
+        ++failures;
+
+  if (failures) return 1;
+  std::cout << "HGCalImagingAlgo: the layers on the tiles are identical to the KD-tree ones ("
+            << nClusters << " clusters, " << nBorder << " border hits)" << std::endl;
+  return 0;
+}
@@ -0,0 +1,175 @@
+// The search of the nearest hit with higher density in rings of tiles, as
+// done by HGCalImagingAlgo::calculateDistanceToHigher, must find the same hit
+// at the same distance as the full scan of the hits in density order it
+// replaces. The layers are random, clustered, on a lattice (many equally
+// distant hits), with hits on top of each other, with one or two hits, and
+// larger than the largest number of tiles; the largest distance is the one of
+// the algorithm (to the farthest hit from the densest one) or a small one,
+// which leaves many hits with no denser hit within it.
+
+#include "RecoLocalCalo/HGCalRecAlgos/interface/HGCalLayerTiles.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+  struct Layer {
+    std::string name;
+    std::vector<double> x;
+    std::vector<double> y;
+  };
+
+  // the positions of the hits are floats, as the ones of the geometry
+  void addHit(Layer &layer, float x, float y) {
+    layer.x.push_back(x);
+    layer.y.push_back(y);
+  }
+
+  std::vector<Layer> makeLayers(std::mt19937 &rng) {
+    std::uniform_real_distribution<float> flat(-50.f, 50.f);
+    std::normal_distribution<float> gauss(0.f, 1.5f);
+    std::vector<Layer> layers;
+
+    for (unsigned int n : {100u, 1000u, 5000u}) {
+      Layer layer{"random " + std::to_string(n)};
+      for (unsigned int i = 0; i < n; ++i)
+        addHit(layer, flat(rng), flat(rng));
+      layers.push_back(layer);
+    }
+
+    Layer clustered{"clustered"};
+    for (unsigned int c = 0; c < 20; ++c) {
+      float x0 = flat(rng), y0 = flat(rng);
+      for (unsigned int i = 0; i < 100; ++i)
+        addHit(clustered, x0 + gauss(rng), y0 + gauss(rng));
+    }
+    layers.push_back(clustered);
+
+    // a pitch commensurate with the tiles, so that hits lie on the tile edges
+    for (float pitch : {0.5f, 1.f, 1.3f}) {
+      Layer lattice{"lattice " + std::to_string(pitch)};
+      for (int i = 0; i < 40; ++i)
+        for (int j = 0; j < 40; ++j)
+          addHit(lattice, i * pitch, j * pitch);
+      layers.push_back(lattice);
+    }
+
+    Layer stacked{"stacked"};
+    for (unsigned int i = 0; i < 500; ++i) {
+      float x = std::round(flat(rng) / 5.f), y = std::round(flat(rng) / 5.f);
+      addHit(stacked, x, y);
+    }
+    layers.push_back(stacked);
+
+    Layer samePoint{"same point"};
+    for (unsigned int i = 0; i < 50; ++i)
+      addHit(samePoint, 3.f, -7.f);
+    layers.push_back(samePoint);
+
+    Layer single{"single hit"};
+    addHit(single, 1.f, 2.f);
+    layers.push_back(single);
+
+    Layer two{"two hits"};
+    addHit(two, 1.f, 2.f);
+    addHit(two, 4.f, -2.f);
+    layers.push_back(two);
+
+    Layer line{"line"};
+    for (unsigned int i = 0; i < 300; ++i)
+      addHit(line, flat(rng), 10.f);
+    layers.push_back(line);
+
+    Layer large{"larger than the tiles"};
+    std::uniform_real_distribution<float> wide(-1500.f, 1500.f);
+    for (unsigned int i = 0; i < 3000; ++i)
+      addHit(large, wide(rng), i % 10 ? flat(rng) : wide(rng));
+    layers.push_back(large);
+
+    return layers;
+  }
+
+  // the scan of HGCalImagingAlgo before the tiles
+  int fullScan(const Layer &layer, const std::vector<size_t> &rs, unsigned int oi, double &dist2) {
+    const unsigned int i = rs[oi];
+    int nearestHigher = -1;
+    for (unsigned int oj = 0; oj < oi; ++oj) {
+      const unsigned int j = rs[oj];
+      const double dx = layer.x[i] - layer.x[j];
+      const double dy = layer.y[i] - layer.y[j];
+      const double tmp = dx * dx + dy * dy;
+      if (tmp <= dist2) {
+        dist2 = tmp;
+        nearestHigher = j;
+      }
+    }
+    return nearestHigher;
+  }
+
+}
+
+int main() {
+  std::mt19937 rng(2017);
+  int failures = 0;
+
+  for (const auto &layer : makeLayers(rng)) {
+    const unsigned int n = layer.x.size();
+    float xmin = layer.x[0], xmax = layer.x[0], ymin = layer.y[0], ymax = layer.y[0];
+    for (unsigned int i = 1; i < n; ++i) {
+      xmin = std::min(xmin, float(layer.x[i]));
+      xmax = std::max(xmax, float(layer.x[i]));
+      ymin = std::min(ymin, float(layer.y[i]));
+      ymax = std::max(ymax, float(layer.y[i]));
+    }
+
+    for (float tileSize : {1.3f, 2.f, 9.f}) {
+      HGCalLayerTiles tiles;
+      tiles.fill(layer.x, layer.y, std::vector<double>(n, 1.), xmin, xmax, ymin, ymax, tileSize);
+
+      // the density order is random
+      std::vector<size_t> rs(n);
+      std::iota(rs.begin(), rs.end(), 0);
+      std::shuffle(rs.begin(), rs.end(), rng);
+      std::vector<unsigned int> order(n);
+      for (unsigned int oi = 0; oi < n; ++oi)
+        order[rs[oi]] = oi;
+
+      double farthest2 = 0.;
+      for (unsigned int j = 0; j < n; ++j) {
+        const double dx = layer.x[rs[0]] - layer.x[j];
+        const double dy = layer.y[rs[0]] - layer.y[j];
+        farthest2 = std::max(farthest2, dx * dx + dy * dy);
+      }
+
+      for (double max_dist2 : {farthest2, 0.49 * tileSize * tileSize, 4. * tileSize * tileSize}) {
+        unsigned int nDifferent = 0, nNone = 0;
+        for (unsigned int oi = 1; oi < n; ++oi) {
+          const unsigned int i = rs[oi];
+          double dist2 = max_dist2, tilesDist2 = max_dist2;
+          const int nearest = fullScan(layer, rs, oi, dist2);
+          const int tilesNearest = tiles.nearestBefore(layer.x[i], layer.y[i], oi, order, tilesDist2);
+          if (tilesNearest != nearest || tilesDist2 != dist2)
+            ++nDifferent;
+          if (nearest == -1)
+            ++nNone;
+        }
+        if (nDifferent) {
+          std::cout << layer.name << ", tile size " << tileSize << ", largest distance " << std::sqrt(max_dist2)
+                    << ": " << nDifferent << " of the " << n << " hits have a different nearest higher hit"
+                    << " (" << nNone << " have none)" << std::endl;
+          ++failures;
+        }
+      }
+    }
+  }
+
+  if (failures) return 1;
+  std::cout << "HGCalLayerTiles: the nearest higher hits are identical to the full scan ones" << std::endl;
+  return 0;
+}
@@ -14,6 +14,8 @@
 
 #include <Math/Functor.h>
 
+#include <unordered_map>
+
 struct MahiNnlsWorkspace {
 
   unsigned int nPulseTot;
@@ -79,6 +81,19 @@ struct MahiNnlsWorkspace {
 
 };
 
+// The pulse shape functor of one pulse shape, and the pulse shapes it
+// returned for arrival times on a regular grid. Shared by all the channels
+// reconstructed with that pulse shape.
+struct MahiPulseTemplates {
+
+  std::unique_ptr<FitterFuncs::PulseShapeFunctor> psf;
+  std::unique_ptr<ROOT::Math::Functor> functor;
+
+  // pulse shape for the arrival time node*step, filled on first use
+  std::unordered_map<int, std::array<double, MaxSVSize> > nodes;
+
+};
+
 struct MahiDebugInfo {
 
   int   nSamples;
@@ -125,7 +140,8 @@ class MahiFit
 		     bool iApplyTimeSlew, HcalTimeSlew::BiasSetting slewFlavor,
 		     double iMeanTime, double iTimeSigmaHPD, double iTimeSigmaSiPM, 
 		     const std::vector <int> &iActiveBXs, int iNMaxItersMin, int iNMaxItersNNLS,
-		     double iDeltaChiSqThresh, double iNnlsThresh);
+		     double iDeltaChiSqThresh, double iNnlsThresh,
+		     double iPulseTemplateStep = 0);
 
   void phase1Apply(const HBHEChannelInfo& channelData, 
 		   float& reconstructedEnergy, 
@@ -154,6 +170,9 @@ class MahiFit
 			FullSampleVector &pulseDeriv,
 			FullSampleMatrix &pulseCov) const;
 
+  void evaluatePulseShape(double t0, std::array<double, MaxSVSize> &pulse) const;
+  const std::array<double, MaxSVSize>& pulseTemplate(int node) const;
+
   double calculateArrivalTime() const;
   double calculateChiSq() const;
   void nnls() const;
@@ -197,13 +216,17 @@ class MahiFit
   float deltaChiSqThresh_; 
   float nnlsThresh_; 
 
+  // arrival time step (ns) of the tabulated pulse shapes, 0 to evaluate
+  // the pulse shape functor for every fit
+  double pulseTemplateStep_=0;
+
   unsigned int bxSizeConf_;
   int bxOffsetConf_;
 
   //for pulse shapes
   int cntsetPulseShape_;
-  std::unique_ptr<FitterFuncs::PulseShapeFunctor> psfPtr_;
-  std::unique_ptr<ROOT::Math::Functor> pfunctor_;
+  std::unordered_map<const HcalPulseShapes::Shape*, MahiPulseTemplates> pulseTemplates_;
+  MahiPulseTemplates* currentTemplates_=nullptr;
 
 }; 
 #endif
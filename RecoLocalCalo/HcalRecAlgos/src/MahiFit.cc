@@ -1,6 +1,8 @@
 #include "RecoLocalCalo/HcalRecAlgos/interface/MahiFit.h" 
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
+#include <cmath>
+
 MahiFit::MahiFit() :
   fullTSSize_(19), 
   fullTSofInterest_(8)
@@ -10,7 +12,8 @@ void MahiFit::setParameters(bool iDynamicPed, double iTS4Thresh, double chiSqSwi
 			    bool iApplyTimeSlew, HcalTimeSlew::BiasSetting slewFlavor,
 			    double iMeanTime, double iTimeSigmaHPD, double iTimeSigmaSiPM, 
 			    const std::vector <int> &iActiveBXs, int iNMaxItersMin, int iNMaxItersNNLS,
-			    double iDeltaChiSqThresh, double iNnlsThresh) {
+			    double iDeltaChiSqThresh, double iNnlsThresh,
+			    double iPulseTemplateStep) {
 
   dynamicPed_    = iDynamicPed;
 
@@ -32,6 +35,9 @@ void MahiFit::setParameters(bool iDynamicPed, double iTS4Thresh, double chiSqSwi
   deltaChiSqThresh_ = iDeltaChiSqThresh;
   nnlsThresh_    = iNnlsThresh;
 
+  pulseTemplateStep_ = iPulseTemplateStep;
+  for (auto& templates : pulseTemplates_) templates.second.nodes.clear();
+
   bxOffsetConf_ = -(*std::min_element(activeBXs_.begin(), activeBXs_.end()));
   bxSizeConf_   = activeBXs_.size();
 
@@ -256,25 +262,12 @@ void MahiFit::updatePulseShape(double itQ, FullSampleVector &pulseShape, FullSam
     else t0+=hcalTimeSlewDelay_->delay(itQ,slewFlavor_);
   }
 
-  nnlsWork_.pulseN.fill(0);
-  nnlsWork_.pulseM.fill(0);
-  nnlsWork_.pulseP.fill(0);
-
-  const double xx[4]={t0, 1.0, 0.0, 3};
-  const double xxm[4]={-nnlsWork_.dt+t0, 1.0, 0.0, 3};
-  const double xxp[4]={ nnlsWork_.dt+t0, 1.0, 0.0, 3};
-
-  (*pfunctor_)(&xx[0]);
-  psfPtr_->getPulseShape(nnlsWork_.pulseN);
-
-  (*pfunctor_)(&xxm[0]);
-  psfPtr_->getPulseShape(nnlsWork_.pulseM);
-  
-  (*pfunctor_)(&xxp[0]);
-  psfPtr_->getPulseShape(nnlsWork_.pulseP);
+  evaluatePulseShape(t0, nnlsWork_.pulseN);
+  evaluatePulseShape(-nnlsWork_.dt+t0, nnlsWork_.pulseM);
+  evaluatePulseShape( nnlsWork_.dt+t0, nnlsWork_.pulseP);
 
   //in the 2018+ case where the sample of interest (SOI) is in TS3, add an extra offset to align 
-  //with previous SOI=TS4 case assumed by psfPtr_->getPulseShape()
+  //with previous SOI=TS4 case assumed by PulseShapeFunctor::getPulseShape()
   int delta =nnlsWork_. tsOffset == 3 ? 1 : 0;
 
   for (unsigned int iTS=0; iTS<nnlsWork_.tsSize; ++iTS) {
@@ -300,6 +293,45 @@ void MahiFit::updatePulseShape(double itQ, FullSampleVector &pulseShape, FullSam
   
 }
 
+void MahiFit::evaluatePulseShape(double t0, std::array<double, MaxSVSize> &pulse) const {
+
+  if (pulseTemplateStep_<=0) {
+    pulse.fill(0);
+    const double xx[4]={t0, 1.0, 0.0, 3};
+    (*currentTemplates_->functor)(&xx[0]);
+    currentTemplates_->psf->getPulseShape(pulse);
+    return;
+  }
+
+  // linear interpolation between the tabulated pulse shapes around t0
+  const double x = t0/pulseTemplateStep_;
+  const int node = std::floor(x);
+  const double frac = x-node;
+
+  const auto& low = pulseTemplate(node);
+  const auto& high = pulseTemplate(node+1);
+
+  for (unsigned int iTS=0; iTS<pulse.size(); ++iTS) {
+    pulse[iTS] = (1.-frac)*low[iTS] + frac*high[iTS];
+  }
+}
+
+const std::array<double, MaxSVSize>& MahiFit::pulseTemplate(int node) const {
+
+  // references to the elements of an unordered_map stay valid on insertion
+  auto& nodes = currentTemplates_->nodes;
+  auto it = nodes.find(node);
+  if (it==nodes.end()) {
+    it = nodes.emplace(node, std::array<double, MaxSVSize>()).first;
+    it->second.fill(0);
+
+    const double xx[4]={node*pulseTemplateStep_, 1.0, 0.0, 3};
+    (*currentTemplates_->functor)(&xx[0]);
+    currentTemplates_->psf->getPulseShape(it->second);
+  }
+  return it->second;
+}
+
 void MahiFit::updateCov() const {
 
   nnlsWork_.invCovMat.resize(nnlsWork_.tsSize, nnlsWork_.tsSize);
@@ -468,7 +500,11 @@ void MahiFit::setPulseShapeTemplate(const HcalPulseShapes::Shape& ps,const HcalT
       hcalTimeSlewDelay_ = hcalTimeSlewDelay;
       tsDelay1GeV_= hcalTimeSlewDelay->delay(1.0, slewFlavor_);
 
-      resetPulseShapeTemplate(ps);
+      // the functor and the tabulated pulse shapes are kept for each pulse
+      // shape, so channels with alternating pulse shapes reuse them
+      auto it = pulseTemplates_.find(&ps);
+      if (it!=pulseTemplates_.end()) currentTemplates_ = &it->second;
+      else resetPulseShapeTemplate(ps);
       currentPulseShape_ = &ps;
     }
 }
@@ -476,12 +512,16 @@ void MahiFit::setPulseShapeTemplate(const HcalPulseShapes::Shape& ps,const HcalT
 void MahiFit::resetPulseShapeTemplate(const HcalPulseShapes::Shape& ps) { 
   ++ cntsetPulseShape_;
 
+  MahiPulseTemplates& templates = pulseTemplates_[&ps];
+
   // only the pulse shape itself from PulseShapeFunctor is used for Mahi
   // the uncertainty terms calculated inside PulseShapeFunctor are used for Method 2 only
-  psfPtr_.reset(new FitterFuncs::PulseShapeFunctor(ps,false,false,false,
-						   1,0,0,10));
-  pfunctor_ = std::unique_ptr<ROOT::Math::Functor>( new ROOT::Math::Functor(psfPtr_.get(),&FitterFuncs::PulseShapeFunctor::singlePulseShapeFunc, 3) );
+  templates.psf.reset(new FitterFuncs::PulseShapeFunctor(ps,false,false,false,
+							 1,0,0,10));
+  templates.functor = std::unique_ptr<ROOT::Math::Functor>( new ROOT::Math::Functor(templates.psf.get(),&FitterFuncs::PulseShapeFunctor::singlePulseShapeFunc, 3) );
+  templates.nodes.clear();
 
+  currentTemplates_ = &templates;
 
 }
 
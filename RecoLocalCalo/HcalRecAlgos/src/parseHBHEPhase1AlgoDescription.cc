@@ -29,13 +29,14 @@ parseHBHEMahiDescription(const edm::ParameterSet& conf)
   const int iNMaxItersNNLS    = conf.getParameter<int>    ("nMaxItersNNLS");
   const double iDeltaChiSqThresh = conf.getParameter<double> ("deltaChiSqThresh");
   const double iNnlsThresh = conf.getParameter<double> ("nnlsThresh");
+  const double iPulseTemplateStep = conf.getParameter<double> ("pulseTemplateStep");
 
   std::unique_ptr<MahiFit> corr = std::make_unique<MahiFit>();
 
   corr->setParameters(iDynamicPed, iTS4Thresh, chiSqSwitch, iApplyTimeSlew, HcalTimeSlew::Medium,
 		      iMeanTime, iTimeSigmaHPD, iTimeSigmaSiPM,
 		      iActiveBXs, iNMaxItersMin, iNMaxItersNNLS,
-		      iDeltaChiSqThresh, iNnlsThresh);
+		      iDeltaChiSqThresh, iNnlsThresh, iPulseTemplateStep);
 
   return corr;
 }
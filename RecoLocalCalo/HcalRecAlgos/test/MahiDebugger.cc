@@ -109,6 +109,7 @@ class MahiDebugger : public edm::one::EDAnalyzer<edm::one::SharedResources>  {
 
   float deltaChiSqThresh_; 
   float nnlsThresh_; 
+  double pulseTemplateStep_;
 
   unsigned int bxSizeConf_;
   int bxOffsetConf_;
@@ -187,7 +188,8 @@ MahiDebugger::MahiDebugger(const edm::ParameterSet& iConfig)
     nMaxItersMin_(iConfig.getParameter<int> ("nMaxItersMin")),
     nMaxItersNNLS_(iConfig.getParameter<int> ("nMaxItersNNLS")),
     deltaChiSqThresh_(iConfig.getParameter<double> ("deltaChiSqThresh")), 
-    nnlsThresh_(iConfig.getParameter<double> ("nnlsThresh"))
+    nnlsThresh_(iConfig.getParameter<double> ("nnlsThresh")),
+    pulseTemplateStep_(iConfig.getParameter<double> ("pulseTemplateStep"))
 {
 
   usesResource("TFileService");
@@ -197,7 +199,7 @@ MahiDebugger::MahiDebugger(const edm::ParameterSet& iConfig)
   mahi_ -> setParameters(dynamicPed_, ts4Thresh_, chiSqSwitch_, applyTimeSlew_, HcalTimeSlew::Medium,
 			 meanTime_, timeSigmaHPD_, timeSigmaSiPM_,
 			 activeBXs_, nMaxItersMin_, nMaxItersNNLS_,
-			 deltaChiSqThresh_, nnlsThresh_);
+			 deltaChiSqThresh_, nnlsThresh_, pulseTemplateStep_);
 
   token_ChannelInfo_ = consumes<HBHEChannelInfoCollection>(edm::InputTag("hbheprereco",""));
 }
@@ -385,6 +387,7 @@ MahiDebugger::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   desc.add<int>   ("nMaxItersNNLS");
   desc.add<double>("deltaChiSqThresh");
   desc.add<double>("nnlsThresh");
+  desc.add<double>("pulseTemplateStep", 0.0);
   
 
   //desc.add<std::string>("algoConfigClass");
@@ -0,0 +1,116 @@
+// Compares the Mahi fit with the pulse shape evaluated for every fit to the
+// one with tabulated pulse shapes: prints the time per channel of both, and
+// fails if the reconstructed energies differ by more than the tolerance.
+//
+// usage: mahiPulseTemplateBenchmark [pulseTemplateStep (ns)] [nChannels]
+
+#include "RecoLocalCalo/HcalRecAlgos/interface/MahiFit.h"
+#include "CalibCalorimetry/HcalAlgos/interface/HcalPulseShapes.h"
+#include "CalibCalorimetry/HcalAlgos/interface/HcalTimeSlew.h"
+#include "DataFormats/HcalRecHit/interface/HBHEChannelInfo.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+  std::vector<HBHEChannelInfo> makeChannels(unsigned int nChannels) {
+
+    // approximate fractions of the charge of an in-time HPD pulse, SOI in TS4
+    const double fractions[HBHEChannelInfo::MAXSAMPLES] = {0., 0., 0., 0.03, 0.62, 0.28, 0.05, 0.02, 0., 0.};
+
+    std::mt19937 rng(12345);
+    std::exponential_distribution<double> amplitude(1./200.);
+    std::uniform_real_distribution<double> pileup(0., 50.);
+    std::normal_distribution<double> noise(0., 1.);
+
+    std::vector<HBHEChannelInfo> channels(nChannels, HBHEChannelInfo(false, false));
+    for (auto& channel : channels) {
+      channel.setChannelInfo(HcalDetId(HcalBarrel, 1, 1, 1), 105, HBHEChannelInfo::MAXSAMPLES, 4, 0,
+			     0., 1., 0., false, false, false);
+
+      const double inTime = amplitude(rng);
+      const double early = pileup(rng);
+      for (unsigned int iTS=0; iTS<HBHEChannelInfo::MAXSAMPLES; ++iTS) {
+	double charge = 3. + inTime*fractions[iTS] + noise(rng);
+	if (iTS>0) charge += early*fractions[iTS-1];
+	channel.setSample(iTS, 0, 2.6, charge, 3., 1., 0.2, 0., 0.);
+      }
+    }
+    return channels;
+  }
+
+  double run(MahiFit& mahi, const HcalPulseShapes::Shape& shape, const HcalTimeSlew& timeSlew,
+	     const std::vector<HBHEChannelInfo>& channels, std::vector<float>& energies) {
+
+    energies.resize(channels.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i=0; i<channels.size(); ++i) {
+      float time, chi2;
+      bool useTriple;
+      mahi.setPulseShapeTemplate(shape, &timeSlew);
+      mahi.phase1Apply(channels[i], energies[i], time, useTriple, chi2);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+    return elapsed.count()/channels.size();
+  }
+
+}
+
+int main(int argc, char* argv[]) {
+
+  const double pulseTemplateStep = argc>1 ? std::atof(argv[1]) : 0.01;
+  const unsigned int nChannels = argc>2 ? std::atoi(argv[2]) : 20000;
+
+  // relative tolerance on the energy, with an absolute floor for small signals
+  const double relTolerance = 1e-3;
+  const double absTolerance = 1e-3;
+
+  HcalTimeSlew timeSlew;
+  timeSlew.addM2ParameterSet(23.960177, -3.178648, 16.00);
+  timeSlew.addM2ParameterSet(13.307784, -1.556668, 10.00);
+  timeSlew.addM2ParameterSet(9.109694, -1.075824, 6.25);
+
+  HcalPulseShapes pulseShapes;
+  const HcalPulseShapes::Shape& shape = pulseShapes.getShape(105);
+
+  const std::vector<HBHEChannelInfo> channels = makeChannels(nChannels);
+
+  auto configure = [](MahiFit& mahi, double step) {
+    mahi.setParameters(true, 0., 15., true, HcalTimeSlew::Medium, 0., 5., 2.5,
+		       std::vector<int>{-1, 0, 1}, 500, 500, 1e-3, 1e-11, step);
+  };
+
+  MahiFit exact, tabulated;
+  configure(exact, 0.);
+  configure(tabulated, pulseTemplateStep);
+
+  std::vector<float> exactEnergies, tabulatedEnergies;
+  const double exactTime = run(exact, shape, timeSlew, channels, exactEnergies);
+  // the first pass fills the table, the second one is timed
+  run(tabulated, shape, timeSlew, channels, tabulatedEnergies);
+  const double tabulatedTime = run(tabulated, shape, timeSlew, channels, tabulatedEnergies);
+
+  unsigned int nBad = 0;
+  double maxDiff = 0.;
+  for (unsigned int i=0; i<nChannels; ++i) {
+    const double diff = std::abs(exactEnergies[i]-tabulatedEnergies[i]);
+    maxDiff = std::max(maxDiff, diff/std::max(1., double(std::abs(exactEnergies[i]))));
+    if (diff > std::max(absTolerance, relTolerance*std::abs(exactEnergies[i]))) ++nBad;
+  }
+
+  std::cout << "channels: " << nChannels << ", pulse template step: " << pulseTemplateStep << " ns\n"
+	    << "exact pulse shapes:     " << exactTime << " us/channel\n"
+	    << "tabulated pulse shapes: " << tabulatedTime << " us/channel\n"
+	    << "max relative energy difference: " << maxDiff << ", channels out of tolerance: " << nBad
+	    << std::endl;
+
+  return nBad==0 ? 0 : 1;
+}
@@ -10,5 +10,8 @@ mahiParameters = cms.PSet(
     nMaxItersMin      = cms.int32(500),
     nMaxItersNNLS     = cms.int32(500),
     deltaChiSqThresh  = cms.double(1e-3),
-    nnlsThresh        = cms.double(1e-11)
+    nnlsThresh        = cms.double(1e-11),
+    # arrival time step (ns) of the tabulated pulse shapes shared by all
+    # channels, 0 evaluates the pulse shape for every fit
+    pulseTemplateStep = cms.double(0.0)
 )
@@ -0,0 +1,98 @@
+#ifndef RecoLocalTracker_SiPixelClusterizer_PixelOccupancyBitmap_H
+#define RecoLocalTracker_SiPixelClusterizer_PixelOccupancyBitmap_H
+
+//----------------------------------------------------------------------------
+//! \class PixelOccupancyBitmap
+//! \brief One bit per pixel of a module, and a dense index of the
+//!        occupied pixels.
+//!
+//! Each column is stored as a few 64 bit words.  Once all the pixels are
+//! set, makeIndex() numbers the occupied pixels by column, then by row:
+//! the index of a pixel is the first index of its column plus the number
+//! of occupied pixels below it (a popcount), so that the charges can be
+//! kept in a dense array instead of a matrix of the size of the module.
+//! Only the columns that have been set are cleared.
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class PixelOccupancyBitmap
+{
+ public:
+  inline PixelOccupancyBitmap() {}
+
+  inline void setSize( int rows, int cols);
+  inline int rows() const { return nrows;}
+  inline int columns() const { return ncols;}
+
+  inline void set( int row, int col);
+  inline bool test( int row, int col) const;
+
+  //! number the occupied pixels, returns their number
+  inline unsigned int makeIndex();
+  //! index of an occupied pixel, valid after makeIndex()
+  inline unsigned int index( int row, int col) const;
+
+  //! reset all the occupied pixels
+  inline void clear();
+
+ private:
+  std::vector<uint64_t> bits;       // nwords per column
+  std::vector<uint64_t> usedCols;   // one bit per column
+  std::vector<unsigned int> colIndex;  // index of the first occupied pixel of each used column
+  int nrows = 0;
+  int ncols = 0;
+  int nwords = 0;
+};
+
+
+void PixelOccupancyBitmap::setSize( int rows, int cols) {
+  nrows = rows;
+  ncols = cols;
+  nwords = (rows+63)/64;
+  bits.assign(nwords*cols, 0);
+  usedCols.assign((cols+63)/64, 0);
+  colIndex.resize(cols);
+}
+
+void PixelOccupancyBitmap::set( int row, int col) {
+  bits[col*nwords + row/64] |= uint64_t(1) << (row%64);
+  usedCols[col/64] |= uint64_t(1) << (col%64);
+}
+
+bool PixelOccupancyBitmap::test( int row, int col) const {
+  return bits[col*nwords + row/64] & (uint64_t(1) << (row%64));
+}
+
+unsigned int PixelOccupancyBitmap::makeIndex() {
+  unsigned int n = 0;
+  for (int cw = 0; cw < int(usedCols.size()); ++cw) {
+    for (uint64_t used = usedCols[cw]; used; used &= used-1) {
+      int col = cw*64 + __builtin_ctzll(used);
+      colIndex[col] = n;
+      for (int w = 0; w < nwords; ++w) n += __builtin_popcountll(bits[col*nwords + w]);
+    }
+  }
+  return n;
+}
+
+unsigned int PixelOccupancyBitmap::index( int row, int col) const {
+  unsigned int i = colIndex[col];
+  auto word = bits.begin() + col*nwords;
+  for (int w = 0; w < row/64; ++w) i += __builtin_popcountll(word[w]);
+  return i + __builtin_popcountll(word[row/64] & ((uint64_t(1) << (row%64)) - 1));
+}
+
+void PixelOccupancyBitmap::clear() {
+  for (int cw = 0; cw < int(usedCols.size()); ++cw) {
+    for (uint64_t used = usedCols[cw]; used; used &= used-1) {
+      int col = cw*64 + __builtin_ctzll(used);
+      std::fill(bits.begin() + col*nwords, bits.begin() + (col+1)*nwords, 0);
+    }
+    usedCols[cw] = 0;
+  }
+}
+
+#endif
@@ -31,6 +31,7 @@
 // STL
 #include <stack>
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <atomic>
 using namespace std;
@@ -59,7 +60,8 @@ PixelThresholdClusterizer::PixelThresholdClusterizer
     theNumOfRows(0), theNumOfCols(0), theDetid(0),
     // Get the constants for the miss-calibration studies
     doMissCalibrate( conf.getUntrackedParameter<bool>("MissCalibrate",true) ),
-    doSplitClusters( conf.getParameter<bool>("SplitClusters") )
+    doSplitClusters( conf.getParameter<bool>("SplitClusters") ),
+    doBitmapLabeling( conf.getParameter<bool>("BitmapLabeling") )
 {
   theBuffer.setSize( theNumOfRows, theNumOfCols );
 }
@@ -76,6 +78,7 @@ PixelThresholdClusterizer::fillDescriptions(edm::ConfigurationDescriptions& desc
   desc.add<int>("ChannelThreshold", 1000);
   desc.addUntracked<bool>("MissCalibrate", true);
   desc.add<bool>("SplitClusters", false);
+  desc.add<bool>("BitmapLabeling", false);
   desc.add<int>("VCaltoElectronGain", 65);
   desc.add<int>("VCaltoElectronGain_L1", 65);
   desc.add<int>("VCaltoElectronOffset", -414);
@@ -109,8 +112,9 @@ bool PixelThresholdClusterizer::setup(const PixelGeomDetUnit * pixDet)
   theNumOfRows = nrows;  // Set new sizes
   theNumOfCols = ncols;
   
-  if ( nrows > theBuffer.rows() || 
-       ncols > theBuffer.columns() ) 
+  if ( !doBitmapLabeling &&
+       ( nrows > theBuffer.rows() || 
+         ncols > theBuffer.columns() ) ) 
     { // change only when a larger is needed
       //if( nrows != theNumOfRows || ncols != theNumOfCols ) {
       //cout << " PixelThresholdClusterizer: pixel buffer redefined to " 
@@ -120,6 +124,9 @@ bool PixelThresholdClusterizer::setup(const PixelGeomDetUnit * pixDet)
       // Resize the buffer
       theBuffer.setSize(nrows,ncols);  // Modify
     }
+  if ( doBitmapLabeling &&
+       ( nrows > theBitmap.rows() || ncols > theBitmap.columns() ) )
+    theBitmap.setSize( std::max(nrows,theBitmap.rows()), std::max(ncols,theBitmap.columns()) );
   
   return true;   
 }
@@ -154,11 +161,17 @@ void PixelThresholdClusterizer::clusterizeDetUnitT( const T & input,
   theLayer = (DetId(theDetid).subdetId()==1) ? tTopo->pxbLayer(theDetid) : 0;
   if (theLayer==1) clusterThreshold = theClusterThreshold_L1;
   
+  assert(output.empty());
+  if ( doBitmapLabeling ) {
+    fill_bitmap(begin, end);
+    make_bitmap_clusters(clusterThreshold, output);
+    return;
+  }
+
   //  Copy PixelDigis to the buffer array; select the seed pixels
   //  on the way, and store them in theSeeds.
   copy_to_buffer(begin, end);
   
-  assert(output.empty());
   //  Loop over all seeds.  TO DO: wouldn't using iterators be faster?
   //  edm::LogError("PixelThresholdClusterizer") <<  "Starting clusterizing" << endl;
   for (unsigned int i = 0; i < theSeeds.size(); i++) 
@@ -236,7 +249,43 @@ void PixelThresholdClusterizer::copy_to_buffer( DigiIterator begin, DigiIterator
   }
 #endif
   int electron[end-begin]; // pixel charge in electrons 
-  memset(electron, 0, sizeof(electron));
+  calibrate_to_electrons(begin, end, electron);
+
+  int i=0;
+#ifdef PIXELREGRESSION
+  static std::atomic<int> eqD=0;
+#endif
+  for(DigiIterator di = begin; di != end; ++di) {
+    int row = di->row();
+    int col = di->column();
+    int adc = electron[i++]; // this is in electrons 
+
+#ifdef PIXELREGRESSION
+    int adcOld = calibrate(di->adc(),col,row);
+    //assert(adc==adcOld);
+    if (adc!=adcOld) std::cout << "VI " << eqD  <<' '<< ic  <<' '<< end-begin <<' '<< i <<' '<< di->adc() <<' ' << adc <<' '<< adcOld << std::endl; else ++eqD;
+#endif
+
+    if(adc<100) adc=100; // put all negative pixel charges into the 100 elec bin 
+    /* This is semi-random good number. The exact number (in place of 100) is irrelevant from the point 
+       of view of the final cluster charge since these are typically >= 20000.
+    */
+
+    if ( adc >= thePixelThreshold) {
+      theBuffer.set_adc( row, col, adc);
+      if ( adc >= theSeedThreshold) theSeeds.push_back( SiPixelCluster::PixelPos(row,col) );
+    }
+  }
+  assert(i==(end-begin));
+
+}
+
+//----------------------------------------------------------------------------
+//! \brief Convert the adc counts of PixelDigis to electrons.
+//----------------------------------------------------------------------------
+void PixelThresholdClusterizer::calibrate_to_electrons( DigiIterator begin, DigiIterator end, int * electron )
+{
+  memset(electron, 0, (end-begin)*sizeof(int));
 
   if (doPhase2Calibration) {
     int i = 0;
@@ -266,34 +315,6 @@ void PixelThresholdClusterizer::copy_to_buffer( DigiIterator begin, DigiIterator
       assert(i==(end-begin));
     }
   }
-
-  int i=0;
-#ifdef PIXELREGRESSION
-  static std::atomic<int> eqD=0;
-#endif
-  for(DigiIterator di = begin; di != end; ++di) {
-    int row = di->row();
-    int col = di->column();
-    int adc = electron[i++]; // this is in electrons 
-
-#ifdef PIXELREGRESSION
-    int adcOld = calibrate(di->adc(),col,row);
-    //assert(adc==adcOld);
-    if (adc!=adcOld) std::cout << "VI " << eqD  <<' '<< ic  <<' '<< end-begin <<' '<< i <<' '<< di->adc() <<' ' << adc <<' '<< adcOld << std::endl; else ++eqD;
-#endif
-
-    if(adc<100) adc=100; // put all negative pixel charges into the 100 elec bin 
-    /* This is semi-random good number. The exact number (in place of 100) is irrelevant from the point 
-       of view of the final cluster charge since these are typically >= 20000.
-    */
-
-    if ( adc >= thePixelThreshold) {
-      theBuffer.set_adc( row, col, adc);
-      if ( adc >= theSeedThreshold) theSeeds.push_back( SiPixelCluster::PixelPos(row,col) );
-    }
-  }
-  assert(i==(end-begin));
-
 }
 
 void PixelThresholdClusterizer::copy_to_buffer( ClusterIterator begin, ClusterIterator end )
@@ -315,6 +336,118 @@ void PixelThresholdClusterizer::copy_to_buffer( ClusterIterator begin, ClusterIt
   }
 }
 
+//----------------------------------------------------------------------------
+//! \brief Set the pixels above threshold in the occupancy bitmap, identify seeds.
+//!
+//! Nothing is copied to theBuffer, and only the occupied columns of the
+//! bitmap need to be cleared afterwards.
+//----------------------------------------------------------------------------
+void PixelThresholdClusterizer::fill_bitmap( DigiIterator begin, DigiIterator end )
+{
+  int electron[end-begin]; // pixel charge in electrons
+  calibrate_to_electrons(begin, end, electron);
+
+  int i=0;
+  for(DigiIterator di = begin; di != end; ++di) {
+    int row = di->row();
+    int col = di->column();
+    int adc = electron[i++];
+    if(adc<100) adc=100; // as in copy_to_buffer
+    if ( adc >= thePixelThreshold) {
+      theBitmap.set( row, col);
+      thePixels.push_back( BitmapPixel{uint16_t(row), uint16_t(col), adc} );
+      if ( adc >= theSeedThreshold) theSeeds.push_back( SiPixelCluster::PixelPos(row,col) );
+    }
+  }
+  // the same pixel twice keeps the last charge, as set_adc
+  index_bitmap(false);
+}
+
+void PixelThresholdClusterizer::fill_bitmap( ClusterIterator begin, ClusterIterator end )
+{
+  for(ClusterIterator ci = begin; ci != end; ++ci) {
+    for(int i = 0; i < ci->size(); ++i) {
+      const SiPixelCluster::Pixel pixel = ci->pixel(i);
+      if ( pixel.adc >= thePixelThreshold) {
+        theBitmap.set( pixel.x, pixel.y);
+        thePixels.push_back( BitmapPixel{uint16_t(pixel.x), uint16_t(pixel.y), pixel.adc} );
+        if ( pixel.adc >= theSeedThreshold) theSeeds.push_back( SiPixelCluster::PixelPos(pixel.x,pixel.y) );
+      }
+    }
+  }
+  // the same pixel twice sums the charges, as add_adc
+  index_bitmap(true);
+}
+
+//----------------------------------------------------------------------------
+//! \brief Store the charges of the pixels at their index in the bitmap.
+//----------------------------------------------------------------------------
+void PixelThresholdClusterizer::index_bitmap( bool sum )
+{
+  theBitmapAdc.assign( theBitmap.makeIndex(), 0 );
+  for (auto const & pixel : thePixels) {
+    auto & adc = theBitmapAdc[theBitmap.index(pixel.row, pixel.col)];
+    adc = sum ? adc + pixel.adc : pixel.adc;
+  }
+  thePixels.clear();
+}
+
+//----------------------------------------------------------------------------
+//!  \brief Make the clusters from the seeds, on the bitmap.
+//!
+//!  The same as the loop over the seeds of clusterizeDetUnitT, with the
+//!  charges looked up through the bitmap index instead of theBuffer: the
+//!  clusters, the order of their pixels and the splitting of the clusters
+//!  larger than AccretionCluster::MAXSIZE are identical.
+//----------------------------------------------------------------------------
+void PixelThresholdClusterizer::make_bitmap_clusters( int clusterThreshold,
+                                                      edmNew::DetSetVector<SiPixelCluster>::FastFiller& output )
+{
+  for (auto const & seed : theSeeds) {
+    // the seeds already included in clusters have their charge set to 1 electron
+    if ( theBitmapAdc[theBitmap.index(seed.row(), seed.col())] >= theSeedThreshold ) {
+      SiPixelCluster && cluster = make_bitmap_cluster( seed );
+      if ( cluster.charge() >= clusterThreshold ) {
+        output.push_back( std::move(cluster) );
+        std::push_heap(output.begin(),output.end(),[](SiPixelCluster const & cl1,SiPixelCluster const & cl2) { return cl1.minPixelRow() < cl2.minPixelRow();});
+      }
+    }
+  }
+  std::sort_heap(output.begin(),output.end(),[](SiPixelCluster const & cl1,SiPixelCluster const & cl2) { return cl1.minPixelRow() < cl2.minPixelRow();});
+
+  theSeeds.clear();
+  theBitmap.clear();
+}
+
+//----------------------------------------------------------------------------
+//!  \brief The accretion of make_cluster, on the bitmap.
+//----------------------------------------------------------------------------
+SiPixelCluster
+PixelThresholdClusterizer::make_bitmap_cluster( const SiPixelCluster::PixelPos& pix )
+{
+  auto & seed_adc = theBitmapAdc[theBitmap.index(pix.row(), pix.col())];
+  AccretionCluster acluster;
+  acluster.add(pix, seed_adc);
+  seed_adc = 1;
+
+  while ( ! acluster.empty())
+    {
+      auto curInd = acluster.top(); acluster.pop();
+      for ( auto c = std::max(0,int(acluster.y[curInd])-1); c < std::min(int(acluster.y[curInd])+2,theNumOfCols) ; ++c) {
+	for ( auto r = std::max(0,int(acluster.x[curInd])-1); r < std::min(int(acluster.x[curInd])+2,theNumOfRows); ++r)  {
+	  if ( !theBitmap.test(r,c) ) continue;
+	  auto & adc = theBitmapAdc[theBitmap.index(r,c)];
+	  if ( adc >= thePixelThreshold) {
+	    if (!acluster.add( SiPixelCluster::PixelPos(r,c), adc)) goto endClus;
+	    adc = 1;
+	  }
+	}
+      }
+    }
+ endClus:
+  return SiPixelCluster(acluster.isize,acluster.adc, acluster.x,acluster.y, acluster.xmin,acluster.ymin);
+}
+
 //----------------------------------------------------------------------------
 // Calibrate adc counts to electrons
 //-----------------------------------------------------------------
@@ -46,6 +46,7 @@
 
 // The private pixel buffer
 #include "SiPixelArrayBuffer.h"
+#include "PixelOccupancyBitmap.h"
 
 // Parameter Set:
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
@@ -87,6 +88,15 @@ class dso_hidden PixelThresholdClusterizer final : public PixelClusterizerBase {
 
   //! Data storage
   SiPixelArrayBuffer               theBuffer;         // internal nrow * ncol matrix
+  PixelOccupancyBitmap             theBitmap;         // occupancy of the pixels above threshold
+
+  struct BitmapPixel {
+    uint16_t row;
+    uint16_t col;
+    int adc;
+  };
+  std::vector<BitmapPixel>   thePixels;           // pixels above threshold, until the bitmap is indexed
+  std::vector<int>           theBitmapAdc;        // charges of the pixels, by bitmap index
   std::vector<SiPixelCluster::PixelPos>  theSeeds;          // cached seed pixels
   std::vector<SiPixelCluster>            theClusters;       // resulting clusters  
   
@@ -118,12 +128,19 @@ class dso_hidden PixelThresholdClusterizer final : public PixelClusterizerBase {
   int theLayer;
   const bool doMissCalibrate; // Use calibration or not
   const bool doSplitClusters;
+  const bool doBitmapLabeling; // Occupancy bitmap and dense charges instead of theBuffer
   //! Private helper methods:
   bool setup(const PixelGeomDetUnit * pixDet);
   void copy_to_buffer( DigiIterator begin, DigiIterator end );   
   void copy_to_buffer( ClusterIterator begin, ClusterIterator end );
   void clear_buffer( DigiIterator begin, DigiIterator end );
   void clear_buffer( ClusterIterator begin, ClusterIterator end );
+  void calibrate_to_electrons( DigiIterator begin, DigiIterator end, int * electron );
+  void fill_bitmap( DigiIterator begin, DigiIterator end );
+  void fill_bitmap( ClusterIterator begin, ClusterIterator end );
+  void index_bitmap( bool sum );
+  void make_bitmap_clusters( int clusterThreshold, edmNew::DetSetVector<SiPixelCluster>::FastFiller& output );
+  SiPixelCluster make_bitmap_cluster( const SiPixelCluster::PixelPos& pix );
   SiPixelCluster make_cluster( const SiPixelCluster::PixelPos& pix, edmNew::DetSetVector<SiPixelCluster>::FastFiller& output);
   // Calibrate the ADC charge to electrons 
   int calibrate(int adc, int col, int row);
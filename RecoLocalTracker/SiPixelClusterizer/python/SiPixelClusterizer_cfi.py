@@ -9,6 +9,7 @@ siPixelClusters = cms.EDProducer("SiPixelClusterProducer",
     ChannelThreshold = cms.int32(1000),
     MissCalibrate = cms.untracked.bool(True),
     SplitClusters = cms.bool(False),
+    BitmapLabeling = cms.bool(False), # seeded accretion on an occupancy bitmap instead of the full module buffer
     VCaltoElectronGain    = cms.int32(65),
     VCaltoElectronGain_L1 = cms.int32(65),
     VCaltoElectronOffset    = cms.int32(-414),  
@@ -0,0 +1,213 @@
+// The clusters made with BitmapLabeling must be the ones of the default
+// clusterizer, pixel by pixel and in the same order, on the same digis
+// (and on the same clusters, for the reclustering of split clusters).
+
+#include "RecoLocalTracker/SiPixelClusterizer/plugins/PixelThresholdClusterizer.cc"
+
+#include "DataFormats/DetId/interface/DetId.h"
+#include "DataFormats/GeometrySurface/interface/BoundPlane.h"
+#include "DataFormats/GeometrySurface/interface/RectangularPlaneBounds.h"
+#include "Geometry/TrackerGeometryBuilder/interface/PixelGeomDetType.h"
+#include "Geometry/TrackerGeometryBuilder/interface/PixelGeomDetUnit.h"
+#include "Geometry/TrackerGeometryBuilder/interface/RectangularPixelTopology.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+  std::mt19937 rng(2017);
+
+  edm::ParameterSet config(bool bitmap) {
+    edm::ParameterSet conf;
+    conf.addParameter<int>("ChannelThreshold", 1000);
+    conf.addUntrackedParameter<bool>("MissCalibrate", false);
+    conf.addParameter<bool>("SplitClusters", false);
+    conf.addParameter<bool>("BitmapLabeling", bitmap);
+    conf.addParameter<int>("VCaltoElectronGain", 65);
+    conf.addParameter<int>("VCaltoElectronGain_L1", 65);
+    conf.addParameter<int>("VCaltoElectronOffset", -414);
+    conf.addParameter<int>("VCaltoElectronOffset_L1", -414);
+    // a digi is a seed from 75 adc counts, a pixel from 8
+    conf.addParameter<int>("SeedThreshold", 10000);
+    conf.addParameter<int>("ClusterThreshold_L1", 4000);
+    conf.addParameter<int>("ClusterThreshold", 4000);
+    conf.addParameter<double>("ElectronPerADCGain", 135.);
+    conf.addParameter<bool>("Phase2Calibration", false);
+    conf.addParameter<int>("Phase2ReadoutMode", -1);
+    conf.addParameter<double>("Phase2DigiBaseline", 1200.);
+    conf.addParameter<int>("Phase2KinkADC", 8);
+    return conf;
+  }
+
+  // a forward pixel module, so that no TrackerTopology is needed
+  struct Module {
+    Module(int nrows, int ncols) :
+      type(new RectangularPixelTopology(nrows, ncols, 0.01, 0.015, false, 80, 52, 1, 2, nrows/80, ncols/52),
+           "test", subdet),
+      det(new BoundPlane(Surface::PositionType(0,0,0), Surface::RotationType(),
+                         new RectangularPlaneBounds(0.01*nrows/2, 0.015*ncols/2, 0.01)),
+          &type, DetId(DetId::Tracker, 2).rawId() | nrows) {}
+    int rows() const { return type.specificTopology().nrows(); }
+    int cols() const { return type.specificTopology().ncolumns(); }
+
+    GeomDetEnumerators::SubDetector subdet = GeomDetEnumerators::PixelEndcap;
+    PixelGeomDetType type;
+    PixelGeomDetUnit det;
+  };
+
+  using Digis = std::vector<PixelDigi>;
+  using Clusters = edmNew::DetSetVector<SiPixelCluster>;
+
+  int adc(int from, int to) { return std::uniform_int_distribution<int>(from, to)(rng); }
+
+  // pixels of any charge, seeds included, at the given occupancy
+  Digis random(Module const & m, float occupancy) {
+    Digis digis;
+    std::bernoulli_distribution occupied(occupancy);
+    for (int c = 0; c < m.cols(); ++c)
+      for (int r = 0; r < m.rows(); ++r)
+        if (occupied(rng)) digis.emplace_back(r, c, adc(0, 255));
+    std::shuffle(digis.begin(), digis.end(), rng);
+    return digis;
+  }
+
+  // a rectangle of pixels, with a seed every seedEvery pixels (none if 0)
+  void block(Digis & digis, int row, int col, int nrows, int ncols, int seedEvery) {
+    int n = 0;
+    for (int c = col; c < col+ncols; ++c)
+      for (int r = row; r < row+nrows; ++r, ++n)
+        digis.emplace_back(r, c, (seedEvery && n % seedEvery == 0) ? adc(75, 255) : adc(8, 74));
+  }
+
+  std::vector<std::pair<std::string, std::function<Digis(Module const &)> > > makeDigis() {
+    std::vector<std::pair<std::string, std::function<Digis(Module const &)> > > cases;
+    cases.emplace_back("empty", [](Module const &) { return Digis(); });
+    for (float occupancy : {0.001f, 0.01f, 0.05f, 0.2f, 0.6f})
+      cases.emplace_back("random " + std::to_string(occupancy), [occupancy](Module const & m) { return random(m, occupancy); });
+    cases.emplace_back("single seed", [](Module const &) { return Digis{PixelDigi(10, 20, 200)}; });
+    cases.emplace_back("no seed", [](Module const &) {
+        Digis digis;
+        block(digis, 10, 10, 5, 5, 0);
+        block(digis, 40, 100, 20, 30, 0);
+        return digis; });
+    cases.emplace_back("touching", [](Module const &) {
+        Digis digis;
+        block(digis, 10, 10, 4, 4, 5);
+        block(digis, 14, 12, 4, 4, 3);  // shares a side
+        block(digis, 18, 16, 3, 3, 1);  // shares a corner
+        block(digis, 30, 30, 1, 6, 0);  // no seed of its own
+        block(digis, 31, 35, 3, 1, 2);
+        return digis; });
+    cases.emplace_back("oversize", [](Module const &) {
+        Digis digis;
+        block(digis, 20, 50, 30, 30, 97);   // 900 pixels, a few seeds
+        block(digis, 60, 200, 17, 16, 0);   // 272 pixels, one seed in the middle
+        digis.emplace_back(68, 208, 250);
+        std::shuffle(digis.begin(), digis.end(), rng);
+        return digis; });
+    cases.emplace_back("line", [](Module const & m) {
+        Digis digis;
+        block(digis, 7, 0, 1, m.cols(), 50);
+        block(digis, 0, 3, m.rows(), 1, 0);
+        return digis; });
+    cases.emplace_back("edges", [](Module const & m) {
+        Digis digis;
+        for (int r : {0, 1, m.rows()-2, m.rows()-1})
+          for (int c : {0, 1, m.cols()-2, m.cols()-1})
+            digis.emplace_back(r, c, adc(8, 255));
+        block(digis, m.rows()-3, m.cols()/2, 3, 3, 4);
+        return digis; });
+    cases.emplace_back("duplicates", [](Module const & m) {
+        Digis digis = random(m, 0.05f);
+        Digis again(digis.begin(), digis.begin() + digis.size()/3);
+        for (auto & d : again) d = PixelDigi(d.row(), d.column(), adc(0, 255));
+        digis.insert(digis.end(), again.begin(), again.end());
+        std::shuffle(digis.begin(), digis.end(), rng);
+        return digis; });
+    return cases;
+  }
+
+  bool sameClusters(Clusters const & a, Clusters const & b, std::string const & what) {
+    // the empty det sets are dropped by the FastFiller
+    bool same = a.size() == b.size();
+    for (auto ia = a.begin(), ib = b.begin(); same && ia != a.end(); ++ia, ++ib) {
+      auto const & da = *ia;
+      auto const & db = *ib;
+      same = da.id() == db.id() && da.size() == db.size();
+      for (unsigned int j = 0; same && j != da.size(); ++j) {
+        auto const & pa = da[j].pixels();
+        auto const & pb = db[j].pixels();
+        same = pa.size() == pb.size();
+        for (unsigned int k = 0; same && k != pa.size(); ++k)
+          same = pa[k].x == pb[k].x && pa[k].y == pb[k].y && pa[k].adc == pb[k].adc;
+      }
+    }
+    if (!same)
+      std::cout << what << ": " << b.dataSize() << " clusters on the bitmap, "
+                << a.dataSize() << " with the default clusterizer" << std::endl;
+    return same;
+  }
+
+}
+
+int main() {
+  // the same clusterizers, as in a stream, on modules of different sizes
+  PixelThresholdClusterizer legacy(config(false));
+  PixelThresholdClusterizer bitmap(config(true));
+  std::vector<std::unique_ptr<Module> > modules;
+  modules.emplace_back(std::make_unique<Module>(160, 416));
+  modules.emplace_back(std::make_unique<Module>(80, 104));
+  modules.emplace_back(std::make_unique<Module>(160, 416));
+
+  const std::vector<short> badChannels;
+  int nFailed = 0, nClusters = 0;
+  for (auto const & c : makeDigis()) {
+    for (unsigned int im = 0; im != modules.size(); ++im) {
+      auto const & m = *modules[im];
+      std::string what = c.first + " on module " + std::to_string(im);
+
+      edm::DetSet<PixelDigi> digis(m.det.geographicalId().rawId());
+      digis.data = c.second(m);
+      Clusters fromLegacy, fromBitmap;
+      {
+        Clusters::FastFiller ff(fromLegacy, digis.detId());
+        legacy.clusterizeDetUnit(digis, &m.det, nullptr, badChannels, ff);
+      }
+      {
+        Clusters::FastFiller ff(fromBitmap, digis.detId());
+        bitmap.clusterizeDetUnit(digis, &m.det, nullptr, badChannels, ff);
+      }
+      nClusters += fromLegacy.dataSize();
+      if (!sameClusters(fromLegacy, fromBitmap, what)) ++nFailed;
+
+      // the clusters as input, twice so that the charges of the pixels add up
+      Clusters input;
+      {
+        Clusters::FastFiller ff(input, digis.detId());
+        for (int i = 0; i != 2; ++i)
+          for (auto const & ds : fromLegacy)
+            for (auto const & cl : ds) ff.push_back(cl);
+      }
+      if (input.empty()) continue;
+      Clusters reLegacy, reBitmap;
+      {
+        Clusters::FastFiller ff(reLegacy, digis.detId());
+        legacy.clusterizeDetUnit(*input.begin(), &m.det, nullptr, badChannels, ff);
+      }
+      {
+        Clusters::FastFiller ff(reBitmap, digis.detId());
+        bitmap.clusterizeDetUnit(*input.begin(), &m.det, nullptr, badChannels, ff);
+      }
+      if (!sameClusters(reLegacy, reBitmap, what + ", from clusters")) ++nFailed;
+    }
+  }
+
+  std::cout << nClusters << " clusters compared, " << nFailed << " failures" << std::endl;
+  return nFailed ? 1 : 0;
+}
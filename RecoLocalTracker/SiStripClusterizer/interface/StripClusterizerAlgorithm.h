@@ -2,7 +2,7 @@
 #define RecoLocalTracker_StripClusterizerAlgorithm_h
 
 namespace edm{class EventSetup;}
-class SiStripDigi;
+#include "DataFormats/SiStripDigi/interface/SiStripDigi.h"
 #include "DataFormats/SiStripCluster/interface/SiStripCluster.h"
 #include "DataFormats/Common/interface/DetSetVector.h"
 #include "DataFormats/Common/interface/DetSetVectorNew.h"
@@ -71,6 +71,13 @@ class StripClusterizerAlgorithm {
   virtual void stripByStripAdd(State & state, uint16_t strip, uint8_t adc, output_t::TSFastFiller & out)  const {}
   virtual void stripByStripEnd(State & state, output_t::TSFastFiller & out)  const {}
 
+  // all the digis of a module at once, ordered in strip
+  virtual void clusterizeStrips(Det const & det, SiStripDigi const * begin, SiStripDigi const * end, output_t::TSFastFiller & out) const {
+    State state(det);
+    for(auto digi=begin; digi!=end; ++digi) stripByStripAdd(state, digi->strip(), digi->adc(), out);
+    stripByStripEnd(state, out);
+  }
+
 
   struct InvalidChargeException : public cms::Exception { public: InvalidChargeException(const SiStripDigi&); };
 
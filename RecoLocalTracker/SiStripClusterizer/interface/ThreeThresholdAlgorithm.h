@@ -42,10 +42,16 @@ class ThreeThresholdAlgorithm final : public StripClusterizerAlgorithm {
 
   void stripByStripEnd(State & state, output_t::TSFastFiller & out) const override { endCandidate(state,out);}
 
+  void clusterizeStrips(Det const & det, SiStripDigi const * begin, SiStripDigi const * end, output_t::TSFastFiller & out) const override;
+
 
  private:
 
   template<class T> void clusterizeDetUnit_(const T&, output_t::TSFastFiller&) const;
+  template<class Iter> void clusterizeStrips_(Det const &, Iter, Iter, output_t::TSFastFiller&) const;
+
+  // the largest modules have 6 APVs of 128 strips
+  static constexpr unsigned maxStrips = 768;
 
   ThreeThresholdAlgorithm(float, float, float, unsigned, unsigned, unsigned, std::string qualityLabel,
 			  bool removeApvShots, float minGoodCharge);
@@ -54,6 +60,7 @@ class ThreeThresholdAlgorithm final : public StripClusterizerAlgorithm {
     //constant methods with state information
     uint16_t firstStrip(State const & state) const {return state.lastStrip - state.ADCs.size() + 1;}
     bool candidateEnded(State const & state, const uint16_t&) const;
+    bool candidateEnded(State const & state, uint16_t testStrip, bool const * badStrips) const;
     bool candidateAccepted(State const & state) const;
 
   //state modification methods
@@ -61,6 +68,7 @@ class ThreeThresholdAlgorithm final : public StripClusterizerAlgorithm {
     void clearCandidate(State & state) const { state.candidateLacksSeed = true;  state.noiseSquared = 0;  state.ADCs.clear();}
     void addToCandidate(State & state, const SiStripDigi& digi) const { addToCandidate(state, digi.strip(),digi.adc());}
     void addToCandidate(State & state, uint16_t strip, uint8_t adc) const;
+    void appendToCandidate(State & state, uint16_t strip, uint8_t adc, float noise, bool isSeed) const;
     void appendBadNeighbors(State & state) const;
     void applyGains(State & state) const;
 
@@ -31,6 +31,8 @@
 #include <atomic>
 #include <mutex>
 
+#include "tbb/enumerable_thread_specific.h"
+
 #include "FWCore/Utilities/interface/GCC11Compatibility.h"
 
 
@@ -129,6 +131,10 @@ namespace {
     
     std::unique_ptr<sistrip::FEDBuffer> buffers[1024];
     std::atomic<sistrip::FEDBuffer*> done[1024];
+
+    // the digis of a module, reused for all the modules: on demand the modules
+    // may be filled concurrently, so there is one buffer per thread
+    tbb::enumerable_thread_specific<std::vector<SiStripDigi>> moduleDigis_;
     
     
     const FEDRawDataCollection& rawColl;
@@ -358,34 +364,6 @@ namespace {
     }
     return out;
   }
-
-  class StripByStripAdder {
-  public:
-    typedef std::output_iterator_tag iterator_category;
-    typedef void value_type;
-    typedef void difference_type;
-    typedef void pointer;
-    typedef void reference;
-
-    StripByStripAdder(StripClusterizerAlgorithm& clusterizer,
-                      StripClusterizerAlgorithm::State& state,
-                      StripClusterizerAlgorithm::output_t::TSFastFiller& record)
-      : clusterizer_(clusterizer), state_(state), record_(record) {}
-
-    StripByStripAdder& operator= ( SiStripDigi digi )
-    {
-      clusterizer_.stripByStripAdd(state_, digi.strip(), digi.adc(), record_);
-      return *this;
-    }
-
-    StripByStripAdder& operator*  ()    { return *this; }
-    StripByStripAdder& operator++ ()    { return *this; }
-    StripByStripAdder& operator++ (int) { return *this; }
-  private:
-    StripClusterizerAlgorithm& clusterizer_;
-    StripClusterizerAlgorithm::State& state_;
-    StripClusterizerAlgorithm::output_t::TSFastFiller& record_;
-  };
 }
 
 void ClusterFiller::fill(StripClusterizerAlgorithm::output_t::TSFastFiller & record) {
@@ -398,7 +376,9 @@ try { // edmNew::CapacityExaustedException
 
   auto const & det = clusterizer.stripByStripBegin(idet);
   if (!det.valid()) return; 
-  StripClusterizerAlgorithm::State state(det);
+  // the digis of all the channels of the module, clusterized at once at the end
+  auto & moduleDigis = moduleDigis_.local();
+  moduleDigis.clear();
 
   incSet();
 
@@ -444,9 +424,8 @@ try { // edmNew::CapacityExaustedException
     if LIKELY( ( mode > sistrip::READOUT_MODE_VIRGIN_RAW ) && ( mode < sistrip::READOUT_MODE_SPY ) && ( mode != sistrip::READOUT_MODE_PROC_RAW ) ) {
       // ZS modes
       try {
-        auto perStripAdder = StripByStripAdder(clusterizer, state, record);
         if LIKELY( ! hybridZeroSuppressed_ ) {
-          unpackZS(buffer->channel(fedCh), mode, ipair*256, perStripAdder);
+          unpackZS(buffer->channel(fedCh), mode, ipair*256, std::back_inserter(moduleDigis));
         } else {
           const uint32_t id = conn->detId();
           edm::DetSet<SiStripDigi> unpDigis{id}; unpDigis.reserve(256);
@@ -455,7 +434,7 @@ try { // edmNew::CapacityExaustedException
           rawAlgos.convertHybridDigiToRawDigiVector(unpDigis, workRawDigis);
           edm::DetSet<SiStripDigi> suppDigis{id};
           rawAlgos.suppressHybridData(id, ipair*2, workRawDigis, suppDigis);
-          std::copy(std::begin(suppDigis), std::end(suppDigis), perStripAdder);
+          moduleDigis.insert(moduleDigis.end(), std::begin(suppDigis), std::end(suppDigis));
         }
       } catch (edmNew::CapacityExaustedException const&) {
         throw;
@@ -498,9 +477,7 @@ try { // edmNew::CapacityExaustedException
       //rawAlgos_->suppressor->suppress( digis, zsdigis);
       uint16_t firstAPV = ipair*2;
       rawAlgos.suppressVirginRawData(id, firstAPV,digis, zsdigis);
-      for ( const auto digi : zsdigis ) {
-        clusterizer.stripByStripAdd(state, digi.strip(), digi.adc(), record);
-      }
+      moduleDigis.insert(moduleDigis.end(), zsdigis.begin(), zsdigis.end());
 
     } else if ( mode == sistrip::READOUT_MODE_PROC_RAW ) {
 
@@ -521,9 +498,7 @@ try { // edmNew::CapacityExaustedException
       //rawAlgos_->suppressor->suppress( digis, zsdigis);
       uint16_t firstAPV = ipair*2;
       rawAlgos.suppressProcessedRawData(id, firstAPV,digis, zsdigis);
-      for( edm::DetSet<SiStripDigi>::const_iterator it = zsdigis.begin(); it!=zsdigis.end(); it++) {
-        clusterizer.stripByStripAdd(state, it->strip(), it->adc(), record);
-      }
+      moduleDigis.insert(moduleDigis.end(), zsdigis.begin(), zsdigis.end());
     } else {
       edm::LogWarning(sistrip::mlRawToCluster_)
         << "[ClustersFromRawProducer::" << __func__ << "]"
@@ -532,7 +507,7 @@ try { // edmNew::CapacityExaustedException
     }
   } // end loop over conn
 
-  clusterizer.stripByStripEnd(state,record);
+  clusterizer.clusterizeStrips(det, moduleDigis.data(), moduleDigis.data()+moduleDigis.size(), record);
   
   incAct();
  
@@ -3,6 +3,7 @@
 #include "DataFormats/SiStripCluster/interface/SiStripCluster.h"
 #include <cmath>
 #include <numeric>
+#include <algorithm>
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
 #include "DataFormats/SiStripCluster/interface/SiStripClusterTools.h"
@@ -39,12 +40,60 @@ clusterizeDetUnit_(const digiDetSet& digis, output_t::TSFastFiller& output) cons
     ApvCleaner.clean(digis,scan,end);
   }
 
+  clusterizeStrips_(det, scan, end, output);
+}
+
+template<class Iter>
+inline
+void ThreeThresholdAlgorithm::
+clusterizeStrips_(Det const & det, Iter scan, Iter end, output_t::TSFastFiller& output) const {
+  const unsigned nDigis = end - scan;
+  if(nDigis == 0) return;
+
   State state(det);
-  while( scan != end ) {
-    while( scan != end  && !candidateEnded(state, scan->strip() ) ) 
-      addToCandidate( state, *scan++);
-    endCandidate(state, output);
+  if(nDigis > maxStrips || (end-1)->strip() >= maxStrips) {
+    while( scan != end ) {
+      while( scan != end  && !candidateEnded(state, scan->strip() ) ) 
+	addToCandidate( state, *scan++);
+      endCandidate(state, output);
+    }
+    return;
+  }
+
+  // module arrays: the bad strip mask is decoded once,
+  // instead of scanning the quality range at each lookup
+  bool badStrips[maxStrips];
+  std::fill(badStrips, badStrips+maxStrips, false);
+  for(auto it = det.qualityRange.first; it != det.qualityRange.second; ++it) {
+    auto const fs = det.quality->decode(*it);
+    std::fill(badStrips + std::min<unsigned>(fs.firstStrip, maxStrips),
+	      badStrips + std::min<unsigned>(fs.firstStrip+fs.range, maxStrips), true);
+  }
+
+  uint16_t strips[maxStrips];
+  uint8_t adcs[maxStrips];
+  float noises[maxStrips];
+  bool good[maxStrips], seed[maxStrips];
+  for(unsigned i=0; i<nDigis; ++i, ++scan) {
+    strips[i] = scan->strip();
+    adcs[i] = scan->adc();
+    noises[i] = det.noise(strips[i]);
+    good[i] = !badStrips[strips[i]];
+  }
+
+  // channel and seed thresholds for all the strips of the module at once (vectorized)
+  for(unsigned i=0; i<nDigis; ++i) {
+    good[i] &= adcs[i] >= static_cast<uint8_t>( noises[i] * ChannelThreshold);
+    seed[i] = adcs[i] >= static_cast<uint8_t>( noises[i] * SeedThreshold);
+  }
+
+  // strips below threshold cannot end a candidate that the next good strip would not end
+  for(unsigned i=0; i<nDigis; ++i) {
+    if(!good[i]) continue;
+    if(candidateEnded(state, strips[i], badStrips)) endCandidate(state, output);
+    appendToCandidate(state, strips[i], adcs[i], noises[i], seed[i]);
   }
+  endCandidate(state, output);
 }
 
 inline 
@@ -60,6 +109,17 @@ candidateEnded(State const & state, const uint16_t& testStrip) const {
 	   );
 }
 
+inline 
+bool ThreeThresholdAlgorithm::
+candidateEnded(State const & state, uint16_t testStrip, bool const * badStrips) const {
+  uint16_t holes = testStrip - state.lastStrip - 1;
+  if( state.ADCs.empty() || holes <= MaxSequentialHoles ) return false;
+  if( holes > MaxSequentialBad ) return true;
+  uint16_t strip = state.lastStrip;
+  while( ++strip < testStrip && badStrips[strip] ) {}
+  return strip != testStrip;
+}
+
 inline 
 void ThreeThresholdAlgorithm::
 addToCandidate(State & state, uint16_t strip, uint8_t adc) const { 
@@ -67,12 +127,18 @@ addToCandidate(State & state, uint16_t strip, uint8_t adc) const {
   if(  adc < static_cast<uint8_t>( Noise * ChannelThreshold) || state.det().bad(strip) )
     return;
 
-  if(state.candidateLacksSeed) state.candidateLacksSeed  =  adc < static_cast<uint8_t>( Noise * SeedThreshold);
+  appendToCandidate(state, strip, adc, Noise, adc >= static_cast<uint8_t>( Noise * SeedThreshold));
+}
+
+inline 
+void ThreeThresholdAlgorithm::
+appendToCandidate(State & state, uint16_t strip, uint8_t adc, float noise, bool isSeed) const { 
+  if(isSeed) state.candidateLacksSeed = false;
   if(state.ADCs.empty()) state.lastStrip = strip - 1; // begin candidate
   while( ++state.lastStrip < strip ) state.ADCs.push_back(0); // pad holes
 
   state.ADCs.push_back( adc );
-  state.noiseSquared += Noise*Noise;
+  state.noiseSquared += noise*noise;
 }
 
 template <class T>
@@ -125,6 +191,11 @@ appendBadNeighbors(State & state) const {
 void ThreeThresholdAlgorithm::clusterizeDetUnit(const    edm::DetSet<SiStripDigi>& digis, output_t::TSFastFiller& output) const {clusterizeDetUnit_(digis,output);}
 void ThreeThresholdAlgorithm::clusterizeDetUnit(const edmNew::DetSet<SiStripDigi>& digis, output_t::TSFastFiller& output) const {clusterizeDetUnit_(digis,output);}
 
+void ThreeThresholdAlgorithm::
+clusterizeStrips(Det const & det, SiStripDigi const * begin, SiStripDigi const * end, output_t::TSFastFiller & out) const {
+  clusterizeStrips_(det, begin, end, out);
+}
+
 StripClusterizerAlgorithm::Det
 ThreeThresholdAlgorithm::
 stripByStripBegin(uint32_t id) const {
@@ -19,7 +19,7 @@ class ClusterizerUnitTester : public edm::EDAnalyzer {
   
  public:
   
-  ClusterizerUnitTester(const PSet& conf) : testGroups(conf.getParameter<VPSet>("ClusterizerTestGroups")) {}
+  ClusterizerUnitTester(const PSet& conf) : testGroups(conf.getParameter<VPSet>("ClusterizerTestGroups")), nModuleMismatches(0) {}
   ~ClusterizerUnitTester() {}
 
  private:
@@ -29,6 +29,7 @@ class ClusterizerUnitTester : public edm::EDAnalyzer {
   void initializeTheGroup(const PSet&, const edm::EventSetup&);
   void testTheGroup(const PSet&);
   void runTheTest(const PSet&);
+  void compareWithStripByStrip(const edmNew::DetSet<SiStripDigi>&, const std::string&);
   
   void constructClusters(const VPSet&, output_t&);
   void constructDigis(const VPSet&, edmNew::DetSetVector<SiStripDigi>&);
@@ -44,6 +45,7 @@ class ClusterizerUnitTester : public edm::EDAnalyzer {
   VPSet testGroups;
   std::unique_ptr<StripClusterizerAlgorithm> clusterizer;
   uint32_t detId;
+  unsigned nModuleMismatches;
 };
 
 #endif
@@ -0,0 +1,7 @@
+#!/bin/bash
+
+function die { echo $1: status $2 ;  exit $2; }
+
+# the expected clusters of the unit tests, and the module at once clusterizer
+# (clusterizeStrips) against the strip by strip one
+cmsRun ${LOCAL_TEST_DIR}/../python/test/testClusterizer_cfg.py || die 'Failure using testClusterizer_cfg.py' $?
@@ -52,6 +52,22 @@ public:
   localParameters( const SiStripCluster& cl, AlgoParam const & ap) const {
     return std::make_pair(LocalPoint(), LocalError());
   }
+
+  /// the quantities of a cluster which do not depend on the track, so can be computed once per event
+  struct ClusterParam {
+    ClusterParam() {}
+    ClusterParam(float barycenter, int charge) : barycenter_(barycenter), charge_(charge) {}
+    explicit ClusterParam(const SiStripCluster& cl) : barycenter_(cl.barycenter()), charge_(cl.charge()) {}
+    float barycenter() const { return barycenter_; }
+    int charge() const { return charge_; }
+    float barycenter_=0; int charge_=0;
+  };
+
+  /// same as above, with the track independent quantities already computed
+  virtual StripClusterParameterEstimator::LocalValues
+  localParameters( const SiStripCluster& cl, ClusterParam const & cp, AlgoParam const & ap) const {
+    return localParameters(cl, ap);
+  }
   
   AlgoParam getAlgoParam(const GeomDetUnit& det, const LocalTrajectoryParameters & ltp) const {
 
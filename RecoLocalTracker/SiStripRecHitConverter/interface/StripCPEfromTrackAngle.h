@@ -30,6 +30,7 @@ private:
 
 public:  
   using AlgoParam = StripCPE::AlgoParam;
+  using ClusterParam = StripCPE::ClusterParam;
   using AClusters = StripClusterParameterEstimator::AClusters;
   using ALocalValues  = StripClusterParameterEstimator::ALocalValues;
   
@@ -38,6 +39,9 @@ public:
   StripClusterParameterEstimator::LocalValues
   localParameters( const SiStripCluster& cl, AlgoParam const & ap) const override;
 
+  StripClusterParameterEstimator::LocalValues
+  localParameters( const SiStripCluster& cl, ClusterParam const & cp, AlgoParam const & ap) const override;
+
   
   StripClusterParameterEstimator::LocalValues
   localParameters( const SiStripCluster&, const GeomDetUnit&, const LocalTrajectoryParameters&) const override;
@@ -97,6 +97,11 @@ void StripCPEfromTrackAngle::localParameters(AClusters const & clusters, ALocalV
 
 StripClusterParameterEstimator::LocalValues
 StripCPEfromTrackAngle::localParameters( const SiStripCluster& cluster, AlgoParam const & par) const {
+  return localParameters(cluster, ClusterParam(cluster.barycenter(), m_algo == Algo::chargeCK ? cluster.charge() : 0), par);
+}
+
+StripClusterParameterEstimator::LocalValues
+StripCPEfromTrackAngle::localParameters( const SiStripCluster& cluster, ClusterParam const & cp, AlgoParam const & par) const {
   auto const & p = par.p;
   auto const & ltp = par.ltp;
   auto loc = par.loc;
@@ -110,7 +115,7 @@ StripCPEfromTrackAngle::localParameters( const SiStripCluster& cluster, AlgoPara
   switch (m_algo) {
   case Algo::chargeCK :
     {
-      auto dQdx = siStripClusterTools::chargePerCM(cluster, ltp, p.invThickness);
+      auto dQdx = siStripClusterTools::chargePerCM(cp, ltp, p.invThickness);
       uerr2 = dQdx > maxChgOneMIP ? legacyStripErrorSquared(N,afp) : stripErrorSquared( N, afp,loc );
     }
     break;
@@ -122,7 +127,7 @@ StripCPEfromTrackAngle::localParameters( const SiStripCluster& cluster, AlgoPara
     break;
   }
   
-  const float strip = cluster.barycenter() + corr;
+  const float strip = cp.barycenter() + corr;
   
   return std::make_pair( p.topology->localPosition(strip, ltp.vector()),
 			 p.topology->localError(strip, uerr2, ltp.vector()) );
@@ -22,6 +22,18 @@ class BlockElementLinkerBase {
   virtual double testLink( const reco::PFBlockElement*,
 			   const reco::PFBlockElement* ) const = 0;
 
+  // Optional spatial preselection. A linker returning true guarantees that
+  // testLink() fails for two elements whose linkCoordinates() differ by
+  // more than dx in x or dy in y (y modulo 2pi if periodicY), so that only
+  // the pairs found in a PFLinkGrid of the elements need to be tested.
+  virtual bool linkWindow( double& dx, double& dy, bool& periodicY ) const
+  { return false; }
+
+  // false if the element has no coordinates: it is then tested against all
+  virtual bool linkCoordinates( const reco::PFBlockElement*,
+				double& x, double& y ) const
+  { return false; }
+
   const std::string& name() const { return _linkerName; }
   
  private:
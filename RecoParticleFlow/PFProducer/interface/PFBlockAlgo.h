@@ -59,6 +59,7 @@
 
 #include "RecoParticleFlow/PFProducer/interface/BlockElementLinkerBase.h"
 #include "RecoParticleFlow/PFProducer/interface/BlockElementImporterBase.h"
+#include "RecoParticleFlow/PFProducer/interface/PFLinkGrid.h"
 
 #include <map>
 #include <unordered_map>
@@ -123,6 +124,13 @@ class PFBlockAlgo {
 
   /// sets debug printout flag
   void setDebug( bool debug ) {debug_ = debug;}
+
+  /// tests the links of all the elements concurrently before building the blocks
+  void setParallelLinking( bool parallel ) {parallelLinking_ = parallel;}
+
+  /// restricts the links tested to the elements close in the grids of the
+  /// linkers providing a link window; otherwise all the pairs are tested
+  void setUseLinkGrids( bool use ) {useLinkGrids_ = use;}
   
   /// \return collection of blocks
   /*   const  reco::PFBlockCollection& blocks() const {return *blocks_;} */
@@ -173,6 +181,13 @@ class PFBlockAlgo {
   unsigned int linkTestSquare_[reco::PFBlockElement::kNBETypes][reco::PFBlockElement::kNBETypes];
   
   std::vector<KDTreePtr> kdtrees_;
+
+  bool parallelLinking_;
+  bool useLinkGrids_;
+
+  /// grids of the elements of one type for the linkers providing a link
+  /// window, keyed by rowsize*(linker index)+(element type)
+  std::unordered_map<unsigned,PFLinkGrid> grids_;
 };
 
 #include "DataFormats/ParticleFlowReco/interface/PFBlockElementGsfTrack.h"
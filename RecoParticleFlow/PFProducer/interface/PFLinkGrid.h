@@ -0,0 +1,42 @@
+#ifndef RecoParticleFlow_PFProducer_PFLinkGrid_h
+#define RecoParticleFlow_PFProducer_PFLinkGrid_h
+
+#include <vector>
+
+// A 2D grid of block elements in the coordinates provided by a linker
+// (see BlockElementLinkerBase::linkWindow), with cells the size of the
+// link window, or larger so that there are at most a few cells per
+// element. The candidates around a point are the elements in the
+// cells overlapping the window around it: a superset of the elements
+// that can be linked to it, which must still be tested by the linker.
+class PFLinkGrid
+{
+ public:
+  PFLinkGrid(double dx, double dy, bool periodicY);
+
+  // element indices and coordinates, the indices in increasing order;
+  // elements without coordinates are candidates everywhere
+  void build(const std::vector<unsigned>& elements,
+	     const std::vector<double>& xs,
+	     const std::vector<double>& ys,
+	     const std::vector<unsigned>& unplaced);
+
+  // the candidates around (x,y), sorted and unique
+  void candidates(double x, double y, std::vector<unsigned>& result) const;
+
+ private:
+  int xBin(double x) const;
+  int yBin(double y) const;
+
+  const double dx_, dy_;
+  const bool periodicY_;
+
+  double xmin_, ymin_;
+  double cellX_, cellY_;  // cell sizes, at least dx_ and dy_
+  int nx_, ny_;
+  std::vector<unsigned> cellBegin_;  // nx_*ny_+1 offsets in cellElements_
+  std::vector<unsigned> cellElements_;
+  std::vector<unsigned> unplaced_;
+};
+
+#endif
@@ -26,6 +26,9 @@ PFBlockProducer::PFBlockProducer(const edm::ParameterSet& iConfig) {
   bool debug_ = 
     iConfig.getUntrackedParameter<bool>("debug",false);  
   pfBlockAlgo_.setDebug(debug_);  
+
+  pfBlockAlgo_.setParallelLinking(iConfig.getParameter<bool>("parallelLinking"));
+  pfBlockAlgo_.setUseLinkGrids(iConfig.getParameter<bool>("useLinkGrids"));
       
   edm::ConsumesCollector coll = consumesCollector();
   const std::vector<edm::ParameterSet>& importers
@@ -14,6 +14,11 @@ public:
   ( const reco::PFBlockElement*,
     const reco::PFBlockElement* ) const override;
 
+  bool linkWindow( double& dx, double& dy, bool& periodicY ) const override;
+
+  bool linkCoordinates( const reco::PFBlockElement*,
+			double& x, double& y ) const override;
+
 private:
   bool _useKDTree,_debug;
 };
@@ -49,3 +54,21 @@ double HCALAndHOLinker::testLink
 	   : -1.0 );
   return (dist < 0.2 ? dist : -1.0);
 }
+
+// the link distance is the eta-phi distance of the cluster positions, below 0.2
+bool HCALAndHOLinker::linkWindow
+  ( double& dx, double& dy, bool& periodicY ) const {
+  dx = dy = 0.2;
+  periodicY = true;
+  return true;
+}
+
+bool HCALAndHOLinker::linkCoordinates
+  ( const reco::PFBlockElement* elem, double& x, double& y ) const {
+  const reco::PFClusterRef& ref =
+    static_cast<const reco::PFBlockElementCluster*>(elem)->clusterRef();
+  if( ref.isNull() ) return false;
+  x = ref->positionREP().Eta();
+  y = ref->positionREP().Phi();
+  return true;
+}
@@ -3,6 +3,8 @@
 #include "DataFormats/ParticleFlowReco/interface/PFBlockElementCluster.h"
 #include "RecoParticleFlow/PFClusterTools/interface/LinkByRecHit.h"
 
+#include <cmath>
+
 class HFEMAndHFHADLinker : public BlockElementLinkerBase {
 public:
   HFEMAndHFHADLinker(const edm::ParameterSet& conf) :
@@ -14,6 +16,11 @@ public:
   ( const reco::PFBlockElement*,
     const reco::PFBlockElement* ) const override;
 
+  bool linkWindow( double& dx, double& dy, bool& periodicY ) const override;
+
+  bool linkCoordinates( const reco::PFBlockElement*,
+			double& x, double& y ) const override;
+
 private:
   bool _useKDTree,_debug;
 };
@@ -41,3 +48,21 @@ double HFEMAndHFHADLinker::testLink
   }    
   return LinkByRecHit::testHFEMAndHFHADByRecHit( *hfemref, *hfhadref, _debug );
 }
+
+// the link distance is the x-y distance of the cluster positions, below sqrt(0.1)
+bool HFEMAndHFHADLinker::linkWindow
+  ( double& dx, double& dy, bool& periodicY ) const {
+  dx = dy = std::sqrt(0.1);
+  periodicY = false;
+  return true;
+}
+
+bool HFEMAndHFHADLinker::linkCoordinates
+  ( const reco::PFBlockElement* elem, double& x, double& y ) const {
+  const reco::PFClusterRef& ref =
+    static_cast<const reco::PFBlockElementCluster*>(elem)->clusterRef();
+  if( ref.isNull() ) return false;
+  x = ref->position().X();
+  y = ref->position().Y();
+  return true;
+}
@@ -6,6 +6,11 @@ particleFlowBlock = cms.EDProducer(
     verbose = cms.untracked.bool(False),
     # Debug flag
     debug = cms.untracked.bool(False),
+    # test the links of all elements concurrently
+    parallelLinking = cms.bool(False),
+    # test only the links of the elements close in the grids of the
+    # linkers with a link window
+    useLinkGrids = cms.bool(True),
     
     #define what we are importing into particle flow
     #from the various subdetectors
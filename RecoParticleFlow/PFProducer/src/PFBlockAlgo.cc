@@ -9,8 +9,13 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <tuple>
 #include "TMath.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
 using namespace std;
 using namespace reco;
 
@@ -80,7 +85,9 @@ PFBlockAlgo::PFBlockAlgo() :
 	INIT_ENTRY(PFBlockElement::SC),
 	INIT_ENTRY(PFBlockElement::HO),
 	INIT_ENTRY(PFBlockElement::HGCAL)  
-	  } ) {}
+	  } ),
+  parallelLinking_(false),
+  useLinkGrids_(true) {}
 
 void PFBlockAlgo::setLinkers(const std::vector<edm::ParameterSet>& confs) {
    constexpr unsigned rowsize = reco::PFBlockElement::kNBETypes;
@@ -162,25 +169,107 @@ void PFBlockAlgo::findBlocks() {
   else                blocks_.reset( new reco::PFBlockCollection );
   blocks_->reserve(elements_.size());
 
-  QuickUnion qu(bare_elements_.size());
-  const auto elem_size = bare_elements_.size();
-  for( unsigned i = 0; i < elem_size; ++i ) {
-    for( unsigned j = 0; j < elem_size; ++j ) {
-      if( qu.connected(i,j) || j == i ) continue;
-      if( !linkTests_[linkTestSquare_[bare_elements_[i]->type()][bare_elements_[j]->type()]] ) {
-        j = ranges_[bare_elements_[j]->type()].second;
-        continue;
+  constexpr unsigned rowsize = reco::PFBlockElement::kNBETypes;
+  const unsigned elem_size = bare_elements_.size();
+
+  // the element types present, in the order of the elements
+  std::vector<unsigned> types;
+  for( unsigned t = 0; t < rowsize; ++t ) {
+    if( elem_size && bare_elements_[ranges_[t].first]->type() == t ) types.push_back(t);
+  }
+
+  // grid the elements for the linkers providing a link window; testing
+  // all the pairs is faster for a few elements
+  constexpr unsigned minGridElements = 16;
+  grids_.clear();
+  for( unsigned t1 : types ) {
+    if( !useLinkGrids_ ) break;
+    for( unsigned t2 : types ) {
+      const unsigned index = linkTestSquare_[t1][t2];
+      const auto& linker = linkTests_[index];
+      double dx, dy;
+      bool periodicY;
+      if( !linker || grids_.count(rowsize*index+t2) || 
+	  !linker->linkWindow(dx,dy,periodicY) ) continue;
+      std::vector<unsigned> placed, unplaced;
+      std::vector<double> xs, ys;
+      for( unsigned j = ranges_[t2].first; j <= ranges_[t2].second; ++j ) {
+	double x, y;
+	if( linker->linkCoordinates(bare_elements_[j],x,y) ) {
+	  placed.push_back(j);
+	  xs.push_back(x);
+	  ys.push_back(y);
+	} else {
+	  unplaced.push_back(j);
+	}
       }
-      auto p1(bare_elements_[i]), p2(bare_elements_[j]);
-      const PFBlockElement::Type type1 = p1->type();
-      const PFBlockElement::Type type2 = p2->type();
-      const unsigned index = linkTestSquare_[type1][type2];
-      if( linkTests_[index]->linkPrefilter(p1,p2) ) {
-        const double dist = linkTests_[index]->testLink(p1,p2);
-        // compute linking info if it is possible
-        if( dist > -0.5 ) {
-          qu.unite(i,j);
-        }
+      if( placed.size() < minGridElements ) continue;
+      auto grid = grids_.emplace(std::piecewise_construct,
+				 std::forward_as_tuple(rowsize*index+t2),
+				 std::forward_as_tuple(dx,dy,periodicY)).first;
+      grid->second.build(placed,xs,ys,unplaced);
+    }
+  }
+
+  // calls f for the elements j that element i may be linked to, in
+  // increasing order: the elements of the types it has a linker for,
+  // restricted to the grid candidates when the linker has a grid
+  auto forEachCandidate = [&](unsigned i, std::vector<unsigned>& candidates, auto f) {
+    const PFBlockElement* p1 = bare_elements_[i];
+    for( unsigned t : types ) {
+      const unsigned index = linkTestSquare_[p1->type()][t];
+      if( !linkTests_[index] ) continue;
+      const auto grid = grids_.find(rowsize*index+t);
+      double x, y;
+      if( grid != grids_.end() && linkTests_[index]->linkCoordinates(p1,x,y) ) {
+	grid->second.candidates(x,y,candidates);
+	for( unsigned j : candidates ) {
+	  if( j != i ) f(j);
+	}
+      } else {
+	for( unsigned j = ranges_[t].first; j <= ranges_[t].second; ++j ) {
+	  if( j != i ) f(j);
+	}
+      }
+    }
+  };
+
+  auto linked = [&](unsigned i, unsigned j) {
+    auto p1(bare_elements_[i]), p2(bare_elements_[j]);
+    const unsigned index = linkTestSquare_[p1->type()][p2->type()];
+    // compute linking info if it is possible
+    return ( linkTests_[index]->linkPrefilter(p1,p2) &&
+	     linkTests_[index]->testLink(p1,p2) > -0.5 );
+  };
+
+  QuickUnion qu(elem_size);
+  if( !parallelLinking_ ) {
+    std::vector<unsigned> candidates;
+    for( unsigned i = 0; i < elem_size; ++i ) {
+      forEachCandidate(i, candidates, [&](unsigned j) {
+	  if( !qu.connected(i,j) && linked(i,j) ) qu.unite(i,j);
+	});
+    }
+  } else {
+    // test all the pairs concurrently, then make the same unions in the
+    // same order as above, so that the blocks are identical
+    std::vector<std::vector<unsigned> > links(elem_size);
+    // isolated so that, while waiting for the links, this thread does not pick up
+    // unrelated tasks (e.g. another event of the same module) that could stall it
+    tbb::this_task_arena::isolate([&] {
+	tbb::parallel_for(tbb::blocked_range<unsigned>(0,elem_size),
+			  [&](const tbb::blocked_range<unsigned>& range) {
+			    std::vector<unsigned> candidates;
+			    for( unsigned i = range.begin(); i != range.end(); ++i ) {
+			      forEachCandidate(i, candidates, [&](unsigned j) {
+				  if( linked(i,j) ) links[i].push_back(j);
+				});
+			    }
+			  });
+      });
+    for( unsigned i = 0; i < elem_size; ++i ) {
+      for( unsigned j : links[i] ) {
+	if( !qu.connected(i,j) ) qu.unite(i,j);
       }
     }
   }
@@ -0,0 +1,121 @@
+#include "RecoParticleFlow/PFProducer/interface/PFLinkGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  // cells per element, to bound the memory for sparse elements
+  constexpr unsigned maxCellsPerElement = 4;
+
+  double normalizedPhi(double phi) {
+    while( phi >= M_PI ) phi -= 2*M_PI;
+    while( phi < -M_PI ) phi += 2*M_PI;
+    return phi;
+  }
+}
+
+PFLinkGrid::PFLinkGrid(double dx, double dy, bool periodicY) :
+  dx_(dx), dy_(dy), periodicY_(periodicY),
+  xmin_(0.), ymin_(0.), cellX_(dx), cellY_(dy), nx_(1), ny_(1) {}
+
+int PFLinkGrid::xBin(double x) const {
+  const int bin = std::floor((x-xmin_)/cellX_);
+  return std::min(std::max(bin,0),nx_-1);
+}
+
+int PFLinkGrid::yBin(double y) const {
+  if( periodicY_ ) {
+    const int bin = std::floor((normalizedPhi(y)+M_PI)*ny_/(2*M_PI));
+    return std::min(std::max(bin,0),ny_-1);
+  }
+  const int bin = std::floor((y-ymin_)/cellY_);
+  return std::min(std::max(bin,0),ny_-1);
+}
+
+void PFLinkGrid::build(const std::vector<unsigned>& elements,
+		       const std::vector<double>& xs,
+		       const std::vector<double>& ys,
+		       const std::vector<unsigned>& unplaced) {
+  unplaced_ = unplaced;
+
+  nx_ = ny_ = 1;
+  cellX_ = dx_;
+  cellY_ = dy_;
+  if( !elements.empty() ) {
+    const auto xrange = std::minmax_element(xs.begin(),xs.end());
+    xmin_ = *xrange.first;
+    double xspan = *xrange.second-xmin_, yspan = 2*M_PI;
+    if( !periodicY_ ) {
+      const auto yrange = std::minmax_element(ys.begin(),ys.end());
+      ymin_ = *yrange.first;
+      yspan = *yrange.second-ymin_;
+    }
+    // the cells are made larger, in the coordinate with the most of
+    // them, until there are few enough
+    const double maxCells = maxCellsPerElement*elements.size();
+    while( true ) {
+      const double xcells = std::floor(xspan/cellX_)+1, ycells = std::floor(yspan/cellY_)+1;
+      if( !(xcells*ycells > maxCells) ) break;
+      if( xcells >= ycells ) cellX_ *= 2;
+      else                   cellY_ *= 2;
+    }
+    nx_ = int(xspan/cellX_)+1;
+    if( periodicY_ ) {
+      // cells at least as large as the window, so that a window overlaps
+      // at most three of them
+      ny_ = std::max(1, int(2*M_PI/cellY_));
+    } else {
+      ny_ = int(yspan/cellY_)+1;
+    }
+  }
+
+  // fill the cells in two passes, the elements of each cell stay in order:
+  // cellBegin_[cell+1] counts the elements of cell, then is the end of
+  // the elements of cell while they are placed, and finally their begin
+  std::vector<unsigned> cells(elements.size());
+  cellBegin_.assign(nx_*ny_+1,0);
+  for( unsigned i = 0; i < elements.size(); ++i ) {
+    cells[i] = xBin(xs[i])*ny_ + yBin(ys[i]);
+    ++cellBegin_[cells[i]+1];
+  }
+  for( unsigned cell = 0; cell < cellBegin_.size()-1; ++cell ) {
+    cellBegin_[cell+1] += cellBegin_[cell];
+  }
+  cellElements_.resize(elements.size());
+  for( unsigned i = 0; i < elements.size(); ++i ) {
+    cellElements_[cellBegin_[cells[i]]++] = elements[i];
+  }
+  for( unsigned cell = cellBegin_.size()-1; cell > 0; --cell ) {
+    cellBegin_[cell] = cellBegin_[cell-1];
+  }
+  cellBegin_[0] = 0;
+}
+
+void PFLinkGrid::candidates(double x, double y, std::vector<unsigned>& result) const {
+  result = unplaced_;
+
+  const int x0 = xBin(x-dx_), x1 = xBin(x+dx_);
+  int y0 = 0, y1 = ny_-1;
+  if( !periodicY_ ) {
+    y0 = yBin(y-dy_);
+    y1 = yBin(y+dy_);
+  } else if( ny_ > 3 ) {
+    // with more than three cells the window cannot wrap around into
+    // the cell it starts from
+    y0 = yBin(y-dy_);
+    y1 = yBin(y+dy_);
+    // the window wraps around: y1 < y0, going through the last bin
+    if( y1 < y0 ) y1 += ny_;
+  }
+
+  for( int ix = x0; ix <= x1; ++ix ) {
+    for( int iy = y0; iy <= y1; ++iy ) {
+      const int cell = ix*ny_ + iy%ny_;
+      result.insert(result.end(),
+		    cellElements_.begin()+cellBegin_[cell],
+		    cellElements_.begin()+cellBegin_[cell+1]);
+    }
+  }
+  std::sort(result.begin(),result.end());
+  result.erase(std::unique(result.begin(),result.end()),result.end());
+}
@@ -0,0 +1,104 @@
+// -*- C++ -*-
+//
+// Package:    PFProducer
+// Class:      PFBlockIdentityComparator
+//
+/**\class PFBlockIdentityComparator PFBlockIdentityComparator.cc RecoParticleFlow/PFProducer/test/PFBlockIdentityComparator.cc
+
+ Description: checks that two PFBlockProducers give identical blocks
+
+ Implementation:
+     Used to compare the blocks linked with the grids and concurrently
+     with the ones of the plain double loop over the elements: the blocks
+     must be the same, in the same order, with the same elements and links.
+     Unlike PFBlockComparator, which matches the blocks of different
+     algorithms, any difference is an error.
+     Throws at the end of the job if any block differs.
+*/
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/global/EDAnalyzer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "DataFormats/ParticleFlowReco/interface/PFBlock.h"
+#include "DataFormats/ParticleFlowReco/interface/PFBlockFwd.h"
+
+#include <atomic>
+
+class PFBlockIdentityComparator : public edm::global::EDAnalyzer<> {
+public:
+  explicit PFBlockIdentityComparator(const edm::ParameterSet&);
+
+private:
+  void analyze(edm::StreamID, const edm::Event&, const edm::EventSetup&) const override;
+  void endJob() override;
+
+  bool sameBlock(reco::PFBlock const & a, reco::PFBlock const & b) const;
+
+  edm::EDGetTokenT<reco::PFBlockCollection> referenceToken_;
+  edm::EDGetTokenT<reco::PFBlockCollection> testToken_;
+  mutable std::atomic<unsigned int> nBlocks_;
+  mutable std::atomic<unsigned int> nDifferent_;
+};
+
+PFBlockIdentityComparator::PFBlockIdentityComparator(const edm::ParameterSet& iConfig) :
+  referenceToken_(consumes<reco::PFBlockCollection>(iConfig.getParameter<edm::InputTag>("reference"))),
+  testToken_(consumes<reco::PFBlockCollection>(iConfig.getParameter<edm::InputTag>("test"))),
+  nBlocks_(0),
+  nDifferent_(0)
+{}
+
+bool PFBlockIdentityComparator::sameBlock(reco::PFBlock const & a, reco::PFBlock const & b) const {
+  if (a.elements().size()!=b.elements().size()) return false;
+  for (unsigned int i=0; i<a.elements().size(); ++i) {
+    auto const & ea = a.elements()[i];
+    auto const & eb = b.elements()[i];
+    if (ea.type()!=eb.type() || ea.index()!=eb.index()) return false;
+    if (ea.trackRef()!=eb.trackRef() || ea.clusterRef()!=eb.clusterRef()) return false;
+  }
+  auto const & la = a.linkData();
+  auto const & lb = b.linkData();
+  if (la.size()!=lb.size()) return false;
+  for (auto ia=la.begin(), ib=lb.begin(); ia!=la.end(); ++ia, ++ib) {
+    if (ia->first!=ib->first || ia->second.distance!=ib->second.distance || ia->second.test!=ib->second.test)
+      return false;
+  }
+  return true;
+}
+
+void PFBlockIdentityComparator::analyze(edm::StreamID, const edm::Event& iEvent, const edm::EventSetup&) const {
+  auto const & reference = edm::get(iEvent, referenceToken_);
+  auto const & test = edm::get(iEvent, testToken_);
+
+  if (reference.size()!=test.size()) {
+    edm::LogError("PFBlockIdentityComparator") << "event " << iEvent.id() << ": " << test.size()
+					       << " blocks instead of " << reference.size();
+    ++nDifferent_;
+    return;
+  }
+  for (unsigned int i=0; i<reference.size(); ++i) {
+    ++nBlocks_;
+    if (!sameBlock(reference[i], test[i])) {
+      edm::LogError("PFBlockIdentityComparator") << "event " << iEvent.id() << ": block " << i << " differs\n"
+						 << test[i] << "\ninstead of\n" << reference[i];
+      ++nDifferent_;
+    }
+  }
+}
+
+void PFBlockIdentityComparator::endJob() {
+  if (nBlocks_==0)
+    throw cms::Exception("PFBlockIdentityComparator") << "no block was built, the comparison is not meaningful";
+  if (nDifferent_!=0)
+    throw cms::Exception("PFBlockIdentityComparator") << nDifferent_ << " of the " << nBlocks_
+						       << " blocks (or events) differ";
+  edm::LogSystem("PFBlockIdentityComparator") << "the " << nBlocks_ << " blocks are identical";
+}
+
+DEFINE_FWK_MODULE(PFBlockIdentityComparator);
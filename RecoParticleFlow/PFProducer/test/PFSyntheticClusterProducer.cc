@@ -0,0 +1,124 @@
+// -*- C++ -*-
+//
+// Package:    PFProducer
+// Class:      PFSyntheticClusterProducer
+//
+/**\class PFSyntheticClusterProducer PFSyntheticClusterProducer.cc RecoParticleFlow/PFProducer/test/PFSyntheticClusterProducer.cc
+
+ Description: puts in the event made-up PFClusters of the layers linked by
+              the linkers with a link window (ECAL-HCAL, HCAL-HO, HFEM-HFHAD)
+
+ Implementation:
+     Needs neither geometry nor conditions: the clusters are placed at random
+     in eta-phi (or x-y in HF), half of them spread uniformly and half around
+     a few jet axes, some right at phi = +-pi and some repeated at the same
+     position, so that the blocks have links across the cells of the link
+     grids, across the phi boundary and between equidistant elements.
+     The first event has too few clusters of each type to be gridded.
+     Meant for PFBlockIdentityComparator.
+*/
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "DataFormats/ParticleFlowReco/interface/PFCluster.h"
+#include "DataFormats/ParticleFlowReco/interface/PFClusterFwd.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+class PFSyntheticClusterProducer : public edm::global::EDProducer<> {
+public:
+  explicit PFSyntheticClusterProducer(const edm::ParameterSet&);
+
+private:
+  void produce(edm::StreamID, edm::Event&, const edm::EventSetup&) const override;
+
+  const unsigned int nClusters_;
+};
+
+PFSyntheticClusterProducer::PFSyntheticClusterProducer(const edm::ParameterSet& iConfig) :
+  nClusters_(iConfig.getParameter<unsigned int>("nClusters"))
+{
+  produces<reco::PFClusterCollection>();
+}
+
+void PFSyntheticClusterProducer::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup&) const {
+  std::mt19937 rng(iEvent.id().event());
+  auto uniform = [&](double a, double b) { return std::uniform_real_distribution<double>(a, b)(rng); };
+  auto gauss = [&](double sigma) { return std::normal_distribution<double>(0., sigma)(rng); };
+  const unsigned int n = iEvent.id().event()==1 ? 10 : nClusters_;
+
+  // a few jet axes shared by all the layers
+  std::vector<std::pair<double,double> > jets;
+  for (int i = 0; i != 8; ++i) jets.emplace_back(uniform(-3., 3.), uniform(-M_PI, M_PI));
+  jets.emplace_back(0.5, M_PI-0.01);
+  jets.emplace_back(2.8, -M_PI+0.01);
+
+  // eta and phi within [etaMin,etaMax] (either sign of eta)
+  auto etaPhi = [&](unsigned int i, double etaMin, double etaMax) {
+    double eta, phi;
+    do {
+      if (i%2 == 0) {
+        eta = uniform(etaMin, etaMax)*(uniform(0., 1.) < 0.5 ? -1 : 1);
+        phi = uniform(-M_PI, M_PI);
+      } else {
+        auto const & jet = jets[std::uniform_int_distribution<unsigned int>(0, jets.size()-1)(rng)];
+        eta = jet.first + gauss(0.1);
+        phi = jet.second + gauss(0.1);
+      }
+    } while (std::abs(eta) < etaMin || std::abs(eta) > etaMax);
+    if (i%10 == 1) phi = M_PI*(eta > 0 ? 1 : -1);
+    return std::make_pair(eta, std::remainder(phi, 2*M_PI));
+  };
+
+  auto clusters = std::make_unique<reco::PFClusterCollection>();
+  // on a cylinder of radius r, or on the disks at +-z
+  auto addBarrel = [&](PFLayer::Layer layer, double r, double etaMax) {
+    for (unsigned int i = 0; i != n; ++i) {
+      auto p = etaPhi(i, 0., etaMax);
+      clusters->emplace_back(layer, uniform(1., 50.), r*std::cos(p.second), r*std::sin(p.second), r*std::sinh(p.first));
+      if (i%7 == 0) clusters->push_back(clusters->back());
+    }
+  };
+  auto addEndcap = [&](PFLayer::Layer layer, double z, double etaMin, double etaMax) {
+    for (unsigned int i = 0; i != n; ++i) {
+      auto p = etaPhi(i, etaMin, etaMax);
+      double r = z/std::sinh(std::abs(p.first));
+      clusters->emplace_back(layer, uniform(1., 50.), r*std::cos(p.second), r*std::sin(p.second), std::copysign(z, p.first));
+      if (i%7 == 0) clusters->push_back(clusters->back());
+    }
+  };
+
+  addEndcap(PFLayer::ECAL_ENDCAP, 320., 1.5, 3.0);
+  addBarrel(PFLayer::HCAL_BARREL1, 190., 1.3);
+  addEndcap(PFLayer::HCAL_ENDCAP, 400., 1.3, 3.0);
+  addBarrel(PFLayer::HCAL_BARREL2, 400., 1.3);
+
+  // HF: the hadronic clusters within a few mm of the electromagnetic ones, or anywhere
+  std::vector<math::XYZPoint> hfem;
+  for (unsigned int i = 0; i != n; ++i) {
+    double r = uniform(15., 130.), phi = uniform(-M_PI, M_PI), z = uniform(0., 1.) < 0.5 ? -1115. : 1115.;
+    clusters->emplace_back(PFLayer::HF_EM, uniform(1., 50.), r*std::cos(phi), r*std::sin(phi), z);
+    hfem.push_back(clusters->back().position());
+  }
+  for (auto const & em : hfem) {
+    if (uniform(0., 1.) < 0.3) {
+      double r = uniform(15., 130.), phi = uniform(-M_PI, M_PI);
+      clusters->emplace_back(PFLayer::HF_HAD, uniform(1., 50.), r*std::cos(phi), r*std::sin(phi), em.z());
+    } else {
+      clusters->emplace_back(PFLayer::HF_HAD, uniform(1., 50.), em.x() + gauss(0.3), em.y() + gauss(0.3), em.z());
+    }
+  }
+
+  iEvent.put(std::move(clusters));
+}
+
+DEFINE_FWK_MODULE(PFSyntheticClusterProducer);
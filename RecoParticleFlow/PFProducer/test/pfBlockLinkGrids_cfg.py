@@ -0,0 +1,55 @@
+import FWCore.ParameterSet.Config as cms
+
+# Builds the blocks of made-up ECAL, HCAL, HO and HF clusters twice, with the
+# link grids and the concurrent link tests and with the plain double loop over
+# the elements, and checks that the blocks are identical.
+# Needs neither geometry nor conditions.
+process = cms.Process("PFBlockLinkGrids")
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(4),
+    numberOfStreams = cms.untracked.uint32(0)
+)
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(10))
+
+process.syntheticClusters = cms.EDProducer("PFSyntheticClusterProducer",
+    nClusters = cms.uint32(500)
+)
+
+from RecoParticleFlow.PFProducer.particleFlowBlock_cfi import particleFlowBlock
+process.particleFlowBlockReference = particleFlowBlock.clone(
+    useLinkGrids = False,
+    parallelLinking = False,
+    elementImporters = cms.VPSet(
+        cms.PSet( importerName = cms.string("GenericClusterImporter"),
+                  source = cms.InputTag("syntheticClusters") )
+    ),
+    linkDefinitions = cms.VPSet(
+        cms.PSet( linkerName = cms.string("ECALAndHCALLinker"),
+                  linkType   = cms.string("ECAL:HCAL"),
+                  useKDTree  = cms.bool(False) ),
+        cms.PSet( linkerName = cms.string("HCALAndHOLinker"),
+                  linkType   = cms.string("HCAL:HO"),
+                  useKDTree  = cms.bool(False) ),
+        cms.PSet( linkerName = cms.string("HFEMAndHFHADLinker"),
+                  linkType   = cms.string("HFEM:HFHAD"),
+                  useKDTree  = cms.bool(False) )
+    )
+)
+process.particleFlowBlockGrids = process.particleFlowBlockReference.clone(
+    useLinkGrids = True,
+    parallelLinking = True
+)
+
+process.pfBlockIdentityComparator = cms.EDAnalyzer("PFBlockIdentityComparator",
+    reference = cms.InputTag("particleFlowBlockReference"),
+    test = cms.InputTag("particleFlowBlockGrids")
+)
+
+process.p = cms.Path(process.syntheticClusters +
+                     process.particleFlowBlockReference +
+                     process.particleFlowBlockGrids +
+                     process.pfBlockIdentityComparator)
@@ -0,0 +1,7 @@
+#!/bin/bash
+
+function die { echo $1: status $2 ;  exit $2; }
+
+# the blocks linked with the grids and concurrently must be identical to
+# the ones of the double loop over the elements
+cmsRun ${LOCAL_TEST_DIR}/pfBlockLinkGrids_cfg.py || die 'Failure comparing the blocks' $?
@@ -49,6 +49,10 @@ public:
 
    
   
+  int getInnerHitId() const {
+    return theDoublets->innerHitId(theDoubletId);
+  }
+  
   Hit const & getInnerHit() const {
     return theDoublets->hit(theDoubletId, HitDoublets::inner);
   }
@@ -98,7 +102,8 @@ public:
     return theDoublets->phi(theDoubletId, HitDoublets::outer);
   }
   
-  void evolve(unsigned int me, CAStatusColl& allStatus) {
+  // only writes the status of this cell, so that it can be called concurrently for different cells
+  void evolve(unsigned int me, CAStatusColl& allStatus) const {
     
     allStatus[me].hasSameStateNeighbors = 0;
     auto mystate = allStatus[me].theCAState;
@@ -116,9 +121,11 @@ public:
   }
   
 
-  void checkAlignmentAndAct(CAColl& allCells, CAntuple & innerCells, const float ptmin, const float region_origin_x,
+  // calls act(innerCellId) for each of the innerCells aligned with this one
+  template<typename Action>
+  void checkAlignmentAndAct(CAColl const& allCells, CAntuple const& innerCells, const float ptmin, const float region_origin_x,
 			    const float region_origin_y, const float region_origin_radius, const float thetaCut,
-			    const float phiCut, const float hardPtCut, std::vector<CACell::CAntuplet> * foundTriplets) {
+			    const float phiCut, const float hardPtCut, Action&& act) const {
     int ncells = innerCells.size();
     int constexpr VSIZE = 16;
     int ok[VSIZE];
@@ -126,7 +133,6 @@ public:
     float z1[VSIZE];
     auto ro = getOuterR();
     auto zo = getOuterZ();
-    unsigned int cellId = this - &allCells.front();
     auto loop = [&](int i, int vs) {
       for (int j=0;j<vs; ++j) {
 	auto koc = innerCells[i+j];
@@ -141,10 +147,7 @@ public:
 	auto & oc =  allCells[koc]; 
 	if (ok[j]&&haveSimilarCurvature(oc,ptmin, region_origin_x, region_origin_y,
 					region_origin_radius, phiCut, hardPtCut)) {
-	  if (foundTriplets) foundTriplets->emplace_back(CACell::CAntuplet{koc,cellId});
-	  else {
-	    oc.tagAsOuterNeighbor(cellId);
-	  }
+	  act(koc);
 	}
       }
     };
@@ -154,19 +157,22 @@ public:
     
   }
   
-  void checkAlignmentAndTag(CAColl& allCells, CAntuple & innerCells, const float ptmin, const float region_origin_x,
+  // only reads the other cells, so that it can be called concurrently for different cells
+  void checkAlignmentAndTag(CAColl const& allCells, CAntuple const& innerCells, CAntuple & alignedInnerCells,
+			    const float ptmin, const float region_origin_x,
 			    const float region_origin_y, const float region_origin_radius, const float thetaCut,
-			    const float phiCut, const float hardPtCut) {
+			    const float phiCut, const float hardPtCut) const {
     checkAlignmentAndAct(allCells, innerCells, ptmin, region_origin_x, region_origin_y, region_origin_radius, thetaCut,
-			 phiCut, hardPtCut, nullptr);
+			 phiCut, hardPtCut, [&](unsigned int koc) { alignedInnerCells.push_back(koc); });
     
   }
   void checkAlignmentAndPushTriplet(CAColl& allCells, CAntuple & innerCells, std::vector<CACell::CAntuplet>& foundTriplets,
 				    const float ptmin, const float region_origin_x, const float region_origin_y,
 				    const float region_origin_radius, const float thetaCut, const float phiCut,
 				    const float hardPtCut) {
+    unsigned int cellId = this - &allCells.front();
     checkAlignmentAndAct(allCells, innerCells, ptmin, region_origin_x, region_origin_y, region_origin_radius, thetaCut,
-			 phiCut, hardPtCut, &foundTriplets);
+			 phiCut, hardPtCut, [&](unsigned int koc) { foundTriplets.emplace_back(CACell::CAntuplet{koc,cellId}); });
   }
   
   
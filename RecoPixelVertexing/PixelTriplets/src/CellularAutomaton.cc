@@ -1,7 +1,16 @@
 #include <queue>
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/task_arena.h"
+
 #include "CellularAutomaton.h"
 
+namespace {
+  // number of cells processed by a single task
+  constexpr unsigned int cellGrainSize = 512;
+}
+
 void CellularAutomaton::createAndConnectCells(
     const std::vector<const HitDoublets *> & hitDoublets,
     const TrackingRegion & region,
@@ -58,11 +67,6 @@ void CellularAutomaton::createAndConnectCells(
           currentOuterLayerRef.isOuterHitOfCell[doubletLayerPairId->outerHitId(i)].push_back(cellId);
 
           cellId++;
-
-          auto & neigCells = currentInnerLayerRef.isOuterHitOfCell[doubletLayerPairId->innerHitId(i)];
-          allCells.back().checkAlignmentAndTag(
-              allCells, neigCells, ptmin, region_origin_x, region_origin_y,
-              region_origin_radius, thetaCut, phiCut, hardPtCut);
         }
         assert(cellId == currentLayerPairRef.theFoundCells[1]);
         for (auto outerLayerPair : currentOuterLayerRef.theOuterLayerPairs) {
@@ -78,6 +82,35 @@ void CellularAutomaton::createAndConnectCells(
       }
     }
   }
+
+  // All the inner layer pairs of a layer pair are visited before it, so the cells sharing
+  // the inner hit of a cell are all known at this point, and the cells can be connected
+  // concurrently: each one collects the inner cells it is aligned with...
+  // The loops are isolated so that a thread waiting for them does not pick up unrelated
+  // tasks (e.g. another event of the calling module) that could stall this event.
+  std::vector<CACell::CAntuple> alignedInnerCells(allCells.size());
+  tbb::this_task_arena::isolate([&] {
+    tbb::parallel_for(std::size_t(0), theLayerGraph.theLayerPairs.size(), [&](std::size_t layerPair) {
+      auto const & layerPairRef = theLayerGraph.theLayerPairs[layerPair];
+      auto const & innerLayerRef = theLayerGraph.theLayers[layerPairRef.theLayers[0]];
+      tbb::parallel_for(tbb::blocked_range<unsigned int>(layerPairRef.theFoundCells[0], layerPairRef.theFoundCells[1], cellGrainSize),
+                        [&](tbb::blocked_range<unsigned int> const & cells) {
+        for (auto i = cells.begin(); i != cells.end(); ++i) {
+          auto const & neigCells = innerLayerRef.isOuterHitOfCell[allCells[i].getInnerHitId()];
+          allCells[i].checkAlignmentAndTag(
+              allCells, neigCells, alignedInnerCells[i], ptmin, region_origin_x, region_origin_y,
+              region_origin_radius, thetaCut, phiCut, hardPtCut);
+        }
+      });
+    });
+  });
+
+  // ...and the outer neighbors are tagged in cell order, as if the cells were connected serially
+  for (unsigned int i = 0; i < allCells.size(); ++i) {
+    for (auto innerCell : alignedInnerCells[i]) {
+      allCells[innerCell].tagAsOuterNeighbor(i);
+    }
+  }
 }
 
 void CellularAutomaton::evolve(const unsigned int minHitsPerNtuplet)
@@ -87,17 +120,22 @@ void CellularAutomaton::evolve(const unsigned int minHitsPerNtuplet)
   unsigned int numberOfIterations = minHitsPerNtuplet - 2;
   // keeping the last iteration for later
   for (unsigned int iteration = 0; iteration < numberOfIterations - 1; ++iteration) {
-    for (auto & layerPair : theLayerGraph.theLayerPairs) {
-      for (auto i = layerPair.theFoundCells[0]; i < layerPair.theFoundCells[1]; ++i) {
-        allCells[i].evolve(i, allStatus);
-      }
-    }
+    // all the cells belong to one of the layer pairs; isolated as in createAndConnectCells
+    tbb::this_task_arena::isolate([&] {
+      tbb::parallel_for(tbb::blocked_range<unsigned int>(0, allCells.size(), cellGrainSize),
+                        [&](tbb::blocked_range<unsigned int> const & cells) {
+        for (auto i = cells.begin(); i != cells.end(); ++i) {
+          allCells[i].evolve(i, allStatus);
+        }
+      });
 
-    for (auto & layerPair : theLayerGraph.theLayerPairs) {
-      for (auto i = layerPair.theFoundCells[0]; i < layerPair.theFoundCells[1]; ++i) {
-        allStatus[i].updateState();
-      }
-    }
+      tbb::parallel_for(tbb::blocked_range<unsigned int>(0, allCells.size(), cellGrainSize),
+                        [&](tbb::blocked_range<unsigned int> const & cells) {
+        for (auto i = cells.begin(); i != cells.end(); ++i) {
+          allStatus[i].updateState();
+        }
+      });
+    });
   }
 
   // last iteration
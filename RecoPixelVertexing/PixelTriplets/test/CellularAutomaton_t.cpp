@@ -0,0 +1,231 @@
+// Checks that the concurrent connect and evolve steps of the CellularAutomaton find
+// the same ntuplets, in the same order, as the serial algorithm they replaced.
+// The reference connects the cells in creation order, as findTriplets still does,
+// and evolves them one layer pair after the other. The events are toy helices and
+// noise hits on four barrel layers.
+
+#include "RecoPixelVertexing/PixelTriplets/src/CellularAutomaton.h"
+#include "RecoTracker/TkTrackingRegions/interface/GlobalTrackingRegion.h"
+
+#include "tbb/task_arena.h"
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+  // RecHitsSortedInPhi only asks its DetLayer whether it is a barrel
+  class ToyBarrelLayer final : public DetLayer {
+  public:
+    ToyBarrelLayer() : DetLayer(false, true) {}
+    const BoundSurface& surface() const override { throw std::logic_error("not used"); }
+    const std::vector<const GeometricSearchDet*>& components() const override { throw std::logic_error("not used"); }
+    const std::vector<const GeomDet*>& basicComponents() const override { throw std::logic_error("not used"); }
+    std::pair<bool, TrajectoryStateOnSurface> compatible(const TrajectoryStateOnSurface&, const Propagator&,
+                                                         const MeasurementEstimator&) const override {
+      throw std::logic_error("not used");
+    }
+    SubDetector subDetector() const override { return GeomDetEnumerators::PixelBarrel; }
+    Location location() const override { return GeomDetEnumerators::barrel; }
+  };
+
+  const std::vector<float> layerRadii = {4.4f, 7.3f, 10.2f, 16.0f};
+  const std::vector<std::pair<int,int>> layerPairs = {{0,1}, {1,2}, {2,3}, {0,2}, {1,3}};
+
+  struct ToyEvent {
+    std::vector<std::unique_ptr<RecHitsSortedInPhi>> layers;
+    std::vector<std::unique_ptr<HitDoublets>> doublets;
+    std::vector<const HitDoublets *> doubletPointers;
+  };
+
+  void addHit(RecHitsSortedInPhi& layer, float x, float y, float z) {
+    float r = std::sqrt(x*x + y*y);
+    float phi = std::atan2(y, x);
+    layer.theHits.emplace_back(phi);
+    layer.x.push_back(x); layer.y.push_back(y); layer.z.push_back(z); layer.r.push_back(r);
+    layer.gphi.push_back(phi); layer.lphi.push_back(phi); layer.drphi.push_back(0.002f);
+    layer.u.push_back(r); layer.v.push_back(z); layer.du.push_back(0.002f); layer.dv.push_back(0.003f);
+  }
+
+  ToyEvent makeEvent(std::mt19937& rng, DetLayer const* detLayer, unsigned int nTracks, unsigned int nNoise) {
+    ToyEvent event;
+    for (unsigned int l = 0; l < layerRadii.size(); ++l)
+      event.layers.emplace_back(new RecHitsSortedInPhi(std::vector<RecHitsSortedInPhi::Hit>(), GlobalPoint(0,0,0), detLayer));
+
+    std::uniform_real_distribution<float> flat(0.f, 1.f);
+    std::normal_distribution<float> gauss(0.f, 1.f);
+    for (unsigned int t = 0; t < nTracks; ++t) {
+      float pt = 0.3f + 10.f*flat(rng)*flat(rng);
+      float phi0 = (2.f*flat(rng) - 1.f)*M_PI;
+      float cotTheta = std::sinh(4.f*flat(rng) - 2.f);
+      float z0 = 4.f*gauss(rng);
+      float charge = flat(rng) < 0.5f ? -1.f : 1.f;
+      float radius = 87.7f*pt;
+      for (unsigned int l = 0; l < layerRadii.size(); ++l) {
+        float r = layerRadii[l];
+        if (r >= 2.f*radius) break;
+        float phi = phi0 - charge*std::asin(r/(2.f*radius)) + 0.0003f*gauss(rng);
+        float z = z0 + 2.f*radius*std::asin(r/(2.f*radius))*cotTheta + 0.003f*gauss(rng);
+        if (std::abs(z) > 27.f) break;
+        if (flat(rng) < 0.03f) continue; // inefficiency
+        addHit(*event.layers[l], r*std::cos(phi), r*std::sin(phi), z);
+      }
+    }
+    for (unsigned int l = 0; l < layerRadii.size(); ++l) {
+      for (unsigned int n = 0; n < nNoise; ++n) {
+        float phi = (2.f*flat(rng) - 1.f)*M_PI;
+        addHit(*event.layers[l], layerRadii[l]*std::cos(phi), layerRadii[l]*std::sin(phi), 54.f*flat(rng) - 27.f);
+      }
+    }
+
+    // doublets pointing to the luminous region, sorted by outer hit
+    for (auto const & pair : layerPairs) {
+      auto const & inner = *event.layers[pair.first];
+      auto const & outer = *event.layers[pair.second];
+      event.doublets.emplace_back(new HitDoublets(inner, outer));
+      for (unsigned int o = 0; o < outer.x.size(); ++o) {
+        for (unsigned int i = 0; i < inner.x.size(); ++i) {
+          float dphi = std::abs(reco::deltaPhi(inner.gphi[i], outer.gphi[o]));
+          float zOrigin = inner.z[i] - inner.r[i]*(outer.z[o] - inner.z[i])/(outer.r[o] - inner.r[i]);
+          if (dphi < 0.1f and std::abs(zOrigin) < 15.f) event.doublets.back()->add(i, o);
+        }
+      }
+      event.doubletPointers.push_back(event.doublets.back().get());
+    }
+    return event;
+  }
+
+  CAGraph makeGraph(ToyEvent const & event) {
+    CAGraph graph;
+    for (unsigned int l = 0; l < layerRadii.size(); ++l)
+      graph.theLayers.emplace_back("BPix" + std::to_string(l+1), event.layers[l]->x.size());
+    for (unsigned int p = 0; p < layerPairs.size(); ++p) {
+      graph.theLayerPairs.emplace_back(layerPairs[p].first, layerPairs[p].second);
+      graph.theLayers[layerPairs[p].first].theOuterLayerPairs.push_back(p);
+      graph.theLayers[layerPairs[p].first].theOuterLayers.push_back(layerPairs[p].second);
+      graph.theLayers[layerPairs[p].second].theInnerLayerPairs.push_back(p);
+      graph.theLayers[layerPairs[p].second].theInnerLayers.push_back(layerPairs[p].first);
+    }
+    graph.theRootLayers.push_back(0);
+    return graph;
+  }
+
+  void findReferenceNtuplets(std::vector<CACell::CAntuple> const & outerNeighbors, unsigned int cell,
+                             std::vector<CACell::CAntuplet> & foundNtuplets, CACell::CAntuplet & tmpNtuplet,
+                             unsigned int minHitsPerNtuplet) {
+    if (tmpNtuplet.size() == minHitsPerNtuplet - 1) {
+      foundNtuplets.push_back(tmpNtuplet);
+      return;
+    }
+    for (auto oc : outerNeighbors[cell]) {
+      tmpNtuplet.push_back(oc);
+      findReferenceNtuplets(outerNeighbors, oc, foundNtuplets, tmpNtuplet, minHitsPerNtuplet);
+      tmpNtuplet.pop_back();
+    }
+  }
+
+  // the serial algorithm
+  std::vector<CACell::CAntuplet> referenceNtuplets(ToyEvent const & event, TrackingRegion const & region,
+                                                   unsigned int minHitsPerNtuplet,
+                                                   float thetaCut, float phiCut, float hardPtCut) {
+    CAGraph graph = makeGraph(event);
+    CellularAutomaton ca(graph);
+    // the triplets are found while creating the cells, in the order the serial connection tagged them
+    std::vector<CACell::CAntuplet> triplets;
+    ca.findTriplets(event.doubletPointers, triplets, region, thetaCut, phiCut, hardPtCut);
+    auto const & allCells = ca.getAllCells();
+    std::vector<CACell::CAntuple> outerNeighbors(allCells.size());
+    for (auto const & triplet : triplets)
+      outerNeighbors[triplet[0]].push_back(triplet[1]);
+
+    std::vector<CACellStatus> allStatus(allCells.size());
+    auto evolveCell = [&](unsigned int i) {
+      allStatus[i].hasSameStateNeighbors = 0;
+      for (auto oc : outerNeighbors[i]) {
+        if (allStatus[oc].getCAState() == allStatus[i].getCAState()) {
+          allStatus[i].hasSameStateNeighbors = 1;
+          break;
+        }
+      }
+    };
+    unsigned int numberOfIterations = minHitsPerNtuplet - 2;
+    for (unsigned int iteration = 0; iteration < numberOfIterations - 1; ++iteration) {
+      for (auto const & layerPair : graph.theLayerPairs)
+        for (auto i = layerPair.theFoundCells[0]; i < layerPair.theFoundCells[1]; ++i)
+          evolveCell(i);
+      for (auto const & layerPair : graph.theLayerPairs)
+        for (auto i = layerPair.theFoundCells[0]; i < layerPair.theFoundCells[1]; ++i)
+          allStatus[i].updateState();
+    }
+    std::vector<unsigned int> rootCells;
+    for (int rootLayerId : graph.theRootLayers) {
+      for (int rootLayerPair : graph.theLayers[rootLayerId].theOuterLayerPairs) {
+        auto foundCells = graph.theLayerPairs[rootLayerPair].theFoundCells;
+        for (auto i = foundCells[0]; i < foundCells[1]; ++i) {
+          evolveCell(i);
+          allStatus[i].updateState();
+          if (allStatus[i].isRootCell(minHitsPerNtuplet - 2))
+            rootCells.push_back(i);
+        }
+      }
+    }
+
+    std::vector<CACell::CAntuplet> foundNtuplets;
+    CACell::CAntuple tmpNtuplet;
+    for (auto rootCell : rootCells) {
+      tmpNtuplet.assign(1, rootCell);
+      findReferenceNtuplets(outerNeighbors, rootCell, foundNtuplets, tmpNtuplet, minHitsPerNtuplet);
+    }
+    return foundNtuplets;
+  }
+
+  std::vector<CACell::CAntuplet> concurrentNtuplets(ToyEvent const & event, TrackingRegion const & region,
+                                                    unsigned int minHitsPerNtuplet,
+                                                    float thetaCut, float phiCut, float hardPtCut) {
+    CAGraph graph = makeGraph(event);
+    CellularAutomaton ca(graph);
+    ca.createAndConnectCells(event.doubletPointers, region, thetaCut, phiCut, hardPtCut);
+    ca.evolve(minHitsPerNtuplet);
+    std::vector<CACell::CAntuplet> foundNtuplets;
+    ca.findNtuplets(foundNtuplets, minHitsPerNtuplet);
+    return foundNtuplets;
+  }
+}
+
+int main() {
+  ToyBarrelLayer detLayer;
+  GlobalTrackingRegion region(0.5f, GlobalPoint(0,0,0), 0.02f, 15.f);
+  // the cuts of the initial step quadruplets
+  const float thetaCut = 0.0012f, phiCut = 0.2f, hardPtCut = 0.f;
+
+  tbb::task_arena arena(8);
+  std::mt19937 rng(42);
+  int failures = 0;
+  std::size_t totalQuadruplets = 0;
+  for (unsigned int e = 0; e < 20; ++e) {
+    ToyEvent event = makeEvent(rng, &detLayer, 50 + 50*e, 20*e);
+    for (unsigned int minHits : {3u, 4u}) {
+      auto reference = referenceNtuplets(event, region, minHits, thetaCut, phiCut, hardPtCut);
+      std::vector<CACell::CAntuplet> concurrent;
+      arena.execute([&] { concurrent = concurrentNtuplets(event, region, minHits, thetaCut, phiCut, hardPtCut); });
+      if (concurrent != reference) {
+        std::cout << "event " << e << ", " << minHits << " hits: " << concurrent.size()
+                  << " ntuplets instead of " << reference.size() << " or in a different order" << std::endl;
+        ++failures;
+      }
+      if (minHits == 4) totalQuadruplets += reference.size();
+    }
+  }
+  if (totalQuadruplets == 0) {
+    std::cout << "no quadruplets found in the toy events, the test is not meaningful" << std::endl;
+    ++failures;
+  }
+  if (failures) return 1;
+  std::cout << "CellularAutomaton: the concurrent and serial algorithms find the same "
+            << totalQuadruplets << " quadruplets" << std::endl;
+  return 0;
+}
@@ -71,6 +71,9 @@ namespace cms
     RedundantSeedCleaner*  theSeedCleaner;
 
     unsigned int maxSeedsBeforeCleaning_;
+
+    /// if not 0, the trajectories of this number of seeds are built concurrently
+    unsigned int theSeedBatchSize;
     
     edm::EDGetTokenT<edm::View<TrajectorySeed> >  theSeedLabel;
     edm::EDGetTokenT<MeasurementTrackerEvent>     theMTELabel;
@@ -0,0 +1,68 @@
+#ifndef RecoTracker_CkfPattern_buildInSeedBatches_h
+#define RecoTracker_CkfPattern_buildInSeedBatches_h
+
+/*
+ * Loop over the seeds order[0..nSeeds) building their trajectories with
+ *   good(j)           : false if seed j is killed by the trajectories stored so far
+ *   build(j, result)  : builds the trajectories of seed j in result (thread safe)
+ *   store(j, result)  : stores the trajectories of seed j, in seed order
+ *   drop(j, result)   : called instead of store for a built seed killed before being stored
+ *
+ * If batchSize is 0 the seeds are built and stored one by one. Otherwise the seeds of
+ * a batch are built concurrently, then stored in seed order. Seeds killed by the
+ * trajectories of the previous batches are not built; those killed by a trajectory of
+ * the same batch are found when storing, and dropped. As good() can only become false
+ * when trajectories are stored, and each seed is built independently, the stored
+ * trajectories are identical to the ones of the serial loop.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
+template <typename Result, typename Good, typename Build, typename Store, typename Drop>
+void buildInSeedBatches(unsigned int const* order, std::size_t nSeeds, unsigned int batchSize,
+                        Good good, Build build, Store store, Drop drop) {
+  if (batchSize == 0) {
+    Result result;
+    for (std::size_t ii = 0; ii < nSeeds; ++ii) {
+      auto j = order[ii];
+      if (!good(j)) continue;
+      build(j, result);
+      store(j, result);
+    }
+    return;
+  }
+
+  std::vector<Result> batchResults(batchSize);
+  std::vector<std::size_t> toBuild;
+  toBuild.reserve(batchSize);
+  for (std::size_t begin = 0; begin < nSeeds; begin += batchSize) {
+    std::size_t end = std::min<std::size_t>(nSeeds, begin + batchSize);
+    toBuild.clear();
+    for (auto ii = begin; ii < end; ++ii)
+      if (good(order[ii])) toBuild.push_back(ii);
+
+    // Isolated so that, while waiting for the batch, this thread does not pick up
+    // unrelated tasks (e.g. another event of the same module) that could stall it
+    tbb::this_task_arena::isolate([&] {
+      tbb::parallel_for(std::size_t(0), toBuild.size(), [&](std::size_t k) {
+        build(order[toBuild[k]], batchResults[toBuild[k]-begin]);
+      });
+    });
+
+    for (auto ii : toBuild) {
+      auto j = order[ii];
+      auto & result = batchResults[ii-begin];
+      if (good(j))
+        store(j, result);
+      else
+        drop(j, result);
+    }
+  }
+}
+
+#endif
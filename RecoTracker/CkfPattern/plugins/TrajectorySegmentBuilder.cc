@@ -320,15 +320,33 @@ TrajectorySegmentBuilder::updateCandidates (TempTrajectory const & traj,
 					    TempTrajectoryContainer& candidates)
 {
   //
-  // generate updated candidates with all valid hits
+  // generate updated candidates with all valid hits,
+  // the states being updated together by the updator
   //
-  for ( auto im=measurements.begin();
-	im!=measurements.end(); ++im ) {
-    if ( im->recHit()->isValid() ) {
-      candidates.push_back(traj);
-      updateTrajectory(candidates.back(),*im);
-      if ( theLockHits )  lockMeasurement(*im);
-    }
+  vector<TM const*> valid;
+  valid.reserve(measurements.size());
+  for ( auto const & tm : measurements ) {
+    if ( tm.recHit()->isValid() )  valid.push_back(&tm);
+  }
+  if ( valid.empty() )  return;
+
+  vector<TrajectoryStateOnSurface> predicted;
+  vector<TrackingRecHit const*> hits;
+  predicted.reserve(valid.size());
+  hits.reserve(valid.size());
+  for ( auto tm : valid ) {
+    predicted.push_back(tm->predictedState());
+    hits.push_back(tm->recHit().get());
+  }
+  vector<TrajectoryStateOnSurface> updated(valid.size());
+  theUpdator.updateBatch(predicted.data(), hits.data(), valid.size(), updated.data());
+
+  for ( unsigned int i=0; i!=valid.size(); ++i ) {
+    TM const & tm = *valid[i];
+    candidates.push_back(traj);
+    candidates.back().emplace(std::move(predicted[i]), std::move(updated[i]),
+			      tm.recHit(), tm.estimate(), tm.layer());
+    if ( theLockHits )  lockMeasurement(tm);
   }
 }
 
@@ -17,6 +17,9 @@ ckfTrackCandidates = cms.EDProducer("CkfTrackCandidateMaker",
 #    SeedLabel = cms.string(''),
     maxNSeeds = cms.uint32(500000),
     maxSeedsBeforeCleaning = cms.uint32(5000),
+# If not 0, build the trajectories of batches of this number of seeds concurrently
+# (the result does not depend on it)
+    seedBatchSize = cms.uint32(0),
 # SeedProducer:SeedLabel descoped to src
     src = cms.InputTag('globalMixedSeeds'),                                  
     SimpleMagneticField = cms.string(''),                                    
@@ -18,6 +18,7 @@
 #include "TrackingTools/TrajectoryState/interface/TrajectoryStateTransform.h"
 
 #include "RecoTracker/CkfPattern/interface/CkfTrackCandidateMakerBase.h"
+#include "RecoTracker/CkfPattern/interface/buildInSeedBatches.h"
 #include "RecoTracker/CkfPattern/interface/TransientInitialStateEstimator.h"
 #include "RecoTracker/Record/interface/TrackerRecoGeometryRecord.h"
 #include "RecoTracker/Record/interface/CkfComponentsRecord.h"
@@ -38,12 +39,7 @@
 
 // #define VI_SORTSEED
 // #define VI_REPRODUCIBLE
-// #define VI_TBB
 
-#include <thread>
-#ifdef VI_TBB
-#include "tbb/parallel_for.h"
-#endif
 
 #include "RecoTracker/CkfPattern/interface/PrintoutHelper.h"
 
@@ -74,6 +70,7 @@ namespace cms{
     theNavigationSchool(nullptr),
     theSeedCleaner(nullptr),
     maxSeedsBeforeCleaning_(0),
+    theSeedBatchSize(conf.getParameter<unsigned int>("seedBatchSize")),
     theMTELabel(iC.consumes<MeasurementTrackerEvent>(conf.getParameter<edm::InputTag>("MeasurementTrackerEvent"))),
     skipClusters_(false),
     phase2skipClusters_(false)
@@ -222,10 +219,6 @@ namespace cms{
       // method for debugging
       countSeedsDebugger();
 
-      // the mutex
-      std::mutex theMutex;
-      using Lock = std::unique_lock<std::mutex>;
-
       // Loop over seeds
       size_t collseed_size = collseed->size();
 
@@ -266,38 +259,21 @@ namespace cms{
       // std::cout << spt(indeces[0]) << ' ' << spt(indeces[collseed_size-1]) << std::endl;
 #endif
 
-      std::atomic<unsigned int> ntseed(0);
-      auto theLoop = [&](size_t ii) {
-        auto j = indeces[ii];
-
-        ntseed++;
-
-        // to be moved inside a par section (how with tbb??)
-        std::vector<Trajectory> theTmpTrajectories;
-
+      // Build the trajectories of seed j into theTmpTrajectories.
+      // It only touches the stop info of seed j, so it can run concurrently for different seeds:
+      // the trajectory builder is only used through const methods, which keep no state of their own,
+      // and the detsets of the MeasurementTrackerEvent are all set when it is produced.
+      auto buildFromSeed = [&](unsigned int j, std::vector<Trajectory>& theTmpTrajectories) {
 
 	LogDebug("CkfPattern") << "======== Begin to look for trajectories from seed " << j << " ========\n";
 
-        { Lock lock(theMutex);
-	// Check if seed hits already used by another track
-	if (theSeedCleaner && !theSeedCleaner->good( &((*collseed)[j])) ) {
-          LogDebug("CkfTrackCandidateMakerBase")<<" Seed cleaning kills seed "<<j;
-          (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::SEED_CLEANING);
-          return;  // from the lambda!
-        }}
-
-
 	// Build trajectory from seed outwards
-        theTmpTrajectories.clear();
         unsigned int nCandPerSeed = 0;
         auto const & startTraj = theTrajectoryBuilder->buildTrajectories( (*collseed)[j], theTmpTrajectories, nCandPerSeed, nullptr );
-        {
-          Lock lock(theMutex);
-          (*outputSeedStopInfos)[j].setCandidatesPerSeed(nCandPerSeed);
-          if(theTmpTrajectories.empty()) {
-            (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::NO_TRAJECTORY);
-            return; // from the lambda!
-          }
+        (*outputSeedStopInfos)[j].setCandidatesPerSeed(nCandPerSeed);
+        if(theTmpTrajectories.empty()) {
+          (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::NO_TRAJECTORY);
+          return; // from the lambda!
         }
 
 	LogDebug("CkfPattern") << "======== In-out trajectory building found " << theTmpTrajectories.size()
@@ -325,7 +301,6 @@ namespace cms{
   			              << " valid/invalid trajectories from seed " << j << " ========\n"
 				 <<PrintoutHelper::dumpCandidates(theTmpTrajectories);
           if(theTmpTrajectories.empty()) {
-            Lock lock(theMutex);
             (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::SEED_REGION_REBUILD);
             return;
           }
@@ -338,8 +313,10 @@ namespace cms{
         LogDebug("CkfPattern") << "======== Trajectory cleaning gave the following " << theTmpTrajectories.size() << " valid trajectories from seed "
                                << j << " ========\n"
 			       <<PrintoutHelper::dumpCandidates(theTmpTrajectories);
+      };
 
-        { Lock lock(theMutex);
+      // Store the valid trajectories of seed j in rawResult: must be called in seed order
+      auto storeTrajectories = [&](unsigned int j, std::vector<Trajectory>& theTmpTrajectories) {
 	for(vector<Trajectory>::iterator it=theTmpTrajectories.begin();
 	    it!=theTmpTrajectories.end(); it++){
 	  if( it->isValid() ) {
@@ -352,13 +329,12 @@ namespace cms{
             if (theSeedCleaner && rawResult.back().foundHits()>3) theSeedCleaner->add( &rawResult.back() );
             //if (theSeedCleaner ) theSeedCleaner->add( & (*it) );
 	  }
-	}}
+	}
 
         theTmpTrajectories.clear();
 
 	LogDebug("CkfPattern") << "rawResult trajectories found so far = " << rawResult.size();
 
-        { Lock lock(theMutex);
 	if ( maxSeedsBeforeCleaning_ >0 && rawResult.size() > maxSeedsBeforeCleaning_+lastCleanResult) {
           theTrajectoryCleaner->clean(rawResult);
           rawResult.erase(std::remove_if(rawResult.begin()+lastCleanResult,rawResult.end(),
@@ -366,26 +342,30 @@ namespace cms{
 			  rawResult.end());
           lastCleanResult=rawResult.size();
         }
-        }
+      };
 
+      // Check if seed hits already used by another track
+      auto seedIsGood = [&](unsigned int j) {
+	if (theSeedCleaner && !theSeedCleaner->good( &((*collseed)[j])) ) {
+          LogDebug("CkfTrackCandidateMakerBase")<<" Seed cleaning kills seed "<<j;
+          (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::SEED_CLEANING);
+          return false;
+        }
+        return true;
       };
-      // end of loop over seeds
 
+      // seeds killed by a trajectory of their own batch are dropped as if they had never been built
+      auto dropTrajectories = [&](unsigned int j, std::vector<Trajectory>& theTmpTrajectories) {
+        (*outputSeedStopInfos)[j].setCandidatesPerSeed(0);
+        theTmpTrajectories.clear();
+      };
 
-#ifdef VI_TBB
-     tbb::parallel_for(0UL,collseed_size,1UL,theLoop);
-#else
-#ifdef VI_OMP
-#pragma omp parallel for schedule(dynamic,4)
-#endif
-      for (size_t j = 0; j < collseed_size; j++){
-       theLoop(j);
-      }
-#endif
-      assert(ntseed==collseed_size);
+      buildInSeedBatches<std::vector<Trajectory>>(indeces, collseed_size, theSeedBatchSize,
+                                                  seedIsGood, buildFromSeed, storeTrajectories, dropTrajectories);
+      // end of loop over seeds
       if (theSeedCleaner) theSeedCleaner->done();
 
-      // std::cout << "VICkfPattern " << "rawResult trajectories found = " << rawResult.size() << " in " << ntseed << " seeds " << collseed_size << std::endl;
+      // std::cout << "VICkfPattern " << "rawResult trajectories found = " << rawResult.size() << " in " << collseed_size << " seeds" << std::endl;
 
 #ifdef VI_REPRODUCIBLE
       // sort trajectory
@@ -404,7 +384,7 @@ namespace cms{
 
       LogDebug("CkfPattern") << "removing invalid trajectories.";
 
-      // Assuming here that theLoop() gives at most one Trajectory per seed
+      // Assuming here that buildFromSeed() gives at most one Trajectory per seed
       for(const auto& traj: rawResult) {
         if(!traj.isValid()) {
           const auto seedIndex = traj.seedRef().key();
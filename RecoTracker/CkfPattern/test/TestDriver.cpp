@@ -0,0 +1,6 @@
+#include "FWCore/Utilities/interface/TestHelper.h"
+
+//____________________________________________________________________________||
+RUNTEST()
+
+//____________________________________________________________________________||
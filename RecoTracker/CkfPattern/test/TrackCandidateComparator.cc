@@ -0,0 +1,109 @@
+// -*- C++ -*-
+//
+// Package:    CkfPattern
+// Class:      TrackCandidateComparator
+//
+/**\class TrackCandidateComparator TrackCandidateComparator.cc RecoTracker/CkfPattern/test/TrackCandidateComparator.cc
+
+ Description: checks that two CkfTrackCandidateMakers give identical track candidates
+
+ Implementation:
+     Used to compare the trajectories built in concurrent batches of seeds
+     (seedBatchSize > 0) with the ones of the serial loop over the seeds: the
+     seeds, hits and starting states of the candidates must be bit by bit the
+     same, and in the same order.
+     Throws at the end of the job if any candidate differs.
+*/
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/global/EDAnalyzer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "DataFormats/TrackCandidate/interface/TrackCandidateCollection.h"
+
+#include <atomic>
+#include <iterator>
+
+namespace {
+  long nRecHits(TrackCandidate const & candidate) {
+    return std::distance(candidate.recHits().first, candidate.recHits().second);
+  }
+}
+
+class TrackCandidateComparator : public edm::global::EDAnalyzer<> {
+public:
+  explicit TrackCandidateComparator(const edm::ParameterSet&);
+
+private:
+  void analyze(edm::StreamID, const edm::Event&, const edm::EventSetup&) const override;
+  void endJob() override;
+
+  bool sameCandidate(TrackCandidate const & a, TrackCandidate const & b) const;
+
+  edm::EDGetTokenT<TrackCandidateCollection> referenceToken_;
+  edm::EDGetTokenT<TrackCandidateCollection> testToken_;
+  mutable std::atomic<unsigned int> nCandidates_;
+  mutable std::atomic<unsigned int> nDifferent_;
+};
+
+TrackCandidateComparator::TrackCandidateComparator(const edm::ParameterSet& iConfig) :
+  referenceToken_(consumes<TrackCandidateCollection>(iConfig.getParameter<edm::InputTag>("reference"))),
+  testToken_(consumes<TrackCandidateCollection>(iConfig.getParameter<edm::InputTag>("test"))),
+  nCandidates_(0),
+  nDifferent_(0)
+{}
+
+bool TrackCandidateComparator::sameCandidate(TrackCandidate const & a, TrackCandidate const & b) const {
+  if (a.seedRef().key()!=b.seedRef().key() || a.nLoops()!=b.nLoops() || a.stopReason()!=b.stopReason()) return false;
+  auto const & sa = a.trajectoryStateOnDet();
+  auto const & sb = b.trajectoryStateOnDet();
+  if (sa.detId()!=sb.detId() || sa.surfaceSide()!=sb.surfaceSide()) return false;
+  if (!(sa.parameters().vector()==sb.parameters().vector())) return false;
+  for (int i=0; i<15; ++i)
+    if (sa.error(i)!=sb.error(i)) return false;
+  if (nRecHits(a)!=nRecHits(b)) return false;
+  auto ha = a.recHits().first;
+  for (auto hb = b.recHits().first; hb!=b.recHits().second; ++ha, ++hb) {
+    if (ha->geographicalId()!=hb->geographicalId() || ha->getType()!=hb->getType()) return false;
+    if (ha->isValid() && !ha->sharesInput(&*hb, TrackingRecHit::all)) return false;
+  }
+  return true;
+}
+
+void TrackCandidateComparator::analyze(edm::StreamID, const edm::Event& iEvent, const edm::EventSetup&) const {
+  auto const & reference = edm::get(iEvent, referenceToken_);
+  auto const & test = edm::get(iEvent, testToken_);
+
+  if (reference.size()!=test.size()) {
+    edm::LogError("TrackCandidateComparator") << "event " << iEvent.id() << ": " << test.size()
+                                              << " track candidates instead of " << reference.size();
+    ++nDifferent_;
+    return;
+  }
+  for (unsigned int i=0; i<reference.size(); ++i) {
+    ++nCandidates_;
+    if (!sameCandidate(reference[i], test[i])) {
+      edm::LogError("TrackCandidateComparator") << "event " << iEvent.id() << ": candidate " << i << " differs,"
+                                                << " seed " << test[i].seedRef().key() << " instead of " << reference[i].seedRef().key()
+                                                << ", " << nRecHits(test[i]) << " hits instead of " << nRecHits(reference[i]);
+      ++nDifferent_;
+    }
+  }
+}
+
+void TrackCandidateComparator::endJob() {
+  if (nCandidates_==0)
+    throw cms::Exception("TrackCandidateComparator") << "no track candidate was built, the comparison is not meaningful";
+  if (nDifferent_!=0)
+    throw cms::Exception("TrackCandidateComparator") << nDifferent_ << " of the " << nCandidates_
+                                                     << " track candidates (or events) differ";
+  edm::LogSystem("TrackCandidateComparator") << "the " << nCandidates_ << " track candidates are identical";
+}
+
+DEFINE_FWK_MODULE(TrackCandidateComparator);
@@ -0,0 +1,39 @@
+import FWCore.ParameterSet.Config as cms
+
+# Build the initialStep track candidates again in concurrent batches of seeds,
+# with the GroupedCkfTrajectoryBuilder of the initialStep and with the
+# CkfTrajectoryBuilder, and check that the candidates are identical to the
+# ones of the serial loop over the seeds.
+def customise(process):
+    process.initialStepTrackCandidatesInBatches = process.initialStepTrackCandidates.clone(
+        seedBatchSize = 16
+    )
+
+    from RecoTracker.CkfPattern.CkfTrajectoryBuilder_cfi import CkfTrajectoryBuilder
+    process.initialStepCkfTrajectoryBuilder = CkfTrajectoryBuilder.clone(
+        trajectoryFilter = cms.PSet(refToPSet_ = cms.string('initialStepTrajectoryFilter')),
+        estimator = 'initialStepChi2Est'
+    )
+    process.initialStepCkfTrackCandidates = process.initialStepTrackCandidates.clone(
+        TrajectoryBuilderPSet = cms.PSet(refToPSet_ = cms.string('initialStepCkfTrajectoryBuilder')),
+        doSeedingRegionRebuilding = False
+    )
+    process.initialStepCkfTrackCandidatesInBatches = process.initialStepCkfTrackCandidates.clone(
+        seedBatchSize = 16
+    )
+
+    process.groupedCkfComparator = cms.EDAnalyzer('TrackCandidateComparator',
+        reference = cms.InputTag('initialStepTrackCandidates'),
+        test = cms.InputTag('initialStepTrackCandidatesInBatches')
+    )
+    process.ckfComparator = process.groupedCkfComparator.clone(
+        reference = 'initialStepCkfTrackCandidates',
+        test = 'initialStepCkfTrackCandidatesInBatches'
+    )
+    process.seedBatches_step = cms.Path(process.initialStepTrackCandidatesInBatches +
+                                        process.initialStepCkfTrackCandidates +
+                                        process.initialStepCkfTrackCandidatesInBatches +
+                                        process.groupedCkfComparator +
+                                        process.ckfComparator)
+    process.schedule.append(process.seedBatches_step)
+    return process
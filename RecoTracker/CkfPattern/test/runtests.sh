@@ -0,0 +1,22 @@
+#!/bin/bash
+
+function die { echo $1: status $2 ;  exit $2; }
+
+# the track candidates built in concurrent batches of seeds, by the real
+# trajectory builders on the MeasurementTrackerEvent of the event, must be the
+# same as the ones of the serial loop over the seeds
+COMMON="--conditions auto:phase1_2017_realistic --era Run2_2017 --geometry DB:Extended"
+
+cmsDriver.py TTbar_13TeV_TuneCUETP8M1_cfi -s GEN,SIM,DIGI,L1,DIGI2RAW -n 2 ${COMMON} --nThreads 1 \
+  --eventcontent FEVTDEBUG --datatier GEN-SIM-DIGI-RAW --fileout file:seedBatches_step1.root \
+  --python_filename seedBatches_step1.py --no_exec || die 'Failure configuring step1' $?
+cmsRun seedBatches_step1.py || die 'Failure running step1' $?
+
+cmsDriver.py step2 -s RAW2DIGI,RECO -n -1 ${COMMON} --nThreads 4 \
+  --filein file:seedBatches_step1.root --fileout file:seedBatches_step2.root \
+  --eventcontent RECO --datatier RECO \
+  --customise RecoTracker/CkfPattern/test/customSeedBatches.py \
+  --python_filename seedBatches_step2.py --no_exec || die 'Failure configuring step2' $?
+cmsRun seedBatches_step2.py || die 'Failure building the track candidates in batches of seeds' $?
+
+rm -f seedBatches_step1.root seedBatches_step2.root
@@ -0,0 +1,93 @@
+// Checks that building the seeds in concurrent batches (seedBatchSize > 0 in
+// CkfTrackCandidateMakerBase) stores the same trajectories, for the same seeds,
+// as the serial loop. The seeds and trajectories are sets of hit indices and the
+// seed cleaner kills the seeds sharing a hit with a stored trajectory of more
+// than 3 hits, as CachingSeedCleanerBySharedInput does.
+
+#include "RecoTracker/CkfPattern/interface/buildInSeedBatches.h"
+
+#include "tbb/task_arena.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+  typedef std::vector<unsigned int> Hits;
+
+  struct Output {
+    std::vector<std::pair<unsigned int, Hits>> stored;
+    std::vector<unsigned int> dropped;
+  };
+
+  Output run(std::vector<Hits> const& seeds, std::vector<unsigned int> const& order, unsigned int batchSize) {
+    Output output;
+    std::set<unsigned int> usedHits;
+
+    auto good = [&](unsigned int j) {
+      for (auto hit : seeds[j])
+        if (usedHits.count(hit)) return false;
+      return true;
+    };
+    // the trajectory continues the seed with hits depending only on the seed
+    auto build = [&](unsigned int j, std::vector<Hits>& result) {
+      std::mt19937 rng(j);
+      Hits hits = seeds[j];
+      unsigned int n = rng() % 8;
+      for (unsigned int i = 0; i < n; ++i) hits.push_back(rng() % 2000);
+      result.push_back(std::move(hits));
+      if (rng() % 5 == 0) result.emplace_back(seeds[j]);
+    };
+    auto store = [&](unsigned int j, std::vector<Hits>& result) {
+      for (auto& hits : result) {
+        if (hits.size() > 3) usedHits.insert(hits.begin(), hits.end());
+        output.stored.emplace_back(j, std::move(hits));
+      }
+      result.clear();
+    };
+    auto drop = [&](unsigned int j, std::vector<Hits>& result) {
+      output.dropped.push_back(j);
+      result.clear();
+    };
+
+    buildInSeedBatches<std::vector<Hits>>(order.data(), order.size(), batchSize, good, build, store, drop);
+    return output;
+  }
+}
+
+int main() {
+  tbb::task_arena arena(4);
+  std::mt19937 rng(12345);
+  int failures = 0;
+  for (unsigned int event = 0; event < 50; ++event) {
+    unsigned int nSeeds = rng() % 500;
+    std::vector<Hits> seeds(nSeeds);
+    for (auto& seed : seeds)
+      for (unsigned int i = 0, n = 2 + rng() % 2; i < n; ++i) seed.push_back(rng() % 2000);
+    std::vector<unsigned int> order(nSeeds);
+    for (unsigned int i = 0; i < nSeeds; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+
+    Output serial = run(seeds, order, 0);
+    if (not serial.dropped.empty()) {
+      std::cout << "event " << event << ": the serial loop dropped built seeds" << std::endl;
+      ++failures;
+    }
+    for (unsigned int batchSize : {1u, 2u, 7u, 64u, 1000u}) {
+      Output batched;
+      arena.execute([&] { batched = run(seeds, order, batchSize); });
+      if (batched.stored != serial.stored) {
+        std::cout << "event " << event << " seedBatchSize " << batchSize << ": " << batched.stored.size()
+                  << " trajectories stored instead of " << serial.stored.size() << " or in a different order"
+                  << std::endl;
+        ++failures;
+      }
+    }
+  }
+  if (failures) return 1;
+  std::cout << "buildInSeedBatches: the batched and serial loops store the same trajectories" << std::endl;
+  return 0;
+}
@@ -8,6 +8,7 @@ RecoTrackerFEVT = cms.PSet(
         'keep recoTracks_generalTracks_*_*', 
         'keep recoTrackExtras_generalTracks_*_*',
         'keep TrackingRecHitsOwned_generalTracks_*_*',
+        'keep CompactTrackerRecHitCollection_generalTracks_*_*',
         'keep *_generalTracks_MVAValues_*',
         'keep TrackingRecHitsOwned_extraFromSeeds_*_*',
         'keep uints_extraFromSeeds_*_*',                                   
@@ -34,6 +35,7 @@ RecoTrackerRECO = cms.PSet(
         'keep recoTracks_generalTracks_*_*', 
         'keep recoTrackExtras_generalTracks_*_*',
         'keep TrackingRecHitsOwned_generalTracks_*_*',
+        'keep CompactTrackerRecHitCollection_generalTracks_*_*',
         'keep *_generalTracks_MVAValues_*',
         'keep *_generalTracks_MVAVals_*',
         'keep TrackingRecHitsOwned_extraFromSeeds_*_*',
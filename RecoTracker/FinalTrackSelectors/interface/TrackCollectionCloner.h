@@ -19,6 +19,7 @@
 
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/TrackReco/interface/TrackExtra.h"
+#include "DataFormats/TrackerRecHit2D/interface/CompactTrackerRecHitCollection.h"
 #include "TrackingTools/PatternTools/interface/TrackCollectionTokens.h"
 
 
@@ -30,6 +31,8 @@ public:
   bool copyExtras_;
   /// copy also trajectories and trajectory->track associations
   bool copyTrajectories_;
+  /// store also the rechits in a CompactTrackerRecHitCollection (to refit from file)
+  bool copyCompactHits_;
  
 
   using Tokens = TrackCollectionTokens;
@@ -38,7 +41,8 @@ public:
   template<typename Producer>
   TrackCollectionCloner(Producer & producer, const edm::ParameterSet & cfg, bool copyDefault ) :
     copyExtras_(cfg.template getUntrackedParameter<bool>("copyExtras", copyDefault)),
-    copyTrajectories_(cfg.template getUntrackedParameter<bool>("copyTrajectories", copyDefault)) {
+    copyTrajectories_(cfg.template getUntrackedParameter<bool>("copyTrajectories", copyDefault)),
+    copyCompactHits_(copyExtras_ && cfg.template getUntrackedParameter<bool>("copyCompactHits", false)) {
     
     std::string alias( cfg.getParameter<std::string>( "@module_label" ) );
     producer.template produces<reco::TrackCollection>().setBranchAlias( alias + "Tracks" );
@@ -46,6 +50,9 @@ public:
       producer.template produces<reco::TrackExtraCollection>().setBranchAlias( alias + "TrackExtras" );
       producer.template produces<TrackingRecHitCollection>().setBranchAlias( alias + "RecHits" );
     }
+    if (copyCompactHits_) {
+      producer.template produces<CompactTrackerRecHitCollection>().setBranchAlias( alias + "CompactRecHits" );
+    }
     if (copyTrajectories_) {
       producer.template produces< std::vector<Trajectory> >().setBranchAlias( alias + "Trajectories" );
       producer.template produces< TrajTrackAssociationCollection >().setBranchAlias( alias + "TrajectoryTrackAssociations" );
@@ -66,6 +73,8 @@ public:
     bool copyExtras_;
     /// copy also trajectories and trajectory->track associations
     bool copyTrajectories_;
+    /// store also the rechits in a CompactTrackerRecHitCollection
+    bool copyCompactHits_;
     
     /// the event
     edm::Event& evt;
@@ -73,6 +82,7 @@ public:
     std::unique_ptr<reco::TrackCollection> selTracks_;
     std::unique_ptr<reco::TrackExtraCollection> selTrackExtras_;
     std::unique_ptr<TrackingRecHitCollection> selHits_;
+    std::unique_ptr<CompactTrackerRecHitCollection> selCompactHits_;
     std::unique_ptr< std::vector<Trajectory> > selTrajs_;
     std::unique_ptr< TrajTrackAssociationCollection > selTTAss_;
   };
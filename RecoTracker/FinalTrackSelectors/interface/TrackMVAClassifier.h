@@ -16,11 +16,13 @@
 #include "FWCore/Utilities/interface/InputTag.h"
 
 #include "CondFormats/EgammaObjects/interface/GBRForest.h"
+#include "CondFormats/EgammaObjects/interface/GBRForestFlatCache.h"
 
 #include <vector>
 #include <memory>
 
-class TrackMVAClassifierBase : public edm::stream::EDProducer<> {
+// the global cache holds the flattened forests, shared by the streams
+class TrackMVAClassifierBase : public edm::stream::EDProducer<edm::GlobalCache<GBRForestFlatCache>> {
 public:
   explicit TrackMVAClassifierBase( const edm::ParameterSet & cfg );
   ~TrackMVAClassifierBase() override;
@@ -59,10 +61,16 @@ private:
 template<typename MVA>
 class TrackMVAClassifier : public TrackMVAClassifierBase {
 public:
-  explicit TrackMVAClassifier( const edm::ParameterSet & cfg ) :
+  explicit TrackMVAClassifier( const edm::ParameterSet & cfg, const GBRForestFlatCache * ) :
     TrackMVAClassifierBase(cfg),
     mva(cfg.getParameter<edm::ParameterSet>("mva")){}
 
+    static std::unique_ptr<GBRForestFlatCache> initializeGlobalCache( const edm::ParameterSet & ) {
+      return std::make_unique<GBRForestFlatCache>();
+    }
+
+    static void globalEndJob( const GBRForestFlatCache * ) {}
+
     static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
       edm::ParameterSetDescription desc;
       fill(desc);
@@ -75,18 +83,36 @@ public:
   
 private:
     void beginStream(edm::StreamID) final {
-      mva.beginStream();
+      mva.beginStream(*globalCache());
     }
 
     void initEvent(const edm::EventSetup& es) final {
-      mva.initEvent(es);
+      mva.initEvent(es,*globalCache());
     }
 
     void computeMVA(reco::TrackCollection const & tracks,
 		    reco::BeamSpot const & beamSpot,
 		    reco::VertexCollection const & vertices,
 		    MVACollection & mvas) const final {
+      computeMVA(mva,tracks,beamSpot,vertices,mvas,0);
+    }
+
+    // an MVA callable on the whole collection scores all the tracks at once
+    template<typename M>
+    static auto computeMVA(M const & mva,
+			   reco::TrackCollection const & tracks,
+			   reco::BeamSpot const & beamSpot,
+			   reco::VertexCollection const & vertices,
+			   MVACollection & mvas, int) -> decltype(mva(tracks,beamSpot,vertices,mvas)) {
+      return mva(tracks,beamSpot,vertices,mvas);
+    }
 
+    template<typename M>
+    static void computeMVA(M const & mva,
+			   reco::TrackCollection const & tracks,
+			   reco::BeamSpot const & beamSpot,
+			   reco::VertexCollection const & vertices,
+			   MVACollection & mvas, long) {
       size_t current = 0;
       for (auto const & trk : tracks) {
 	mvas[current++]= mva(trk,beamSpot,vertices);
@@ -3,9 +3,12 @@
 #include "FWCore/Framework/interface/EventSetup.h"
 #include "FWCore/Framework/interface/ESHandle.h"
 #include "CondFormats/DataRecord/interface/GBRWrapperRcd.h"
+#include "CondFormats/EgammaObjects/interface/GBRForestFlat.h"
+#include "CondFormats/EgammaObjects/interface/GBRForestFlatCache.h"
 
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/VertexReco/interface/Vertex.h"
+#include <algorithm>
 #include <limits>
 
 #include "getBestVertex.h"
@@ -22,25 +25,58 @@ struct mva {
     useForestFromDB_( (!forestLabel_.empty()) & dbFileName_.empty())
   {}
 
-  void beginStream() {
+  static constexpr unsigned int nVars = PROMPT ? 16 : 12;
+
+  // the flat forest is built once, by the first stream, and shared
+  void beginStream(GBRForestFlatCache const & forests) {
     if(!dbFileName_.empty()){
-      TFile gbrfile(dbFileName_.c_str());
-      forestFromFile_.reset((GBRForest*)gbrfile.Get(forestLabel_.c_str()));
+      forest_ = forests.Get(forestLabel_, 0, [this]() {
+	  TFile gbrfile(dbFileName_.c_str());
+	  return std::unique_ptr<GBRForest>((GBRForest*)gbrfile.Get(forestLabel_.c_str()));
+	});
     }
   }
 
-  void initEvent(const edm::EventSetup& es) {
-    forest_ = forestFromFile_.get();
+  void initEvent(const edm::EventSetup& es, GBRForestFlatCache const & forests) {
     if(useForestFromDB_){
-      edm::ESHandle<GBRForest> forestHandle;
-      es.get<GBRWrapperRcd>().get(forestLabel_,forestHandle);
-      forest_ = forestHandle.product();
+      auto const & rcd = es.get<GBRWrapperRcd>();
+      if (rcd.cacheIdentifier()!=forestCacheId_) {
+	forestCacheId_ = rcd.cacheIdentifier();
+	forest_ = forests.Get(forestLabel_, forestCacheId_, [&]() {
+	    edm::ESHandle<GBRForest> forestHandle;
+	    rcd.get(forestLabel_,forestHandle);
+	    return forestHandle;
+	  });
+      }
     }
   }
 
   float operator()(reco::Track const & trk,
 		   reco::BeamSpot const & beamSpot,
 		   reco::VertexCollection const & vertices) const {
+    float gbrVals_[nVars];
+    fillInputs(trk,beamSpot,vertices,gbrVals_);
+    return forest_->GetClassifier(gbrVals_);
+  }
+
+  // scores all the tracks with one call to the forest
+  void operator()(reco::TrackCollection const & tracks,
+		  reco::BeamSpot const & beamSpot,
+		  reco::VertexCollection const & vertices,
+		  std::vector<float> & mvas) const {
+    std::vector<float> gbrVals(tracks.size()*nVars);
+    for (size_t i=0; i<tracks.size(); ++i)
+      fillInputs(tracks[i],beamSpot,vertices,&gbrVals[i*nVars]);
+
+    std::vector<double> responses(tracks.size());
+    forest_->GetGradBoostClassifiers(gbrVals.data(),tracks.size(),nVars,responses.data());
+    std::copy(responses.begin(),responses.end(),mvas.begin());
+  }
+
+  void fillInputs(reco::Track const & trk,
+		  reco::BeamSpot const & beamSpot,
+		  reco::VertexCollection const & vertices,
+		  float * gbrVals_) const {
 
     auto tmva_pt_ = trk.pt();
     auto tmva_ndof_ = trk.ndof();
@@ -72,7 +108,6 @@ struct mva {
     auto tmva_minlost_ = std::min(lostIn,lostOut);
     auto tmva_lostmidfrac_ = static_cast<float>(trk.numberOfLostHits()) / static_cast<float>(trk.numberOfValidHits() + trk.numberOfLostHits());
    
-    float gbrVals_[PROMPT ? 16 : 12];
     gbrVals_[0] = tmva_pt_;
     gbrVals_[1] = tmva_lostmidfrac_;
     gbrVals_[2] = tmva_minlost_;
@@ -98,11 +133,6 @@ struct mva {
       gbrVals_[14] = tmva_absdz_;
       gbrVals_[15] = tmva_absd0_;
     }
-
- 
-
-    return forest_->GetClassifier(gbrVals_);
-    
   }
 
   static const char * name();
@@ -112,8 +142,8 @@ struct mva {
     desc.add<std::string>("GBRForestFileName",std::string());
   }
   
-  std::unique_ptr<GBRForest> forestFromFile_;
-  const GBRForest *forest_ = nullptr; // owned by somebody else
+  std::shared_ptr<const GBRForestFlat> forest_;
+  unsigned long long forestCacheId_ = 0;
   const std::string forestLabel_;
   const std::string dbFileName_;
   const bool useForestFromDB_;
@@ -175,8 +175,8 @@ namespace {
       fillArrayF(drWPVerr_par, dr_par,"drWPVerr_par");
     }
     
-    void beginStream() {}
-    void initEvent(const edm::EventSetup&) {}
+    void beginStream(GBRForestFlatCache const &) {}
+    void initEvent(const edm::EventSetup&, GBRForestFlatCache const &) {}
     
     float operator()(reco::Track const & trk,
 		     reco::BeamSpot const & beamSpot,
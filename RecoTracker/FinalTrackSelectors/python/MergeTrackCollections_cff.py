@@ -42,6 +42,8 @@ generalTracks.mergedSource = cms.InputTag("mergedDuplicateTracks")
 generalTracks.mergedMVAVals = cms.InputTag("duplicateTrackClassifier","MVAValues")
 generalTracks.candidateSource = cms.InputTag("duplicateTrackCandidates","candidates")
 generalTracks.candidateComponents = cms.InputTag("duplicateTrackCandidates","candidateMap")
+# the hits also in flat form, for the TrackRefitter (compactHits) reading RECO
+generalTracks.copyCompactHits = cms.untracked.bool(True)
 
 
 generalTracksTask = cms.Task(
@@ -4,15 +4,19 @@ void
 TrackCollectionCloner::fill(edm::ParameterSetDescription& desc) {
   desc.addUntracked<bool>("copyExtras",      true);
   desc.addUntracked<bool>("copyTrajectories",false);  
+  desc.addUntracked<bool>("copyCompactHits",false);
 }
 
 TrackCollectionCloner::Producer::Producer(edm::Event& ievt, TrackCollectionCloner const & cloner) :
-  copyExtras_(cloner.copyExtras_), copyTrajectories_(cloner.copyTrajectories_), evt(ievt)  {
+  copyExtras_(cloner.copyExtras_), copyTrajectories_(cloner.copyTrajectories_), copyCompactHits_(cloner.copyCompactHits_), evt(ievt)  {
   selTracks_ = std::make_unique<reco::TrackCollection>();
   if (copyExtras_) {
     selTrackExtras_ = std::make_unique<reco::TrackExtraCollection>();
     selHits_ = std::make_unique<TrackingRecHitCollection>();
   }
+  if (copyCompactHits_) {
+    selCompactHits_ = std::make_unique<CompactTrackerRecHitCollection>(evt.getRefBeforePut<TrackingRecHitCollection>().id());
+  }
   if ( copyTrajectories_ ) {
     selTrajs_ = std::make_unique< std::vector<Trajectory> >();
     selTTAss_ = std::make_unique< TrajTrackAssociationCollection >(evt.getRefBeforePut< std::vector<Trajectory> >(), evt.getRefBeforePut<reco::TrackCollection>());
@@ -74,6 +78,8 @@ void TrackCollectionCloner::Producer::operator()(Tokens const & tokens, std::vec
     // TrackingRecHits
     for( auto hit = trk.recHitsBegin(); hit != trk.recHitsEnd(); ++ hit ) {
       selHits_->push_back( (*hit)->clone() );
+      // parallel to the TrackingRecHitCollection
+      if (copyCompactHits_) selCompactHits_->push_back( **hit );
     }
   }
 
@@ -90,6 +96,9 @@ TrackCollectionCloner::Producer::~Producer() {
     evt.put(std::move(selTrackExtras_));
     evt.put(std::move(selHits_));
   }
+  if (copyCompactHits_) {
+    evt.put(std::move(selCompactHits_));
+  }
   if ( copyTrajectories_ ) {
     selTrajs_->shrink_to_fit();
     assert(selTrajs_->size()==tsize);
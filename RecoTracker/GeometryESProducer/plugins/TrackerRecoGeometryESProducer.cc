@@ -27,6 +27,10 @@ TrackerRecoGeometryESProducer::TrackerRecoGeometryESProducer(const edm::Paramete
     // The default parameter ("") makes this change transparent to the user
     // See FastSimulation/Configuration/data/ for examples of cfi's.
     geoLabel = p.getUntrackedParameter<std::string>("trackerGeometryLabel","");
+    // lookup grids for the compatible dets of the barrel layers
+    useDetLayerGrids = p.existsAs<bool>("useDetLayerGrids") ? p.getParameter<bool>("useDetLayerGrids") : false;
+    // check every grid search against the exact search (slow, for validation only)
+    validateDetLayerGrids = p.existsAs<bool>("validateDetLayerGrids") ? p.getParameter<bool>("validateDetLayerGrids") : false;
 }
 
 TrackerRecoGeometryESProducer::~TrackerRecoGeometryESProducer() {}
@@ -42,7 +46,7 @@ TrackerRecoGeometryESProducer::produce(const TrackerRecoGeometryRecord & iRecord
   iRecord.getRecord<TrackerTopologyRcd>().get(tTopoHand);
   const TrackerTopology *tTopo=tTopoHand.product();
 
-  GeometricSearchTrackerBuilder builder;
+  GeometricSearchTrackerBuilder builder(useDetLayerGrids, validateDetLayerGrids);
   return std::unique_ptr<GeometricSearchTracker>(builder.build( tG->trackerDet(), &(*tG), tTopo ));
 }
 
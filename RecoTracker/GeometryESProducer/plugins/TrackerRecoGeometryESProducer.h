@@ -15,6 +15,8 @@ class  TrackerRecoGeometryESProducer: public edm::ESProducer{
   std::unique_ptr<GeometricSearchTracker> produce(const TrackerRecoGeometryRecord &);
  private:
  std::string geoLabel;
+ bool useDetLayerGrids;
+ bool validateDetLayerGrids;
 };
 
 
@@ -288,6 +288,7 @@ MeasurementTrackerEventProducer::updateStrips( const edm::Event& event, StMeasur
       }
     
       theStDets.handle() = clusterHandle;
+      theStDets.resetClusterParams(clusterCollection->dataSize());
       int i=0;
       // cluster and det and in order (both) and unique so let's use set intersection
       for ( auto j = 0U; j< (*clusterCollection).size(); ++j) {
@@ -78,7 +78,7 @@ bool TkStripMeasurementDet::recHits(SimpleHitContainer & result,
     auto leftCluster = rightCluster;
     while ( --leftCluster >=  detSet.begin()) {
       SiStripClusterRef clusterref = detSet.makeRefTo( data.stripData().handle(), leftCluster); 
-      bool isCompatible = filteredRecHits(clusterref, cpepar, stateOnThisDet, est, data.stripClustersToSkip(), tmp);
+      bool isCompatible = filteredRecHits(clusterref, cpepar, stateOnThisDet, est, data, tmp);
       if(!isCompatible) break; // exit loop on first incompatible hit
       for (auto && h: tmp) result.push_back(new SiStripRecHit2D(std::move(h)));
       tmp.clear();								
@@ -86,7 +86,7 @@ bool TkStripMeasurementDet::recHits(SimpleHitContainer & result,
   }
   for ( ; rightCluster != detSet.end(); rightCluster++) {
     SiStripClusterRef clusterref = detSet.makeRefTo( data.stripData().handle(), rightCluster); 
-    bool isCompatible = filteredRecHits(clusterref, cpepar, stateOnThisDet, est, data.stripClustersToSkip(), tmp);
+    bool isCompatible = filteredRecHits(clusterref, cpepar, stateOnThisDet, est, data, tmp);
     if(!isCompatible) break; // exit loop on first incompatible hit
     for (auto && h: tmp) result.push_back(new SiStripRecHit2D(std::move(h))); 
     tmp.clear();
@@ -117,13 +117,13 @@ bool TkStripMeasurementDet::simpleRecHits( const TrajectoryStateOnSurface& state
     auto leftCluster = rightCluster;
     while ( --leftCluster >=  detSet.begin()) {
       SiStripClusterRef clusterref = detSet.makeRefTo( data.stripData().handle(), leftCluster); 
-      bool isCompatible = filteredRecHits(clusterref, cpepar, stateOnThisDet, est, data.stripClustersToSkip(), result);
+      bool isCompatible = filteredRecHits(clusterref, cpepar, stateOnThisDet, est, data, result);
       if(!isCompatible) break; // exit loop on first incompatible hit
     }
   }
   for ( ; rightCluster != detSet.end(); rightCluster++) {
     SiStripClusterRef clusterref = detSet.makeRefTo( data.stripData().handle(), rightCluster); 
-    bool isCompatible = filteredRecHits(clusterref, cpepar, stateOnThisDet, est, data.stripClustersToSkip(), result);
+    bool isCompatible = filteredRecHits(clusterref, cpepar, stateOnThisDet, est, data, result);
     if(!isCompatible) break; // exit loop on first incompatible hit
   }
   
@@ -151,13 +151,13 @@ TkStripMeasurementDet::recHits( const TrajectoryStateOnSurface& stateOnThisDet,
       auto leftCluster = rightCluster;
       while ( --leftCluster >=  detSet.begin()) {
 	SiStripClusterRef clusterref = detSet.makeRefTo( data.stripData().handle(), leftCluster); 
-	bool isCompatible = filteredRecHits(clusterref, cpepar, stateOnThisDet, est, data.stripClustersToSkip(), result, diffs);
+	bool isCompatible = filteredRecHits(clusterref, cpepar, stateOnThisDet, est, data, result, diffs);
 	if(!isCompatible) break; // exit loop on first incompatible hit
       }
     }
     for ( ; rightCluster != detSet.end(); rightCluster++) {
       SiStripClusterRef clusterref = detSet.makeRefTo( data.stripData().handle(), rightCluster); 
-      bool isCompatible = filteredRecHits(clusterref, cpepar, stateOnThisDet, est, data.stripClustersToSkip(), result,diffs);
+      bool isCompatible = filteredRecHits(clusterref, cpepar, stateOnThisDet, est, data, result,diffs);
       if(!isCompatible) break; // exit loop on first incompatible hit
     }
     
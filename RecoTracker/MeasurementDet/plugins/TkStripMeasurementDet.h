@@ -173,12 +173,12 @@ public:
 
   template<class ClusterRefT>
   bool filteredRecHits( const ClusterRefT& cluster, StripCPE::AlgoParam const& cpepar,
-			const TrajectoryStateOnSurface& ltp,  const MeasurementEstimator& est, const std::vector<bool> & skipClusters,
+			const TrajectoryStateOnSurface& ltp,  const MeasurementEstimator& est, const MeasurementTrackerEvent & data,
 			RecHitContainer & result, std::vector<float> & diffs) const {
     if (isMasked(*cluster)) return true;
-    if (!accept(cluster, skipClusters)) return true;
+    if (!accept(cluster, data.stripClustersToSkip())) return true;
     if (!est.preFilter(ltp, ClusterFilterPayload(rawId(),&*cluster) )) return true;  // avoids shadow; consistent with previous statement...
-    auto const & vl = cpe()->localParameters( *cluster, cpepar);
+    auto const & vl = cpe()->localParameters( *cluster, data.stripData().clusterParam(cluster.key(),*cluster), cpepar);
     SiStripRecHit2D recHit(vl.first, vl.second, fastGeomDet(), cluster); // FIXME add cluster count in OmniRef (and move again to multiple sub-clusters..)
     std::pair<bool,double> diffEst = est.estimate(ltp, recHit);
     LogDebug("TkStripMeasurementDet")<<" chi2=" << diffEst.second;
@@ -192,12 +192,12 @@ public:
 
   template<class ClusterRefT>
     bool filteredRecHits( const ClusterRefT& cluster, StripCPE::AlgoParam const& cpepar,
-			  const TrajectoryStateOnSurface& ltp,  const MeasurementEstimator& est, const std::vector<bool> & skipClusters,
+			  const TrajectoryStateOnSurface& ltp,  const MeasurementEstimator& est, const MeasurementTrackerEvent & data,
 			  std::vector<SiStripRecHit2D> & result) const {
     if (isMasked(*cluster)) return true;
-    if (!accept(cluster, skipClusters)) return true;
+    if (!accept(cluster, data.stripClustersToSkip())) return true;
     if (!est.preFilter(ltp, ClusterFilterPayload(rawId(),&*cluster) )) return true;   // avoids shadow; consistent with previous statement...
-    auto const & vl = cpe()->localParameters( *cluster, cpepar);
+    auto const & vl = cpe()->localParameters( *cluster, data.stripData().clusterParam(cluster.key(),*cluster), cpepar);
     result.emplace_back( vl.first, vl.second, fastGeomDet(), cluster);   // FIXME add cluster count in OmniRef
     std::pair<bool,double> diffEst = est.estimate(ltp, result.back());
     LogDebug("TkStripMeasurementDet")<<" chi2=" << diffEst.second;
@@ -15,6 +15,7 @@ class Phase2StripCPE;
 #include "DataFormats/SiPixelCluster/interface/SiPixelCluster.h"
 #include "DataFormats/Phase2TrackerCluster/interface/Phase2TrackerCluster1D.h"
 #include "RecoLocalTracker/Phase2TrackerRecHits/interface/Phase2StripCPE.h"
+#include "RecoLocalTracker/SiStripRecHitConverter/interface/StripCPE.h"
 #include "DataFormats/Common/interface/Handle.h"
 
 #include "CondFormats/SiStripObjects/interface/SiStripBadStrip.h"
@@ -23,6 +24,9 @@ class Phase2StripCPE;
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 
 #include <unordered_map>
+#include <atomic>
+#include <memory>
+#include <cstring>
 
 // #define VISTAT
 
@@ -155,8 +159,6 @@ public:
     empty_(cond.nDet(), true),
     activeThisEvent_(cond.nDet(), true),
     detSet_(cond.nDet()),
-    detIndex_(cond.nDet(),-1),
-    ready_(cond.nDet(),true),
     theRawInactiveStripDetIds_(),
     stripDefined_(0), 
     stripUpdated_(0), 
@@ -176,9 +178,11 @@ public:
     empty_[i] = false;
   }
 
+  // the detset is set here, once per event, rather than on first access, so that
+  // detSet() can be called concurrently (e.g. by the seed batches of the trajectory builders)
   void update(int i, int j ) {
-    assert(j>=0); assert(empty_[i]); assert(ready_[i]); 
-    detIndex_[i] = j;
+    assert(j>=0); assert(empty_[i]);
+    detSet_[i].set(*handle_,handle_->item(j));
     empty_[i] = false;
     incReady();
   }
@@ -198,9 +202,9 @@ public:
   
   void setEmpty() {
     printStat();
+    nClusterParams_=0;
     std::fill(empty_.begin(),empty_.end(),true);
-    std::fill(ready_.begin(),ready_.end(),true);
-    std::fill(detIndex_.begin(),detIndex_.end(),-1);
+    std::fill(detSet_.begin(),detSet_.end(),StripDetset());
     std::fill(activeThisEvent_.begin(), activeThisEvent_.end(),true);
     incTot(size());
   }
@@ -212,7 +216,7 @@ public:
   edm::Handle<edmNew::DetSetVector<SiStripCluster> > & handle() {  return handle_; }
   const edm::Handle<edmNew::DetSetVector<SiStripCluster> > & handle() const {  return handle_; }
   // StripDetset & detSet(int i) { return detSet_[i]; }
-  const StripDetset & detSet(int i) const { if (ready_[i]) const_cast<StMeasurementDetSet*>(this)->getDetSet(i);     return detSet_[i]; }
+  const StripDetset & detSet(int i) const { return detSet_[i]; }
   
 
   //// ------- pieces for on-demand unpacking -------- 
@@ -228,21 +232,42 @@ public:
     stripRegions_[i] = range; 
   }
 
-private:
+  /// Forget the cluster quantities of the previous event, for nClusters clusters in this one
+  void resetClusterParams(unsigned int nClusters) {
+    if (nClusters>clusterParamsCapacity_) {
+      clusterParams_.reset(new std::atomic<uint64_t>[nClusters]);
+      clusterParamsCapacity_ = nClusters;
+    }
+    for (auto i=0U; i<nClusters; ++i) clusterParams_[i].store(0,std::memory_order_relaxed);
+    nClusterParams_=nClusters;
+  }
 
-  void getDetSet(int i) {
-    if(detIndex_[i]>=0) {
-      detSet_[i].set(*handle_,handle_->item(detIndex_[i]));
-      empty_[i]=false; // better be false already
-      incAct();
-    }  else { // we should not be here
-      detSet_[i] = StripDetset();
-      empty_[i]=true;  
+  /** \brief The track independent CPE quantities of the cluster of index key in the collection.
+      They are computed the first time they are needed in the event, then reused by all the
+      MeasurementTrackerEvents sharing this set, i.e. by all the tracking iterations.
+      Can be called concurrently: the same values may be computed and stored more than once. */
+  StripCPE::ClusterParam clusterParam(unsigned int key, const SiStripCluster & cluster) const {
+    if (key>=nClusterParams_) return StripCPE::ClusterParam(cluster);
+    auto & cached = clusterParams_[key];
+    // the upper half holds charge+1, so that 0 means "not computed"
+    auto packed = cached.load(std::memory_order_relaxed);
+    if (packed!=0) {
+      uint32_t bits = packed;
+      float barycenter;
+      std::memcpy(&barycenter,&bits,sizeof(float));
+      incReused();
+      return StripCPE::ClusterParam(barycenter, int(packed>>32)-1);
     }
-    ready_[i]=false;
-    incSet();
+    StripCPE::ClusterParam cp(cluster);
+    float barycenter = cp.barycenter();
+    uint32_t bits;
+    std::memcpy(&bits,&barycenter,sizeof(float));
+    cached.store((uint64_t(cp.charge()+1)<<32) | bits, std::memory_order_relaxed);
+    incComputed();
+    return cp;
   }
 
+private:
 
   friend class  MeasurementTrackerImpl;
 
@@ -258,8 +283,6 @@ private:
   
   // full reco
   std::vector<StripDetset> detSet_;
-  std::vector<int> detIndex_;
-  std::vector<bool> ready_; // to be cleaned
   
  
   // note: not aligned to the index
@@ -267,6 +290,10 @@ private:
   // keyed on si-strip index
   std::vector<bool> stripDefined_, stripUpdated_;
   std::vector<std::pair<unsigned int, unsigned int> > stripRegions_;
+  // keyed on cluster index
+  std::unique_ptr<std::atomic<uint64_t>[]> clusterParams_;
+  unsigned int clusterParamsCapacity_=0;
+  unsigned int nClusterParams_=0;
   // keyed on glued
   // std::vector<bool> gluedUpdated_;
 
@@ -278,6 +305,8 @@ private:
     int detReady=0; // dets "updated"
     int detSet=0;  // det actually set not empty
     int detAct=0;  // det actually set with content
+    int clusterComputed=0; // cluster quantities computed
+    int clusterReused=0;  // cluster quantities taken from the cache
   };
 
   mutable Stat stat;
@@ -286,8 +315,11 @@ private:
   void incReady() const { stat.detReady++;}
   void incSet() const { stat.detSet++;}
   void incAct() const { stat.detAct++;}
+  void incComputed() const { stat.clusterComputed++;}
+  void incReused() const { stat.clusterReused++;}
   void printStat() const {
     COUT << "VI detsets " << stat.totDet <<','<< stat.detReady <<','<< stat.detSet <<','<< stat.detAct << std::endl;
+    COUT << "VI cluster CPE quantities computed,reused " << stat.clusterComputed <<','<< stat.clusterReused << std::endl;
   }
 
 #else
@@ -296,6 +328,8 @@ private:
   static void incReady() {}
   static void incSet() {}
   static void incAct() {}
+  static void incComputed() {}
+  static void incReused() {}
   static void printStat(){}
 #endif
    
@@ -16,11 +16,19 @@ class GeometricSearchTrackerBuilder {
  public:
 
   GeometricSearchTrackerBuilder() {}
+  /// with useDetLayerGrids the barrel layers find their compatible dets from a (phi,z) grid;
+  /// with validateDetLayerGrids they throw if it does not give the dets of the exact search
+  explicit GeometricSearchTrackerBuilder(bool useDetLayerGrids, bool validateDetLayerGrids = false) :
+    theUseDetLayerGrids(useDetLayerGrids), theValidateDetLayerGrids(validateDetLayerGrids) {}
   ~GeometricSearchTrackerBuilder() {}
   
   GeometricSearchTracker* build(const GeometricDet* theGeometricTracker,
 				const TrackerGeometry* theGeomDetGeometry,
 				const TrackerTopology* tTopo) __attribute__ ((cold));
+
+ private:
+  bool theUseDetLayerGrids = false;
+  bool theValidateDetLayerGrids = false;
 };
 
 
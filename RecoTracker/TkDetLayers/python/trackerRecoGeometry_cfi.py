@@ -3,6 +3,11 @@ import FWCore.ParameterSet.Config as cms
 #
 # This cfi should be included to build the TrackerReco geometry.
 #
-TrackerRecoGeometryESProducer = cms.ESProducer("TrackerRecoGeometryESProducer")
+TrackerRecoGeometryESProducer = cms.ESProducer("TrackerRecoGeometryESProducer",
+    # find the compatible dets of the barrel layers from a (phi,z) lookup grid
+    useDetLayerGrids = cms.bool(False),
+    # throw if the grid does not give the compatible dets of the exact search (slow)
+    validateDetLayerGrids = cms.bool(False)
+)
 
 
@@ -3,6 +3,7 @@
 
 #include "PixelBarrelLayerBuilder.h"
 #include "Phase2OTBarrelLayerBuilder.h"
+#include "Phase2OTtiltedBarrelLayer.h"
 #include "PixelForwardLayerBuilder.h"
 #include "Phase2EndcapLayerBuilder.h"
 #include "TIBLayerBuilder.h"
@@ -37,6 +38,12 @@ GeometricSearchTrackerBuilder::build(const GeometricDet* theGeometricTracker,
   TIDLayerBuilder aTIDLayerBuilder;
   TECLayerBuilder aTECLayerBuilder;
 
+  // the tilted layers have their own search
+  auto withGrid = [this](TBLayer* layer) {
+    if (theUseDetLayerGrids && !dynamic_cast<Phase2OTtiltedBarrelLayer*>(layer)) layer->buildGrid(theValidateDetLayerGrids);
+    return layer;
+  };
+
   vector<BarrelDetLayer const*>  thePxlBarLayers;
   vector<BarrelDetLayer const*>  theTIBLayers;
   vector<BarrelDetLayer const*>  theTOBLayers;
@@ -55,7 +62,7 @@ GeometricSearchTrackerBuilder::build(const GeometricDet* theGeometricTracker,
       vector<const GeometricDet*> thePxlBarGeometricDetLayers = (*it)->components();
       for(vector<const GeometricDet*>::const_iterator it2=thePxlBarGeometricDetLayers.begin();
 	  it2!=thePxlBarGeometricDetLayers.end(); it2++){
-	thePxlBarLayers.push_back( aPixelBarrelLayerBuilder.build(*it2,theGeomDetGeometry) );
+	thePxlBarLayers.push_back( withGrid(aPixelBarrelLayerBuilder.build(*it2,theGeomDetGeometry)) );
       }
     }
 
@@ -63,7 +70,7 @@ GeometricSearchTrackerBuilder::build(const GeometricDet* theGeometricTracker,
       vector<const GeometricDet*> thePxlBarGeometricDetLayers = (*it)->components();
       for(vector<const GeometricDet*>::const_iterator it2=thePxlBarGeometricDetLayers.begin();
 	  it2!=thePxlBarGeometricDetLayers.end(); it2++){
-	thePxlBarLayers.push_back( aPixelBarrelLayerBuilder.build(*it2,theGeomDetGeometry) );
+	thePxlBarLayers.push_back( withGrid(aPixelBarrelLayerBuilder.build(*it2,theGeomDetGeometry)) );
       }
     }
 
@@ -71,7 +78,7 @@ GeometricSearchTrackerBuilder::build(const GeometricDet* theGeometricTracker,
       vector<const GeometricDet*> thePxlBarGeometricDetLayers = (*it)->components();
       for(vector<const GeometricDet*>::const_iterator it2=thePxlBarGeometricDetLayers.begin();
 	  it2!=thePxlBarGeometricDetLayers.end(); it2++){
-	thePxlBarLayers.push_back( aPixelBarrelLayerBuilder.build(*it2,theGeomDetGeometry) );
+	thePxlBarLayers.push_back( withGrid(aPixelBarrelLayerBuilder.build(*it2,theGeomDetGeometry)) );
       }
     }
 
@@ -79,7 +86,7 @@ GeometricSearchTrackerBuilder::build(const GeometricDet* theGeometricTracker,
       vector<const GeometricDet*> theTIBGeometricDetLayers = (*it)->components();
       for(vector<const GeometricDet*>::const_iterator it2=theTIBGeometricDetLayers.begin();
 	  it2!=theTIBGeometricDetLayers.end(); it2++){
-	theTIBLayers.push_back( aTIBLayerBuilder.build(*it2,theGeomDetGeometry) );
+	theTIBLayers.push_back( withGrid(aTIBLayerBuilder.build(*it2,theGeomDetGeometry)) );
       }
     }
 
@@ -87,7 +94,7 @@ GeometricSearchTrackerBuilder::build(const GeometricDet* theGeometricTracker,
       vector<const GeometricDet*> theTOBGeometricDetLayers = (*it)->components();
       for(vector<const GeometricDet*>::const_iterator it2=theTOBGeometricDetLayers.begin();
       it2!=theTOBGeometricDetLayers.end(); it2++){
-	theTOBLayers.push_back( aTOBLayerBuilder.build(*it2,theGeomDetGeometry) );
+	theTOBLayers.push_back( withGrid(aTOBLayerBuilder.build(*it2,theGeomDetGeometry)) );
       }
     }
 
@@ -95,7 +102,7 @@ GeometricSearchTrackerBuilder::build(const GeometricDet* theGeometricTracker,
       vector<const GeometricDet*> theTOBGeometricDetLayers = (*it)->components();
       for(vector<const GeometricDet*>::const_iterator it2=theTOBGeometricDetLayers.begin();
 	  it2!=theTOBGeometricDetLayers.end(); it2++){
-	theTOBLayers.push_back( aPhase2OTBarrelLayerBuilder.build(*it2,theGeomDetGeometry) );
+	theTOBLayers.push_back( withGrid(aPhase2OTBarrelLayerBuilder.build(*it2,theGeomDetGeometry)) );
       }
     }
 
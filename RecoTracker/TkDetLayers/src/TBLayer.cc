@@ -4,9 +4,20 @@
 #include "DetGroupMerger.h"
 #include "CompatibleDetToGroupAdder.h"
 
+#include "BarrelUtil.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "TrackingTools/DetLayers/interface/GeomDetCompatibilityChecker.h"
 #include "TrackingTools/DetLayers/interface/MeasurementEstimator.h"
 #include "TrackingTools/GeomPropagators/interface/HelixBarrelCylinderCrossing.h"
 
+#include <algorithm>
+
+namespace {
+  // the candidates of the grid searches, reused by all the layers of a thread
+  thread_local std::vector<unsigned int> gridCandidates;
+}
+
 
 TBLayer::~TBLayer() {
   for ( auto i : theComps) delete i;
@@ -94,3 +105,109 @@ bool TBLayer::addClosest( const TrajectoryStateOnSurface& tsos,
   auto det = sub[crossing.closestDetIndex()];
   return CompatibleDetToGroupAdder().add( *det, tsos, prop, est, result);
 }
+
+
+void TBLayer::buildGrid(bool validate) {
+  // about two cells per rod (or ring) in phi and per det along a rod in z
+  unsigned int nphi = 2*std::max(theInnerComps.size(), theOuterComps.size());
+  unsigned int nz = theComps.empty() ? 1 : 2*theBasicComps.size()/theComps.size();
+  if (isTIB()) std::swap(nphi, nz);  // rings instead of rods
+  theGrid = std::make_unique<const TkDetLayerGrid>(theBasicComps, nphi, nz);
+  theValidateGrid = validate;
+}
+
+
+void TBLayer::compatibleDetsV( const TrajectoryStateOnSurface& tsos,
+			       const Propagator& prop,
+			       const MeasurementEstimator& est,
+			       std::vector<DetWithState> & result) const {
+  if (!theGrid) {
+    BarrelDetLayer::compatibleDetsV( tsos, prop, est, result);
+    return;
+  }
+
+  auto first = result.size();
+  gridCompatibleDets( tsos, prop, est, result);
+  if (theValidateGrid) validateGrid( tsos, prop, est, result, first);
+}
+
+
+void TBLayer::gridCompatibleDets( const TrajectoryStateOnSurface& tsos,
+				  const Propagator& prop,
+				  const MeasurementEstimator& est,
+				  std::vector<DetWithState> & result) const {
+  SubLayerCrossings  crossings; 
+  crossings = computeCrossings( tsos, prop.propagationDirection());
+  if(! crossings.isValid()) return;
+
+  auto const & dets = theGrid->dets();
+  auto & candidates = gridCandidates;
+
+  // the det hit at the closest crossing sizes the search window
+  const GlobalPoint& gClosest = crossings.closest().position();
+  candidates.clear();
+  theGrid->candidates( gClosest.barePhi(), gClosest.z(), 0.f, 0.f, candidates);
+  unsigned int closest = dets.size();
+  auto first = result.size();
+  for (auto i : candidates) {
+    auto && compat = GeomDetCompatibilityChecker::isCompatible( dets[i], tsos, prop, est);
+    if (compat.first) {
+      closest = i;
+      result.emplace_back( dets[i], std::move(compat.second));
+      break;
+    }
+  }
+  // e.g. in a gap between dets: let the exact search decide
+  if (closest == dets.size()) {
+    BarrelDetLayer::compatibleDetsV( tsos, prop, est, result);
+    return;
+  }
+
+  auto const closestState = result[first].second;
+  auto xy = est.maximalLocalDisplacement( closestState, dets[closest]->surface());
+  // same tolerance as barrelUtil::overlap
+  constexpr float phiOffset = 0.00034;
+  float phiWindow = barrelUtil::calculatePhiWindow( xy.x(), *dets[closest], closestState) + phiOffset;
+  float zWindow = std::max( std::abs(xy.x()), std::abs(xy.y()));
+
+  // the dets around both sublayer crossings, each once
+  const GlobalPoint& gOther = crossings.other().position();
+  candidates.clear();
+  theGrid->candidates( gClosest.barePhi(), gClosest.z(), phiWindow, zWindow, candidates);
+  theGrid->candidates( gOther.barePhi(), gOther.z(), phiWindow, zWindow, candidates);
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+  for (auto i : candidates) {
+    if (i == closest) continue;
+    auto && compat = GeomDetCompatibilityChecker::isCompatible( dets[i], tsos, prop, est);
+    if (compat.first) result.emplace_back( dets[i], std::move(compat.second));
+  }
+}
+
+
+void TBLayer::validateGrid( const TrajectoryStateOnSurface& tsos,
+			    const Propagator& prop,
+			    const MeasurementEstimator& est,
+			    std::vector<DetWithState> const & result, std::size_t first) const {
+  std::vector<DetWithState> exact;
+  BarrelDetLayer::compatibleDetsV( tsos, prop, est, exact);
+
+  auto ids = [](std::vector<DetWithState>::const_iterator b, std::vector<DetWithState>::const_iterator e) {
+    std::vector<unsigned int> ids;
+    for (auto i = b; i != e; ++i) ids.push_back(i->first->geographicalId().rawId());
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+  auto gridIds = ids(result.begin()+first, result.end());
+  auto exactIds = ids(exact.begin(), exact.end());
+  if (gridIds == exactIds) return;
+
+  cms::Exception e("TkDetLayers");
+  e << "TBLayer (" << subDetector() << "): the compatible dets from the grid differ from the exact search at "
+    << tsos.globalPosition() << ", momentum " << tsos.globalMomentum() << "\n grid:";
+  for (auto id : gridIds) e << " " << id;
+  e << "\n exact:";
+  for (auto id : exactIds) e << " " << id;
+  throw e;
+}
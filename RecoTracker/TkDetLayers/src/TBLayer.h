@@ -4,6 +4,8 @@
 
 #include "TrackingTools/DetLayers/interface/BarrelDetLayer.h"
 #include "SubLayerCrossings.h"
+#include "TkDetLayerGrid.h"
+#include <memory>
 #include <tuple>
 
 
@@ -29,11 +31,23 @@ class TBLayer: public BarrelDetLayer {
 
   const std::vector<const GeometricSearchDet*>& components() const final  __attribute__ ((cold)) {return theComps;}
   
+  // always the exact rod (or ring) search: the grid does not give the
+  // grouping and ordering of the dets the grouped CKF relies on
   void groupedCompatibleDetsV( const TrajectoryStateOnSurface& tsos,
 			       const Propagator& prop,
 			       const MeasurementEstimator& est,
 			       std::vector<DetGroup> & result) const override __attribute__ ((hot));
 
+  // uses the (phi,z) grid of the basic components if built
+  void compatibleDetsV( const TrajectoryStateOnSurface& tsos,
+			const Propagator& prop,
+			const MeasurementEstimator& est,
+			std::vector<DetWithState> & result) const override __attribute__ ((hot));
+
+  /// build the (phi,z) grid used by compatibleDets (but not by groupedCompatibleDets);
+  /// with validate, every grid search is checked against the exact search
+  void buildGrid(bool validate = false) __attribute__ ((cold));
+
 
   // DetLayer interface
   SubDetector subDetector() const final {return GeomDetEnumerators::subDetGeom[me];}
@@ -90,6 +104,20 @@ protected:
 
   GeomDetEnumerators::SubDetector me;
 
+  std::unique_ptr<const TkDetLayerGrid> theGrid;
+  bool theValidateGrid = false;
+
+ private:
+  void gridCompatibleDets( const TrajectoryStateOnSurface& tsos,
+			   const Propagator& prop,
+			   const MeasurementEstimator& est,
+			   std::vector<DetWithState> & result) const;
+
+  void validateGrid( const TrajectoryStateOnSurface& tsos,
+		     const Propagator& prop,
+		     const MeasurementEstimator& est,
+		     std::vector<DetWithState> const & result, std::size_t first) const __attribute__ ((cold));
+
 };
 
 
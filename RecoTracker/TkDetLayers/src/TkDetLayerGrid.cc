@@ -0,0 +1,93 @@
+#include "TkDetLayerGrid.h"
+
+#include "DataFormats/GeometryVector/interface/Pi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+  inline float normalizedPhi(float phi) {
+    while (phi >= Geom::fpi()) phi -= Geom::ftwoPi();
+    while (phi < -Geom::fpi()) phi += Geom::ftwoPi();
+    return phi;
+  }
+
+  // calls f for the bins from first to last, both included, going around in phi
+  template<typename F>
+  inline void forEachPhiBin(unsigned int first, unsigned int last, unsigned int n, F f) {
+    for (unsigned int b = first; ; b = (b+1)%n) {
+      f(b);
+      if (b == last) break;
+    }
+  }
+}
+
+TkDetLayerGrid::TkDetLayerGrid(std::vector<const GeomDet*> const & dets, unsigned int nphi, unsigned int nz) :
+  theDets(dets), theNPhi(std::max(nphi,1u)), theNZ(std::max(nz,1u))
+{
+  theInvPhiStep = theNPhi/Geom::ftwoPi();
+
+  float zmax = -std::numeric_limits<float>::max();
+  theZMin = std::numeric_limits<float>::max();
+  for (auto det : theDets) {
+    theZMin = std::min(theZMin, det->surface().zSpan().first);
+    zmax = std::max(zmax, det->surface().zSpan().second);
+  }
+  theInvZStep = (zmax > theZMin) ? theNZ/(zmax-theZMin) : 0.f;
+
+  // the cells overlapping the phi and z spans of det i
+  auto forEachCell = [this](unsigned int i, auto f) {
+    auto const & surface = theDets[i]->surface();
+    unsigned int p0 = phiBin(surface.phiSpan().first);
+    unsigned int p1 = phiBin(surface.phiSpan().second);
+    // a span wrapping around in phi entirely within one bin covers them all
+    if (p0 == p1 && surface.phiSpan().first > surface.phiSpan().second) p1 = (p0+theNPhi-1)%theNPhi;
+    unsigned int z0 = zBin(surface.zSpan().first);
+    unsigned int z1 = zBin(surface.zSpan().second);
+    forEachPhiBin(p0, p1, theNPhi, [&](unsigned int p) {
+	for (unsigned int z = z0; z <= z1; ++z) f(p*theNZ+z);
+      });
+  };
+
+  std::vector<unsigned int> count(theNPhi*theNZ, 0);
+  for (unsigned int i = 0; i != theDets.size(); ++i)
+    forEachCell(i, [&](unsigned int cell) { ++count[cell]; });
+
+  theCellBegin.resize(theNPhi*theNZ+1, 0);
+  for (unsigned int cell = 0; cell != count.size(); ++cell)
+    theCellBegin[cell+1] = theCellBegin[cell] + count[cell];
+
+  theCellDets.resize(theCellBegin.back());
+  std::fill(count.begin(), count.end(), 0);
+  for (unsigned int i = 0; i != theDets.size(); ++i)
+    forEachCell(i, [&](unsigned int cell) { theCellDets[theCellBegin[cell] + count[cell]++] = i; });
+}
+
+unsigned int TkDetLayerGrid::phiBin(float phi) const {
+  int b = int((normalizedPhi(phi) + Geom::fpi())*theInvPhiStep);
+  return std::min(std::max(b,0), int(theNPhi)-1);
+}
+
+unsigned int TkDetLayerGrid::zBin(float z) const {
+  int b = int((z - theZMin)*theInvZStep);
+  return std::min(std::max(b,0), int(theNZ)-1);
+}
+
+void TkDetLayerGrid::candidates(float phi, float z, float dphi, float dz, std::vector<unsigned int> & result) const {
+  unsigned int p0 = 0, p1 = theNPhi-1;
+  if (dphi < Geom::fpi()) {
+    p0 = phiBin(phi-dphi);
+    p1 = phiBin(phi+dphi);
+    // the window wraps around in phi entirely within one bin
+    if (p0 == p1 && 2*dphi*theInvPhiStep > 1.f) p0 = (p1+1)%theNPhi;
+  }
+  unsigned int z0 = zBin(z-dz);
+  unsigned int z1 = zBin(z+dz);
+
+  forEachPhiBin(p0, p1, theNPhi, [&](unsigned int p) {
+      auto first = theCellDets.begin() + theCellBegin[p*theNZ+z0];
+      auto last = theCellDets.begin() + theCellBegin[p*theNZ+z1+1];
+      result.insert(result.end(), first, last);
+    });
+}
@@ -0,0 +1,42 @@
+#ifndef TkDetLayers_TkDetLayerGrid_h
+#define TkDetLayers_TkDetLayerGrid_h
+
+#include "Geometry/CommonDetUnit/interface/GeomDet.h"
+
+#include <vector>
+
+/** A (phi,z) lookup grid of the basic components of a barrel layer.
+ *  Each cell lists the dets whose phi and z spans overlap it, so that
+ *  the candidate dets around a point are found without searching
+ *  the rods (or rings) of the layer.
+ *  The candidates are a superset of the compatible dets: they must
+ *  still be checked for compatibility with the state.
+ */
+
+#pragma GCC visibility push(hidden)
+class TkDetLayerGrid {
+public:
+  TkDetLayerGrid(std::vector<const GeomDet*> const & dets, unsigned int nphi, unsigned int nz) __attribute__ ((cold));
+
+  /// appends to result the indices in dets() of the dets overlapping [phi-dphi,phi+dphi]x[z-dz,z+dz],
+  /// once per cell: a det spanning several cells of the window is appended more than once
+  void candidates(float phi, float z, float dphi, float dz, std::vector<unsigned int> & result) const __attribute__ ((hot));
+
+  std::vector<const GeomDet*> const & dets() const { return theDets;}
+
+private:
+  unsigned int phiBin(float phi) const;
+  unsigned int zBin(float z) const;
+
+  std::vector<const GeomDet*> theDets;
+  unsigned int theNPhi;
+  unsigned int theNZ;
+  float theInvPhiStep;
+  float theZMin;
+  float theInvZStep;
+  std::vector<unsigned int> theCellBegin;  // theNPhi*theNZ+1 offsets in theCellDets
+  std::vector<unsigned int> theCellDets;
+};
+
+#pragma GCC visibility pop
+#endif
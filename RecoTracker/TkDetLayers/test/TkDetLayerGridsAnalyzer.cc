@@ -0,0 +1,143 @@
+// -*- C++ -*-
+//
+// Package:    TkDetLayers
+// Class:      TkDetLayerGridsAnalyzer
+//
+/**\class TkDetLayerGridsAnalyzer TkDetLayerGridsAnalyzer.cc RecoTracker/TkDetLayers/test/TkDetLayerGridsAnalyzer.cc
+
+ Description: checks that the barrel layers find the same compatible dets
+              from their (phi,z) grids as with the exact search
+
+ Implementation:
+     Needs only the tracker geometry, built with useDetLayerGrids.
+     Random states, with random errors, are made between the beam line and
+     each barrel layer, aimed at the layer (and a bit beyond its ends), and
+     propagated in a uniform field. compatibleDets, which uses the grid, must
+     give the dets of groupedCompatibleDets, which always searches the rods
+     (or rings). Throws at the end of the job if any state differs.
+*/
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "DataFormats/GeometrySurface/interface/Plane.h"
+#include "MagneticField/UniformEngine/interface/UniformMagneticField.h"
+#include "RecoTracker/Record/interface/TrackerRecoGeometryRecord.h"
+#include "RecoTracker/TkDetLayers/interface/GeometricSearchTracker.h"
+#include "TrackingTools/GeomPropagators/interface/AnalyticalPropagator.h"
+#include "TrackingTools/KalmanUpdators/interface/Chi2MeasurementEstimator.h"
+#include "TrackingTools/TrajectoryParametrization/interface/CurvilinearTrajectoryError.h"
+#include "TrackingTools/TrajectoryParametrization/interface/GlobalTrajectoryParameters.h"
+#include "TrackingTools/TrajectoryState/interface/TrajectoryStateOnSurface.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+class TkDetLayerGridsAnalyzer : public edm::one::EDAnalyzer<> {
+public:
+  explicit TkDetLayerGridsAnalyzer(const edm::ParameterSet&);
+
+private:
+  void analyze(const edm::Event&, const edm::EventSetup&) override;
+  void endJob() override;
+
+  const unsigned int nStates_;
+  const UniformMagneticField field_;
+  const AnalyticalPropagator propagator_;
+  // as the CKF, and a loose one for wide windows
+  const std::vector<Chi2MeasurementEstimator> estimators_;
+  unsigned int nStatesRun_ = 0;
+  unsigned int nCompatible_ = 0;
+  unsigned int nDifferent_ = 0;
+};
+
+TkDetLayerGridsAnalyzer::TkDetLayerGridsAnalyzer(const edm::ParameterSet& iConfig) :
+  nStates_(iConfig.getParameter<unsigned int>("nStates")),
+  field_(3.8),
+  propagator_(&field_, alongMomentum),
+  estimators_{Chi2MeasurementEstimator(30., 3.), Chi2MeasurementEstimator(1000., 10.)}
+{}
+
+void TkDetLayerGridsAnalyzer::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  edm::ESHandle<GeometricSearchTracker> tracker;
+  iSetup.get<TrackerRecoGeometryRecord>().get(tracker);
+
+  std::mt19937 rng(iEvent.id().event());
+  auto uniform = [&](float a, float b) { return std::uniform_real_distribution<float>(a, b)(rng); };
+  auto logUniform = [&](float a, float b) { return std::exp(uniform(std::log(a), std::log(b))); };
+
+  auto ids = [](std::vector<GeometricSearchDet::DetWithState> const & dets) {
+    std::vector<unsigned int> ids;
+    for (auto const & d : dets) ids.push_back(d.first->geographicalId().rawId());
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+
+  for (auto layer : tracker->barrelLayers()) {
+    const float radius = layer->specificSurface().radius();
+    const float halfLength = layer->specificSurface().bounds().length()/2;
+    for (unsigned int i = 0; i != nStates_; ++i) {
+      // aimed at a point of the layer, from a point between the beam line and the layer
+      const float phi = uniform(-M_PI, M_PI);
+      const GlobalPoint target(radius*std::cos(phi), radius*std::sin(phi), uniform(-1.1f, 1.1f)*halfLength);
+      const float r0 = uniform(0.f, 0.8f)*radius;
+      const float phi0 = phi + uniform(-0.1f, 0.1f);
+      const GlobalPoint start(r0*std::cos(phi0), r0*std::sin(phi0), target.z()*r0/radius + uniform(-5.f, 5.f));
+      const GlobalVector dir = (target - start).unit();
+      const float pt = logUniform(0.5f, 50.f);
+      const GlobalVector momentum = dir*(pt/dir.perp());
+      const int charge = uniform(0.f, 1.f) < 0.5f ? -1 : 1;
+
+      // the state on a plane perpendicular to the momentum
+      const GlobalVector x = GlobalVector(-dir.y(), dir.x(), 0).unit();
+      const Surface::RotationType rotation(x, dir.cross(x), dir);
+      auto plane = Plane::build(start, rotation);
+      AlgebraicSymMatrix55 errors;
+      errors(0,0) = std::pow(0.05f*charge/momentum.mag(), 2);
+      errors(1,1) = errors(2,2) = std::pow(logUniform(1e-4f, 1e-2f), 2);
+      errors(3,3) = errors(4,4) = std::pow(logUniform(1e-3f, 0.5f), 2);
+      const TrajectoryStateOnSurface tsos(GlobalTrajectoryParameters(start, momentum, charge, &field_),
+                                          CurvilinearTrajectoryError(errors), *plane);
+
+      for (auto const & est : estimators_) {
+        ++nStatesRun_;
+        auto fromGrid = ids(layer->compatibleDets(tsos, propagator_, est));
+        std::vector<GeometricSearchDet::DetWithState> exact;
+        for (auto const & group : layer->groupedCompatibleDets(tsos, propagator_, est))
+          for (auto const & gel : group) exact.emplace_back(gel.det(), gel.trajectoryState());
+        auto fromSearch = ids(exact);
+        if (!fromSearch.empty()) ++nCompatible_;
+        if (fromGrid != fromSearch) {
+          ++nDifferent_;
+          edm::LogError("TkDetLayerGridsAnalyzer") << "layer " << layer->subDetector() << " at r " << radius
+                                                   << ": " << fromGrid.size() << " dets from the grid, " << fromSearch.size()
+                                                   << " from the exact search, for the state at " << start
+                                                   << " with momentum " << momentum;
+        }
+      }
+    }
+  }
+}
+
+void TkDetLayerGridsAnalyzer::endJob() {
+  if (nCompatible_==0)
+    throw cms::Exception("TkDetLayerGridsAnalyzer") << "no state was compatible with any det, the comparison is not meaningful";
+  if (nDifferent_!=0)
+    throw cms::Exception("TkDetLayerGridsAnalyzer") << "the grid differs from the exact search for " << nDifferent_
+                                                    << " of the " << nStatesRun_ << " states";
+  edm::LogSystem("TkDetLayerGridsAnalyzer") << "the grids give the compatible dets of the exact search for the "
+                                            << nStatesRun_ << " states (" << nCompatible_ << " with compatible dets)";
+}
+
+DEFINE_FWK_MODULE(TkDetLayerGridsAnalyzer);
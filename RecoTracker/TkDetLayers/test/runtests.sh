@@ -0,0 +1,8 @@
+#!/bin/bash
+
+function die { echo $1: status $2 ;  exit $2; }
+
+# the compatible dets that the barrel layers find from their (phi,z) grids
+# must be the ones of the exact search, for random states
+cmsRun ${LOCAL_TEST_DIR}/tkDetLayerGrids_cfg.py geometry=Run2 || die 'Failure comparing the det layer grids (Run2)' $?
+cmsRun ${LOCAL_TEST_DIR}/tkDetLayerGrids_cfg.py geometry=2017 || die 'Failure comparing the det layer grids (2017)' $?
@@ -0,0 +1,33 @@
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# Compares the compatible dets that the barrel layers find from their (phi,z)
+# grids with the exact search, for random states in a uniform field.
+# Only the ideal tracker geometry is needed, no conditions.
+options = VarParsing.VarParsing()
+options.register('geometry', 'Run2', VarParsing.VarParsing.multiplicity.singleton, VarParsing.VarParsing.varType.string,
+                 "Run2 (tracker only) or 2017")
+options.parseArguments()
+
+process = cms.Process("TkDetLayerGrids")
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+if options.geometry == '2017':
+    process.load("Geometry.CMSCommonData.cmsExtendedGeometry2017XML_cfi")
+else:
+    process.load("Geometry.TrackerRecoData.trackerRecoGeometryXML_cfi")
+process.load("Geometry.TrackerNumberingBuilder.trackerNumberingGeometry_cfi")
+process.load("Geometry.TrackerNumberingBuilder.trackerTopology_cfi")
+process.load("Geometry.TrackerGeometryBuilder.trackerGeometry_cfi")
+process.load("Geometry.TrackerGeometryBuilder.trackerParameters_cfi")
+process.trackerGeometry.applyAlignment = cms.bool(False)
+process.load("RecoTracker.GeometryESProducer.TrackerRecoGeometryESProducer_cfi")
+process.TrackerRecoGeometryESProducer.useDetLayerGrids = True
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(3))
+
+process.tkDetLayerGrids = cms.EDAnalyzer("TkDetLayerGridsAnalyzer",
+    nStates = cms.uint32(10000)
+)
+process.p = cms.Path(process.tkDetLayerGrids)
@@ -3,15 +3,18 @@
 
 #include "DataFormats/TrackerRecHit2D/interface/BaseTrackerRecHit.h"
 #include "TrackingTools/DetLayers/interface/DetLayer.h"
+#include "DataFormats/GeometryVector/interface/Pi.h"
 
 #include <vector>
 #include<array>
+#include<algorithm>
 
 #include<cassert>
 
 /** A RecHit container sorted in phi.
  *  Provides fast access for hits in a given phi window
- *  using binary search.
+ *  using a phi binning followed by a binary search inside the bins.
+ *  The hit coordinates are stored as contiguous arrays.
  */
 
 class RecHitsSortedInPhi {
@@ -86,8 +89,8 @@ public:
   }
 
 public:
-  float       phi(int i) const { return theHits[i].phi();}
-  float       gv(int i) const { return isBarrel ? z[i] : gp(i).perp();}  // global v
+  float       phi(int i) const { return gphi[i];}
+  float       gv(int i) const { return isBarrel ? z[i] : r[i];}  // global v
   float       rv(int i) const { return isBarrel ? u[i] : v[i];}  // dispaced r
   GlobalPoint gp(int i) const { return GlobalPoint(x[i],y[i],z[i]);}
 
@@ -103,6 +106,8 @@ public:
   std::vector<float> x;
   std::vector<float> y;
   std::vector<float> z;
+  std::vector<float> r;
+  std::vector<float> gphi;
   std::vector<float> drphi;
 
   // barrel: u=r, v=z, forward the opposite...
@@ -112,11 +117,26 @@ public:
   std::vector<float> dv;
   std::vector<float> lphi;
 
+  // phiBinStart[b] is the index of the first hit in the phi bin b, or later
+  static constexpr int nPhiBins = 128;
+  static int phiBin(float phi) {
+    int b = (phi + Geom::fpi())*(nPhiBins/Geom::ftwoPi());
+    return std::min(std::max(b,0),nPhiBins-1);
+  }
+  std::array<int,nPhiBins+1> phiBinStart;
+
   static void copyResult( const Range& range, std::vector<Hit>& result) {
     result.reserve(result.size()+(range.second-range.first));
     for (HitIter i = range.first; i != range.second; i++) result.push_back( i->hit());
   }
 
+protected:
+  // for the derived classes which fill theHits and gphi themselves, then call initPhiBins
+  RecHitsSortedInPhi() : layer(nullptr), isBarrel(false) {}
+
+  // fill phiBinStart from gphi, which must be sorted
+  void initPhiBins();
+
 };
 
 
@@ -161,7 +181,7 @@ public:
   Hit const & hit(int i, layer l) const { return layers[l]->theHits[index(i,l)].hit();}
   float       phi(int i, layer l) const { return layers[l]->phi(index(i,l));}
   float       rv(int i, layer l) const { return layers[l]->rv(index(i,l));}
-  float       r(int i, layer l) const { float xp = x(i,l); float yp = y(i,l);  return std::sqrt (xp*xp + yp*yp);}
+  float       r(int i, layer l) const { return layers[l]->r[index(i,l)];}
   float        z(int i, layer l) const { return layers[l]->z[index(i,l)];}
   float        x(int i, layer l) const { return layers[l]->x[index(i,l)];}
   float        y(int i, layer l) const { return layers[l]->y[index(i,l)];}
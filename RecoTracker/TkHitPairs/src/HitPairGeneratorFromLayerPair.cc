@@ -121,16 +121,35 @@ void HitPairGeneratorFromLayerPair::doublets(const TrackingRegion& region,
 
   // constexpr float nSigmaRZ = std::sqrt(12.f);
   constexpr float nSigmaPhi = 3.f;
-  for (int io = 0; io!=int(outerHitsMap.theHits.size()); ++io) {
-    if (!deltaPhi.prefilter(outerHitsMap.x[io],outerHitsMap.y[io])) continue;
-    Hit const & ohit =  outerHitsMap.theHits[io].hit();
+
+  // first select the outer hits outside the inner layer and evaluate their phi windows
+  // looping over the contiguous coordinates, then search the inner hits in each window
+  int nOuter = outerHitsMap.theHits.size();
+  if (nOuter==0) return;
+  std::vector<char> outside(nOuter);
+  for (int io = 0; io!=nOuter; ++io)
+    outside[io] = deltaPhi.prefilter(outerHitsMap.x[io],outerHitsMap.y[io]);
+
+  struct PhiWindow {
+    int outerId;
+    float phiMin, phiMax;
+  };
+  std::vector<PhiWindow> windows;
+  windows.reserve(nOuter);
+  for (int io = 0; io!=nOuter; ++io) {
+    if (!outside[io]) continue;
     PixelRecoRange<float> phiRange = deltaPhi(outerHitsMap.x[io],
 					      outerHitsMap.y[io],
 					      outerHitsMap.z[io],
 					      nSigmaPhi*outerHitsMap.drphi[io]
 					      );
-
     if (phiRange.empty()) continue;
+    windows.push_back({io, phiRange.min(), phiRange.max()});
+  }
+
+  for (auto const & window : windows) {
+    auto io = window.outerId;
+    Hit const & ohit =  outerHitsMap.theHits[io].hit();
 
     const HitRZCompatibility *checkRZ = region.checkRZ(&innerHitDetLayer, ohit, iSetup, &outerHitDetLayer, 
 						       outerHitsMap.rv(io),outerHitsMap.z[io],
@@ -141,7 +160,7 @@ void HitPairGeneratorFromLayerPair::doublets(const TrackingRegion& region,
 
     Kernels<HitZCheck,HitRCheck,HitEtaCheck> kernels;
 
-    auto innerRange = innerHitsMap.doubleRange(phiRange.min(), phiRange.max());
+    auto innerRange = innerHitsMap.doubleRange(window.phiMin, window.phiMax);
     LogDebug("HitPairGeneratorFromLayerPair")<<
       "preparing for combination of: "<< innerRange[1]-innerRange[0]+innerRange[3]-innerRange[2]
 				      <<" inner and: "<< outerHitsMap.theHits.size()<<" outter";
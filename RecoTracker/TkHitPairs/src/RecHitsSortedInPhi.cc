@@ -9,7 +9,7 @@
 RecHitsSortedInPhi::RecHitsSortedInPhi(const std::vector<Hit>& hits, GlobalPoint const & origin, DetLayer const * il) :
   layer(il),
   isBarrel(il->isBarrel()),
-  x(hits.size()),y(hits.size()),z(hits.size()),drphi(hits.size()),
+  x(hits.size()),y(hits.size()),z(hits.size()),r(hits.size()),gphi(hits.size()),drphi(hits.size()),
   u(hits.size()),v(hits.size()),du(hits.size()),dv(hits.size()),
   lphi(hits.size())
 {
@@ -37,6 +37,8 @@ RecHitsSortedInPhi::RecHitsSortedInPhi(const std::vector<Hit>& hits, GlobalPoint
     x[i] = gs.position.x();
     y[i] = gs.position.y();
     z[i] = lz;
+    r[i] = gs.position.perp();
+    gphi[i] = theHits[i].phi();
     drphi[i] = gs.errorRPhi;
     u[i] = isBarrel ? lr : lz;
     v[i] = isBarrel ? lz : lr;
@@ -44,7 +46,17 @@ RecHitsSortedInPhi::RecHitsSortedInPhi(const std::vector<Hit>& hits, GlobalPoint
     dv[i] = isBarrel ? dz : dr;
     lphi[i] = loc.barePhi();
   }
-  
+
+  initPhiBins();
+}
+
+void RecHitsSortedInPhi::initPhiBins() {
+  // phiBin is monotonic in phi, so the hits of each bin are contiguous
+  int b = 0;
+  for (int i=0; i!=int(gphi.size()); ++i) {
+    for (auto hb = phiBin(gphi[i]); b<=hb; ++b) phiBinStart[b] = i;
+  }
+  for (; b<=nPhiBins; ++b) phiBinStart[b] = gphi.size();
 }
 
 
@@ -105,7 +117,11 @@ std::vector<RecHitsSortedInPhi::Hit> RecHitsSortedInPhi::hits( float phiMin, flo
 RecHitsSortedInPhi::Range 
 RecHitsSortedInPhi::unsafeRange( float phiMin, float phiMax) const
 {
-  auto low = std::lower_bound( theHits.begin(), theHits.end(), HitWithPhi(phiMin), HitLessPhi());
-  return Range( low,
-	       std::upper_bound(low, theHits.end(), HitWithPhi(phiMax), HitLessPhi()));
+  // the hits with phi>=phiMin (phi>phiMax) cannot be in a bin before the one of phiMin (phiMax)
+  auto bmin = phiBin(phiMin);
+  auto low = std::lower_bound(gphi.begin()+phiBinStart[bmin], gphi.begin()+phiBinStart[bmin+1], phiMin);
+  auto bmax = phiBin(phiMax);
+  auto high = std::upper_bound(gphi.begin()+phiBinStart[bmax], gphi.begin()+phiBinStart[bmax+1], phiMax);
+  high = std::max(low,high);
+  return Range(theHits.begin()+(low-gphi.begin()), theHits.begin()+(high-gphi.begin()));
 }
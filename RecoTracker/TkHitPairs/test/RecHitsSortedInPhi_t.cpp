@@ -0,0 +1,165 @@
+// The phi binned search of RecHitsSortedInPhi::unsafeRange and doubleRange
+// must return the same ranges as the binary search over all the hits it
+// replaces.  The layers are random, empty, with all the hits in one bin, with
+// hits on the bin edges and at +-pi; the windows are random, narrow, wide,
+// start or end on a bin edge or on a hit, and wrap around +-pi.
+
+#include "RecoTracker/TkHitPairs/interface/RecHitsSortedInPhi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // only the phi of the hits, which is all the search looks at
+  class PhiLayer : public RecHitsSortedInPhi {
+  public:
+    explicit PhiLayer(std::vector<float> phis) {
+      std::sort(phis.begin(), phis.end());
+      for (auto phi : phis) theHits.emplace_back(phi);
+      gphi = phis;
+      initPhiBins();
+    }
+  };
+
+  // the search before the phi bins
+  std::pair<int,int> binarySearch(std::vector<float> const & gphi, float phiMin, float phiMax) {
+    auto low = std::lower_bound(gphi.begin(), gphi.end(), phiMin);
+    auto high = std::upper_bound(gphi.begin(), gphi.end(), phiMax);
+    high = std::max(low,high);
+    return std::make_pair(int(low-gphi.begin()), int(high-gphi.begin()));
+  }
+
+  RecHitsSortedInPhi::DoubleRange binaryDoubleRange(std::vector<float> const & gphi, float phiMin, float phiMax) {
+    std::pair<int,int> r1, r2;
+    if ( phiMin < phiMax) {
+      if ( phiMin < -Geom::fpi()) {
+        r1 = binarySearch(gphi, phiMin + Geom::ftwoPi(), Geom::fpi());
+        r2 = binarySearch(gphi, -Geom::fpi(), phiMax);
+      }
+      else if (phiMax > Geom::pi()) {
+        r1 = binarySearch(gphi, phiMin, Geom::fpi());
+        r2 = binarySearch(gphi, -Geom::fpi(), phiMax-Geom::ftwoPi());
+      }
+      else {
+        r1 = binarySearch(gphi, phiMin, phiMax);
+        r2 = std::make_pair(0,0);
+      }
+    }
+    else {
+      r1 = binarySearch(gphi, phiMin, Geom::fpi());
+      r2 = binarySearch(gphi, -Geom::fpi(), phiMax);
+    }
+    return RecHitsSortedInPhi::DoubleRange{{r1.first, r1.second, r2.first, r2.second}};
+  }
+
+  float binEdge(int b) {
+    return -Geom::fpi() + b*(Geom::ftwoPi()/RecHitsSortedInPhi::nPhiBins);
+  }
+
+  std::vector<std::pair<std::string, std::vector<float>>> makeLayers(std::mt19937 & rng) {
+    std::uniform_real_distribution<float> flat(-Geom::fpi(), Geom::fpi());
+    std::vector<std::pair<std::string, std::vector<float>>> layers;
+
+    for (unsigned int n : {1u, 10u, 100u, 1000u, 10000u}) {
+      std::vector<float> phis;
+      for (unsigned int i = 0; i < n; ++i) phis.push_back(flat(rng));
+      layers.emplace_back("random " + std::to_string(n), phis);
+    }
+
+    layers.emplace_back("empty", std::vector<float>());
+
+    std::vector<float> oneBin;
+    for (unsigned int i = 0; i < 200; ++i) oneBin.push_back(0.01f + 0.0001f*i);
+    layers.emplace_back("one bin", oneBin);
+
+    std::vector<float> edges;
+    for (int b = 0; b <= RecHitsSortedInPhi::nPhiBins; ++b) {
+      edges.push_back(binEdge(b));
+      edges.push_back(std::nextafter(binEdge(b), -10.f));
+      edges.push_back(std::nextafter(binEdge(b), 10.f));
+    }
+    layers.emplace_back("bin edges", edges);
+
+    std::vector<float> pi;
+    for (unsigned int i = 0; i < 50; ++i) {
+      pi.push_back(Geom::fpi());
+      pi.push_back(-Geom::fpi());
+      pi.push_back(flat(rng));
+    }
+    layers.emplace_back("+-pi", pi);
+
+    std::vector<float> same(100, 1.f);
+    layers.emplace_back("same phi", same);
+
+    return layers;
+  }
+
+  std::vector<std::pair<float,float>> makeWindows(std::mt19937 & rng, std::vector<float> const & gphi) {
+    std::uniform_real_distribution<float> flat(-Geom::fpi(), Geom::fpi());
+    std::uniform_real_distribution<float> width(0.f, 3.f);
+    std::vector<std::pair<float,float>> windows;
+    for (unsigned int i = 0; i < 2000; ++i) {
+      float phi = flat(rng);
+      float w = i % 2 ? width(rng) : 0.01f*width(rng);
+      windows.emplace_back(phi, phi + w);             // may end beyond pi
+      windows.emplace_back(phi - w, phi);             // may start before -pi
+      float wrapped = phi + w;
+      if (wrapped > Geom::fpi()) wrapped -= Geom::ftwoPi();
+      windows.emplace_back(phi, wrapped);             // may wrap, with phiMax < phiMin
+    }
+    for (int b = 0; b <= RecHitsSortedInPhi::nPhiBins; ++b) {
+      windows.emplace_back(binEdge(b), binEdge(b) + 0.02f);
+      windows.emplace_back(binEdge(b) - 0.02f, binEdge(b));
+    }
+    for (unsigned int i = 0; i < gphi.size(); i += 1 + gphi.size()/100) {
+      windows.emplace_back(gphi[i], gphi[i] + 0.1f);
+      windows.emplace_back(gphi[i] - 0.1f, gphi[i]);
+      windows.emplace_back(gphi[i], gphi[i]);
+    }
+    windows.emplace_back(Geom::fpi() - 0.1f, -Geom::fpi() + 0.1f);
+    windows.emplace_back(3.f, -3.f);
+    windows.emplace_back(-4.f, -3.f);
+    windows.emplace_back(3.1f, 3.2f);
+    return windows;
+  }
+
+}
+
+int main() {
+  std::mt19937 rng(2017);
+  int failures = 0;
+
+  for (auto const & layer : makeLayers(rng)) {
+    PhiLayer hits(layer.second);
+    unsigned int nUnsafe = 0, nDouble = 0;
+    auto windows = makeWindows(rng, hits.gphi);
+    for (auto const & window : windows) {
+      float phiMin = window.first, phiMax = window.second;
+
+      // unsafeRange is only defined for -pi <= phiMin < phiMax <= pi
+      if (-Geom::fpi() <= phiMin && phiMin < phiMax && phiMax <= Geom::fpi()) {
+        auto range = hits.unsafeRange(phiMin, phiMax);
+        auto expected = binarySearch(hits.gphi, phiMin, phiMax);
+        if (range.first - hits.theHits.begin() != expected.first || range.second - hits.theHits.begin() != expected.second)
+          ++nUnsafe;
+      }
+
+      if (hits.doubleRange(phiMin, phiMax) != binaryDoubleRange(hits.gphi, phiMin, phiMax))
+        ++nDouble;
+    }
+    if (nUnsafe || nDouble) {
+      std::cout << layer.first << ": " << nUnsafe << " unsafeRange and " << nDouble << " doubleRange of the "
+                << windows.size() << " windows differ from the binary search" << std::endl;
+      ++failures;
+    }
+  }
+
+  if (failures) return 1;
+  std::cout << "RecHitsSortedInPhi: the ranges are identical to the binary search ones" << std::endl;
+  return 0;
+}
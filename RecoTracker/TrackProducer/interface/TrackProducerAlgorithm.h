@@ -28,6 +28,7 @@ class TrackingGeometry;
 class Propagator;
 class Trajectory;
 class TrajectoryStateOnSurface;
+class CompactTrackerRecHitCollection;
 
 struct FitterCloner {
    std::unique_ptr<TrajectoryFitter> fitter;
@@ -84,6 +85,7 @@ public:
 			AlgoProductCollection &);
 
   /// Run the Final Fit taking Tracks as input (for Refitter)
+  /// the hits are built from the compact collection, if given and parallel to the hits of the track
   void runWithTrack(const TrackingGeometry *, 
 		    const MagneticField *, 
 		    const TrackView&,
@@ -91,7 +93,8 @@ public:
 		    const Propagator *,
 		    const TransientTrackingRecHitBuilder*,
 		    const reco::BeamSpot&,
-		    AlgoProductCollection &);
+		    AlgoProductCollection &,
+		    const CompactTrackerRecHitCollection * compactHits = nullptr);
 
   /// Run the Final Fit taking TrackMomConstraintAssociation as input (Refitter with momentum constraint)
   void runWithMomentum(const TrackingGeometry *, 
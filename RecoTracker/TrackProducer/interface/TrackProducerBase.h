@@ -48,7 +48,7 @@ public:
   /// Constructor
   TrackProducerBase(bool trajectoryInEvent = false):
      trajectoryInEvent_(trajectoryInEvent),
-        rekeyClusterRefs_(false) {}
+        rekeyClusterRefs_(false), compactHitsInEvent_(false) {}
 
   /// Destructor
   virtual ~TrackProducerBase() noexcept(false);
@@ -90,6 +90,9 @@ public:
     clusterRemovalInfo_ = clusterRemovalInfo;
   }
 
+  /// Also put the hits in the event as a CompactTrackerRecHitCollection
+  void setCompactHitsInEvent(bool compactHitsInEvent) { compactHitsInEvent_ = compactHitsInEvent; }
+
   void setSecondHitPattern(Trajectory* traj, T& track, 
 			   const Propagator* prop, const MeasurementTrackerEvent* measTk,
                            const TrackerTopology* ttopo);
@@ -108,6 +111,8 @@ public:
   bool rekeyClusterRefs_;
   edm::InputTag clusterRemovalInfo_;
 
+  bool compactHitsInEvent_;
+
   edm::ESHandle<NavigationSchool> theSchool;
 
 };
@@ -14,6 +14,7 @@
 
 #include "DataFormats/TrackerCommon/interface/TrackerTopology.h"
 #include "Geometry/Records/interface/TrackerTopologyRcd.h"
+#include "DataFormats/TrackerRecHit2D/interface/CompactTrackerRecHitCollection.h"
 
 TrackProducer::TrackProducer(const edm::ParameterSet& iConfig):
   KfTrackProducerBase(iConfig.getParameter<bool>("TrajectoryInEvent"),
@@ -31,10 +32,15 @@ TrackProducer::TrackProducer(const edm::ParameterSet& iConfig):
         if (!(tag == edm::InputTag())) { setClusterRemovalInfo( tag ); }
   }
 
+  if ( iConfig.exists("compactHitsInEvent") ) {
+        setCompactHitsInEvent( iConfig.getParameter<bool>("compactHitsInEvent") );
+  }
+
   //register your products
   produces<reco::TrackCollection>().setBranchAlias( alias_ + "Tracks" );
   produces<reco::TrackExtraCollection>().setBranchAlias( alias_ + "TrackExtras" );
   produces<TrackingRecHitCollection>().setBranchAlias( alias_ + "RecHits" );
+  if (compactHitsInEvent_) produces<CompactTrackerRecHitCollection>().setBranchAlias( alias_ + "CompactRecHits" );
   produces<std::vector<Trajectory> >() ;
   produces<std::vector<int> >() ;
   produces<TrajTrackAssociationCollection>();
@@ -16,7 +16,8 @@
 TrackRefitter::TrackRefitter(const edm::ParameterSet& iConfig):
   KfTrackProducerBase(iConfig.getParameter<bool>("TrajectoryInEvent"),
 		      iConfig.getParameter<bool>("useHitsSplitting")),
-  theAlgo(iConfig)
+  theAlgo(iConfig),
+  useCompactHits_(false)
 {
   setConf(iConfig);
   setSrc( consumes<edm::View<reco::Track>>(iConfig.getParameter<edm::InputTag>( "src" )), 
@@ -36,6 +37,12 @@ TrackRefitter::TrackRefitter(const edm::ParameterSet& iConfig):
     throw cms::Exception("TrackRefitter") << "unknown type of contraint! Set it to 'momentum', 'vertex', 'trackParameters' or leave it empty";    
   }
 
+  // hits from the compact collection put in the event by the producer of the tracks
+  if ( iConfig.exists("compactHits") ) {
+    edm::InputTag tag = iConfig.getParameter<edm::InputTag>("compactHits");
+    if (!(tag == edm::InputTag())) { useCompactHits_ = true; compactHits_ = consumes<CompactTrackerRecHitCollection>(tag); }
+  }
+
   //register your products
   produces<reco::TrackCollection>().setBranchAlias( alias_ + "Tracks" );
   produces<reco::TrackExtraCollection>().setBranchAlias( alias_ + "TrackExtras" );
@@ -94,10 +101,17 @@ void TrackRefitter::produce(edm::Event& theEvent, const edm::EventSetup& setup)
 	edm::LogError("TrackRefitter")<<"could not get the reco::TrackCollection." << labels.module; break;}
       LogDebug("TrackRefitter") << "run the algorithm" << "\n";
 
+      const CompactTrackerRecHitCollection * compactHits = nullptr;
+      if (useCompactHits_) {
+        edm::Handle<CompactTrackerRecHitCollection> hCompactHits;
+        theEvent.getByToken(compactHits_, hCompactHits);
+        if (hCompactHits.isValid()) compactHits = hCompactHits.product();
+      }
+
       try {
 	theAlgo.runWithTrack(theG.product(), theMF.product(), *theTCollection, 
 			     theFitter.product(), thePropagator.product(), 
-			     theBuilder.product(), bs, algoResults);
+			     theBuilder.product(), bs, algoResults, compactHits);
       }catch (cms::Exception &e){ edm::LogError("TrackProducer") << "cms::Exception caught during theAlgo.runWithTrack." << "\n" << e << "\n"; throw; }
       break;
     }
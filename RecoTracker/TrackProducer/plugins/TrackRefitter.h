@@ -10,6 +10,7 @@
 #include "FWCore/Framework/interface/stream/EDProducer.h"
 #include "RecoTracker/TrackProducer/interface/KfTrackProducerBase.h"
 #include "RecoTracker/TrackProducer/interface/TrackProducerAlgorithm.h"
+#include "DataFormats/TrackerRecHit2D/interface/CompactTrackerRecHitCollection.h"
 
 class TrackRefitter : public KfTrackProducerBase, public edm::stream::EDProducer<> {
 public:
@@ -25,6 +26,8 @@ private:
   enum Constraint { none, momentum, vertex, trackParameters };
   Constraint constraint_;
   edm::EDGetToken trkconstrcoll_;
+  edm::EDGetTokenT<CompactTrackerRecHitCollection> compactHits_;
+  bool useCompactHits_;
 
 };
 
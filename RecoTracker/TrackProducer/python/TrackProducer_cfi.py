@@ -10,6 +10,8 @@ TrackProducer = cms.EDProducer("TrackProducer",
     useHitsSplitting = cms.bool(False),
     alias = cms.untracked.string('ctfWithMaterialTracks'),
     TrajectoryInEvent = cms.bool(False),
+    # also put the hits in the flat CompactTrackerRecHitCollection, usable by the TrackRefitter
+    compactHitsInEvent = cms.bool(False),
     TTRHBuilder = cms.string('WithAngleAndTemplate'),
     AlgorithmName = cms.string('undefAlgorithm'),
     Propagator = cms.string('RungeKuttaTrackerPropagator'),
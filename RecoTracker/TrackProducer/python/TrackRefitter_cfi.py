@@ -23,6 +23,12 @@ TrackRefitter = cms.EDProducer("TrackRefitter",
 
     TrajectoryInEvent = cms.bool(True),
 
+    ### the CompactTrackerRecHitCollection put in the event with the tracks
+    ### (compactHitsInEvent of the TrackProducer, copyCompactHits of the
+    ### generalTracks kept in RECO): if set, the hits are
+    ### built from it instead of being read and cloned from the TrackingRecHitCollection
+    compactHits = cms.InputTag(''),
+
     # this parameter decides if the propagation to the beam line
     # for the track parameters defiition is from the first hit
     # or from the closest to the beam line
@@ -14,6 +14,7 @@
 #include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
 
 #include "DataFormats/TrackerRecHit2D/interface/ClusterRemovalRefSetter.h"
+#include "DataFormats/TrackerRecHit2D/interface/CompactTrackerRecHitCollection.h"
 #include "TrajectoryToResiduals.h"
 
 #include "RecoTracker/TransientTrackingRecHit/interface/Traj2TrackHits.h"
@@ -155,6 +156,14 @@ void KfTrackProducerBase::putInEvt(edm::Event& evt,
       }
   }
 
+  // the compact copy of the (rekeyed) hits, parallel to the TrackingRecHitCollection
+  if (compactHitsInEvent_ && BeforeOrAfter == 0) {
+    auto compactHits = std::make_unique<CompactTrackerRecHitCollection>(rHits.id());
+    compactHits->reserve(selHits->size());
+    for (auto const & hit : *selHits) compactHits->push_back(hit);
+    evt.put(std::move(compactHits));
+  }
+
   LogTrace("TrackingRegressionTest") << "========== TrackProducer Info ===================";
   LogTrace("TrackingRegressionTest") << "number of finalTracks: " << selTracks->size();
   for (reco::TrackCollection::const_iterator it = selTracks->begin(); it != selTracks->end(); it++) {
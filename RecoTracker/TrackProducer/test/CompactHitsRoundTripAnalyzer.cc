@@ -0,0 +1,133 @@
+// -*- C++ -*-
+//
+// Package:    TrackProducer
+// Class:      CompactHitsRoundTripAnalyzer
+//
+/**\class CompactHitsRoundTripAnalyzer CompactHitsRoundTripAnalyzer.cc RecoTracker/TrackProducer/test/CompactHitsRoundTripAnalyzer.cc
+
+ Description: checks that the hits read back from a CompactTrackerRecHitCollection
+              are the ones of the TrackingRecHitCollection it is parallel to
+
+ Implementation:
+     Meant to run on a file written by CompactHitsRoundTripProducer.
+     The collection must still point to the TrackingRecHitCollection read
+     from the file. hit(i) must give back the i-th hit. hitForFit(i,det) on
+     the det of the tracker geometry, which is what the TrackRefitter fits
+     with compactHits set, must be the same as cloneForFit(det) on the i-th
+     hit, which is what it fits otherwise.
+     Throws at the end of the job if any hit differs.
+*/
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/global/EDAnalyzer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "DataFormats/TrackingRecHit/interface/TrackingRecHitFwd.h"
+#include "DataFormats/TrackerRecHit2D/interface/CompactTrackerRecHitCollection.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiPixelRecHit.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiStripMatchedRecHit2D.h"
+#include "DataFormats/TrackerRecHit2D/interface/ProjectedSiStripRecHit2D.h"
+
+#include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+
+#include <atomic>
+#include <typeinfo>
+#include <vector>
+
+namespace {
+  // the clusters of the hit, mono first
+  std::vector<OmniClusterRef> clusters(TrackingRecHit const & hit) {
+    if (typeid(hit)==typeid(SiStripMatchedRecHit2D)) {
+      auto const & h = static_cast<SiStripMatchedRecHit2D const &>(hit);
+      return {h.monoClusterRef(), h.stereoClusterRef()};
+    }
+    if (!hit.isValid()) return {};
+    return {static_cast<TrackerSingleRecHit const &>(hit).omniClusterRef()};
+  }
+
+  bool sameHit(TrackingRecHit const & a, TrackingRecHit const & b) {
+    if (typeid(a)!=typeid(b) || a.geographicalId()!=b.geographicalId() || a.getType()!=b.getType()) return false;
+    if (a.det()!=b.det() || trackerHitRTTI::rtti(a)!=trackerHitRTTI::rtti(b)) return false;
+    auto ca = clusters(a);
+    if (ca!=clusters(b)) return false;
+    // the clusters must be readable from the file
+    for (auto const & c : ca)
+      if (!c.isValid() || !(c.isPixel() ? c.cluster_pixel().isAvailable() : c.cluster_strip().isAvailable())) return false;
+    if (typeid(a)==typeid(SiPixelRecHit) &&
+        static_cast<SiPixelRecHit const &>(a).rawQualityWord()!=static_cast<SiPixelRecHit const &>(b).rawQualityWord())
+      return false;
+    if (typeid(a)==typeid(ProjectedSiStripRecHit2D) &&
+        static_cast<ProjectedSiStripRecHit2D const &>(a).originalDet()!=static_cast<ProjectedSiStripRecHit2D const &>(b).originalDet())
+      return false;
+    return true;
+  }
+}
+
+class CompactHitsRoundTripAnalyzer : public edm::global::EDAnalyzer<> {
+public:
+  explicit CompactHitsRoundTripAnalyzer(const edm::ParameterSet&);
+
+private:
+  void analyze(edm::StreamID, const edm::Event&, const edm::EventSetup&) const override;
+  void endJob() override;
+
+  edm::EDGetTokenT<TrackingRecHitCollection> hitsToken_;
+  edm::EDGetTokenT<CompactTrackerRecHitCollection> compactHitsToken_;
+  mutable std::atomic<unsigned int> nHits_;
+  mutable std::atomic<unsigned int> nDifferent_;
+};
+
+CompactHitsRoundTripAnalyzer::CompactHitsRoundTripAnalyzer(const edm::ParameterSet& iConfig) :
+  hitsToken_(consumes<TrackingRecHitCollection>(iConfig.getParameter<edm::InputTag>("src"))),
+  compactHitsToken_(consumes<CompactTrackerRecHitCollection>(iConfig.getParameter<edm::InputTag>("src"))),
+  nHits_(0),
+  nDifferent_(0)
+{}
+
+void CompactHitsRoundTripAnalyzer::analyze(edm::StreamID, const edm::Event& iEvent, const edm::EventSetup& iSetup) const {
+  edm::ESHandle<TrackerGeometry> geometry;
+  iSetup.get<TrackerDigiGeometryRecord>().get(geometry);
+
+  edm::Handle<TrackingRecHitCollection> hHits;
+  iEvent.getByToken(hitsToken_, hHits);
+  auto const & hits = *hHits;
+  auto const & compactHits = edm::get(iEvent, compactHitsToken_);
+
+  if (compactHits.hitsProductId()!=hHits.id() || compactHits.size()!=hits.size() ||
+      !compactHits.isSupported(0, compactHits.size())) {
+    edm::LogError("CompactHitsRoundTripAnalyzer") << "event " << iEvent.id() << ": the " << compactHits.size()
+                                                  << " compact hits are not parallel to the " << hits.size() << " hits read";
+    ++nDifferent_;
+    return;
+  }
+  for (unsigned int i=0; i<hits.size(); ++i) {
+    ++nHits_;
+    auto const & det = *geometry->idToDet(hits[i].geographicalId());
+    auto cloned = hits[i].cloneForFit(det);
+    if (!sameHit(*compactHits.hit(i), hits[i]) || !sameHit(*compactHits.hitForFit(i, det), *cloned)) {
+      edm::LogError("CompactHitsRoundTripAnalyzer") << "event " << iEvent.id() << ": hit " << i << " of type "
+                                                    << typeid(hits[i]).name() << " on " << hits[i].geographicalId().rawId() << " differs";
+      ++nDifferent_;
+    }
+  }
+}
+
+void CompactHitsRoundTripAnalyzer::endJob() {
+  if (nHits_==0)
+    throw cms::Exception("CompactHitsRoundTripAnalyzer") << "no hit was read, the comparison is not meaningful";
+  if (nDifferent_!=0)
+    throw cms::Exception("CompactHitsRoundTripAnalyzer") << nDifferent_ << " of the " << nHits_
+                                                         << " hits (or events) differ";
+  edm::LogSystem("CompactHitsRoundTripAnalyzer") << "the " << nHits_ << " hits read back are identical";
+}
+
+DEFINE_FWK_MODULE(CompactHitsRoundTripAnalyzer);
@@ -0,0 +1,157 @@
+// -*- C++ -*-
+//
+// Package:    TrackProducer
+// Class:      CompactHitsRoundTripProducer
+//
+/**\class CompactHitsRoundTripProducer CompactHitsRoundTripProducer.cc RecoTracker/TrackProducer/test/CompactHitsRoundTripProducer.cc
+
+ Description: puts in the event tracker hits of every kind, in a TrackingRecHitCollection
+              and in the parallel CompactTrackerRecHitCollection
+
+ Implementation:
+     Needs only the ideal tracker geometry: the clusters are made up on a few
+     pixel, strip and glued dets (changing with the event), and the hits are
+     made of them as read back from file, that is without position.
+     The output is read back by CompactHitsRoundTripAnalyzer.
+*/
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "DataFormats/Common/interface/DetSetVectorNew.h"
+#include "DataFormats/SiPixelCluster/interface/SiPixelCluster.h"
+#include "DataFormats/SiStripCluster/interface/SiStripCluster.h"
+#include "DataFormats/SiStripDetId/interface/SiStripDetId.h"
+#include "DataFormats/TrackingRecHit/interface/TrackingRecHitFwd.h"
+#include "DataFormats/TrackingRecHit/interface/InvalidTrackingRecHit.h"
+#include "DataFormats/TrackerRecHit2D/interface/CompactTrackerRecHitCollection.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiPixelRecHit.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiStripRecHit2D.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiStripRecHit1D.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiStripMatchedRecHit2D.h"
+#include "DataFormats/TrackerRecHit2D/interface/ProjectedSiStripRecHit2D.h"
+
+#include "Geometry/CommonDetUnit/interface/GluedGeomDet.h"
+#include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+class CompactHitsRoundTripProducer : public edm::global::EDProducer<> {
+public:
+  explicit CompactHitsRoundTripProducer(const edm::ParameterSet&);
+
+private:
+  void produce(edm::StreamID, edm::Event&, const edm::EventSetup&) const override;
+
+  const unsigned int nDets_;
+};
+
+CompactHitsRoundTripProducer::CompactHitsRoundTripProducer(const edm::ParameterSet& iConfig) :
+  nDets_(iConfig.getParameter<unsigned int>("nDets"))
+{
+  produces<edmNew::DetSetVector<SiPixelCluster> >();
+  produces<edmNew::DetSetVector<SiStripCluster> >();
+  produces<TrackingRecHitCollection>();
+  produces<CompactTrackerRecHitCollection>();
+}
+
+void CompactHitsRoundTripProducer::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const {
+  edm::ESHandle<TrackerGeometry> geometry;
+  iSetup.get<TrackerDigiGeometryRecord>().get(geometry);
+
+  // a few dets of each kind (the strip ones not part of a glued det), not the same ones in every event
+  const unsigned int skip = iEvent.id().event();
+  std::vector<GeomDet const *> pixelDets, stripDets, gluedDets;
+  unsigned int nPixel = 0, nStrip = 0, nGlued = 0;
+  for (auto det : geometry->dets()) {
+    if (GeomDetEnumerators::isTrackerPixel(det->subDetector())) {
+      if (nPixel++ % (skip+1) == 0 && pixelDets.size()<nDets_) pixelDets.push_back(det);
+    } else if (dynamic_cast<GluedGeomDet const *>(det)) {
+      if (nGlued++ % (skip+1) == 0 && gluedDets.size()<nDets_) gluedDets.push_back(det);
+    } else if (SiStripDetId(det->geographicalId()).glued()==0) {
+      if (nStrip++ % (skip+1) == 0 && stripDets.size()<nDets_) stripDets.push_back(det);
+    }
+  }
+  // the DetSetVectors are sorted by detId
+  auto byId = [](GeomDet const * a, GeomDet const * b) { return a->geographicalId() < b->geographicalId(); };
+  std::sort(pixelDets.begin(), pixelDets.end(), byId);
+  std::vector<DetId> stripIds;
+  for (auto det : stripDets) stripIds.push_back(det->geographicalId());
+  for (auto det : gluedDets) {
+    auto glued = static_cast<GluedGeomDet const *>(det);
+    stripIds.push_back(glued->monoDet()->geographicalId());
+    stripIds.push_back(glued->stereoDet()->geographicalId());
+  }
+  std::sort(stripIds.begin(), stripIds.end());
+
+  // two clusters on each det
+  auto pixels = std::make_unique<edmNew::DetSetVector<SiPixelCluster> >();
+  for (auto det : pixelDets) {
+    edmNew::DetSetVector<SiPixelCluster>::FastFiller ff(*pixels, det->geographicalId());
+    ff.push_back(SiPixelCluster(SiPixelCluster::PixelPos(10+skip, 20), 5000));
+    ff.push_back(SiPixelCluster(SiPixelCluster::PixelPos(30, 40+skip), 7000));
+  }
+  auto strips = std::make_unique<edmNew::DetSetVector<SiStripCluster> >();
+  for (auto id : stripIds) {
+    edmNew::DetSetVector<SiStripCluster>::FastFiller ff(*strips, id);
+    const std::vector<uint8_t> amplitudes = {10, 80, uint8_t(40+skip)};
+    ff.push_back(SiStripCluster(100+skip, amplitudes.begin(), amplitudes.end(), false));
+    ff.push_back(SiStripCluster(200, amplitudes.begin(), amplitudes.end(), true));
+  }
+  auto hPixels = iEvent.put(std::move(pixels));
+  auto hStrips = iEvent.put(std::move(strips));
+
+  auto clusters = [](auto const & handle, DetId id) {
+    auto detSet = (*handle)[id];
+    return std::make_pair(OmniClusterRef(edmNew::makeRefTo(handle, detSet.begin())),
+                          OmniClusterRef(edmNew::makeRefTo(handle, detSet.begin()+1)));
+  };
+
+  // the hits, as read from a TrackingRecHitCollection
+  auto hits = std::make_unique<TrackingRecHitCollection>();
+  for (auto det : pixelDets) {
+    auto id = det->geographicalId();
+    auto c = clusters(hPixels, id);
+    hits->push_back(new SiPixelRecHit(id, c.first, 0x12345678+skip));
+    hits->push_back(new SiPixelRecHit(id, c.second, 0));
+    hits->push_back(new InvalidTrackingRecHit(id, TrackingRecHit::missing));
+  }
+  for (auto det : stripDets) {
+    auto id = det->geographicalId();
+    auto c = clusters(hStrips, id);
+    hits->push_back(new SiStripRecHit2D(id, c.first));
+    hits->push_back(new SiStripRecHit1D(id, c.second));
+    hits->push_back(new InvalidTrackingRecHit(id, TrackingRecHit::inactive));
+  }
+  for (auto det : gluedDets) {
+    auto id = det->geographicalId();
+    auto glued = static_cast<GluedGeomDet const *>(det);
+    auto mono = clusters(hStrips, glued->monoDet()->geographicalId());
+    auto stereo = clusters(hStrips, glued->stereoDet()->geographicalId());
+    hits->push_back(new SiStripMatchedRecHit2D(id, mono.first, stereo.first));
+    hits->push_back(new ProjectedSiStripRecHit2D(id, true, mono.second));
+    hits->push_back(new ProjectedSiStripRecHit2D(id, false, stereo.second));
+    hits->push_back(new SiStripRecHit2D(glued->stereoDet()->geographicalId(), stereo.second));
+    hits->push_back(new InvalidTrackingRecHit(id, TrackingRecHit::bad));
+  }
+
+  // filled as the TrackProducer and the TrackCollectionCloner do
+  auto compactHits = std::make_unique<CompactTrackerRecHitCollection>(iEvent.getRefBeforePut<TrackingRecHitCollection>().id());
+  compactHits->reserve(hits->size());
+  for (auto const & hit : *hits) compactHits->push_back(hit);
+
+  iEvent.put(std::move(hits));
+  iEvent.put(std::move(compactHits));
+}
+
+DEFINE_FWK_MODULE(CompactHitsRoundTripProducer);
@@ -0,0 +1,42 @@
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# Writes tracker hits of every kind with their CompactTrackerRecHitCollection
+# (write), or reads them back and checks that the hits built from the compact
+# collection are the ones of the TrackingRecHitCollection (read).
+# Only the ideal tracker geometry is needed, no conditions.
+options = VarParsing.VarParsing()
+options.register('step', 'write', VarParsing.VarParsing.multiplicity.singleton, VarParsing.VarParsing.varType.string,
+                 "write or read")
+options.parseArguments()
+
+process = cms.Process("CompactHits" + options.step.capitalize())
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.load("Geometry.TrackerRecoData.trackerRecoGeometryXML_cfi")
+process.load("Geometry.TrackerNumberingBuilder.trackerNumberingGeometry_cfi")
+process.load("Geometry.TrackerNumberingBuilder.trackerTopology_cfi")
+process.load("Geometry.TrackerGeometryBuilder.trackerGeometry_cfi")
+process.load("Geometry.TrackerGeometryBuilder.trackerParameters_cfi")
+process.trackerGeometry.applyAlignment = cms.bool(False)
+
+if options.step == 'write':
+    process.source = cms.Source("EmptySource")
+    process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(3))
+    process.compactHits = cms.EDProducer("CompactHitsRoundTripProducer",
+        nDets = cms.uint32(20)
+    )
+    process.out = cms.OutputModule("PoolOutputModule",
+        fileName = cms.untracked.string("compactHitsRoundTrip.root"),
+        outputCommands = cms.untracked.vstring("drop *", "keep *_compactHits_*_*")
+    )
+    process.p = cms.Path(process.compactHits)
+    process.e = cms.EndPath(process.out)
+else:
+    process.source = cms.Source("PoolSource",
+        fileNames = cms.untracked.vstring("file:compactHitsRoundTrip.root")
+    )
+    process.compactHitsRoundTrip = cms.EDAnalyzer("CompactHitsRoundTripAnalyzer",
+        src = cms.InputTag("compactHits")
+    )
+    process.p = cms.Path(process.compactHitsRoundTrip)
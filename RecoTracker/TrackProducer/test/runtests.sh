@@ -0,0 +1,10 @@
+#!/bin/bash
+
+function die { echo $1: status $2 ;  exit $2; }
+
+# the hits built from the CompactTrackerRecHitCollection read back from file must be
+# the ones of the TrackingRecHitCollection, also as given to the fit (hitForFit vs cloneForFit)
+cmsRun ${LOCAL_TEST_DIR}/compactHitsRoundTrip_cfg.py step=write || die 'Failure writing the compact hits' $?
+cmsRun ${LOCAL_TEST_DIR}/compactHitsRoundTrip_cfg.py step=read || die 'Failure reading back the compact hits' $?
+
+rm -f compactHitsRoundTrip.root
@@ -36,6 +36,17 @@ public:
       
       pi.push_back( new_pi ); // track weight
       Z_sum.push_back( 1.0 ); // Z[i]   for DA clustering, initial value as done in ::fill
+      kmin.push_back( 0 );
+      kmax.push_back( 0 );
+    }
+
+    // the tracks [first,last) as a new set of tracks
+    track_t region( unsigned int first, unsigned int last ) const
+    {
+      track_t r;
+      for ( unsigned int i = first; i < last; ++i ) r.addItem( z[i], t[i], dz2[i], dt2[i], tt[i], pi[i] );
+      r.extractRaw();
+      return r;
     }
     
     unsigned int getSize() const
@@ -52,6 +63,8 @@ public:
       dt2_ = &dt2.front();
       Z_sum_ = &Z_sum.front();
       pi_ = &pi.front();
+      kmin_ = &kmin.front();
+      kmax_ = &kmax.front();
     }
     
     double * z_; // z-coordinate at point of closest approach to the beamline
@@ -61,6 +74,8 @@ public:
     double * dz2_; // square of the error of z(pca)
     double * dt2_; // square of the error of t(pca)
     double * Z_sum_; // Z[i]   for DA clustering
+    unsigned int * kmin_; // first vertex the track is compatible with
+    unsigned int * kmax_; // one past the last vertex the track is compatible with
     
     std::vector<double> z; // z-coordinate at point of closest approach to the beamline
     std::vector<double> t; // t-coordinate at point of closest approach to the beamline
@@ -69,6 +84,8 @@ public:
     std::vector<double> Z_sum; // Z[i]   for DA clustering
     std::vector<double> pi; // track weight
     std::vector< const reco::TransientTrack* > tt; // a pointer to the Transient Track
+    std::vector<unsigned int> kmin; // vertex range of the track, when banded
+    std::vector<unsigned int> kmax;
   };
   
   struct vertex_t {
@@ -223,6 +240,10 @@ public:
   std::vector<TransientVertex>
   vertices(const std::vector<reco::TransientTrack> & tracks,
 	   const int verbosity = 0) const ;
+
+  // the annealing of one set of tracks
+  std::vector<TransientVertex>
+  vertices(track_t & tks, const int verbosity = 0) const ;
   
   track_t	fill(const std::vector<reco::TransientTrack> & tracks) const;
   
@@ -242,6 +263,8 @@ public:
   double beta0(const double betamax, track_t const & tks, vertex_t const & y) const;
     
   double get_Tc(const vertex_t & y, int k) const;
+
+  void set_vtx_range(double beta, track_t & gtracks, vertex_t & gvertices) const;
   
 private:
   bool verbose_;
@@ -265,6 +288,13 @@ private:
   double tmerge_;
   double betapurge_;
 
+  // tracks separated by more than zgap_ are annealed independently (and concurrently), if >0
+  double zgap_;
+  unsigned int minRegionTracks_;
+  // tracks only see the vertices within zrange_ standard deviations in z (at the current temperature), if >0
+  double zrange_;
+  double zrangeMin_;
+
 };
 
 
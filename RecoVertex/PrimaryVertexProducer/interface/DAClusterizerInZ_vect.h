@@ -32,6 +32,17 @@ public:
       
       pi.push_back( new_pi ); // track weight
       Z_sum.push_back( 1.0); // Z[i]   for DA clustering, initial value as done in ::fill
+      kmin.push_back( 0 );
+      kmax.push_back( 0 );
+    }
+
+    // the tracks [first,last) as a new set of tracks
+    track_t Region( unsigned int first, unsigned int last ) const
+    {
+      track_t r;
+      for ( unsigned int i = first; i < last; ++i ) r.AddItem( z[i], dz2[i], tt[i], pi[i] );
+      r.ExtractRaw();
+      return r;
     }
 
     
@@ -49,6 +60,8 @@ public:
       _dz2 = &dz2.front();
       _Z_sum = &Z_sum.front();
       _pi = &pi.front();
+      _kmin = &kmin.front();
+      _kmax = &kmax.front();
     }
     
     double * __restrict__ _z; // z-coordinate at point of closest approach to the beamline
@@ -56,6 +69,8 @@ public:
     
     double * __restrict__  _Z_sum; // Z[i]   for DA clustering
     double * __restrict__  _pi; // track weight
+    unsigned int * __restrict__ _kmin; // first vertex the track is compatible with
+    unsigned int * __restrict__ _kmax; // one past the last vertex the track is compatible with
     
     std::vector<double> z; // z-coordinate at point of closest approach to the beamline
     std::vector<double> dz2; // square of the error of z(pca)
@@ -63,6 +78,8 @@ public:
     
     std::vector<double> Z_sum; // Z[i]   for DA clustering
     std::vector<double> pi; // track weight
+    std::vector<unsigned int> kmin; // vertex range of the track, when banded
+    std::vector<unsigned int> kmax;
   };
   
   struct vertex_t {
@@ -175,6 +192,10 @@ public:
   std::vector<TransientVertex>
   vertices(const std::vector<reco::TransientTrack> & tracks,
 	   const int verbosity = 0) const ;
+
+  // the annealing of one set of tracks
+  std::vector<TransientVertex>
+  vertices(track_t & tks, const int verbosity = 0) const ;
   
   track_t	fill(const std::vector<reco::TransientTrack> & tracks) const;
   
@@ -190,6 +211,8 @@ public:
   bool split(const double beta,  track_t &t, vertex_t & y, double threshold = 1. ) const;
   
   double beta0(const double betamax, track_t const & tks, vertex_t const & y) const;
+
+  void set_vtx_range(double beta, track_t & gtracks, vertex_t & gvertices) const;
     
   
 private:
@@ -211,6 +234,13 @@ private:
   double zmerge_;
   double betapurge_;
 
+  // tracks separated by more than zgap_ are annealed independently (and concurrently), if >0
+  double zgap_;
+  unsigned int minRegionTracks_;
+  // tracks only see the vertices within zrange_ standard deviations (at the current temperature), if >0
+  double zrange_;
+  double zrangeMin_;
+
 };
 
 
@@ -0,0 +1,102 @@
+#ifndef DAClusterizerRegions_h
+#define DAClusterizerRegions_h
+
+/**\namespace DAClusterizerRegions
+
+ Description: helpers shared by DAClusterizerInZ_vect and DAClusterizerInZT_vect
+
+   - findRegions: splits z-sorted tracks into independent regions at gaps in z
+   - annealRegions: runs the annealing of each region, concurrently if asked,
+     and returns the vertices of all regions in z order
+   - vertexRange: the range of z-ordered vertices a track is compatible with
+     at a given temperature (banded track-vertex assignment)
+
+ */
+
+#include "RecoVertex/VertexPrimitives/interface/TransientVertex.h"
+
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace DAClusterizerRegions {
+
+  // [first,last) in the z-sorted tracks
+  typedef std::pair<unsigned int, unsigned int> Region;
+
+  // a new region starts at a gap larger than zgap, provided that the regions
+  // on both sides have at least minTracks tracks
+  inline std::vector<Region> findRegions(double const * z, unsigned int nt, double zgap, unsigned int minTracks) {
+    std::vector<Region> regions;
+    unsigned int first = 0;
+    for (unsigned int i = 1; i < nt; ++i) {
+      if ((z[i] - z[i-1] > zgap) && (i - first >= minTracks) && (nt - i >= minTracks)) {
+	regions.emplace_back(first, i);
+	first = i;
+      }
+    }
+    if (nt > first) regions.emplace_back(first, nt);
+    return regions;
+  }
+
+  // anneal(region) returns the vertices of a region, ordered in z
+  template<typename F>
+  std::vector<TransientVertex> annealRegions(std::vector<Region> const & regions, F const & anneal, bool concurrent) {
+    std::vector<std::vector<TransientVertex> > vertices(regions.size());
+    if (concurrent) {
+      // isolated so that, while waiting for the regions, this thread does not pick up
+      // unrelated tasks (e.g. another event of the same module) that could stall it
+      tbb::this_task_arena::isolate([&] {
+	tbb::parallel_for(std::size_t(0), regions.size(), [&](std::size_t r) { vertices[r] = anneal(regions[r]); });
+      });
+    } else {
+      for (std::size_t r = 0; r < regions.size(); ++r) vertices[r] = anneal(regions[r]);
+    }
+
+    std::vector<TransientVertex> all;
+    for (auto & v : vertices) std::move(v.begin(), v.end(), std::back_inserter(all));
+    return all;
+  }
+
+  // for each track the range [kmin,kmax) of the vertices closer than
+  // max(zrange/sqrt(beta*dz2), zrangeMin) in z; the vertices must be ordered in z,
+  // otherwise all the tracks get the full range
+  inline void vertexRange(double beta, double zrange, double zrangeMin,
+			  unsigned int nt, double const * tz, double const * tdz2,
+			  unsigned int nv, double const * vz,
+			  unsigned int * kmin, unsigned int * kmax) {
+    if (nv == 0 || !std::is_sorted(vz, vz + nv)) {
+      std::fill(kmin, kmin + nt, 0);
+      std::fill(kmax, kmax + nt, nv);
+      return;
+    }
+    // tracks ordered in z make the walk short
+    unsigned int k0 = 0, k1 = 0;
+    for (unsigned int i = 0; i < nt; ++i) {
+      double dz = std::max(zrange / std::sqrt(beta * tdz2[i]), zrangeMin);
+      double zmin = tz[i] - dz, zmax = tz[i] + dz;
+      // first vertex above zmin
+      while (k0 > 0 && vz[k0-1] >= zmin) --k0;
+      while (k0 < nv && vz[k0] < zmin) ++k0;
+      // first vertex above zmax
+      while (k1 > 0 && vz[k1-1] > zmax) --k1;
+      while (k1 < nv && vz[k1] <= zmax) ++k1;
+      if (k0 < k1) {
+	kmin[i] = k0;
+	kmax[i] = k1;
+      } else {
+	// no vertex in the window, keep the nearest one(s)
+	kmin[i] = (k1 > 0) ? k1 - 1 : 0;
+	kmax[i] = std::min(k0 + 1, nv);
+      }
+    }
+  }
+
+}
+
+#endif
@@ -28,7 +28,9 @@ pixelVertices = cms.EDProducer("PrimaryVertexProducer",
             coolingFactor = cms.double(0.6),
             vertexSize = cms.double(0.01),
             zmerge = cms.double(0.01),
-            uniquetrkweight = cms.double(0.9)
+            uniquetrkweight = cms.double(0.9),
+            zgap = cms.double(0.),
+            zrange = cms.double(0.)
         )
     ),
 
@@ -1,4 +1,5 @@
 #include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerInZT_vect.h"
+#include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerRegions.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "DataFormats/GeometryCommonDetAlgo/interface/Measurement1D.h"
 #include "RecoVertex/VertexPrimitives/interface/VertexException.h"
@@ -7,6 +8,7 @@
 #include <cassert>
 #include <limits>
 #include <iomanip>
+#include <numeric>
 #include "FWCore/Utilities/interface/isFinite.h"
 #include "vdt/vdtMath.h"
 
@@ -18,6 +20,8 @@ DAClusterizerInZT_vect::DAClusterizerInZT_vect(const edm::ParameterSet& conf) {
   // hardcoded parameters
   maxIterations_ = 100;
   mintrkweight_ = 0.5; // conf.getParameter<double>("mintrkweight");
+  minRegionTracks_ = 10; // smaller regions are annealed with their neighbours
+  zrangeMin_ = 0.1; // smallest z window of a track when banded
 
 
   // configurable debug outptut debug output
@@ -43,6 +47,8 @@ DAClusterizerInZT_vect::DAClusterizerInZT_vect(const edm::ParameterSet& conf) {
   uniquetrkweight_ = conf.getParameter<double>("uniquetrkweight");
   zmerge_ = conf.getParameter<double>("zmerge");
   tmerge_ = conf.getParameter<double>("tmerge");
+  zgap_ = conf.getParameter<double>("zgap");
+  zrange_ = conf.getParameter<double>("zrange");
 
 #ifdef VI_DEBUG
   if(verbose_){
@@ -59,6 +65,8 @@ DAClusterizerInZT_vect::DAClusterizerInZT_vect(const edm::ParameterSet& conf) {
     std::cout << "DAClusterizerinZT_vect: d0CutOff = " << d0CutOff_ << std::endl;
     std::cout << "DAClusterizerinZT_vect: dzCutOff = " << dzCutOff_ << std::endl;
     std::cout << "DAClusterizerinZT_vect: dtCutoff = " << dtCutOff_ << std::endl;
+    std::cout << "DAClusterizerinZT_vect: zgap = " << zgap_ << std::endl;
+    std::cout << "DAClusterizerinZT_vect: zrange = " << zrange_ << std::endl;
   }
 #endif
 
@@ -144,6 +152,17 @@ DAClusterizerInZT_vect::fill(const vector<reco::TransientTrack> & tracks) const
     tks.addItem(t_z, t_t, t_dz2, t_dt2, &tk, t_pi);
   }
   tks.extractRaw();
+
+  // regions and vertex ranges need the tracks ordered in z
+  if ( (zgap_ > 0 || zrange_ > 0) && !std::is_sorted(tks.z.begin(), tks.z.end()) ) {
+    std::vector<unsigned int> order(tks.getSize());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&tks](unsigned int a, unsigned int b){ return tks.z[a] < tks.z[b]; });
+    track_t sorted;
+    for (auto i : order) sorted.addItem(tks.z[i], tks.t[i], tks.dz2[i], tks.dt2[i], tks.tt[i], tks.pi[i]);
+    tks = std::move(sorted);
+    tks.extractRaw();
+  }
   
 #ifdef VI_DEBUG
   if (verbose_) {
@@ -162,6 +181,14 @@ namespace {
   }
 }
 
+void DAClusterizerInZT_vect::set_vtx_range(double beta, track_t & gtracks, vertex_t & gvertices) const {
+  // the range is found in z only: the time term can only make a vertex less compatible
+  DAClusterizerRegions::vertexRange(beta, zrange_, zrangeMin_,
+				    gtracks.getSize(), gtracks.z_, gtracks.dz2_,
+				    gvertices.getSize(), gvertices.z_,
+				    gtracks.kmin_, gtracks.kmax_);
+}
+
 double DAClusterizerInZT_vect::update(double beta, track_t & gtracks,
 				     vertex_t & gvertices, bool useRho0, const double & rho0) const {
 
@@ -187,10 +214,15 @@ double DAClusterizerInZT_vect::update(double beta, track_t & gtracks,
       Z_init = rho0 * local_exp(-beta * dzCutOff_ * dzCutOff_); // cut-off
     }
   
+  // only the vertices in [kmin,kmax) are considered for each track
+  const bool banded = zrange_ > 0;
+  if (banded) set_vtx_range(beta, gtracks, gvertices);
+
   // define kernels
-  auto kernel_calc_exp_arg = [ beta, nv ] ( const unsigned int itrack,
-					     track_t const& tracks,
-					     vertex_t const& vertices ) {
+  auto kernel_calc_exp_arg = [ beta ] ( const unsigned int itrack,
+					 track_t const& tracks,
+					 vertex_t const& vertices,
+					 const unsigned int kmin, const unsigned int kmax ) {
     
     const auto track_z = tracks.z_[itrack];
     const auto track_t = tracks.t_[itrack];
@@ -198,25 +230,26 @@ double DAClusterizerInZT_vect::update(double beta, track_t & gtracks,
     const auto botrack_dt2 = -beta*tracks.dt2_[itrack];
 
     // auto-vectorized
-    for ( unsigned int ivertex = 0; ivertex < nv; ++ivertex) {
+    for ( unsigned int ivertex = kmin; ivertex < kmax; ++ivertex) {
       const auto mult_resz = track_z - vertices.z_[ivertex];
       const auto mult_rest = track_t - vertices.t_[ivertex];
       vertices.ei_cache_[ivertex] = botrack_dz2 * ( mult_resz * mult_resz ) + botrack_dt2 * ( mult_rest * mult_rest );
     }
   };
   
-  auto kernel_add_Z = [ nv, Z_init ] (vertex_t const& vertices) -> double
+  auto kernel_add_Z = [ Z_init ] (vertex_t const& vertices, const unsigned int kmin, const unsigned int kmax) -> double
     {
       double ZTemp = Z_init;
-      for (unsigned int ivertex = 0; ivertex < nv; ++ivertex) {	
+      for (unsigned int ivertex = kmin; ivertex < kmax; ++ivertex) {	
 	ZTemp += vertices.pk_[ivertex] * vertices.ei_[ivertex];
       }
       return ZTemp;
     };
 
-  auto kernel_calc_normalization = [ beta, nv ] (const unsigned int track_num,
-						  track_t & tks_vec,
-						  vertex_t & y_vec ) {
+  auto kernel_calc_normalization = [ beta ] (const unsigned int track_num,
+					      track_t & tks_vec,
+					      vertex_t & y_vec,
+					      const unsigned int kmin, const unsigned int kmax ) {
     auto tmp_trk_pi = tks_vec.pi_[track_num];
     auto o_trk_Z_sum = 1./tks_vec.Z_sum_[track_num];
     auto o_trk_err_z = tks_vec.dz2_[track_num];
@@ -226,7 +259,7 @@ double DAClusterizerInZT_vect::update(double beta, track_t & gtracks,
 
 
     // auto-vectorized
-    for (unsigned int k = 0; k < nv; ++k) {
+    for (unsigned int k = kmin; k < kmax; ++k) {
       // parens are important for numerical stability
       y_vec.se_[k] +=  tmp_trk_pi*( y_vec.ei_[k] * o_trk_Z_sum );      
       const auto w = tmp_trk_pi * (y_vec.pk_[k] * y_vec.ei_[k] * o_trk_Z_sum);  // p_{ik}
@@ -260,16 +293,18 @@ double DAClusterizerInZT_vect::update(double beta, track_t & gtracks,
    
   // loop over tracks
   for (auto itrack = 0U; itrack < nt; ++itrack) {
-    kernel_calc_exp_arg(itrack, gtracks, gvertices);
-    local_exp_list(gvertices.ei_cache_, gvertices.ei_, nv);
+    const unsigned int kmin = banded ? gtracks.kmin_[itrack] : 0;
+    const unsigned int kmax = banded ? gtracks.kmax_[itrack] : nv;
+    kernel_calc_exp_arg(itrack, gtracks, gvertices, kmin, kmax);
+    local_exp_list(gvertices.ei_cache_ + kmin, gvertices.ei_ + kmin, kmax - kmin);
         
-    gtracks.Z_sum_[itrack] = kernel_add_Z(gvertices);
+    gtracks.Z_sum_[itrack] = kernel_add_Z(gvertices, kmin, kmax);
     if (edm::isNotFinite(gtracks.Z_sum_[itrack])) gtracks.Z_sum_[itrack] = 0.0;
     // used in the next major loop to follow
     sumpi += gtracks.pi_[itrack];
     
     if (gtracks.Z_sum_[itrack] > 1.e-100){
-      kernel_calc_normalization(itrack, gtracks, gvertices);
+      kernel_calc_normalization(itrack, gtracks, gvertices, kmin, kmax);
     }
   }
   
@@ -815,7 +850,26 @@ vector<TransientVertex>
 DAClusterizerInZT_vect::vertices(const vector<reco::TransientTrack> & tracks, const int verbosity) const {
   track_t && tks = fill(tracks);
   tks.extractRaw();
-  
+
+  // tracks separated by large gaps in z are annealed independently
+  if (zgap_ > 0) {
+    auto regions = DAClusterizerRegions::findRegions(tks.z_, tks.getSize(), zgap_, minRegionTracks_);
+    if (regions.size() > 1) {
+      auto anneal = [&](DAClusterizerRegions::Region const & r) {
+	track_t rtks = tks.region(r.first, r.second);
+	rtks.extractRaw();
+	return vertices(rtks, verbosity);
+      };
+      // the verbose dumps of concurrent regions would interleave
+      return DAClusterizerRegions::annealRegions(regions, anneal, !verbose_);
+    }
+  }
+  return vertices(tks, verbosity);
+}
+
+
+vector<TransientVertex> 
+DAClusterizerInZT_vect::vertices(track_t & tks, const int verbosity) const {
   unsigned int nt = tks.getSize();
   double rho0 = 0.0; // start with no outlier rejection
   
@@ -1,4 +1,5 @@
 #include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerInZ_vect.h"
+#include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerRegions.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "DataFormats/GeometryCommonDetAlgo/interface/Measurement1D.h"
 #include "RecoVertex/VertexPrimitives/interface/VertexException.h"
@@ -7,6 +8,7 @@
 #include <cassert>
 #include <limits>
 #include <iomanip>
+#include <numeric>
 #include "FWCore/Utilities/interface/isFinite.h"
 #include "vdt/vdtMath.h"
 
@@ -17,6 +19,8 @@ DAClusterizerInZ_vect::DAClusterizerInZ_vect(const edm::ParameterSet& conf) {
   // hardcoded parameters
   maxIterations_ = 100;
   mintrkweight_ = 0.5; // conf.getParameter<double>("mintrkweight");
+  minRegionTracks_ = 10; // smaller regions are annealed with their neighbours
+  zrangeMin_ = 0.1; // smallest z window of a track when banded
 
 
   // configurable debug outptut debug output
@@ -39,6 +43,8 @@ DAClusterizerInZ_vect::DAClusterizerInZ_vect(const edm::ParameterSet& conf) {
   dzCutOff_ = conf.getParameter<double> ("dzCutOff");
   uniquetrkweight_ = conf.getParameter<double>("uniquetrkweight");
   zmerge_ = conf.getParameter<double>("zmerge");
+  zgap_ = conf.getParameter<double>("zgap");
+  zrange_ = conf.getParameter<double>("zrange");
 
   if(verbose_){
     std::cout << "DAClusterizerinZ_vect: mintrkweight = " << mintrkweight_ << std::endl;
@@ -51,6 +57,8 @@ DAClusterizerInZ_vect::DAClusterizerInZ_vect(const edm::ParameterSet& conf) {
     std::cout << "DAClusterizerinZ_vect: coolingFactor = " << coolingFactor_ << std::endl;
     std::cout << "DAClusterizerinZ_vect: d0CutOff = " << d0CutOff_ << std::endl;
     std::cout << "DAClusterizerinZ_vect: dzCutOff = " << dzCutOff_ << std::endl;
+    std::cout << "DAClusterizerinZ_vect: zgap = " << zgap_ << std::endl;
+    std::cout << "DAClusterizerinZ_vect: zrange = " << zrange_ << std::endl;
   }
 
 
@@ -121,6 +129,18 @@ DAClusterizerInZ_vect::fill(const vector<reco::TransientTrack> & tracks) const {
     tks.AddItem(t_z, t_dz2, &(*it), t_pi);
   }
   tks.ExtractRaw();
+
+  // regions and vertex ranges need the tracks ordered in z
+  if ( (zgap_ > 0 || zrange_ > 0) && !std::is_sorted(tks.z.begin(), tks.z.end()) ) {
+    std::vector<unsigned int> order(tks.GetSize());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&tks](unsigned int a, unsigned int b){ return tks.z[a] < tks.z[b]; });
+    track_t sorted;
+    for (auto i : order) sorted.AddItem(tks.z[i], tks.dz2[i], tks.tt[i], tks.pi[i]);
+    sorted.ExtractRaw();
+    tks = std::move(sorted);
+    tks.ExtractRaw();
+  }
   
   if (verbose_) {
     std::cout << "Track count " << tks.GetSize() << std::endl;
@@ -137,6 +157,14 @@ namespace {
   }
 }
 
+void DAClusterizerInZ_vect::set_vtx_range(double beta, track_t & gtracks, vertex_t & gvertices) const {
+  // the vertices a track can contribute to at this temperature
+  DAClusterizerRegions::vertexRange(beta, zrange_, zrangeMin_,
+				    gtracks.GetSize(), gtracks._z, gtracks._dz2,
+				    gvertices.GetSize(), gvertices._z,
+				    gtracks._kmin, gtracks._kmax);
+}
+
 double DAClusterizerInZ_vect::update(double beta, track_t & gtracks,
 				     vertex_t & gvertices, bool useRho0, const double & rho0) const {
 
@@ -162,32 +190,38 @@ double DAClusterizerInZ_vect::update(double beta, track_t & gtracks,
       Z_init = rho0 * local_exp(-beta * dzCutOff_ * dzCutOff_); // cut-off
     }
   
+  // only the vertices in [kmin,kmax) are considered for each track
+  const bool banded = zrange_ > 0;
+  if (banded) set_vtx_range(beta, gtracks, gvertices);
+
   // define kernels
-  auto kernel_calc_exp_arg = [ beta, nv ] ( const unsigned int itrack,
-					     track_t const& tracks,
-					     vertex_t const& vertices ) {
+  auto kernel_calc_exp_arg = [ beta ] ( const unsigned int itrack,
+					 track_t const& tracks,
+					 vertex_t const& vertices,
+					 const unsigned int kmin, const unsigned int kmax ) {
     const double track_z = tracks._z[itrack];
     const double botrack_dz2 = -beta*tracks._dz2[itrack];
 
     // auto-vectorized
-    for ( unsigned int ivertex = 0; ivertex < nv; ++ivertex) {
+    for ( unsigned int ivertex = kmin; ivertex < kmax; ++ivertex) {
       auto mult_res =  track_z - vertices._z[ivertex];
       vertices._ei_cache[ivertex] = botrack_dz2 * ( mult_res * mult_res );
     }
   };
   
-  auto kernel_add_Z = [ nv, Z_init ] (vertex_t const& vertices) -> double
+  auto kernel_add_Z = [ Z_init ] (vertex_t const& vertices, const unsigned int kmin, const unsigned int kmax) -> double
     {
       double ZTemp = Z_init;
-      for (unsigned int ivertex = 0; ivertex < nv; ++ivertex) {	
+      for (unsigned int ivertex = kmin; ivertex < kmax; ++ivertex) {	
 	ZTemp += vertices._pk[ivertex] * vertices._ei[ivertex];
       }
       return ZTemp;
     };
 
-  auto kernel_calc_normalization = [ beta, nv ] (const unsigned int track_num,
-						  track_t & tks_vec,
-						  vertex_t & y_vec ) {
+  auto kernel_calc_normalization = [ beta ] (const unsigned int track_num,
+					      track_t & tks_vec,
+					      vertex_t & y_vec,
+					      const unsigned int kmin, const unsigned int kmax ) {
     auto tmp_trk_pi = tks_vec._pi[track_num];
     auto o_trk_Z_sum = 1./tks_vec._Z_sum[track_num];
     auto o_trk_dz2 = tks_vec._dz2[track_num];
@@ -195,7 +229,7 @@ double DAClusterizerInZ_vect::update(double beta, track_t & gtracks,
     auto obeta =  -1./beta;
     
     // auto-vectorized
-    for (unsigned int k = 0; k < nv; ++k) {
+    for (unsigned int k = kmin; k < kmax; ++k) {
       y_vec._se[k] +=  y_vec._ei[k] * (tmp_trk_pi* o_trk_Z_sum);
       auto w = y_vec._pk[k] * y_vec._ei[k] * (tmp_trk_pi*o_trk_Z_sum *o_trk_dz2);
       y_vec._sw[k]  += w;
@@ -216,16 +250,18 @@ double DAClusterizerInZ_vect::update(double beta, track_t & gtracks,
   
   // loop over tracks
   for (auto itrack = 0U; itrack < nt; ++itrack) {
-    kernel_calc_exp_arg(itrack, gtracks, gvertices);
-    local_exp_list(gvertices._ei_cache, gvertices._ei, nv);
+    const unsigned int kmin = banded ? gtracks._kmin[itrack] : 0;
+    const unsigned int kmax = banded ? gtracks._kmax[itrack] : nv;
+    kernel_calc_exp_arg(itrack, gtracks, gvertices, kmin, kmax);
+    local_exp_list(gvertices._ei_cache + kmin, gvertices._ei + kmin, kmax - kmin);
     
-    gtracks._Z_sum[itrack] = kernel_add_Z(gvertices);
+    gtracks._Z_sum[itrack] = kernel_add_Z(gvertices, kmin, kmax);
     if (edm::isNotFinite(gtracks._Z_sum[itrack])) gtracks._Z_sum[itrack] = 0.0;
     // used in the next major loop to follow
     sumpi += gtracks._pi[itrack];
     
     if (gtracks._Z_sum[itrack] > 1.e-100){
-      kernel_calc_normalization(itrack, gtracks, gvertices);
+      kernel_calc_normalization(itrack, gtracks, gvertices, kmin, kmax);
     }
   }
   
@@ -329,6 +365,32 @@ DAClusterizerInZ_vect::purge(vertex_t & y, track_t & tks, double & rho0, const d
   double sumpmin = nt;
   unsigned int k0 = nv;
   
+  if (zrange_ > 0) {
+    // same sums, but only over the vertices in the range of each track
+    set_vtx_range(beta, tks, y);
+    std::vector<int> nUnique(nv, 0);
+    std::vector<double> sump(nv, 0.);
+    std::vector<double> pmax(nv);
+    for (unsigned int k = 0; k < nv; k++)
+      pmax[k] = y._pk[k] / (y._pk[k] + rho0 * local_exp(-beta * dzCutOff_* dzCutOff_));
+    for (unsigned int i = 0; i < nt; i++) {
+      if (tks._Z_sum[i] > 1.e-100) {
+	for (unsigned int k = tks._kmin[i]; k < tks._kmax[i]; k++) {
+	  double p = y._pk[k] * local_exp(-beta * Eik(tks._z[i], y._z[k], tks._dz2[i])) / tks._Z_sum[i];
+	  sump[k] += p;
+	  if ((p > uniquetrkweight_ * pmax[k]) && (tks._pi[i] > 0)) {
+	    nUnique[k]++;
+	  }
+	}
+      }
+    }
+    for (unsigned int k = 0; k < nv; k++) {
+      if ((nUnique[k] < 2) && (sump[k] < sumpmin)) {
+	sumpmin = sump[k];
+	k0 = k;
+      }
+    }
+  } else {
   for (unsigned int k = 0; k < nv; k++) {
     
     int nUnique = 0;
@@ -351,6 +413,7 @@ DAClusterizerInZ_vect::purge(vertex_t & y, track_t & tks, double & rho0, const d
     }
 
   }
+  }
   
   if (k0 != nv) {
     if (verbose_) {
@@ -452,6 +515,8 @@ DAClusterizerInZ_vect::split(const double beta,  track_t &tks, vertex_t & y, dou
     double p1=0, z1=0, w1=0;
     double p2=0, z2=0, w2=0;
     for(unsigned int i=0; i<nt; i++){
+      // negligible contribution outside of the range of the track
+      if ((zrange_ > 0) && (Eik(tks._z[i], y._z[k], tks._dz2[i]) * beta > zrange_ * zrange_)) continue;
       if (tks._Z_sum[i] > 1.e-100) {
 
 	// winner-takes-all, usually overestimates splitting
@@ -572,7 +637,27 @@ vector<TransientVertex>
 DAClusterizerInZ_vect::vertices(const vector<reco::TransientTrack> & tracks, const int verbosity) const {
   track_t && tks = fill(tracks);
   tks.ExtractRaw();
-  
+
+  // tracks separated by large gaps in z are annealed independently
+  if (zgap_ > 0) {
+    auto regions = DAClusterizerRegions::findRegions(tks._z, tks.GetSize(), zgap_, minRegionTracks_);
+    if (regions.size() > 1) {
+      if (verbose_) std::cout << "DAClusterizerInZ_vect: " << regions.size() << " regions" << std::endl;
+      auto anneal = [&](DAClusterizerRegions::Region const & r) {
+	track_t rtks = tks.Region(r.first, r.second);
+	rtks.ExtractRaw();
+	return vertices(rtks, verbosity);
+      };
+      // the verbose dumps of concurrent regions would interleave
+      return DAClusterizerRegions::annealRegions(regions, anneal, !verbose_);
+    }
+  }
+  return vertices(tks, verbosity);
+}
+
+
+vector<TransientVertex> 
+DAClusterizerInZ_vect::vertices(track_t & tks, const int verbosity) const {
   unsigned int nt = tks.GetSize();
   double rho0 = 0.0; // start with no outlier rejection
   
@@ -713,6 +798,34 @@ DAClusterizerInZ_vect::vertices(const vector<reco::TransientTrack> & tracks, con
   for (unsigned int i = 0; i < nt; i++) // initialize
     tks._Z_sum[i] = rho0 * local_exp(-beta * dzCutOff_ * dzCutOff_);
 
+  if (zrange_ > 0) {
+    // each track can only go to a vertex in its range, the first one above
+    // threshold takes it as in the loop below
+    set_vtx_range(beta, tks, y);
+    for (unsigned int i = 0; i < nt; i++)
+      for (unsigned int k = tks._kmin[i]; k < tks._kmax[i]; k++)
+	tks._Z_sum[i] += y._pk[k] * local_exp(-beta * Eik(tks._z[i], y._z[k],tks._dz2[i]));
+
+    vector<vector<reco::TransientTrack> > vertexTracks(nv);
+    for (unsigned int i = 0; i < nt; i++) {
+      if ((tks._Z_sum[i] > 1e-100) && (tks._pi[i] > 0)) {
+	for (unsigned int k = tks._kmin[i]; k < tks._kmax[i]; k++) {
+	  double p = y._pk[k] * local_exp(-beta * Eik(tks._z[i], y._z[k],
+						      tks._dz2[i])) / tks._Z_sum[i];
+	  if (p > mintrkweight_) {
+	    vertexTracks[k].push_back(*(tks.tt[i]));
+	    break;
+	  }
+	}
+      }
+    }
+    for (unsigned int k = 0; k < nv; k++) {
+      GlobalPoint pos(0, 0, y._z[k]);
+      clusters.emplace_back(pos, dummyError, vertexTracks[k], 0);
+    }
+    return clusters;
+  }
+
   // improve vectorization (does not require reduction ....)
   for (unsigned int k = 0; k < nv; k++) {
      for (unsigned int i = 0; i < nt; i++)  
@@ -0,0 +1,186 @@
+// Checks that the zgap (regions annealed concurrently) and zrange (banded
+// track-vertex assignment) modes of DAClusterizerInZ_vect and DAClusterizerInZT_vect
+// find the same vertices as the default annealing, on toy events of 10 to 140
+// pile-up vertices. The regions have their own critical temperature, so the
+// vertices are only required to be the same within small tolerances.
+
+#include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerInZ_vect.h"
+#include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerInZT_vect.h"
+#include "MagneticField/UniformEngine/interface/UniformMagneticField.h"
+#include "DataFormats/BeamSpot/interface/BeamSpot.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+
+#include "tbb/task_arena.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+  struct ToyEvent {
+    std::vector<reco::Track> tracks;
+    std::vector<reco::TransientTrack> transientTracks;
+    std::vector<unsigned int> simVertex;  // of each track
+    unsigned int nSimVertices;
+  };
+
+  // the chi2 of a toy track is its index, to find its simulated vertex back
+  ToyEvent makeEvent(std::mt19937& rng, unsigned int nPileUp, MagneticField const * field,
+                     reco::BeamSpot const & beamSpot) {
+    ToyEvent event;
+    event.nSimVertices = nPileUp + 1;
+    std::normal_distribution<double> gauss(0., 1.);
+    std::uniform_real_distribution<double> flat(0., 1.);
+    std::geometric_distribution<unsigned int> multiplicity(1./20.);
+
+    std::vector<std::pair<double, double> > trackTimes;
+    for (unsigned int v = 0; v < event.nSimVertices; ++v) {
+      double vz = 3.5 * gauss(rng), vt = 0.18 * gauss(rng);
+      unsigned int nTracks = (v == 0) ? 60 : 2 + multiplicity(rng);
+      for (unsigned int i = 0; i < nTracks; ++i) {
+        double dz = 0.005 + 0.05 * flat(rng) * flat(rng);
+        double pt = 0.5 + 5. * flat(rng) * flat(rng), eta = 5. * flat(rng) - 2.5, phi = 2. * M_PI * flat(rng);
+        reco::Track::Vector momentum(pt * std::cos(phi), pt * std::sin(phi), pt * std::sinh(eta));
+        reco::Track::Point vertex(0., 0., vz + dz * gauss(rng));
+        reco::Track::CovarianceMatrix cov;
+        double p = std::sqrt(momentum.mag2());
+        cov(reco::TrackBase::i_qoverp, reco::TrackBase::i_qoverp) = std::pow(0.01 / p, 2);
+        cov(reco::TrackBase::i_lambda, reco::TrackBase::i_lambda) = 1e-6;
+        cov(reco::TrackBase::i_phi, reco::TrackBase::i_phi) = 1e-6;
+        cov(reco::TrackBase::i_dxy, reco::TrackBase::i_dxy) = 1e-4;
+        cov(reco::TrackBase::i_dsz, reco::TrackBase::i_dsz) = std::pow(dz * pt / p, 2);
+        event.tracks.emplace_back(event.tracks.size(), 10., vertex, momentum, flat(rng) < 0.5 ? -1 : 1, cov);
+        event.simVertex.push_back(v);
+        // 30% of the tracks have no time measurement
+        if (flat(rng) < 0.7) trackTimes.emplace_back(vt + 0.035 * gauss(rng), 0.035);
+        else trackTimes.emplace_back(0., 0.5);
+      }
+    }
+    for (unsigned int i = 0; i < event.tracks.size(); ++i) {
+      event.transientTracks.emplace_back(event.tracks[i], trackTimes[i].first, trackTimes[i].second, field);
+      event.transientTracks.back().setBeamSpot(beamSpot);
+    }
+    // the clusterizer sorts the tracks itself
+    std::shuffle(event.transientTracks.begin(), event.transientTracks.end(), rng);
+    return event;
+  }
+
+  std::vector<TransientVertex> selected(std::vector<TransientVertex> const & vertices) {
+    std::vector<TransientVertex> sel;
+    for (auto const & v : vertices)
+      if (v.originalTracks().size() > 1) sel.push_back(v);
+    return sel;
+  }
+
+  // fraction of the vertices of a with a vertex of b closer than dzMax
+  double matched(std::vector<TransientVertex> const & a, std::vector<TransientVertex> const & b, double dzMax) {
+    if (a.empty()) return 1.;
+    unsigned int n = 0;
+    for (auto const & va : a)
+      for (auto const & vb : b)
+        if (std::abs(va.position().z() - vb.position().z()) < dzMax) { ++n; break; }
+    return double(n) / a.size();
+  }
+
+  // number of simulated vertices with at least 4 tracks which give most of the tracks of a vertex
+  unsigned int found(ToyEvent const & event, std::vector<TransientVertex> const & vertices) {
+    std::vector<unsigned int> nTracks(event.nSimVertices, 0);
+    for (auto v : event.simVertex) ++nTracks[v];
+    std::vector<bool> isFound(event.nSimVertices, false);
+    for (auto const & v : vertices) {
+      std::map<unsigned int, unsigned int> count;
+      for (auto const & t : v.originalTracks()) ++count[event.simVertex[(unsigned int)t.track().chi2()]];
+      auto best = std::max_element(count.begin(), count.end(),
+                                   [](auto const & a, auto const & b) { return a.second < b.second; });
+      if (best != count.end() && 2 * best->second > v.originalTracks().size()) isFound[best->first] = true;
+    }
+    unsigned int n = 0;
+    for (unsigned int s = 0; s < event.nSimVertices; ++s)
+      if (nTracks[s] >= 4 && isFound[s]) ++n;
+    return n;
+  }
+
+  edm::ParameterSet parameters(bool withTime, double zgap, double zrange) {
+    edm::ParameterSet p;
+    // as in TkClusParameters_cff
+    p.addParameter<double>("coolingFactor", 0.6);
+    p.addParameter<double>("Tmin", withTime ? 4.0 : 2.0);
+    p.addParameter<double>("Tpurge", withTime ? 4.0 : 2.0);
+    p.addParameter<double>("Tstop", withTime ? 2.0 : 0.5);
+    p.addParameter<double>("vertexSize", 0.006);
+    p.addParameter<double>("vertexSizeTime", 0.008);
+    p.addParameter<double>("d0CutOff", 3.);
+    p.addParameter<double>("dzCutOff", 3.);
+    p.addParameter<double>("dtCutOff", 4.);
+    p.addParameter<double>("zmerge", 1e-2);
+    p.addParameter<double>("tmerge", 1e-1);
+    p.addParameter<double>("uniquetrkweight", 0.8);
+    p.addParameter<double>("zgap", zgap);
+    p.addParameter<double>("zrange", zrange);
+    return p;
+  }
+
+  std::vector<TransientVertex> vertices(bool withTime, double zgap, double zrange,
+                                        std::vector<reco::TransientTrack> const & tracks) {
+    if (withTime) return selected(DAClusterizerInZT_vect(parameters(withTime, zgap, zrange)).vertices(tracks));
+    return selected(DAClusterizerInZ_vect(parameters(withTime, zgap, zrange)).vertices(tracks));
+  }
+
+  struct Mode {
+    double zgap;
+    double zrange;
+  };
+}
+
+int main() {
+  UniformMagneticField field(3.8);
+  reco::BeamSpot::CovarianceMatrix bsError;
+  reco::BeamSpot beamSpot(reco::BeamSpot::Point(0., 0., 0.), 3.5, 0., 0., 0.001, bsError);
+
+  const std::vector<Mode> modes = {{1.0, 0.}, {0.5, 0.}, {0., 4.}, {1.0, 4.}};
+
+  tbb::task_arena arena(4);
+  std::mt19937 rng(2017);
+  int failures = 0;
+  for (unsigned int nPileUp : {10u, 50u, 140u}) {
+    for (unsigned int e = 0; e < 2; ++e) {
+      ToyEvent event = makeEvent(rng, nPileUp, &field, beamSpot);
+      for (bool withTime : {false, true}) {
+        auto reference = vertices(withTime, 0., 0., event.transientTracks);
+        unsigned int referenceFound = found(event, reference);
+        for (auto const & mode : modes) {
+          std::vector<TransientVertex> test;
+          arena.execute([&] { test = vertices(withTime, mode.zgap, mode.zrange, event.transientTracks); });
+          unsigned int testFound = found(event, test);
+
+          // the banding alone only drops negligible terms; the regions may move a vertex around
+          bool regions = mode.zgap > 0;
+          double nTolerance = regions ? std::max(1., 0.02 * reference.size()) : 1.;
+          double fTolerance = regions ? 0.95 : 0.98;
+          bool ok = std::abs(double(test.size()) - double(reference.size())) <= nTolerance
+            && matched(reference, test, 0.005) >= fTolerance
+            && matched(test, reference, 0.005) >= fTolerance
+            && testFound + std::max(1., 0.02 * referenceFound) >= referenceFound;
+          if (!ok) {
+            std::cout << (withTime ? "DAClusterizerInZT_vect" : "DAClusterizerInZ_vect")
+                      << " pile-up " << nPileUp << " event " << e
+                      << " zgap " << mode.zgap << " zrange " << mode.zrange << ": "
+                      << test.size() << " vertices instead of " << reference.size()
+                      << ", " << testFound << " simulated vertices found instead of " << referenceFound
+                      << std::endl;
+            ++failures;
+          }
+        }
+      }
+    }
+  }
+  if (failures) return 1;
+  std::cout << "DAClusterizer: the zgap and zrange modes find the same vertices as the default annealing"
+            << std::endl;
+  return 0;
+}
@@ -40,6 +40,15 @@ public:
   TrajectoryStateOnSurface update(const TrajectoryStateOnSurface&,
                                   const TrackingRecHit&) const override;
 
+  /// Updates the states with 1D and 2D hits by batches of KFUpdator::batchWidth,
+  /// laid out so that the compiler vectorizes over the states of a batch.
+  void updateBatch(const TrajectoryStateOnSurface* predicted,
+                   const TrackingRecHit* const* hits,
+                   unsigned int n,
+                   TrajectoryStateOnSurface* updated) const override;
+
+  static constexpr unsigned int batchWidth = 8;
+
 
   KFUpdator * clone() const override {
     return new KFUpdator(*this);
@@ -180,3 +180,183 @@ TrajectoryStateOnSurface KFUpdator::update(const TrajectoryStateOnSurface& tsos,
         ", type is " << typeid(aRecHit).name() << "\n";
 }
 
+namespace {
+
+  // Batched update, "matriplex" style: each matrix element is stored as an
+  // array over the states of the batch, so that every step of the update is
+  // a loop over the batch which the compiler turns into vector instructions.
+  constexpr unsigned int kLanes = KFUpdator::batchWidth;
+  typedef double Plex[kLanes];
+
+  // index in the packed storage of a ROOT::Math::MatRepSym
+  constexpr unsigned int sym(unsigned int i, unsigned int j) {
+    return i >= j ? i*(i+1)/2 + j : j*(j+1)/2 + i;
+  }
+
+  template <unsigned int D>
+  struct alignas(64) Batch {
+    static constexpr unsigned int kSym = D*(D+1)/2;
+    Plex x[5];       // predicted parameters
+    Plex c[15];      // predicted covariance
+    Plex res[D];     // residual, measured - predicted
+    Plex v[kSym];    // covariance of the hit
+    Plex r[kSym];    // covariance of the residual
+    Plex cht[5][D];  // C * H^T
+    Plex ok;
+    unsigned int index[kLanes];  // of the state in the input
+    unsigned int size = 0;
+  };
+
+  template <unsigned int D>
+  void loadLane(Batch<D>& b, const TrajectoryStateOnSurface& tsos, const TrackingRecHit& aRecHit) {
+    typedef typename AlgebraicROOTObject<D,D>::SymMatrix SMatDD;
+    typedef typename AlgebraicROOTObject<D>::Vector VecD;
+    using ROOT::Math::SMatrixNoInit;
+
+    auto && x = tsos.localParameters().vector();
+    auto && C = tsos.localError().matrix();
+
+    ProjectMatrix<double,5,D> pf;
+    VecD r, rMeas;
+    SMatDD V(SMatrixNoInit{}), VMeas(SMatrixNoInit{});
+    KfComponentsHolder holder;
+    holder.template setup<D>(&r, &V, &pf, &rMeas, &VMeas, x, C);
+    aRecHit.getKfComponents(holder);
+
+    unsigned int l = b.size;
+    for (unsigned int i = 0; i < 5; ++i) b.x[i][l] = x[i];
+    auto c = C.Array();
+    for (unsigned int i = 0; i < 15; ++i) b.c[i][l] = c[i];
+    for (unsigned int k = 0; k < D; ++k) {
+      b.res[k][l] = r[k] - rMeas[k];
+      for (unsigned int m = 0; m <= k; ++m) {
+        b.v[sym(k,m)][l] = V(k,m);
+        b.r[sym(k,m)][l] = V(k,m) + VMeas(k,m);
+      }
+      for (unsigned int i = 0; i < 5; ++i) b.cht[i][k][l] = C(i, pf.index[k]);
+    }
+  }
+
+  // the same Joseph form as lupdate: M C M^T + K V K^T with M = 1 - K H,
+  // written as C - K H C - (K H C)^T + K R K^T
+  template <unsigned int D>
+  void updateLanes(Batch<D>& b) {
+    constexpr unsigned int kSym = Batch<D>::kSym;
+    Plex rinv[kSym];
+    if constexpr (D == 1) {
+      for (unsigned int l = 0; l < kLanes; ++l) {
+        b.ok[l] = b.r[0][l] > 0.;
+        rinv[0][l] = 1./b.r[0][l];
+      }
+    } else {
+      for (unsigned int l = 0; l < kLanes; ++l) {
+        double det = b.r[0][l]*b.r[2][l] - b.r[1][l]*b.r[1][l];
+        b.ok[l] = b.r[0][l] > 0. && det > 0.;
+        double idet = 1./det;
+        rinv[0][l] =  b.r[2][l]*idet;
+        rinv[1][l] = -b.r[1][l]*idet;
+        rinv[2][l] =  b.r[0][l]*idet;
+      }
+    }
+
+    // Kalman gain
+    Plex k[5][D];
+    for (unsigned int i = 0; i < 5; ++i)
+      for (unsigned int j = 0; j < D; ++j)
+        for (unsigned int l = 0; l < kLanes; ++l) {
+          double sum = 0.;
+          for (unsigned int m = 0; m < D; ++m) sum += b.cht[i][m][l]*rinv[sym(m,j)][l];
+          k[i][j][l] = sum;
+        }
+
+    for (unsigned int i = 0; i < 5; ++i)
+      for (unsigned int l = 0; l < kLanes; ++l) {
+        double sum = 0.;
+        for (unsigned int m = 0; m < D; ++m) sum += k[i][m][l]*b.res[m][l];
+        b.x[i][l] += sum;
+      }
+
+    // K R
+    Plex kr[5][D];
+    for (unsigned int i = 0; i < 5; ++i)
+      for (unsigned int j = 0; j < D; ++j)
+        for (unsigned int l = 0; l < kLanes; ++l) {
+          double sum = 0.;
+          for (unsigned int m = 0; m < D; ++m) sum += k[i][m][l]*b.r[sym(m,j)][l];
+          kr[i][j][l] = sum;
+        }
+
+    for (unsigned int i = 0; i < 5; ++i)
+      for (unsigned int j = 0; j <= i; ++j)
+        for (unsigned int l = 0; l < kLanes; ++l) {
+          double sum = 0.;
+          for (unsigned int m = 0; m < D; ++m)
+            sum += kr[i][m][l]*k[j][m][l] - k[i][m][l]*b.cht[j][m][l] - b.cht[i][m][l]*k[j][m][l];
+          b.c[sym(i,j)][l] += sum;
+        }
+  }
+
+  template <unsigned int D>
+  void storeLanes(Batch<D>& b, const TrajectoryStateOnSurface* predicted, TrajectoryStateOnSurface* updated) {
+    updateLanes(b);
+    for (unsigned int l = 0; l < b.size; ++l) {
+      auto const& tsos = predicted[b.index[l]];
+      if (b.ok[l] != 0.) {
+        AlgebraicVector5 fsv;
+        for (unsigned int i = 0; i < 5; ++i) fsv[i] = b.x[i][l];
+        AlgebraicSymMatrix55 fse;
+        auto c = fse.Array();
+        for (unsigned int i = 0; i < 15; ++i) c[i] = b.c[i][l];
+        updated[b.index[l]] = TrajectoryStateOnSurface( LocalTrajectoryParameters(fsv, tsos.localParameters().pzSign()),
+                                                         LocalTrajectoryError(fse), tsos.surface(),
+                                                         &(tsos.globalParameters().magneticField()), tsos.surfaceSide() );
+      } else {
+        edm::LogError("KFUpdator")<<" could not invert martix for a state of a batch";
+        updated[b.index[l]] = TrajectoryStateOnSurface();
+      }
+    }
+    b.size = 0;
+  }
+
+  template <unsigned int D>
+  void addLane(Batch<D>& b, unsigned int i,
+               const TrajectoryStateOnSurface* predicted, const TrackingRecHit* const* hits,
+               TrajectoryStateOnSurface* updated) {
+    loadLane(b, predicted[i], *hits[i]);
+    b.index[b.size++] = i;
+    if (b.size == kLanes) storeLanes(b, predicted, updated);
+  }
+
+  // the lanes past the size of a partial batch repeat the first one, so that
+  // they do not produce floating point exceptions
+  template <unsigned int D>
+  void flush(Batch<D>& b, const TrajectoryStateOnSurface* predicted, TrajectoryStateOnSurface* updated) {
+    if (b.size == 0) return;
+    for (unsigned int l = b.size; l < kLanes; ++l) {
+      for (auto & e : b.x) e[l] = e[0];
+      for (auto & e : b.c) e[l] = e[0];
+      for (auto & e : b.res) e[l] = e[0];
+      for (auto & e : b.v) e[l] = e[0];
+      for (auto & e : b.r) e[l] = e[0];
+      for (auto & row : b.cht) for (auto & e : row) e[l] = e[0];
+    }
+    storeLanes(b, predicted, updated);
+  }
+}
+
+void KFUpdator::updateBatch(const TrajectoryStateOnSurface* predicted,
+                            const TrackingRecHit* const* hits,
+                            unsigned int n,
+                            TrajectoryStateOnSurface* updated) const {
+  Batch<1> batch1;
+  Batch<2> batch2;
+  for (unsigned int i = 0; i != n; ++i) {
+    switch (hits[i]->dimension()) {
+      case 1: addLane(batch1, i, predicted, hits, updated); break;
+      case 2: addLane(batch2, i, predicted, hits, updated); break;
+      default: updated[i] = update(predicted[i], *hits[i]);
+    }
+  }
+  flush(batch1, predicted, updated);
+  flush(batch2, predicted, updated);
+}
@@ -100,6 +100,8 @@ void print(TrajectoryStateOnSurface const & ts) {
 
 
 #include "FWCore/Utilities/interface/HRRealTime.h"
+#include<algorithm>
+#include<cmath>
 #include<iostream>
 #include<vector>
 
@@ -138,6 +140,29 @@ struct KFUTest {
     std::cout << e-s << std::endl;
   }
 
+  // compares updateBatch with update, returns false if they differ
+  bool batch(std::vector<TrajectoryStateOnSurface> const & tsos,
+	     std::vector<TrackingRecHit const *> const & hits) const {
+    std::vector<TrajectoryStateOnSurface> tsn(tsos.size());
+    edm::HRTimeType s= edm::hrRealTime();
+    tsu.updateBatch(tsos.data(), hits.data(), tsos.size(), tsn.data());
+    edm::HRTimeType e = edm::hrRealTime();
+    std::cout << "batch of " << tsos.size() << ' ' << e-s << std::endl;
+
+    double maxDiff = 0;
+    for (unsigned int i=0; i!=tsos.size(); ++i) {
+      TrajectoryStateOnSurface ref = tsu.update(tsos[i], *hits[i]);
+      if (ref.isValid() != tsn[i].isValid()) return false;
+      if (!ref.isValid()) continue;
+      auto && dv = ref.localParameters().vector() - tsn[i].localParameters().vector();
+      for (int j=0; j<5; ++j) maxDiff = std::max(maxDiff, std::abs(dv[j]));
+      AlgebraicSymMatrix55 dm = ref.localError().matrix() - tsn[i].localError().matrix();
+      for (int j=0; j<5; ++j) for (int k=0; k<5; ++k) maxDiff = std::max(maxDiff, std::abs(dm(j,k)));
+    }
+    std::cout << "max difference to update " << maxDiff << std::endl;
+    return maxDiff < 1.e-10;
+  }
+
 };
 
 struct Chi2Test {
@@ -232,6 +257,18 @@ int main() {
   kt.time(ts,*thit);
   kt.time(ts2,*thit);
 
+  // more states than a batch, with 1D and 2D hits mixed
+  std::vector<TrajectoryStateOnSurface> states;
+  std::vector<TrackingRecHit const *> hits;
+  TrackingRecHit const * someHits[] = {thit, &hit2d, &hitpx, &hitpj, &hit1d};
+  for (unsigned int i=0; i!=3*KFUpdator::batchWidth+3; ++i) {
+    states.push_back(i%2 ? ts : ts2);
+    hits.push_back(someHits[i%5]);
+  }
+  if (!kt.batch(states,hits)) {
+    std::cout << "updateBatch differs from update" << std::endl;
+    return 1;
+  }
 
 
   std::cout << "\n** Chi2 ** \n" << std::endl;
@@ -19,6 +19,17 @@ class TrajectoryStateUpdator {
   
   virtual TrajectoryStateOnSurface update(const TrajectoryStateOnSurface&,
 					  const TrackingRecHit&) const = 0;
+
+  /** Updates n independent predicted states, each with its own hit, and
+   *  writes the results to updated[0..n-1]. Implementations can override it
+   *  to process several states at once; by default it calls update for each.
+   */
+  virtual void updateBatch(const TrajectoryStateOnSurface* predicted,
+			   const TrackingRecHit* const* hits,
+			   unsigned int n,
+			   TrajectoryStateOnSurface* updated) const {
+    for (unsigned int i = 0; i != n; ++i) updated[i] = update(predicted[i], *hits[i]);
+  }
   
   virtual TrajectoryStateUpdator * clone() const = 0;
   